@@ -3,7 +3,7 @@
 #
 
 set (QQUALIF_MAJOR_VERSION "4")
-set (QQUALIF_MINOR_VERSION "6")
+set (QQUALIF_MINOR_VERSION "7")
 set (QQUALIF_RELEASE_VERSION "0")
 set (QQUALIF_VERSION ${QQUALIF_MAJOR_VERSION}.${QQUALIF_MINOR_VERSION}.${QQUALIF_RELEASE_VERSION})
 
@@ -0,0 +1,1269 @@
+//
+// CalQualBatch : analyse qualité de maillages en mode non interactif, destiné
+// à être intégré dans des chaînes de calcul (noeuds de calcul sans display).
+//
+// Pour chaque critère demandé une unique tâche Qualif est exécutée sur
+// l'ensemble des séries de tous les fichiers, ce qui permet à
+// QualifRangeTask/QualifAnalysisTask de traiter les séries en parallèle dans
+// la limite du nombre de threads alloué (option -threads). Le chargement des
+// fichiers est également effectué en parallèle dans cette même limite, hormis
+// la lecture des fichiers Lima, sérialisée par LimaMeshCache.
+//
+
+#include "GQualif/QualifAnalysisTask.h"
+#include "GQualif/QualifHelper.h"
+#include "GQualif/QualifRangeTask.h"
+#include "GQualif/QualifTracer.h"
+#include "GQLima/LimaMeshCache.h"
+#include "GQLima/LimaQualifSerie.h"
+#ifdef USE_VTK
+#include "GQVtk/VtkQualifSerie.h"
+#endif	// USE_VTK
+#ifdef USE_GMDS
+#include "GQGMDS/GMDSQualifSerie.h"
+#include "GQGMDS/MeditFileScanner.h"
+#endif	// USE_GMDS
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/File.h>
+#include <TkUtil/InternalError.h>
+#include <TkUtil/NumericServices.h>
+#include <TkUtil/ThreadManager.h>
+#include <TkUtil/UTF8String.h>
+
+#include <Lima/erreur.h>
+#ifdef USE_GMDS
+#include <gmds/io/IGMeshIOService.h>
+#include <gmds/io/MeditReader.h>
+#include <gmds/io/VTKReader.h>
+#endif	// USE_GMDS
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+
+USING_UTIL
+USING_STD
+using namespace GQualif;
+using namespace Qualif;
+
+static const Charset	charset ("àéèùô");
+
+
+// ============================================================================
+//                          PARAMETRES DE L'ANALYSE
+// ============================================================================
+
+/** Mode de détermination du domaine d'échantillonnage des critères. */
+enum DOMAIN_MODE { COMPUTED_DOMAIN, THEORETICAL_DOMAIN, USER_DOMAIN };
+
+/** Format de sortie des résultats. */
+enum OUTPUT_FORMAT { JSON_FORMAT, CSV_FORMAT };
+
+static vector<string>		meshPaths;
+static vector<string>		groupNames;
+static vector<Critere>		criteria;
+static size_t				classNum		= 10;
+static size_t				userTypes		= 0;
+static DOMAIN_MODE			domainMode		= COMPUTED_DOMAIN;
+static double				domainMin		= 0., domainMax	= 1.;
+static bool					strictMode		= false;
+static bool					cellValues		= false;
+static bool					validation		= false;
+static bool					snapshots		= false;
+static bool					reordering		= false;
+static bool					listing			= false;
+static OUTPUT_FORMAT		outputFormat	= JSON_FORMAT;
+static string				outputPath;
+static string				tracePath;
+static string				reader;
+static size_t				threadsNum		= 0;
+
+
+// ============================================================================
+//                     STRUCTURES DE DONNEES DES RESULTATS
+// ============================================================================
+
+/**
+ * Un fichier maillage chargé et les séries qui en sont issues.
+ */
+struct MeshFile
+{
+	MeshFile (const string& path)
+		: fileName (path), limaMesh ( ),
+#ifdef USE_GMDS
+		  gmdsMesh ( ),
+#endif	// USE_GMDS
+		  series ( ), loadingTime (0.), error ( )
+	{ }
+
+	~MeshFile ( )
+	{
+		for (vector<AbstractQualifSerie*>::iterator its = series.begin ( );
+		     series.end ( ) != its; its++)
+			delete *its;
+		series.clear ( );
+	}
+
+	string									fileName;
+	shared_ptr<Lima::_MaillageInterne>		limaMesh;
+#ifdef USE_GMDS
+	unique_ptr<gmds::Mesh>					gmdsMesh;
+#endif	// USE_GMDS
+	vector<AbstractQualifSerie*>			series;
+	double									loadingTime;
+	string									error;
+
+
+	private :
+
+	MeshFile (const MeshFile&);
+	MeshFile& operator = (const MeshFile&);
+};	// struct MeshFile
+
+
+/**
+ * Les statistiques d'une série pour un critère donné.
+ */
+struct SerieStatistics
+{
+	SerieStatistics ( )
+		: count (0), undefined (0),
+		  min (NumericServices::doubleMachMax ( )),
+		  max (-NumericServices::doubleMachMax ( )), mean (0.), stddev (0.)
+	{ }
+
+	size_t		count, undefined;
+	double		min, max, mean, stddev;
+};	// struct SerieStatistics
+
+
+/**
+ * Le résultat de l'analyse de l'ensemble des séries pour un critère donné.
+ */
+struct CriterionResult
+{
+	CriterionResult (Critere c)
+		: criterion (c), types (0), min (0.), max (1.), applicable (false),
+		  histograms ( ), statistics ( ), values ( )
+	{ }
+
+	Critere								criterion;
+	size_t								types;
+	double								min, max;
+	bool								applicable;
+	/** Les histogrammes : histograms [cl][s] */
+	vector< vector<size_t> >			histograms;
+	/** Les statistiques : statistics [s] */
+	vector<SerieStatistics>				statistics;
+	/** Les éventuelles valeurs par maille : values [s][c] (NaN si
+	 * indéfinie). */
+	vector< vector<double> >			values;
+};	// struct CriterionResult
+
+
+/**
+ * Chronométrage des différentes phases du traitement.
+ */
+struct PhaseTimings
+{
+	PhaseTimings ( )
+		: loading (0.), reordering (0.), validation (0.), range (0.),
+		  classification (0.), statistics (0.), writing (0.)
+	{ }
+
+	double	loading, reordering, validation, range, classification, statistics,
+			writing;
+};	// struct PhaseTimings
+
+
+typedef chrono::steady_clock	Clock;
+
+static double elapsed (const Clock::time_point& start)
+{
+	return chrono::duration<double> (Clock::now ( ) - start).count ( );
+}	// elapsed
+
+
+static int parseArgs (int argc, char* argv []);
+static int syntax (const string& pgm);
+static void loadMeshFile (MeshFile& meshFile, size_t threads);
+static int listMeshFiles ( );
+static void loadMeshFiles (vector<MeshFile*>& files, size_t threads);
+static void analyse (const vector<AbstractQualifSerie*>& series,
+                     CriterionResult& result, PhaseTimings& timings);
+static void writeJson (ostream& stream, const vector<MeshFile*>& files,
+                       const vector<CriterionResult*>& results,
+                       const PhaseTimings& timings, size_t threads);
+static void writeCsv (ostream& stream, const vector<MeshFile*>& files,
+                      const vector<CriterionResult*>& results,
+                      const PhaseTimings& timings, size_t threads);
+
+
+int main (int argc, char* argv[])
+{
+	if (0 != parseArgs (argc, argv))
+		return syntax (argv [0]);
+	if (true == listing)
+		return listMeshFiles ( );
+
+	vector<MeshFile*>			files;
+	vector<CriterionResult*>	results;
+	int							status	= 0;
+
+	try
+	{
+		PhaseTimings	timings;
+		const size_t	threads	= QualifHelper::getThreadsNum (threadsNum);
+		ThreadManager::initialize (threads);
+		if (false == tracePath.empty ( ))
+			QualifTracer::start ( );
+
+		// Chargement des fichiers :
+		Clock::time_point	start	= Clock::now ( );
+		for (vector<string>::const_iterator itp = meshPaths.begin ( );
+		     meshPaths.end ( ) != itp; itp++)
+			files.push_back (new MeshFile (*itp));
+		loadMeshFiles (files, threads);
+		timings.loading	= elapsed (start);
+
+		vector<AbstractQualifSerie*>	series;
+		size_t							types	= 0;
+		for (vector<MeshFile*>::const_iterator itf = files.begin ( );
+		     files.end ( ) != itf; itf++)
+		{
+			if (false == (*itf)->error.empty ( ))
+			{
+				cerr << (*itf)->error << endl;
+				status	= -2;
+			}	// if (false == (*itf)->error.empty ( ))
+			for (vector<AbstractQualifSerie*>::const_iterator its =
+			     (*itf)->series.begin ( ); (*itf)->series.end ( ) != its; its++)
+			{
+				series.push_back (*its);
+				types	|= (*its)->getDataTypes ( );
+			}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+		}	// for (vector<MeshFile*>::const_iterator itf = files.begin ( ); ...
+		if (0 != userTypes)
+			types	&= userTypes;
+
+		// Ordre d'évaluation des mailles (courbe de Morton) et
+		// renumérotation des noeuds des instantanés :
+		if (true == reordering)
+		{
+			for (vector<AbstractQualifSerie*>::iterator its = series.begin ( );
+			     series.end ( ) != its; its++)
+				timings.reordering	+=
+						(*its)->computeEvaluationOrder (threads, true);
+			cerr << "Calcul de l'ordre d'évaluation des mailles : "
+			     << timings.reordering << " s." << endl;
+		}	// if (true == reordering)
+
+		// Validation éventuelle des coordonnées :
+		if (true == validation)
+		{
+			start	= Clock::now ( );
+			for (vector<AbstractQualifSerie*>::iterator its = series.begin ( );
+			     series.end ( ) != its; its++)
+				(*its)->validateCoordinates ( );
+			timings.validation	= elapsed (start);
+		}	// if (true == validation)
+
+		// Analyse, critère par critère :
+		for (vector<Critere>::const_iterator itc = criteria.begin ( );
+		     criteria.end ( ) != itc; itc++)
+		{
+			CriterionResult*	result	= new CriterionResult (*itc);
+			results.push_back (result);
+			for (size_t type = QualifHelper::TRIANGLE;
+			     type <= QualifHelper::TRIANGULAR_PRISM; type <<= 1)
+				if ((0 != (type & types)) &&
+				    (true == QualifHelper::isTypeSupported (type, *itc)))
+					result->types	|= type;
+			result->applicable	= 0 != result->types;
+			if ((true == result->applicable) && (0 != series.size ( )))
+				analyse (series, *result, timings);
+		}	// for (vector<Critere>::const_iterator itc = criteria.begin ( );
+
+		// Ecriture des résultats :
+		start	= Clock::now ( );
+		unique_ptr<ofstream>	file;
+		if (false == outputPath.empty ( ))
+		{
+			file.reset (new ofstream (outputPath.c_str ( )));
+			if (false == file->good ( ))
+			{
+				UTF8String	error (charset);
+				error << "Impossibilité d'ouvrir le fichier " << outputPath
+				      << " en écriture.";
+				throw Exception (error);
+			}	// if (false == file->good ( ))
+		}	// if (false == outputPath.empty ( ))
+		ostream&	stream	= 0 == file.get ( ) ? cout : *file;
+		stream << setprecision (numeric_limits<double>::digits10 + 1);
+		if (JSON_FORMAT == outputFormat)
+			writeJson (stream, files, results, timings, threads);
+		else
+			writeCsv (stream, files, results, timings, threads);
+		stream.flush ( );
+		// Le temps d'écriture ne peut figurer dans les résultats écrits, il
+		// est affiché sur la sortie d'erreur :
+		timings.writing	= elapsed (start);
+		cerr << "Ecriture des résultats : " << timings.writing << " s." << endl;
+
+		// Ecriture de la chronologie :
+		if (false == tracePath.empty ( ))
+		{
+			QualifTracer::stop ( );
+			QualifTracer::write (tracePath);
+		}	// if (false == tracePath.empty ( ))
+	}
+	catch (const Exception& exc)
+	{
+		cerr << "Erreur : " << exc.getFullMessage ( ) << endl;
+		status	= -3;
+	}
+	catch (const exception& exc)
+	{
+		cerr << "Erreur : " << exc.what ( ) << endl;
+		status	= -4;
+	}
+	catch (...)
+	{
+		cerr << "Erreur non documentée." << endl;
+		status	= -5;
+	}
+
+	for (vector<CriterionResult*>::iterator itr = results.begin ( );
+	     results.end ( ) != itr; itr++)
+		delete *itr;
+	for (vector<MeshFile*>::iterator itf = files.begin ( );
+	     files.end ( ) != itf; itf++)
+		delete *itf;
+
+	return status;
+}	// int main (int, char*[])
+
+
+// ============================================================================
+//                           CHARGEMENT DES MAILLAGES
+// ============================================================================
+
+static bool isGroupRequested (const string& name)
+{
+	if (0 == groupNames.size ( ))
+		return true;
+
+	for (vector<string>::const_iterator itg = groupNames.begin ( );
+	     groupNames.end ( ) != itg; itg++)
+		if (*itg == name)
+			return true;
+
+	return false;
+}	// isGroupRequested
+
+
+static void loadLimaFile (MeshFile& meshFile, size_t threads)
+{
+	const string&	fileName	= meshFile.fileName;
+	// Un même fichier éventuellement transmis plusieurs fois n'est lu
+	// qu'une fois :
+	meshFile.limaMesh	= LimaMeshCache::getMesh (fileName);
+	Lima::_MaillageInterne&	mesh	= *meshFile.limaMesh.get ( );
+
+	size_t	g	= 0;
+	for (g = 0; g < mesh.nb_volumes ( ); g++)
+		if (true == isGroupRequested (mesh.volume (g)->nom ( )))
+			meshFile.series.push_back (
+					new LimaQualifSerie (*mesh.volume (g), fileName, &mesh));
+	for (g = 0; g < mesh.nb_surfaces ( ); g++)
+		if (true == isGroupRequested (mesh.surface (g)->nom ( )))
+			meshFile.series.push_back (new LimaQualifSerie (
+					*mesh.surface (g), mesh.dimension ( ), fileName, &mesh));
+
+	// Pas de groupe => on prend les mailles 2D ou 3D du maillage :
+	if ((0 == meshFile.series.size ( )) && (0 == groupNames.size ( )))
+	{
+		unsigned char	dimension	= 0;
+		if (0 != mesh.nb_polyedres ( ))
+			dimension	= 3;
+		else if (0 != mesh.nb_polygones ( ))
+			dimension	= 2;
+		if (0 == dimension)
+			throw Exception (
+				UTF8String ("Absence de mailles 2D ou 3D dans le maillage.", charset));
+		meshFile.series.push_back (
+				new LimaQualifSerie (mesh, false, dimension, "", fileName));
+	}	// if ((0 == meshFile.series.size ( )) && ...
+
+	// Instantanés des groupes, avec les threads alloués à ce chargement : le
+	// maillage Lima n'est alors plus utile.
+	if (true == snapshots)
+	{
+		for (vector<AbstractQualifSerie*>::iterator its =
+		     meshFile.series.begin ( ); meshFile.series.end ( ) != its; its++)
+			dynamic_cast<LimaQualifSerie*>(*its)->createSnapshot (threads);
+		meshFile.limaMesh.reset ( );
+	}	// if (true == snapshots)
+}	// loadLimaFile
+
+
+#ifdef USE_GMDS
+
+static const int	gmdsMask	=
+				gmds::DIM3|gmds::N|gmds::E|gmds::F|gmds::R|gmds::E2N|
+				gmds::F2N|gmds::R2N|gmds::F2E|gmds::R2F|gmds::F2R|
+				gmds::N2F|gmds::N2E|gmds::E2F|gmds::N2R|gmds::E2R|gmds::R2E;
+
+static void loadGMDSFile (MeshFile& meshFile)
+{
+	const string&	fileName	= meshFile.fileName;
+	TkUtil::File	file (fileName);
+	meshFile.gmdsMesh.reset (new gmds::Mesh (gmdsMask));
+	gmds::Mesh&		mesh	= *meshFile.gmdsMesh.get ( );
+	gmds::IGMeshIOService ioService (&mesh);
+	if ((0 == strcasecmp (file.getExtension ( ).c_str ( ), "mesh")) ||
+	    (0 == strcasecmp (file.getExtension ( ).c_str ( ), "med")))
+	{
+		gmds::MeditReader reader (&ioService);
+		reader.setCellOptions (gmds::R|gmds::F|gmds::N);
+		reader.read (fileName);
+	}	// mesh med
+	else
+	{
+		gmds::VTKReader	reader (&ioService);
+		reader.read (fileName);
+	}	// vtu vtp
+
+	for (auto its = mesh.groups_begin<gmds::Face>( );
+	     its != mesh.groups_end<gmds::Face>( ); its++)
+		if (true == isGroupRequested ((*its)->name ( )))
+			meshFile.series.push_back (
+					new GMDSFaceQualifSerie (mesh, (*its)->name ( ), fileName));
+	for (auto itv = mesh.groups_begin<gmds::Region>( );
+	     itv != mesh.groups_end<gmds::Region>( ); itv++)
+		if (true == isGroupRequested ((*itv)->name ( )))
+			meshFile.series.push_back (
+				new GMDSRegionQualifSerie (mesh, (*itv)->name ( ), fileName));
+
+	if ((0 == meshFile.series.size ( )) && (0 == groupNames.size ( )))
+	{
+		if (0 != mesh.getNbRegions ( ))
+			meshFile.series.push_back (
+						new GMDSRegionQualifSerie (mesh, "", fileName));
+		else if (0 != mesh.getNbFaces ( ))
+			meshFile.series.push_back (
+						new GMDSFaceQualifSerie (mesh, "", fileName));
+		else
+			throw Exception (
+				UTF8String ("Absence de mailles 2D ou 3D dans le maillage.", charset));
+	}	// if ((0 == meshFile.series.size ( )) && ...
+}	// loadGMDSFile
+
+#endif	// USE_GMDS
+
+
+/**
+ * @return		Le lecteur (<I>lima</I>, <I>vtk</I> ou <I>gmds</I>) du fichier
+ * 				transmis en argument : celui demandé (option <I>-reader</I>)
+ * 				ou, à défaut, celui correspondant à l'extension du fichier.
+ * @exception	Une exception est levée si le fichier n'est pas accessible.
+ */
+static string meshFormat (const string& fileName)
+{
+	TkUtil::File	file (fileName);
+	if (false == file.isReadable ( ))
+	{
+		UTF8String	message (charset);
+		message << "Le fichier " << fileName << " n'existe pas ou n'est "
+		        << "pas accessible en lecture.";
+		throw Exception (message);
+	}	// if (false == file.isReadable ( ))
+
+	const string	extension	= file.getExtension ( );
+	string			format		= reader;
+	if (true == format.empty ( ))
+	{
+		if (0 == strcasecmp (extension.c_str ( ), "vtk"))
+			format	= "vtk";
+#ifdef USE_GMDS
+		else if ((0 == strcasecmp (extension.c_str ( ), "mesh")) ||
+		         (0 == strcasecmp (extension.c_str ( ), "med"))  ||
+		         (0 == strcasecmp (extension.c_str ( ), "vtu"))  ||
+		         (0 == strcasecmp (extension.c_str ( ), "vtp")))
+			format	= "gmds";
+#endif	// USE_GMDS
+		else
+			format	= "lima";
+	}	// if (true == format.empty ( ))
+
+	return format;
+}	// meshFormat
+
+
+static void loadMeshFile (MeshFile& meshFile, size_t threads)
+{
+	const Clock::time_point	start		= Clock::now ( );
+	const string&			fileName	= meshFile.fileName;
+	QualifTraceScope		scope ("Chargement", "loading", fileName);
+
+	try
+	{
+		TkUtil::File	file (fileName);
+		const string	format	= meshFormat (fileName);
+		if ("lima" == format)
+			loadLimaFile (meshFile, threads);
+#ifdef USE_VTK
+		else if ("vtk" == format)
+			meshFile.series.push_back (
+						new VtkQualifSerie (fileName, file.getFileName ( )));
+#endif	// USE_VTK
+#ifdef USE_GMDS
+		else if ("gmds" == format)
+			loadGMDSFile (meshFile);
+#endif	// USE_GMDS
+		else
+		{
+			UTF8String	message (charset);
+			message << "Format de maillage non supporté (" << format << ").";
+			throw Exception (message);
+		}
+
+		if (0 == meshFile.series.size ( ))
+			throw Exception (
+				UTF8String ("Aucun des groupes demandés n'est présent dans le maillage.", charset));
+	}
+	catch (const Exception& exc)
+	{
+		UTF8String	message (charset);
+		message << "Impossibilité de charger le maillage contenu dans le "
+		        << "fichier " << fileName << " :" << "\n"
+		        << exc.getFullMessage ( );
+		meshFile.error	= message.utf8 ( );
+	}
+	catch (const Lima::erreur& err)
+	{
+		UTF8String	message (charset);
+		message << "Impossibilité de charger le maillage Lima contenu dans le "
+		        << "fichier " << fileName << " :" << "\n" << err.what ( );
+		meshFile.error	= message.utf8 ( );
+	}
+#ifdef USE_GMDS
+	catch (const gmds::GMDSException& gexc)
+	{
+		UTF8String	message (charset);
+		message << "Impossibilité de charger le maillage GMDS contenu dans le "
+		        << "fichier " << fileName << " :" << "\n" << gexc.what ( );
+		meshFile.error	= message.utf8 ( );
+	}
+#endif	// USE_GMDS
+	catch (const exception& exc)
+	{
+		UTF8String	message (charset);
+		message << "Impossibilité de charger le maillage contenu dans le "
+		        << "fichier " << fileName << " :" << "\n" << exc.what ( );
+		meshFile.error	= message.utf8 ( );
+	}
+	catch (...)
+	{
+		UTF8String	message (charset);
+		message << "Impossibilité de charger le maillage contenu dans le "
+		        << "fichier " << fileName << " : erreur non documentée.";
+		meshFile.error	= message.utf8 ( );
+	}
+
+	if (false == meshFile.error.empty ( ))
+	{	// On ne garde pas de résultats partiels :
+		for (vector<AbstractQualifSerie*>::iterator its =
+		     meshFile.series.begin ( ); meshFile.series.end ( ) != its; its++)
+			delete *its;
+		meshFile.series.clear ( );
+	}	// if (false == meshFile.error.empty ( ))
+
+	meshFile.loadingTime	= elapsed (start);
+}	// loadMeshFile
+
+
+/**
+ * Affiche sur la sortie standard la description sommaire des groupes de
+ * mailles des fichiers, obtenue sans chargement des maillages.
+ * @return		0 en cas de succès, un code d'erreur sinon.
+ */
+static int listMeshFiles ( )
+{
+	int	status	= 0;
+	for (vector<string>::const_iterator itp = meshPaths.begin ( );
+	     meshPaths.end ( ) != itp; itp++)
+	{
+		try
+		{
+			const string				format	= meshFormat (*itp);
+			vector<QualifGroupMetadata>	metadata;
+			bool						known	= true;
+			if ("lima" == format)
+				metadata	= LimaQualifSerie::getMetadata (*itp);
+#ifdef USE_VTK
+			else if ("vtk" == format)
+				metadata.push_back (VtkQualifSerie::getMetadata (*itp));
+#endif	// USE_VTK
+#ifdef USE_GMDS
+			else if ("gmds" == format)
+				known	= MeditFileScanner::scan (*itp, metadata);
+#endif	// USE_GMDS
+			else
+			{
+				UTF8String	message (charset);
+				message << "Format de maillage non supporté (" << format << ").";
+				throw Exception (message);
+			}
+
+			cout << *itp << " :" << "\n";
+			if (false == known)
+				cout << "\t" << "Description non disponible pour ce format."
+				     << "\n";
+			for (vector<QualifGroupMetadata>::const_iterator itm =
+			     metadata.begin ( ); metadata.end ( ) != itm; itm++)
+				cout << "\t" << (*itm).getDescription ( ) << "\n";
+			cout.flush ( );
+		}
+		catch (const Exception& exc)
+		{
+			cerr << "Erreur : " << exc.getFullMessage ( ) << endl;
+			status	= -2;
+		}
+		catch (const Lima::erreur& err)
+		{
+			cerr << "Erreur Lima : " << err.what ( ) << endl;
+			status	= -2;
+		}
+		catch (const exception& exc)
+		{
+			cerr << "Erreur : " << exc.what ( ) << endl;
+			status	= -2;
+		}
+	}	// for (vector<string>::const_iterator itp = meshPaths.begin ( ); ...
+
+	return status;
+}	// listMeshFiles
+
+
+static void loadMeshFiles (vector<MeshFile*>& files, size_t threads)
+{
+	// Les fichiers sont chargés en parallèle (hors lectures Lima, cf.
+	// LimaMeshCache), chaque thread prenant le prochain fichier non chargé.
+	// Les threads alloués sont répartis entre
+	// les chargements (instantanés des séries) :
+	atomic<size_t>	next (0);
+	const size_t	count	= files.size ( );
+	const size_t	num		= threads < count ? threads : count;
+	const size_t	share	= (0 != num) && (threads / num > 1) ? threads / num : 1;
+	vector<thread>	loaders;
+	for (size_t t = 0; t < num; t++)
+		loaders.push_back (thread ([&files, &next, count, share] ( )
+		{
+			for (size_t f = next++; f < count; f = next++)
+				loadMeshFile (*files [f], share);
+		}));
+	for (vector<thread>::iterator itt = loaders.begin ( );
+	     loaders.end ( ) != itt; itt++)
+		(*itt).join ( );
+}	// loadMeshFiles
+
+
+// ============================================================================
+//                               L'ANALYSE
+// ============================================================================
+
+static void analyse (const vector<AbstractQualifSerie*>& series,
+                     CriterionResult& result, PhaseTimings& timings)
+{
+	const Critere	criterion	= result.criterion;
+	const size_t	seriesNum	= series.size ( );
+
+	// Calcul (et mise en cache) des valeurs du critère pour chaque maille, et
+	// du domaine couvert :
+	Clock::time_point	start	= Clock::now ( );
+	QualifRangeTask		rangeTask (result.types, criterion, series);
+	rangeTask.execute ( );
+	timings.range	+= elapsed (start);
+
+	switch (domainMode)
+	{
+		case	USER_DOMAIN			:
+			result.min	= domainMin;
+			result.max	= domainMax;
+			break;
+		case	THEORETICAL_DOMAIN	:
+			// Les bornes infinies sont remplacées par les bornes calculées :
+			QualifHelper::getDomain (
+							criterion, result.types, result.min, result.max);
+			if (false == NumericServices::isValidAndNotMax (result.min))
+				result.min	= rangeTask.getMin ( );
+			if (false == NumericServices::isValidAndNotMax (result.max))
+				result.max	= rangeTask.getMax ( );
+			break;
+		default						:
+			rangeTask.getRange (result.min, result.max);
+	}	// switch (domainMode)
+
+	// Répartition en classes :
+	start	= Clock::now ( );
+	QualifAnalysisTask	analysisTask (result.types, criterion, classNum,
+							result.min, result.max, strictMode, series);
+	analysisTask.execute ( );
+	result.histograms	= analysisTask.getSeriesValues ( );
+	timings.classification	+= elapsed (start);
+
+	// Statistiques et éventuelles valeurs par maille :
+	start	= Clock::now ( );
+	result.statistics.resize (seriesNum);
+	if (true == cellValues)
+		result.values.resize (seriesNum);
+	for (size_t s = 0; s < seriesNum; s++)
+	{
+		AbstractQualifSerie&	serie	= *series [s];
+		SerieStatistics&		stats	= result.statistics [s];
+		const size_t			count	= serie.getCellCount ( );
+		double					sum		= 0., sum2	= 0.;
+		if (true == cellValues)
+			result.values [s].assign (
+							count, numeric_limits<double>::quiet_NaN ( ));
+		for (size_t c = 0; c < count; c++)
+		{
+			try
+			{
+				if (0 == (serie.getCellType (c) & result.types))
+					continue;
+
+				const double	value	= serie.getStoredCriteria (criterion, c);
+				stats.count++;
+				stats.min	= value < stats.min ? value : stats.min;
+				stats.max	= value > stats.max ? value : stats.max;
+				sum		+= value;
+				sum2	+= value * value;
+				if (true == cellValues)
+					result.values [s][c]	= value;
+			}
+			catch (...)
+			{	// Critère non défini pour cette maille.
+				stats.undefined++;
+			}
+		}	// for (size_t c = 0; c < count; c++)
+		if (0 != stats.count)
+		{
+			stats.mean		= sum / stats.count;
+			const double	variance	= sum2 / stats.count - stats.mean * stats.mean;
+			stats.stddev	= 0. < variance ? sqrt (variance) : 0.;
+		}	// if (0 != stats.count)
+
+		// Les valeurs ont été exploitées, on libère la mémoire avant de passer
+		// au critère suivant :
+		serie.releaseStoredData ( );
+	}	// for (size_t s = 0; s < seriesNum; s++)
+	timings.statistics	+= elapsed (start);
+}	// analyse
+
+
+// ============================================================================
+//                          ECRITURE DES RESULTATS
+// ============================================================================
+
+static string csvString (const string& str)
+{
+	string	csv ("\"");
+	for (string::const_iterator it = str.begin ( ); str.end ( ) != it; it++)
+	{
+		if ('"' == *it)
+			csv += '"';
+		csv += *it;
+	}	// for (string::const_iterator it = str.begin ( ); ...
+	csv += "\"";
+
+	return csv;
+}	// csvString
+
+
+/** Ecrit la valeur transmise en argument, <I>null</I> si elle n'est pas
+ * représentable (NaN, infinie). */
+static void writeNumber (ostream& stream, double value, const char* invalid)
+{
+	if (true == NumericServices::isValid (value))
+		stream << value;
+	else
+		stream << invalid;
+}	// writeNumber
+
+
+static void writeJson (ostream& stream, const vector<MeshFile*>& files,
+                       const vector<CriterionResult*>& results,
+                       const PhaseTimings& timings, size_t threads)
+{
+	size_t	s	= 0;	// Indice global de la série
+	stream << "{" << "\n"
+	       << "  \"version\": " << QualifHelper::jsonString (
+	                               QualifHelper::getVersion ( ).getVersion ( ))
+	       << ",\n"
+	       << "  \"threads\": " << threads << ",\n"
+	       << "  \"classes\": " << classNum << ",\n"
+	       << "  \"strict\": " << (true == strictMode ? "true" : "false")
+	       << ",\n"
+	       << "  \"files\": [";
+	for (vector<MeshFile*>::const_iterator itf = files.begin ( );
+	     files.end ( ) != itf; itf++)
+	{
+		const MeshFile&	meshFile	= **itf;
+		stream << (files.begin ( ) == itf ? "" : ",") << "\n"
+		       << "    {" << "\n"
+		       << "      \"file\": "
+		       << QualifHelper::jsonString (meshFile.fileName) << ",\n"
+		       << "      \"loadingTime\": " << meshFile.loadingTime << ",\n";
+		if (false == meshFile.error.empty ( ))
+			stream << "      \"error\": "
+			       << QualifHelper::jsonString (meshFile.error) << ",\n";
+		stream << "      \"series\": [";
+		for (size_t fs = 0; fs < meshFile.series.size ( ); fs++, s++)
+		{
+			const AbstractQualifSerie&	serie	= *meshFile.series [fs];
+			stream << (0 == fs ? "" : ",") << "\n"
+			       << "        {" << "\n"
+			       << "          \"name\": "
+			       << QualifHelper::jsonString (serie.getName ( )) << ",\n"
+			       << "          \"cells\": " << serie.getCellCount ( ) << ",\n"
+			       << "          \"types\": [";
+			bool	first	= true;
+			for (size_t type = QualifHelper::TRIANGLE;
+			     type <= QualifHelper::TRIANGULAR_PRISM; type <<= 1)
+				if (0 != (type & serie.getDataTypes ( )))
+				{
+					stream << (true == first ? "" : ", ")
+					       << QualifHelper::jsonString (
+							QualifHelper::dataTypeToName (type).utf8 ( ));
+					first	= false;
+				}	// if (0 != (type & serie.getDataTypes ( )))
+			stream << "],\n"
+			       << "          \"criteria\": [";
+			for (vector<CriterionResult*>::const_iterator itr =
+			     results.begin ( ); results.end ( ) != itr; itr++)
+			{
+				const CriterionResult&	result	= **itr;
+				stream << (results.begin ( ) == itr ? "" : ",") << "\n"
+				       << "            {" << "\n"
+				       << "              \"criterion\": "
+				       << QualifHelper::jsonString (CRITERESTR [result.criterion]);
+				if ((false == result.applicable) ||
+				    (s >= result.statistics.size ( )))
+				{
+					stream << ",\n"
+					       << "              \"applicable\": false" << "\n"
+					       << "            }";
+					continue;
+				}	// if ((false == result.applicable) || ...
+				const SerieStatistics&	stats	= result.statistics [s];
+				stream << ",\n"
+				       << "              \"domain\": [";
+				writeNumber (stream, result.min, "null");
+				stream << ", ";
+				writeNumber (stream, result.max, "null");
+				stream << "],\n"
+				       << "              \"histogram\": [";
+				for (size_t cl = 0; cl < result.histograms.size ( ); cl++)
+					stream << (0 == cl ? "" : ", ") << result.histograms [cl][s];
+				stream << "],\n"
+				       << "              \"statistics\": {"
+				       << "\"count\": " << stats.count
+				       << ", \"undefined\": " << stats.undefined;
+				if (0 != stats.count)
+				{
+					stream << ", \"min\": ";
+					writeNumber (stream, stats.min, "null");
+					stream << ", \"max\": ";
+					writeNumber (stream, stats.max, "null");
+					stream << ", \"mean\": ";
+					writeNumber (stream, stats.mean, "null");
+					stream << ", \"stddev\": ";
+					writeNumber (stream, stats.stddev, "null");
+				}	// if (0 != stats.count)
+				stream << "}";
+				if (s < result.values.size ( ))
+				{
+					const vector<double>&	values	= result.values [s];
+					stream << ",\n"
+					       << "              \"values\": [";
+					for (size_t c = 0; c < values.size ( ); c++)
+					{
+						stream << (0 == c ? "" : ", ");
+						writeNumber (stream, values [c], "null");
+					}	// for (size_t c = 0; c < values.size ( ); c++)
+					stream << "]";
+				}	// if (s < result.values.size ( ))
+				stream << "\n"
+				       << "            }";
+			}	// for (vector<CriterionResult*>::const_iterator itr = ...
+			stream << "\n"
+			       << "          ]" << "\n"
+			       << "        }";
+		}	// for (size_t fs = 0; fs < meshFile.series.size ( ); fs++, s++)
+		stream << "\n"
+		       << "      ]" << "\n"
+		       << "    }";
+	}	// for (vector<MeshFile*>::const_iterator itf = files.begin ( ); ...
+	stream << "\n"
+	       << "  ],\n"
+	       << "  \"timings\": {"
+	       << "\"loading\": " << timings.loading
+	       << ", \"reordering\": " << timings.reordering
+	       << ", \"validation\": " << timings.validation
+	       << ", \"range\": " << timings.range
+	       << ", \"classification\": " << timings.classification
+	       << ", \"statistics\": " << timings.statistics
+	       << "}" << "\n"
+	       << "}" << endl;
+}	// writeJson
+
+
+static void writeCsv (ostream& stream, const vector<MeshFile*>& files,
+                      const vector<CriterionResult*>& results,
+                      const PhaseTimings& timings, size_t threads)
+{
+	// Une table unique, la première colonne précisant le type
+	// d'enregistrement :
+	// histogram,fichier,série,critère,classe,min,max,nombre
+	// statistics,fichier,série,critère,nombre,indéfinis,min,max,moyenne,écart-type
+	// value,fichier,série,critère,maille,valeur
+	// file,fichier,temps de chargement,erreur
+	// timing,phase,temps
+	size_t	s	= 0;
+	stream << "record,file,serie,criterion,c1,c2,c3,c4,c5,c6" << "\n";
+	for (vector<MeshFile*>::const_iterator itf = files.begin ( );
+	     files.end ( ) != itf; itf++)
+	{
+		const MeshFile&	meshFile	= **itf;
+		stream << "file," << csvString (meshFile.fileName) << ","
+		       << meshFile.loadingTime << "," << csvString (meshFile.error)
+		       << "\n";
+		for (size_t fs = 0; fs < meshFile.series.size ( ); fs++, s++)
+		{
+			const string	prefix	= csvString (meshFile.fileName) + "," +
+								csvString (meshFile.series [fs]->getName ( ));
+			for (vector<CriterionResult*>::const_iterator itr =
+			     results.begin ( ); results.end ( ) != itr; itr++)
+			{
+				const CriterionResult&	result	= **itr;
+				if ((false == result.applicable) ||
+				    (s >= result.statistics.size ( )))
+					continue;
+				const string	name	= csvString (CRITERESTR [result.criterion]);
+				const double	width	=
+						result.max / classNum - result.min / classNum;
+				for (size_t cl = 0; cl < result.histograms.size ( ); cl++)
+				{
+					stream << "histogram," << prefix << "," << name << ","
+					       << cl << ",";
+					writeNumber (stream, result.min + cl * width, "");
+					stream << ",";
+					writeNumber (stream, result.min + (cl + 1) * width, "");
+					stream << "," << result.histograms [cl][s] << "\n";
+				}	// for (size_t cl = 0; cl < result.histograms.size ( ); ...
+				const SerieStatistics&	stats	= result.statistics [s];
+				stream << "statistics," << prefix << "," << name << ","
+				       << stats.count << "," << stats.undefined << ",";
+				if (0 != stats.count)
+				{
+					writeNumber (stream, stats.min, "");
+					stream << ",";
+					writeNumber (stream, stats.max, "");
+					stream << ",";
+					writeNumber (stream, stats.mean, "");
+					stream << ",";
+					writeNumber (stream, stats.stddev, "");
+				}	// if (0 != stats.count)
+				else
+					stream << ",,,";
+				stream << "\n";
+				if (s < result.values.size ( ))
+				{
+					const vector<double>&	values	= result.values [s];
+					for (size_t c = 0; c < values.size ( ); c++)
+					{
+						if (false == NumericServices::isValid (values [c]))
+							continue;
+						stream << "value," << prefix << "," << name << ","
+						       << c << "," << values [c] << "\n";
+					}	// for (size_t c = 0; c < values.size ( ); c++)
+				}	// if (s < result.values.size ( ))
+			}	// for (vector<CriterionResult*>::const_iterator itr = ...
+		}	// for (size_t fs = 0; fs < meshFile.series.size ( ); fs++, s++)
+	}	// for (vector<MeshFile*>::const_iterator itf = files.begin ( ); ...
+	stream << "timing,threads," << threads << "\n"
+	       << "timing,loading," << timings.loading << "\n"
+	       << "timing,reordering," << timings.reordering << "\n"
+	       << "timing,validation," << timings.validation << "\n"
+	       << "timing,range," << timings.range << "\n"
+	       << "timing,classification," << timings.classification << "\n"
+	       << "timing,statistics," << timings.statistics << endl;
+}	// writeCsv
+
+
+// ============================================================================
+//                        LECTURE DE LA LIGNE DE COMMANDE
+// ============================================================================
+
+static vector<string> split (const string& str)
+{
+	vector<string>	tokens;
+	istringstream	stream (str);
+	string			token;
+	while (true == getline (stream, token, ','))
+		if (false == token.empty ( ))
+			tokens.push_back (token);
+
+	return tokens;
+}	// split
+
+
+static bool parseCriterion (const string& name, Critere& criterion)
+{
+	for (int c = 0; c < (int)FIN; c++)
+		if (0 == strcasecmp (name.c_str ( ), CRITERESTR [c].c_str ( )))
+		{
+			criterion	= (Critere)c;
+			return true;
+		}	// if (0 == strcasecmp (name.c_str ( ), CRITERESTR [c].c_str ( )))
+
+	return false;
+}	// parseCriterion
+
+
+static bool parseType (const string& name, size_t& type)
+{
+	if (0 == strcasecmp (name.c_str ( ), "triangle"))
+		type	= QualifHelper::TRIANGLE;
+	else if (0 == strcasecmp (name.c_str ( ), "quadrangle"))
+		type	= QualifHelper::QUADRANGLE;
+	else if (0 == strcasecmp (name.c_str ( ), "tetraedron"))
+		type	= QualifHelper::TETRAEDRON;
+	else if (0 == strcasecmp (name.c_str ( ), "pyramid"))
+		type	= QualifHelper::PYRAMID;
+	else if (0 == strcasecmp (name.c_str ( ), "hexaedron"))
+		type	= QualifHelper::HEXAEDRON;
+	else if (0 == strcasecmp (name.c_str ( ), "prism"))
+		type	= QualifHelper::TRIANGULAR_PRISM;
+	else
+		return false;
+
+	return true;
+}	// parseType
+
+
+static int parseArgs (int argc, char* argv [])
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (0 == strcmp (argv [i], "-strict"))
+		{
+			strictMode	= true;
+			continue;
+		}	// if (0 == strcmp (argv [i], "-strict"))
+		if (0 == strcmp (argv [i], "-values"))
+		{
+			cellValues	= true;
+			continue;
+		}	// if (0 == strcmp (argv [i], "-values"))
+		if (0 == strcmp (argv [i], "-validate"))
+		{
+			validation	= true;
+			continue;
+		}	// if (0 == strcmp (argv [i], "-validate"))
+		if (0 == strcmp (argv [i], "-snapshot"))
+		{
+			snapshots	= true;
+			continue;
+		}	// if (0 == strcmp (argv [i], "-snapshot"))
+		if (0 == strcmp (argv [i], "-reorder"))
+		{
+			reordering	= true;
+			continue;
+		}	// if (0 == strcmp (argv [i], "-reorder"))
+		if (0 == strcmp (argv [i], "-list"))
+		{
+			listing	= true;
+			continue;
+		}	// if (0 == strcmp (argv [i], "-list"))
+		if (0 == strcmp (argv [i], "-help"))
+			return -1;
+
+		if (i < argc - 1)
+		{
+			if (0 == strcmp (argv [i], "-mesh"))
+			{
+				meshPaths.push_back (argv [++i]);
+				continue;
+			}	// if (0 == strcmp (argv [i], "-mesh"))
+			if (0 == strcmp (argv [i], "-groups"))
+			{
+				const vector<string>	groups	= split (argv [++i]);
+				groupNames.insert (groupNames.end ( ), groups.begin ( ), groups.end ( ));
+				continue;
+			}	// if (0 == strcmp (argv [i], "-groups"))
+			if (0 == strcmp (argv [i], "-criteria"))
+			{
+				const vector<string>	names	= split (argv [++i]);
+				for (vector<string>::const_iterator itn = names.begin ( );
+				     names.end ( ) != itn; itn++)
+				{
+					Critere	criterion	= FIN;
+					if (false == parseCriterion (*itn, criterion))
+					{
+						cerr << "Critère " << *itn << " inconnu." << endl;
+						return -1;
+					}	// if (false == parseCriterion (*itn, criterion))
+					criteria.push_back (criterion);
+				}	// for (vector<string>::const_iterator itn = ...
+				continue;
+			}	// if (0 == strcmp (argv [i], "-criteria"))
+			if (0 == strcmp (argv [i], "-types"))
+			{
+				const vector<string>	names	= split (argv [++i]);
+				for (vector<string>::const_iterator itn = names.begin ( );
+				     names.end ( ) != itn; itn++)
+				{
+					size_t	type	= 0;
+					if (false == parseType (*itn, type))
+					{
+						cerr << "Type de maille " << *itn << " inconnu." << endl;
+						return -1;
+					}	// if (false == parseType (*itn, type))
+					userTypes	|= type;
+				}	// for (vector<string>::const_iterator itn = ...
+				continue;
+			}	// if (0 == strcmp (argv [i], "-types"))
+			if (0 == strcmp (argv [i], "-classes"))
+			{
+				const long	num	= atol (argv [++i]);
+				if (0 >= num)
+					return -1;
+				classNum	= (size_t)num;
+				continue;
+			}	// if (0 == strcmp (argv [i], "-classes"))
+			if (0 == strcmp (argv [i], "-threads"))
+			{
+				const long	num	= atol (argv [++i]);
+				if (0 > num)
+					return -1;
+				threadsNum	= (size_t)num;
+				continue;
+			}	// if (0 == strcmp (argv [i], "-threads"))
+			if (0 == strcmp (argv [i], "-domain"))
+			{
+				const char*	domain	= argv [++i];
+				if (0 == strcmp (domain, "computed"))
+					domainMode	= COMPUTED_DOMAIN;
+				else if (0 == strcmp (domain, "theoretical"))
+					domainMode	= THEORETICAL_DOMAIN;
+				else if (2 == sscanf (domain, "%lf:%lf", &domainMin, &domainMax))
+				{
+					domainMode	= USER_DOMAIN;
+					if (domainMin >= domainMax)
+						return -1;
+				}
+				else
+					return -1;
+				continue;
+			}	// if (0 == strcmp (argv [i], "-domain"))
+			if (0 == strcmp (argv [i], "-format"))
+			{
+				const char*	format	= argv [++i];
+				if (0 == strcasecmp (format, "json"))
+					outputFormat	= JSON_FORMAT;
+				else if (0 == strcasecmp (format, "csv"))
+					outputFormat	= CSV_FORMAT;
+				else
+					return -1;
+				continue;
+			}	// if (0 == strcmp (argv [i], "-format"))
+			if (0 == strcmp (argv [i], "-output"))
+			{
+				outputPath	= argv [++i];
+				continue;
+			}	// if (0 == strcmp (argv [i], "-output"))
+			if (0 == strcmp (argv [i], "-trace"))
+			{
+				tracePath	= argv [++i];
+				continue;
+			}	// if (0 == strcmp (argv [i], "-trace"))
+			if (0 == strcmp (argv [i], "-reader"))
+			{
+				reader	= argv [++i];
+				if (("lima" != reader) && ("vtk" != reader) && ("gmds" != reader))
+					return -1;
+				continue;
+			}	// if (0 == strcmp (argv [i], "-reader"))
+		}	// if (i < argc - 1)
+
+		cerr << "Argument " << argv [i] << " invalide." << endl;
+		return -1;
+	}	// for (int i = 1; i < argc; i++)
+
+	if (0 == meshPaths.size ( ))
+		return -1;
+	if (0 == criteria.size ( ))
+		for (int c = 0; c < (int)FIN; c++)
+			criteria.push_back ((Critere)c);
+
+	return 0;
+}	// parseArgs
+
+
+static int syntax (const string& pgm)
+{
+	cout << "Syntaxe : " << pgm << " -mesh filename [-mesh filename ...]" << "\n"
+	     << "\t[-groups g1,g2,...] [-criteria c1,c2,...] [-types t1,t2,...]" << "\n"
+	     << "\t[-classes num] [-domain computed|theoretical|min:max] [-strict]" << "\n"
+	     << "\t[-values] [-validate] [-snapshot] [-reorder] [-threads num]" << "\n"
+	     << "\t[-reader lima|vtk|gmds] [-format json|csv] [-output filename]" << "\n"
+	     << "\t[-trace filename] [-list]" << "\n"
+	     << "-groups : groupes de mailles analysés (défaut : tous)." << "\n"
+	     << "-criteria : critères appliqués (défaut : tous). Critères disponibles :";
+	for (int c = 0; c < (int)FIN; c++)
+		cout << (0 == c ? " " : ", ") << CRITERESTR [c];
+	cout << "." << "\n"
+	     << "-types : types de mailles analysés parmi triangle, quadrangle, "
+	     << "tetraedron, pyramid, hexaedron, prism (défaut : tous)." << "\n"
+	     << "-classes : nombre de classes des histogrammes (défaut : 10)." << "\n"
+	     << "-domain : domaine d'échantillonnage (défaut : computed)." << "\n"
+	     << "-strict : ne pas prendre en compte les mailles hors domaine." << "\n"
+	     << "-values : écrire les valeurs des critères maille par maille." << "\n"
+	     << "-validate : valider préalablement les coordonnées des noeuds." << "\n"
+	     << "-snapshot : recopier les groupes Lima dans des tableaux contigus "
+	     << "et libérer le maillage Lima avant analyse." << "\n"
+	     << "-reorder : évaluer les mailles dans l'ordre d'une courbe de "
+	     << "Morton de leurs centres (et renuméroter les noeuds des "
+	     << "instantanés)." << "\n"
+	     << "-threads : nombre de threads utilisés (défaut : nombre de "
+	     << "processeurs)." << "\n"
+	     << "-reader : lecteur de maillage (défaut : selon l'extension)." << "\n"
+	     << "-format : format des résultats (défaut : json)." << "\n"
+	     << "-output : fichier des résultats (défaut : sortie standard)." << "\n"
+	     << "-trace : fichier de la chronologie des calculs (format Chrome "
+	     << "trace-event, visualisable avec Perfetto)." << "\n"
+	     << "-list : afficher les groupes de mailles des fichiers (nombre de "
+	     << "mailles par type) sans charger les maillages."
+	     << endl;
+
+	return -1;
+}	// syntax
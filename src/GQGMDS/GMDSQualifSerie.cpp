@@ -20,28 +20,49 @@ using namespace GQualif;
 static const Charset	charset ("àéèùô");
 
 
+/**
+ * Recense les identifiants des faces/régions du maillage.
+ */
+static void getCellIds (
+		gmds::Mesh& mesh, const gmds::Face*, vector<gmds::TCellID>& ids)
+{
+	ids.reserve (mesh.getNbFaces ( ));
+	for (auto id : mesh.faces ( ))
+		ids.push_back (id);
+}	// getCellIds
+
+static void getCellIds (
+		gmds::Mesh& mesh, const gmds::Region*, vector<gmds::TCellID>& ids)
+{
+	ids.reserve (mesh.getNbRegions ( ));
+	for (auto id : mesh.regions ( ))
+		ids.push_back (id);
+}	// getCellIds
+
+
 template<typename TCellType, unsigned char Dim>
 GMDSQualifSerie<TCellType, Dim>::GMDSQualifSerie (
 		gmds::Mesh& mesh,
 		const std::string& name, const std::string& fileName)
 : AbstractQualifSerieAdapter (fileName, name, Dim),
-  _gmdsCells()
+  _mesh (&mesh), _group (0), _cellIds ( ), _gmdsCells ( ), _nodes ( )
 {
 	// Méthodes getL* de Mesh : retournent la maille d'ID local i.
 	// La numérotation commence souvent à 0, mais peut commencer à 1 (voire
 	// autre chose), et ne pas être contigue.
-	// => on utilise  mesh.getAllFaces et  mesh.getAllRegions (GMDS v 0.2.33)
-	// qui stockent dans un vecteur les mailles (inconvénient) mais permettent
-	// d'avoir toutes les mailles du maillage indépendamment de leur id, et
-	// sans itérateur (avantage).
+	// => les mailles d'un groupe sont accédées via les identifiants du
+	// groupe, celles du maillage via un tableau de leurs identifiants (8
+	// octets par maille), plutôt que via une copie des mailles
+	// (mesh.getAll).
 	try
 	{
 		if (Dim == 2 || Dim == 3)
 		{
 			if (0 != name.size ( ))
-				fill(mesh, name);
+				_group	= mesh.getGroup<TCellType>(name);
 			else
-				mesh.getAll<TCellType>(_gmdsCells);
+				getCellIds (mesh, (const TCellType*)0, _cellIds);
+			_nodes.reserve (8);
 		}
 		else
 		{
@@ -90,14 +111,15 @@ GMDSQualifSerie<TCellType, Dim>::GMDSQualifSerie (
 	const std::vector<TCellType>& v, const std::string& name,
 	const std::string& fileName)
 	: AbstractQualifSerieAdapter (fileName, name, Dim),
-	  _gmdsCells(v)
+	  _mesh (0), _group (0), _cellIds ( ), _gmdsCells (v), _nodes ( )
 {
+	_nodes.reserve (8);
 }	// template<typename TCellType, int Dim> GMDSQualifSerie<TCellType>::GMDSQualifSerie
 
 template<typename TCellType, unsigned char Dim>
 GMDSQualifSerie<TCellType, Dim>::GMDSQualifSerie (const GMDSQualifSerie&)
 	: AbstractQualifSerieAdapter ("Invalid file name", "Invalid serie name", 3),
-	  _gmdsCells()
+	  _mesh (0), _group (0), _cellIds ( ), _gmdsCells ( ), _nodes ( )
 {
 	assert (0 && "GMDSQualifSerie copy constructor is not allowed.");
 }	// template<typename TCellType, int Dim> GMDSQualifSerie<TCellType>::GMDSQualifSerie
@@ -119,7 +141,10 @@ GMDSQualifSerie<TCellType, Dim>::~GMDSQualifSerie ( )
 template<typename TCellType, unsigned char Dim>
 size_t GMDSQualifSerie<TCellType, Dim>::getCellCount ( ) const
 {
-	return _gmdsCells.size();
+	if (0 == _mesh)
+		return _gmdsCells.size ( );
+
+	return 0 == _group ? _cellIds.size ( ) : _group->size ( );
 }	// template<typename TCellType, int Dim> GMDSQualifSerie<TCellType>::getCellCount
 
 
@@ -137,53 +162,53 @@ Qualif::Maille& GMDSQualifSerie<TCellType, Dim>::getCell (size_t i) const
 	try
 	{
 		size_t s = 0;
-		std::vector<gmds::Node>	nodes;
 
+		// Le tampon _nodes conservant sa capacité, pas d'allocation :
 		TCellType cell = getGMDSCell(i);
 		gmds::ECellType t = cell.type();
-		cell.getAll(nodes);
+		cell.getAll(_nodes);
 
 		switch (t)
 		{
 			case gmds::GMDS_TRIANGLE	:
 				for (s = 0; s < 3; s++)
 				{
-					gmds::Node node = nodes [s];
+					const gmds::Node&	node	= _nodes [s];
 					_triangle.Modifier_Sommet (s, node.X(),node.Y(), node.Z());
 				}
 				return _triangle;
 			case gmds::GMDS_QUAD	:
 				for (s = 0; s < 4; s++)
 				{
-					gmds::Node node = nodes [s];
+					const gmds::Node&	node	= _nodes [s];
 					_quadrangle.Modifier_Sommet (s, node.X(),node.Y(), node.Z());
 				}
 				return _quadrangle;
 			case gmds::GMDS_TETRA	:
 				for (s = 0; s < 4; s++)
 				{
-					gmds::Node node = nodes [s];
+					const gmds::Node&	node	= _nodes [s];
 					_tetraedron.Modifier_Sommet (s, node.X(),node.Y(), node.Z());
 				}
 				return _tetraedron;
 			case gmds::GMDS_PYRAMID	:
 				for (s = 0; s < 5; s++)
 				{
-					gmds::Node node = nodes [s];
+					const gmds::Node&	node	= _nodes [s];
 					_pyramid.Modifier_Sommet (s, node.X(),node.Y(), node.Z());
 				}
 				return _pyramid;
 			case gmds::GMDS_PRISM3	:
 				for (s = 0; s < 6; s++)
 				{
-					gmds::Node node = nodes [s];
+					const gmds::Node&	node	= _nodes [s];
 					_prism.Modifier_Sommet (s, node.X(),node.Y(), node.Z());
 				}
 				return _prism;
 			case gmds::GMDS_HEX	:
 				for (s = 0; s < 8; s++)
 				{
-					gmds::Node node = nodes [s];
+					const gmds::Node&	node	= _nodes [s];
 					_hexaedron.Modifier_Sommet (s, node.X(),node.Y(), node.Z());
 				}
 				return _hexaedron;
@@ -242,7 +267,10 @@ Qualif::Maille& GMDSQualifSerie<TCellType, Dim>::getCell (size_t i) const
 template<typename TCellType, unsigned char Dim>
 TCellType GMDSQualifSerie<TCellType, Dim>::getGMDSCell (size_t i) const
 {
-	return _gmdsCells[i];
+	if (0 == _mesh)
+		return _gmdsCells[i];
+
+	return _mesh->get<TCellType> (getCellId (i));
 }	//  template<typename TCellType, int Dim> GMDSQualifSerie<TCellType>::getGMDSFace
 
 template<typename TCellType, unsigned char Dim>
@@ -259,7 +287,7 @@ size_t GMDSQualifSerie<TCellType, Dim>::getCellType (size_t i) const
 	try
 	{
 
-		TCellType cell = _gmdsCells[i];
+		TCellType cell = getGMDSCell(i);
 		gmds::ECellType t = cell.type();
 		switch (t)
 		{
@@ -335,15 +363,78 @@ bool GMDSQualifSerie<TCellType, Dim>::isThreadable ( ) const
 
 
 template<typename TCellType, unsigned char Dim>
-void GMDSQualifSerie<TCellType, Dim>::fill(gmds::Mesh& mesh, const std::string& name)
+bool GMDSQualifSerie<TCellType, Dim>::hasMeshCellIds ( ) const
 {
-	auto group = mesh.getGroup<TCellType>(name);
-	_gmdsCells.clear();
-	_gmdsCells.resize(group->size());
-	for (auto i = 0 ; i < group->size(); i++) {
-		_gmdsCells[i] = mesh.get<TCellType>((*group)[i]);
-	}
-}
+	return true;
+}	// template<typename TCellType, int Dim> GMDSQualifSerie<TCellType>::hasMeshCellIds
+
+
+template<typename TCellType, unsigned char Dim>
+size_t GMDSQualifSerie<TCellType, Dim>::getMeshCellId (size_t i) const
+{
+	if (i >= getCellCount ( ))
+	{
+		TkUtil::UTF8String	error (charset);
+		error << "Le groupe de données ne contient que " << getCellCount ( )
+		      << " mailles. Accès à la " << i << "-ème maille impossible.";
+		throw TkUtil::Exception (error);
+	}	// if (i >= getCellCount ( ))
+
+	return 0 == _mesh ? _gmdsCells [i].id ( ) : getCellId (i);
+}	// template<typename TCellType, int Dim> GMDSQualifSerie<TCellType>::getMeshCellId
+
+
+template<typename TCellType, unsigned char Dim>
+const void* GMDSQualifSerie<TCellType, Dim>::getMeshInstance ( ) const
+{
+	return _mesh;
+}	// template<typename TCellType, int Dim> GMDSQualifSerie<TCellType>::getMeshInstance
+
+
+template<typename TCellType, unsigned char Dim>
+void GMDSQualifSerie<TCellType, Dim>::getCellCentroid (
+						size_t i, double& x, double& y, double& z) const
+{
+	if (i >= getCellCount ( ))
+	{
+		TkUtil::UTF8String	error (charset);
+		error << "Le groupe de données ne contient que " << getCellCount ( )
+		      << " mailles. Accès à la " << i << "-ème maille impossible.";
+		throw TkUtil::Exception (error);
+	}	// if (i >= getCellCount ( ))
+
+	std::vector<gmds::Node>	nodes;
+	TCellType				cell	= getGMDSCell (i);
+	cell.getAll (nodes);
+	x	= y	= z	= 0.;
+	for (std::vector<gmds::Node>::const_iterator itn = nodes.begin ( );
+	     nodes.end ( ) != itn; itn++)
+	{
+		x	+= (*itn).X ( );
+		y	+= (*itn).Y ( );
+		z	+= (*itn).Z ( );
+	}	// for (std::vector<gmds::Node>::const_iterator itn = ...
+	if (0 != nodes.size ( ))
+	{
+		x	/= nodes.size ( );
+		y	/= nodes.size ( );
+		z	/= nodes.size ( );
+	}	// if (0 != nodes.size ( ))
+}	// template<typename TCellType, int Dim> GMDSQualifSerie<TCellType>::getCellCentroid
+
+
+template<typename TCellType, unsigned char Dim>
+bool GMDSQualifSerie<TCellType, Dim>::isCentroidReentrant ( ) const
+{
+	return true;
+}	// template<typename TCellType, int Dim> GMDSQualifSerie<TCellType>::isCentroidReentrant
+
+
+template<typename TCellType, unsigned char Dim>
+gmds::TCellID GMDSQualifSerie<TCellType, Dim>::getCellId (size_t i) const
+{
+	return 0 == _group ? _cellIds [i] : (*_group)[i];
+}	// template<typename TCellType, int Dim> GMDSQualifSerie<TCellType>::getCellId
 
 template class GMDSQualifSerie<gmds::Face, 2>;  // Explicit instantiation
 template class GMDSQualifSerie<gmds::Region, 3>;  // Explicit instantiation
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "GQGMDS/MeditFileScanner.h"
+
+#include "GQualif/QualifHelper.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/UTF8String.h>
+
+#include <assert.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+USING_UTIL
+USING_STD
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                           FONCTIONS UTILITAIRES
+// ============================================================================
+
+/**
+ * Les types de mailles <I>Medit</I> supportés par <I>Qualif</I>.
+ */
+struct MeditCellType
+{
+	const char*		keyword;
+	size_t			type;
+	unsigned char	dimension;
+};	// struct MeditCellType
+
+static const MeditCellType	meditCellTypes [ ]	=
+{
+	{ "Triangles",		QualifHelper::TRIANGLE,			2 },
+	{ "Quadrilaterals",	QualifHelper::QUADRANGLE,		2 },
+	{ "Tetrahedra",		QualifHelper::TETRAEDRON,		3 },
+	{ "Pyramids",		QualifHelper::PYRAMID,			3 },
+	{ "Prisms",			QualifHelper::TRIANGULAR_PRISM,	3 },
+	{ "Hexahedra",		QualifHelper::HEXAEDRON,		3 },
+	{ 0,				0,								0 }
+};	// meditCellTypes
+
+
+/**
+ * @return		Le mot suivant <I>p</I> (commentaires exclus), <I>p</I> étant
+ * 				positionné en retour juste après ce mot.
+ */
+static string nextToken (const char*& p, const char* end)
+{
+	while (p < end)
+	{
+		if ('#' == *p)
+		{
+			const char*	eol	= (const char*)memchr (p, '\n', end - p);
+			p	= 0 == eol ? end : eol + 1;
+		}	// if ('#' == *p)
+		else if (0 != isspace ((unsigned char)*p))
+			p++;
+		else
+			break;
+	}	// while (p < end)
+
+	const char*	begin	= p;
+	while ((p < end) && (0 == isspace ((unsigned char)*p)))
+		p++;
+
+	return string (begin, p);
+}	// nextToken
+
+
+// ============================================================================
+//                           LA CLASSE MeditFileScanner
+// ============================================================================
+
+MeditFileScanner::MeditFileScanner ( )
+{
+	assert (0 && "MeditFileScanner constructor is not allowed.");
+}	// MeditFileScanner::MeditFileScanner
+
+
+MeditFileScanner::MeditFileScanner (const MeditFileScanner&)
+{
+	assert (0 && "MeditFileScanner copy constructor is not allowed.");
+}	// MeditFileScanner::MeditFileScanner
+
+
+MeditFileScanner& MeditFileScanner::operator = (const MeditFileScanner&)
+{
+	assert (0 && "MeditFileScanner assignment operator is not allowed.");
+	return *this;
+}	// MeditFileScanner::operator =
+
+
+MeditFileScanner::~MeditFileScanner ( )
+{
+}	// MeditFileScanner::~MeditFileScanner
+
+
+bool MeditFileScanner::scan (
+					const string& fileName, vector<QualifGroupMetadata>& metadata)
+{
+	metadata.clear ( );
+	const int	fd	= open (fileName.c_str ( ), O_RDONLY);
+	struct stat	status;
+	if ((-1 == fd) || (0 != fstat (fd, &status)) || (0 == status.st_size))
+	{
+		if (-1 != fd)
+			close (fd);
+		UTF8String	message (charset);
+		message << "Impossibilité d'ouvrir le fichier " << fileName
+		        << " en lecture, ou fichier vide.";
+		throw Exception (message);
+	}	// if ((-1 == fd) || ...
+	void*	data	= mmap (0, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close (fd);
+	if (MAP_FAILED == data)
+	{
+		UTF8String	message (charset);
+		message << "Impossibilité de projeter en mémoire le fichier "
+		        << fileName << ".";
+		throw Exception (message);
+	}	// if (MAP_FAILED == data)
+	// Le fichier est essentiellement sauté :
+	madvise (data, status.st_size, MADV_SEQUENTIAL);
+
+	const char*			p		= (const char*)data;
+	const char*			end		= p + status.st_size;
+	QualifGroupMetadata	surfaces ("", 2),	volumes ("", 3);
+	bool				medit	= "MeshVersionFormatted" == nextToken (p, end);
+	bool				truncated	= false;
+	string				keyword;
+	while ((true == medit) && (false == truncated))
+	{
+		keyword	= true == keyword.empty ( ) ? nextToken (p, end) : keyword;
+		if ((true == keyword.empty ( )) || ("End" == keyword))
+			break;
+		if ((0 == isalpha ((unsigned char)keyword [0])) ||
+		    ("Dimension" == keyword))
+		{	// Version, dimension, ... :
+			keyword.clear ( );
+			continue;
+		}	// if ((0 == isalpha ((unsigned char)keyword [0])) || ...
+
+		// Section : nombre d'entités puis une entité par ligne.
+		const string	count	= nextToken (p, end);
+		char*			last	= 0;
+		const size_t	num		= strtoull (count.c_str ( ), &last, 10);
+		if ((true == count.empty ( )) || ('\0' != *last))
+		{	// Pas de nombre d'entités : count est un mot clé.
+			keyword	= count;
+			continue;
+		}	// if ((true == count.empty ( )) || ('\0' != *last))
+		for (const MeditCellType* type = meditCellTypes; 0 != type->keyword;
+		     type++)
+			if ((keyword == type->keyword) && (0 != num))
+				(2 == type->dimension ? surfaces : volumes).addCells (
+															type->type, num);
+		for (size_t l = 0; (l <= num) && (false == truncated); l++)
+		{
+			const char*	eol	= (const char*)memchr (p, '\n', end - p);
+			truncated	= (0 == eol) && (l < num);
+			p	= 0 == eol ? end : eol + 1;
+		}	// for (size_t l = 0; (l <= num) && (false == truncated); l++)
+		if (false == truncated)
+			keyword.clear ( );
+	}	// while ((true == medit) && (false == truncated))
+	munmap (data, status.st_size);
+
+	if (true == truncated)
+	{
+		UTF8String	message (charset);
+		message << "Le fichier " << fileName << " est tronqué (section "
+		        << keyword << ").";
+		throw Exception (message);
+	}	// if (true == truncated)
+	if (false == medit)
+		return false;
+
+	if (QualifGroupMetadata::UNKNOWN != surfaces.cellsNum)
+		metadata.push_back (surfaces);
+	if (QualifGroupMetadata::UNKNOWN != volumes.cellsNum)
+		metadata.push_back (volumes);
+
+	return true;
+}	// MeditFileScanner::scan
+
+
+}	// namespace GQualif
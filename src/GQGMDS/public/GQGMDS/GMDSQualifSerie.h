@@ -23,6 +23,16 @@ namespace GQualif
  * <P>Classe représentant une série de mailles issues d'un maillage <I>GMDS</I>
  * à soumettre à <I>Qualif</I> en vue d'être analysée (ex : surface composée de
  * polygones, ...).</P>
+ *
+ * <P>Les mailles d'un groupe sont parcourues via les identifiants du groupe,
+ * celles du maillage via un tableau de leurs identifiants : aucun objet
+ * <I>GMDS</I> n'est recopié à la construction. Les noeuds d'une maille sont
+ * lus dans un tampon de la série, réutilisé d'une maille à l'autre, et
+ * <I>getCell</I> n'effectue donc pas d'allocation mémoire par maille.
+ * </P>
+ *
+ * @warning		Le maillage ne doit pas être modifié durant la durée de vie
+ * 				de la série.
  */
 template<typename TCellType, unsigned char Dim>
 class GMDSQualifSerie : public AbstractQualifSerieAdapter
@@ -99,6 +109,35 @@ public :
 	 */
 	virtual bool isThreadable ( ) const;
 
+	/**
+	 * @return		<I>true</I>
+	 */
+	virtual bool hasMeshCellIds ( ) const;
+
+	/**
+	 * @return		L'identifiant <I>GMDS</I> de la i-ème maille.
+	 */
+	virtual size_t getMeshCellId (size_t i) const;
+
+	/**
+	 * @return		Le maillage <I>GMDS</I> dont est issue la série (0 pour le
+	 * 				constructeur 2).
+	 */
+	virtual const void* getMeshInstance ( ) const;
+
+	/**
+	 * @return		En retour, le centre de la i-ème maille, dont les noeuds
+	 * 				sont lus dans un tampon local (et non dans
+	 * 				<I>_nodes</I>).
+	 */
+	virtual void getCellCentroid (
+						size_t i, double& x, double& y, double& z) const;
+
+	/**
+	 * @return		<I>true</I>
+	 */
+	virtual bool isCentroidReentrant ( ) const;
+
 
 protected :
 
@@ -111,10 +150,28 @@ private :
 	GMDSQualifSerie (const GMDSQualifSerie&);
 	GMDSQualifSerie& operator = (const GMDSQualifSerie&);
 
-	// gmdsCells est un vector de Face ou Region
-	std::vector<TCellType> _gmdsCells;
+	/**
+	 * @return		L'identifiant <I>GMDS</I> de la i-ème maille (constructeur
+	 *				1).
+	 */
+	gmds::TCellID getCellId (size_t i) const;
+
+	/** Le maillage (constructeur 1, nul pour le constructeur 2). */
+	gmds::Mesh*							_mesh;
+
+	/** L'éventuel groupe de mailles représenté (constructeur 1). */
+	gmds::CellGroup<TCellType>*			_group;
+
+	/** Les identifiants des mailles du maillage, en l'absence de groupe
+	 * (constructeur 1). */
+	std::vector<gmds::TCellID>			_cellIds;
+
+	/** Les mailles (Face ou Region) transmises au constructeur 2. */
+	std::vector<TCellType>				_gmdsCells;
 
-	void fill(gmds::Mesh& mesh, const std::string& name);
+	/** Tampon des noeuds de la maille courante, dont la capacité est
+	 * conservée d'un appel à getCell à l'autre. */
+	mutable std::vector<gmds::Node>		_nodes;
 
 };	// class GMDSQualifSerie
 
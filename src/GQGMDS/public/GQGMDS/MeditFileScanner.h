@@ -0,0 +1,56 @@
+#ifndef MEDIT_FILE_SCANNER_H
+#define MEDIT_FILE_SCANNER_H
+
+#include "GQualif/QualifGroupMetadata.h"
+
+#include <string>
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Lecture rapide des nombres de mailles par type d'un fichier
+ * <I>Medit</I> ASCII (<I>.mesh</I>), sans lecture des coordonnées ni de la
+ * connectivité : seuls les mots clés et les nombres d'entités qui les suivent
+ * sont lus, les sections étant sautées ligne à ligne (une entité par ligne,
+ * convention des écrivains <I>Medit</I>).
+ * </P>
+ *
+ * <P>Les groupes de mailles construits par le lecteur <I>GMDS</I> ne sont
+ * pas décrits : le maillage est décrit par dimension (mailles surfaciques
+ * puis volumiques).
+ * </P>
+ */
+class MeditFileScanner
+{
+	public :
+
+	/**
+	 * @param		Nom du fichier à lire.
+	 * @param		En retour, la description des mailles du fichier, par
+	 *				dimension (nom vide).
+	 * @return		<I>true</I> en cas de succès, <I>false</I> si le fichier
+	 * 				n'est pas un fichier <I>Medit</I> ASCII.
+	 * @exception	Une exception est levée si le fichier ne peut être lu ou
+	 * 				est tronqué.
+	 */
+	static bool scan (const IN_STD string& fileName,
+	                  IN_STD vector<QualifGroupMetadata>& metadata);
+
+
+	private :
+
+	/**
+	 * Constructeurs, opérateur = et destructeur : interdits.
+	 */
+	MeditFileScanner ( );
+	MeditFileScanner (const MeditFileScanner&);
+	MeditFileScanner& operator = (const MeditFileScanner&);
+	~MeditFileScanner ( );
+};	// class MeditFileScanner
+
+}	// namespace GQualif
+
+#endif	// MEDIT_FILE_SCANNER_H
@@ -0,0 +1,157 @@
+#include "GQLima/LimaMeshCache.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/UTF8String.h>
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+
+USING_UTIL
+USING_STD
+using namespace Lima;
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+mutex									LimaMeshCache::_mutex;
+mutex									LimaMeshCache::_readingMutex;
+map<string, shared_ptr<LimaMeshCache::Entry> >	LimaMeshCache::_entries;
+
+
+LimaMeshCache::LimaMeshCache ( )
+{
+	assert (0 && "LimaMeshCache constructor is not allowed.");
+}	// LimaMeshCache::LimaMeshCache
+
+
+LimaMeshCache::LimaMeshCache (const LimaMeshCache&)
+{
+	assert (0 && "LimaMeshCache copy constructor is not allowed.");
+}	// LimaMeshCache::LimaMeshCache
+
+
+LimaMeshCache& LimaMeshCache::operator = (const LimaMeshCache&)
+{
+	assert (0 && "LimaMeshCache assignment operator is not allowed.");
+	return *this;
+}	// LimaMeshCache::operator =
+
+
+LimaMeshCache::~LimaMeshCache ( )
+{
+}	// LimaMeshCache::~LimaMeshCache
+
+
+shared_ptr<_MaillageInterne> LimaMeshCache::getMesh (const string& fileName)
+{
+	char		path [PATH_MAX];
+	struct stat	status;
+	if ((0 == realpath (fileName.c_str ( ), path)) ||
+	    (0 != stat (path, &status)))
+	{
+		UTF8String	message (charset);
+		message << "Le fichier " << fileName
+		        << " n'existe pas ou n'est pas accessible.";
+		throw Exception (message);
+	}	// if ((0 == realpath (fileName.c_str ( ), path)) || ...
+	const long long	modificationTime	=
+		1000000000LL * status.st_mtim.tv_sec + status.st_mtim.tv_nsec;
+
+	shared_ptr<Entry>	entry;
+	{
+		lock_guard<mutex>	lock (_mutex);
+		// Les maillages détruits sont retirés du cache :
+		for (map<string, shared_ptr<Entry> >::iterator ite = _entries.begin ( );
+		     _entries.end ( ) != ite; )
+		{
+			if ((true == ite->second->mesh.expired ( )) &&
+			    (1 == ite->second.use_count ( )))
+				ite	= _entries.erase (ite);
+			else
+				ite++;
+		}	// for (map<string, shared_ptr<Entry> >::iterator ite = ...
+
+		shared_ptr<Entry>&	cached	= _entries [path];
+		if ((0 == cached.get ( )) ||
+		    (modificationTime != cached->modificationTime))
+		{
+			cached.reset (new Entry ( ));
+			cached->modificationTime	= modificationTime;
+		}	// if ((0 == cached.get ( )) || ...
+		entry	= cached;
+	}
+
+	// Chargement éventuel, sans bloquer l'accès aux autres maillages :
+	lock_guard<mutex>				lock (entry->loadingMutex);
+	shared_ptr<_MaillageInterne>	mesh	= entry->mesh.lock ( );
+	if (0 == mesh.get ( ))
+	{
+		mesh.reset (new _MaillageInterne ( ));
+		{	// La réentrance des lecteurs Lima (MLI, HDF5, ...) n'est pas
+			// documentée : une seule lecture à la fois dans le processus.
+			lock_guard<mutex>	readingLock (_readingMutex);
+			mesh->lire (path);
+		}
+		entry->mesh	= mesh;
+	}	// if (0 == mesh.get ( ))
+
+	return mesh;
+}	// LimaMeshCache::getMesh
+
+
+shared_ptr<_MaillageInterne> LimaMeshCache::findMesh (const string& fileName)
+{
+	char		path [PATH_MAX];
+	struct stat	status;
+	if ((0 == realpath (fileName.c_str ( ), path)) ||
+	    (0 != stat (path, &status)))
+		return shared_ptr<_MaillageInterne> ( );
+	const long long	modificationTime	=
+		1000000000LL * status.st_mtim.tv_sec + status.st_mtim.tv_nsec;
+
+	shared_ptr<Entry>	entry;
+	{
+		lock_guard<mutex>	lock (_mutex);
+		map<string, shared_ptr<Entry> >::const_iterator	it	=
+														_entries.find (path);
+		if ((_entries.end ( ) == it) ||
+		    (modificationTime != it->second->modificationTime))
+			return shared_ptr<_MaillageInterne> ( );
+		entry	= it->second;
+	}
+
+	// Un chargement en cours n'est pas attendu :
+	unique_lock<mutex>	lock (entry->loadingMutex, try_to_lock);
+	if (false == lock.owns_lock ( ))
+		return shared_ptr<_MaillageInterne> ( );
+
+	return entry->mesh.lock ( );
+}	// LimaMeshCache::findMesh
+
+
+size_t LimaMeshCache::getMeshesNum ( )
+{
+	lock_guard<mutex>	lock (_mutex);
+	size_t				count	= 0;
+	for (map<string, shared_ptr<Entry> >::const_iterator ite =
+	     _entries.begin ( ); _entries.end ( ) != ite; ite++)
+		if (false == ite->second->mesh.expired ( ))
+			count++;
+
+	return count;
+}	// LimaMeshCache::getMeshesNum
+
+
+mutex& LimaMeshCache::getReadingMutex ( )
+{
+	return _readingMutex;
+}	// LimaMeshCache::getReadingMutex
+
+
+}	// namespace GQualif
@@ -1,4 +1,5 @@
 #include "GQLima/LimaQualifSerie.h"
+#include "GQLima/LimaMeshCache.h"
 #include "GQualif/QualifHelper.h"
 
 #include <TkUtil/Exception.h>
@@ -7,6 +8,7 @@
 #include <TkUtil/MemoryError.h>
 #include <TkUtil/UTF8String.h>
 
+#include <algorithm>
 #include <iostream>
 #include <assert.h>
 
@@ -24,7 +26,10 @@ namespace GQualif
 LimaQualifSerie::LimaQualifSerie (
 			const string& fileName, const string& name, unsigned char dimension)
 	: AbstractQualifSerieAdapter (fileName, name, dimension),
-	  _mesh ( ), _destroy (true), _surface (0), _volume (0), _cellsDimension (0)
+	  _mesh (0), _sharedMesh ( ), _surface (0), _volume (0),
+	  _meshInstance (0), _cellsDimension (0),
+	  _snapshot (false), _xs ( ), _ys ( ), _zs ( ), _connectivity ( ), _offsets ( ),
+	  _cellIds ( )
 {
 	try
 	{
@@ -43,9 +48,10 @@ LimaQualifSerie::LimaQualifSerie (
 			throw Exception (message);
 		}	// if (false == file.isReadable ( ))
 
-		// Chargement du maillage :
-		_mesh.reset (new _MaillageInterne ( ));
-		_mesh->lire (fileName);
+		// Chargement du maillage, éventuellement déjà effectué :
+		_sharedMesh		= LimaMeshCache::getMesh (fileName);
+		_mesh			= _sharedMesh.get ( );
+		_meshInstance	= _mesh;
 
 		// On récupère le groupe demandé :
 		switch (dimension)
@@ -98,7 +104,13 @@ LimaQualifSerie::LimaQualifSerie (
 			_MaillageInterne& mesh, bool destroy, unsigned char dimension,
 			const string& name, const string& fileName)
 	: AbstractQualifSerieAdapter (fileName, name, dimension),
-	  _mesh (&mesh), _destroy (destroy), _surface (0), _volume (0)
+	  _mesh (&mesh),
+	  _sharedMesh (true == destroy ?
+	               shared_ptr<_MaillageInterne> (&mesh) :
+	               shared_ptr<_MaillageInterne> ( )),
+	  _surface (0), _volume (0), _meshInstance (&mesh), _cellsDimension (0),
+	  _snapshot (false), _xs ( ), _ys ( ), _zs ( ), _connectivity ( ), _offsets ( ),
+	  _cellIds ( )
 {
 	try
 	{
@@ -162,19 +174,26 @@ LimaQualifSerie::LimaQualifSerie (
 
 LimaQualifSerie::LimaQualifSerie (
 					const _SurfaceInterne& surface, Lima::dim_t dimension,
-					const string& fileName)
+					const string& fileName, const _MaillageInterne* mesh)
 	: AbstractQualifSerieAdapter (
 						fileName, surface.nom ( ), (unsigned char)dimension),
-	  _mesh ( ), _destroy (false), _surface (&surface), _volume (0)
+	  _mesh (0), _sharedMesh ( ), _surface (&surface),
+	  _volume (0), _meshInstance (mesh), _cellsDimension (0),
+	  _snapshot (false), _xs ( ), _ys ( ), _zs ( ), _connectivity ( ), _offsets ( ),
+	  _cellIds ( )
 {
 		initialize ( );
 }	// LimaQualifSerie::LimaQualifSerie
 
 
 LimaQualifSerie::LimaQualifSerie (
-					const _VolumeInterne& volume, const string& fileName)
+					const _VolumeInterne& volume, const string& fileName,
+					const _MaillageInterne* mesh)
 	: AbstractQualifSerieAdapter (fileName, volume.nom ( ), 3),
-	  _mesh ( ), _destroy (false), _surface (0), _volume (&volume)
+	  _mesh (0), _sharedMesh ( ), _surface (0),
+	  _volume (&volume), _meshInstance (mesh), _cellsDimension (0),
+	  _snapshot (false), _xs ( ), _ys ( ), _zs ( ), _connectivity ( ), _offsets ( ),
+	  _cellIds ( )
 {
 		initialize ( );
 }	// LimaQualifSerie::LimaQualifSerie
@@ -183,7 +202,10 @@ LimaQualifSerie::LimaQualifSerie (
 LimaQualifSerie::LimaQualifSerie (const LimaQualifSerie&)
 	: AbstractQualifSerieAdapter (
 						"Invalid file name", "Invalid name", (unsigned char)-1),
-	  _mesh ( ), _surface (0), _volume (0)
+	  _mesh (0), _sharedMesh ( ), _surface (0), _volume (0),
+	  _meshInstance (0), _cellsDimension (0),
+	  _snapshot (false), _xs ( ), _ys ( ), _zs ( ), _connectivity ( ), _offsets ( ),
+	  _cellIds ( )
 {
 	assert (0 && "LimaQualifSerie copy constructor is not allowed.");
 }	// LimaQualifSerie::LimaQualifSerie
@@ -198,19 +220,20 @@ LimaQualifSerie& LimaQualifSerie::operator = (const LimaQualifSerie&)
 
 LimaQualifSerie::~LimaQualifSerie ( )
 {
-	if (false == _destroy)
-		_mesh.release ( );
 }	// LimaQualifSerie::~LimaQualifSerie
 
 
 size_t LimaQualifSerie::getCellCount ( ) const
 {
+	if (true == _snapshot)
+		return _offsets.size ( ) - 1;
+
 	switch (_cellsDimension)
 	{
 		case	2	:
 			if (0 == _surface)
 			{
-				if (0 != _mesh.get ( ))
+				if (0 != _mesh)
 					return _mesh->nb_polygones ( );
 			}
 			else
@@ -219,7 +242,7 @@ size_t LimaQualifSerie::getCellCount ( ) const
 		case	3	:
 			if (0 == _volume)
 			{
-				if (0 != _mesh.get ( ))
+				if (0 != _mesh)
 					return _mesh->nb_polyedres ( );
 			}
 			else
@@ -248,6 +271,8 @@ Qualif::Maille& LimaQualifSerie::getCell (size_t i) const
 
 	try
 	{
+		if (true == _snapshot)
+			return getSnapshotCell (i);
 
 		switch (_cellsDimension)
 		{
@@ -259,12 +284,12 @@ Qualif::Maille& LimaQualifSerie::getCell (size_t i) const
 				break;
 			case	2	:
 			{
-				if ((0 == _surface) && (0 == _mesh.get ( )))
+				if ((0 == _surface) && (0 == _mesh))
 				{
 					INTERNAL_ERROR (exc, "Surface nulle pour une dimension 2",
 						"LimaQualifSerie::getCell")
 					throw exc;
-				}	// if ((0 == _surface) && (0 == _mesh.get ( )))
+				}	// if ((0 == _surface) && (0 == _mesh))
 				_PolygoneInterne*	polygon	= 0 == _surface ?
 						_mesh->polygone (i) : _surface->polygone (i);
 				CHECK_NULL_PTR_ERROR (polygon)
@@ -301,12 +326,12 @@ Qualif::Maille& LimaQualifSerie::getCell (size_t i) const
 			}	// case 2
 			case	3	:
 			{
-				if ((0 == _volume) && (0 == _mesh.get ( )))
+				if ((0 == _volume) && (0 == _mesh))
 				{
 					INTERNAL_ERROR (exc, "Volume nul pour une dimension 3",
 						"LimaQualifSerie::getCell")
 					throw exc;
-				}	// if ((0 == _volume) && (0 == _mesh.get ( )))
+				}	// if ((0 == _volume) && (0 == _mesh))
 				_PolyedreInterne*	polyedron	= 0 == _volume ?
 									_mesh->polyedre (i) : _volume->polyedre (i);
 				CHECK_NULL_PTR_ERROR (polyedron)
@@ -419,6 +444,8 @@ size_t LimaQualifSerie::getCellType (size_t i) const
 
 	try
 	{
+		if (true == _snapshot)
+			return getSnapshotCellType (i);
 
 		switch (_cellsDimension)
 		{
@@ -430,12 +457,12 @@ size_t LimaQualifSerie::getCellType (size_t i) const
 				break;
 			case	2	:
 			{
-				if ((0 == _surface) && (0 == _mesh.get ( )))
+				if ((0 == _surface) && (0 == _mesh))
 				{
 					INTERNAL_ERROR (exc, "Surface nulle pour une dimension 2",
 						"LimaQualifSerie::getCellType")
 					throw exc;
-				}	// if ((0 == _surface) && (0 == _mesh.get ( )))
+				}	// if ((0 == _surface) && (0 == _mesh))
 				_PolygoneInterne*	polygon	= 0 == _surface ?
 						_mesh->polygone (i) : _surface->polygone (i);
 				CHECK_NULL_PTR_ERROR (polygon)
@@ -456,12 +483,12 @@ size_t LimaQualifSerie::getCellType (size_t i) const
 			}	// case 2
 			case	3	:
 			{
-				if ((0 == _volume) && (0 == _mesh.get ( )))
+				if ((0 == _volume) && (0 == _mesh))
 				{
 					INTERNAL_ERROR (exc, "Volume nul pour une dimension 3",
 						"LimaQualifSerie::getCellType")
 					throw exc;
-				}	// if ((0 == _volume) && (0 == _mesh.get ( )))
+				}	// if ((0 == _volume) && (0 == _mesh))
 				_PolyedreInterne*	polyedron	= 0 == _volume ?
 									_mesh->polyedre (i) : _volume->polyedre (i);
 				CHECK_NULL_PTR_ERROR (polyedron)
@@ -544,6 +571,378 @@ bool LimaQualifSerie::isThreadable ( ) const
 }	// LimaQualifSerie::isThreadable
 
 
+bool LimaQualifSerie::hasMeshCellIds ( ) const
+{
+	return true;
+}	// LimaQualifSerie::hasMeshCellIds
+
+
+size_t LimaQualifSerie::getMeshCellId (size_t i) const
+{
+	if (i >= getCellCount ( ))	// => initialize
+	{
+		UTF8String	error (charset);
+		error << "Le groupe de données ne contient que " << getCellCount ( )
+		      << " mailles. Accès à la " << i << "-ème maille impossible.";
+		throw Exception (error);
+	}	// if (i >= getCellCount ( ))
+	if (true == _snapshot)
+		return _cellIds [i];
+
+	if (2 == _cellsDimension)
+	{
+		const _PolygoneInterne*	polygon	= 0 == _surface ?
+				_mesh->polygone (i) : _surface->polygone (i);
+		CHECK_NULL_PTR_ERROR (polygon)
+		return polygon->id ( );
+	}	// if (2 == _cellsDimension)
+	const _PolyedreInterne*	polyedron	= 0 == _volume ?
+			_mesh->polyedre (i) : _volume->polyedre (i);
+	CHECK_NULL_PTR_ERROR (polyedron)
+	return polyedron->id ( );
+}	// LimaQualifSerie::getMeshCellId
+
+
+const void* LimaQualifSerie::getMeshInstance ( ) const
+{
+	return _meshInstance;
+}	// LimaQualifSerie::getMeshInstance
+
+
+void LimaQualifSerie::getCellCentroid (
+						size_t i, double& x, double& y, double& z) const
+{
+	if (i >= getCellCount ( ))
+	{
+		UTF8String	error (charset);
+		error << "Le groupe de données ne contient que " << getCellCount ( )
+		      << " mailles. Accès à la " << i << "-ème maille impossible.";
+		throw Exception (error);
+	}	// if (i >= getCellCount ( ))
+
+	x	= y	= z	= 0.;
+	size_t	nodesNum	= 0;
+	if (true == _snapshot)
+	{
+		const size_t	first	= (size_t)_offsets [i];
+		nodesNum	= (size_t)(_offsets [i + 1] - first);
+		for (size_t s = 0; s < nodesNum; s++)
+		{
+			const uint32_t	id	= _connectivity [first + s];
+			x	+= _xs [id];
+			y	+= _ys [id];
+			z	+= _zs [id];
+		}	// for (size_t s = 0; s < nodesNum; s++)
+	}	// if (true == _snapshot)
+	else
+	{
+		try
+		{
+			_PolygoneInterne*	polygon		= 0;
+			_PolyedreInterne*	polyedron	= 0;
+			if ((0 == _surface) && (0 == _volume))
+			{
+				CHECK_NULL_PTR_ERROR (_mesh)
+			}	// if ((0 == _surface) && (0 == _volume))
+			if (2 == _cellsDimension)
+			{
+				polygon		= 0 == _surface ?
+						_mesh->polygone (i) : _surface->polygone (i);
+				CHECK_NULL_PTR_ERROR (polygon)
+				nodesNum	= polygon->nb_noeuds ( );
+			}	// if (2 == _cellsDimension)
+			else
+			{
+				polyedron	= 0 == _volume ?
+						_mesh->polyedre (i) : _volume->polyedre (i);
+				CHECK_NULL_PTR_ERROR (polyedron)
+				nodesNum	= polyedron->nb_noeuds ( );
+			}	// else if (2 == _cellsDimension)
+			for (size_t s = 0; s < nodesNum; s++)
+			{
+				_NoeudInterne*	node	= 0 != polygon ?
+							polygon->noeud (s) : polyedron->noeud (s);
+				CHECK_NULL_PTR_ERROR (node)
+				x	+= node->x ( );
+				y	+= node->y ( );
+				z	+= node->z ( );
+			}	// for (size_t s = 0; s < nodesNum; s++)
+		}
+		catch (const erreur& err)
+		{
+			UTF8String	error (charset);
+			error << "Erreur Lima lors de l'accès à la " << i
+			      << "-ème maille : " << err.what ( );
+			throw Exception (error);
+		}
+	}	// else if (true == _snapshot)
+	if (0 != nodesNum)
+	{
+		x	/= nodesNum;
+		y	/= nodesNum;
+		z	/= nodesNum;
+	}	// if (0 != nodesNum)
+}	// LimaQualifSerie::getCellCentroid
+
+
+bool LimaQualifSerie::isCentroidReentrant ( ) const
+{
+	return true;
+}	// LimaQualifSerie::isCentroidReentrant
+
+
+void LimaQualifSerie::createSnapshot (size_t threadsNum)
+{
+	if (true == _snapshot)
+		return;
+
+	try
+	{
+		const size_t	cellsNum	= getCellCount ( );	// => initialize
+		if ((2 != _cellsDimension) && (3 != _cellsDimension))
+			throw Exception (UTF8String ("Erreur lors de la détermination de la dimension des mailles.", charset));
+		const bool		surfacic	= 2 == _cellsDimension;
+		const _SurfaceInterne*	surface	= _surface;
+		const _VolumeInterne*	volume	= _volume;
+		_MaillageInterne*		mesh	= _mesh;
+
+		// Nombre de noeuds des mailles => décalages, et identifiants Lima
+		// des mailles :
+		vector<uint64_t>	offsets (cellsNum + 1, 0);
+		vector<size_t>		ids (cellsNum, 0);
+		QualifHelper::parallelFor (cellsNum, threadsNum,
+		                           [&] (size_t first, size_t last)
+		{
+			for (size_t c = first; c < last; c++)
+			{
+				if (true == surfacic)
+				{
+					_PolygoneInterne*	polygon	= 0 == surface ?
+							mesh->polygone (c) : surface->polygone (c);
+					CHECK_NULL_PTR_ERROR (polygon)
+					offsets [c + 1]	= polygon->nb_noeuds ( );
+					ids [c]			= polygon->id ( );
+				}	// if (true == surfacic)
+				else
+				{
+					_PolyedreInterne*	polyedron	= 0 == volume ?
+							mesh->polyedre (c) : volume->polyedre (c);
+					CHECK_NULL_PTR_ERROR (polyedron)
+					offsets [c + 1]	= polyedron->nb_noeuds ( );
+					ids [c]			= polyedron->id ( );
+				}	// else if (true == surfacic)
+			}	// for (size_t c = first; c < last; c++)
+		});
+		for (size_t c = 0; c < cellsNum; c++)
+			offsets [c + 1]	+= offsets [c];
+
+		// Les noeuds des mailles :
+		vector<const _NoeudInterne*>	cellNodes (offsets [cellsNum], 0);
+		QualifHelper::parallelFor (cellsNum, threadsNum,
+		                           [&] (size_t first, size_t last)
+		{
+			for (size_t c = first; c < last; c++)
+			{
+				const size_t	nodesNum	= offsets [c + 1] - offsets [c];
+				for (size_t s = 0; s < nodesNum; s++)
+				{
+					_NoeudInterne*	node	= true == surfacic ?
+						(0 == surface ? mesh->polygone (c) :
+						                surface->polygone (c))->noeud (s) :
+						(0 == volume ? mesh->polyedre (c) :
+						               volume->polyedre (c))->noeud (s);
+					CHECK_NULL_PTR_ERROR (node)
+					cellNodes [offsets [c] + s]	= node;
+				}	// for (size_t s = 0; s < nodesNum; s++)
+			}	// for (size_t c = first; c < last; c++)
+		});
+
+		// Numérotation locale des noeuds : noeuds distincts triés (par
+		// adresse, soit peu ou prou dans leur ordre de création), tri par
+		// morceaux en parallèle puis fusion.
+		vector<const _NoeudInterne*>	nodes (cellNodes);
+		const size_t	chunks	= QualifHelper::getThreadsNum (threadsNum);
+		const size_t	count	= nodes.size ( );
+		QualifHelper::parallelFor (chunks, chunks,
+		                           [&] (size_t first, size_t last)
+		{
+			for (size_t k = first; k < last; k++)
+				sort (nodes.begin ( ) + count * k / chunks,
+				      nodes.begin ( ) + count * (k + 1) / chunks);
+		});
+		for (size_t width = 1; width < chunks; width *= 2)
+			for (size_t k = 0; k + width < chunks; k += 2 * width)
+				inplace_merge (nodes.begin ( ) + count * k / chunks,
+				       nodes.begin ( ) + count * (k + width) / chunks,
+				       nodes.begin ( ) + count * min (k + 2 * width, chunks) / chunks);
+		nodes.erase (unique (nodes.begin ( ), nodes.end ( )), nodes.end ( ));
+		if (nodes.size ( ) > (size_t)UINT32_MAX)
+			throw Exception (UTF8String ("Nombre de noeuds trop important pour un instantané.", charset));
+
+		vector<uint32_t>	connectivity (cellNodes.size ( ), 0);
+		QualifHelper::parallelFor (cellNodes.size ( ), threadsNum,
+		                           [&] (size_t first, size_t last)
+		{
+			for (size_t k = first; k < last; k++)
+				connectivity [k]	= (uint32_t)(lower_bound (nodes.begin ( ),
+					nodes.end ( ), cellNodes [k]) - nodes.begin ( ));
+		});
+		vector<const _NoeudInterne*> ( ).swap (cellNodes);
+
+		vector<double>	xs (nodes.size ( )), ys (nodes.size ( )), zs (nodes.size ( ));
+		QualifHelper::parallelFor (nodes.size ( ), threadsNum,
+		                           [&] (size_t first, size_t last)
+		{
+			for (size_t n = first; n < last; n++)
+			{
+				xs [n]	= nodes [n]->x ( );
+				ys [n]	= nodes [n]->y ( );
+				zs [n]	= nodes [n]->z ( );
+			}	// for (size_t n = first; n < last; n++)
+		});
+
+		_xs.swap (xs);
+		_ys.swap (ys);
+		_zs.swap (zs);
+		_connectivity.swap (connectivity);
+		_offsets.swap (offsets);
+		_cellIds.swap (ids);
+		_snapshot	= true;
+	}
+	catch (const erreur& err)
+	{
+		UTF8String	error (charset);
+		error << "Erreur Lima lors de la création de l'instantané du groupe "
+		      << getName ( ) << " du maillage du fichier " << getFileName ( )
+		      << " : " << err.what ( );
+		throw Exception (error);
+	}
+	catch (const Exception& exc)
+	{
+		UTF8String	error (charset);
+		error << "Erreur lors de la création de l'instantané du groupe "
+		      << getName ( ) << " du maillage du fichier " << getFileName ( )
+		      << " : " << exc.getFullMessage ( );
+		throw Exception (error);
+	}
+	catch (const exception& e)
+	{
+		UTF8String	error (charset);
+		error << "Erreur lors de la création de l'instantané du groupe "
+		      << getName ( ) << " du maillage du fichier " << getFileName ( )
+		      << " : " << e.what ( );
+		throw Exception (error);
+	}
+
+	// Les structures Lima ne sont plus utilisées :
+	_surface	= 0;
+	_volume		= 0;
+	_mesh		= 0;
+	_sharedMesh.reset ( );
+}	// LimaQualifSerie::createSnapshot
+
+
+bool LimaQualifSerie::hasSnapshot ( ) const
+{
+	return _snapshot;
+}	// LimaQualifSerie::hasSnapshot
+
+
+bool LimaQualifSerie::flattenCoordinates (size_t threadsNum)
+{
+	if (true == _snapshot)
+		return false;
+
+	createSnapshot (threadsNum);
+	return true;
+}	// LimaQualifSerie::flattenCoordinates
+
+
+/**
+ * @return		La description complète des groupes du maillage transmis en
+ * 				argument.
+ */
+static vector<QualifGroupMetadata> meshMetadata (const _MaillageInterne& mesh)
+{
+	vector<QualifGroupMetadata>	metadata;
+	size_t						g	= 0,	c	= 0;
+	for (g = 0; g < mesh.nb_volumes ( ); g++)
+	{
+		const _VolumeInterne*	volume	= mesh.volume (g);
+		QualifGroupMetadata		group (volume->nom ( ), 3);
+		group.cellsNum	= 0;
+		for (c = 0; c < volume->nb_elm ( ); c++)
+			switch (volume->polyedre (c)->nb_noeuds ( ))
+			{
+				case	4	: group.addCells (QualifHelper::TETRAEDRON);		break;
+				case	5	: group.addCells (QualifHelper::PYRAMID);			break;
+				case	6	: group.addCells (QualifHelper::TRIANGULAR_PRISM);	break;
+				case	8	: group.addCells (QualifHelper::HEXAEDRON);			break;
+				default		: group.addCells (0);
+			}	// switch (volume->polyedre (c)->nb_noeuds ( ))
+		metadata.push_back (group);
+	}	// for (g = 0; g < mesh.nb_volumes ( ); g++)
+	for (g = 0; g < mesh.nb_surfaces ( ); g++)
+	{
+		const _SurfaceInterne*	surface	= mesh.surface (g);
+		QualifGroupMetadata		group (surface->nom ( ), 2);
+		group.cellsNum	= 0;
+		for (c = 0; c < surface->nb_elm ( ); c++)
+			switch (surface->polygone (c)->nb_noeuds ( ))
+			{
+				case	3	: group.addCells (QualifHelper::TRIANGLE);			break;
+				case	4	: group.addCells (QualifHelper::QUADRANGLE);		break;
+				default		: group.addCells (0);
+			}	// switch (surface->polygone (c)->nb_noeuds ( ))
+		metadata.push_back (group);
+	}	// for (g = 0; g < mesh.nb_surfaces ( ); g++)
+
+	return metadata;
+}	// meshMetadata
+
+
+vector<QualifGroupMetadata> LimaQualifSerie::getMetadata (
+													const string& fileName)
+{
+	shared_ptr<_MaillageInterne>	mesh	= LimaMeshCache::findMesh (fileName);
+	if (0 != mesh.get ( ))
+		return meshMetadata (*mesh.get ( ));
+
+	vector<QualifGroupMetadata>	metadata;
+	try
+	{	// Lecture de la seule structure du maillage (noms et tailles des
+		// groupes), sans les noeuds ni les mailles :
+		_MaillageInterne	structure;
+		{
+			lock_guard<mutex>	lock (LimaMeshCache::getReadingMutex ( ));
+			structure.lire_structure (fileName);
+		}
+		size_t	g	= 0;
+		for (g = 0; g < structure.nb_volumes ( ); g++)
+		{
+			QualifGroupMetadata	group (structure.volume (g)->nom ( ), 3);
+			if (0 != structure.volume (g)->nb_elm ( ))
+				group.cellsNum	= structure.volume (g)->nb_elm ( );
+			metadata.push_back (group);
+		}	// for (g = 0; g < structure.nb_volumes ( ); g++)
+		for (g = 0; g < structure.nb_surfaces ( ); g++)
+		{
+			QualifGroupMetadata	group (structure.surface (g)->nom ( ), 2);
+			if (0 != structure.surface (g)->nb_elm ( ))
+				group.cellsNum	= structure.surface (g)->nb_elm ( );
+			metadata.push_back (group);
+		}	// for (g = 0; g < structure.nb_surfaces ( ); g++)
+
+		return metadata;
+	}
+	catch (const erreur&)
+	{	// Format ne permettant pas la lecture de la structure seule.
+	}
+
+	return meshMetadata (*LimaMeshCache::getMesh (fileName).get ( ));
+}	// LimaQualifSerie::getMetadata
+
+
 void LimaQualifSerie::initialize ( ) const
 {
 	// Sur la dimension ...
@@ -557,16 +956,118 @@ void LimaQualifSerie::initialize ( ) const
 	{
 		if (0 != _volume)
 			_cellsDimension	= 3;
-		else if (0 != _mesh.get ( ))
+		else if (0 != _mesh)
 		{
 			if (0 != _mesh->nb_polyedres ( ))
 				_cellsDimension	= 3;
 			else if (0 != _mesh->nb_polygones ( ))
 				_cellsDimension	= 2;
-		}	// else if (0 != _mesh.get ( ))
+		}	// else if (0 != _mesh)
 	}	// if (0 == _cellsDimension)
 }	// LimaQualifSerie::initialize
 
+
+bool LimaQualifSerie::renumberNodes (size_t threadsNum)
+{
+	if (false == _snapshot)
+		return false;
+
+	// Numéros des noeuds dans leur ordre de première utilisation :
+	const size_t		cellsNum	= getCellCount ( );
+	const size_t		nodesNum	= _xs.size ( );
+	vector<uint32_t>	ids (nodesNum, UINT32_MAX);
+	uint32_t			next		= 0;
+	for (size_t p = 0; p < cellsNum; p++)
+	{
+		const size_t	c	= getEvaluatedCell (p);
+		for (uint64_t k = _offsets [c]; k < _offsets [c + 1]; k++)
+			if (UINT32_MAX == ids [_connectivity [k]])
+				ids [_connectivity [k]]	= next++;
+	}	// for (size_t p = 0; p < cellsNum; p++)
+	for (size_t n = 0; n < nodesNum; n++)	// Noeuds non utilisés
+		if (UINT32_MAX == ids [n])
+			ids [n]	= next++;
+
+	vector<double>	xs (nodesNum), ys (nodesNum), zs (nodesNum);
+	QualifHelper::parallelFor (nodesNum, threadsNum,
+	                           [&] (size_t first, size_t last)
+	{
+		for (size_t n = first; n < last; n++)
+		{
+			xs [ids [n]]	= _xs [n];
+			ys [ids [n]]	= _ys [n];
+			zs [ids [n]]	= _zs [n];
+		}	// for (size_t n = first; n < last; n++)
+	});
+	QualifHelper::parallelFor (_connectivity.size ( ), threadsNum,
+	                           [&] (size_t first, size_t last)
+	{
+		for (size_t k = first; k < last; k++)
+			_connectivity [k]	= ids [_connectivity [k]];
+	});
+	_xs.swap (xs);
+	_ys.swap (ys);
+	_zs.swap (zs);
+
+	return true;
+}	// LimaQualifSerie::renumberNodes
+
+
+Qualif::Maille& LimaQualifSerie::getSnapshotCell (size_t i) const
+{
+	const size_t	first		= (size_t)_offsets [i];
+	const size_t	nodesNum	= (size_t)(_offsets [i + 1] - first);
+	Maille*			cell		= 0;
+	switch (nodesNum)
+	{
+		case	3	: cell	= &_triangle;									break;
+		case	4	: cell	= 2 == _cellsDimension ?
+							(Maille*)&_quadrangle : (Maille*)&_tetraedron;		break;
+		case	5	: cell	= &_pyramid;									break;
+		case	6	: cell	= &_prism;										break;
+		case	8	: cell	= &_hexaedron;									break;
+	}	// switch (nodesNum)
+	if ((0 == cell) || ((3 == _cellsDimension) && (3 == nodesNum)) ||
+	    ((2 == _cellsDimension) && (4 < nodesNum)))
+	{
+		UTF8String	error (charset);
+		error << "Nombre de noeuds invalide (" << (unsigned long)nodesNum
+		      << ") pour la " << i << "-ème maille.";
+		throw Exception (error);
+	}	// if ((0 == cell) || ...
+
+	const uint32_t*	ids	= _connectivity.data ( ) + first;
+	for (size_t s = 0; s < nodesNum; s++)
+		cell->Modifier_Sommet (s, _xs [ids [s]], _ys [ids [s]], _zs [ids [s]]);
+
+	return *cell;
+}	// LimaQualifSerie::getSnapshotCell
+
+
+size_t LimaQualifSerie::getSnapshotCellType (size_t i) const
+{
+	const size_t	nodesNum	= (size_t)(_offsets [i + 1] - _offsets [i]);
+	if (2 == _cellsDimension)
+		switch (nodesNum)
+		{
+			case	3	: return QualifHelper::TRIANGLE;
+			case	4	: return QualifHelper::QUADRANGLE;
+		}	// switch (nodesNum)
+	else
+		switch (nodesNum)
+		{
+			case	4	: return QualifHelper::TETRAEDRON;
+			case	5	: return QualifHelper::PYRAMID;
+			case	6	: return QualifHelper::TRIANGULAR_PRISM;
+			case	8	: return QualifHelper::HEXAEDRON;
+		}	// switch (nodesNum)
+
+	UTF8String	error (charset);
+	error << "Nombre de noeuds invalide (" << (unsigned long)nodesNum
+	      << ") pour la " << i << "-ème maille.";
+	throw Exception (error);
+}	// LimaQualifSerie::getSnapshotCellType
+
 }	// namespace GQualif
 
 
@@ -0,0 +1,115 @@
+#ifndef LIMA_MESH_CACHE_H
+#define LIMA_MESH_CACHE_H
+
+#include <TkUtil/util_config.h>
+
+#include <LimaP/maillage_it.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Cache, à l'échelle du processus, des maillages <I>Lima</I> chargés. Les
+ * maillages sont identifiés par le chemin canonique de leur fichier et la date
+ * de dernière modification de celui-ci : plusieurs séries, ou plusieurs vues
+ * d'une application, portant sur un même fichier partagent ainsi un seul
+ * maillage en mémoire, chargé une seule fois.
+ * </P>
+ *
+ * <P>Le cache ne détient pas les maillages : ceux-ci sont détruits dès que la
+ * dernière instance de <I>shared_ptr</I> les référençant l'est (fermeture de
+ * la dernière vue, ...). Un fichier modifié depuis son chargement est
+ * rechargé.
+ * </P>
+ *
+ * <P>Cette classe est utilisable en contexte multithread. Des chargements
+ * concurrents d'un même fichier n'en provoquent qu'une lecture. Les lectures
+ * de fichiers différents sont en revanche effectuées l'une après l'autre
+ * (<I>getReadingMutex</I>), seuls les traitements qui les suivent
+ * s'effectuant en parallèle.
+ * </P>
+ */
+class LimaMeshCache
+{
+	public :
+
+	/**
+	 * @return		Le maillage contenu dans le fichier transmis en argument,
+	 * 				chargé si nécessaire.
+	 * @exception	Une exception est levée si le fichier n'est pas accessible
+	 * 				ou en cas d'erreur de lecture (erreur <I>Lima</I>).
+	 */
+	static IN_STD shared_ptr<Lima::_MaillageInterne> getMesh (
+											const IN_STD string& fileName);
+
+	/**
+	 * @return		Le maillage contenu dans le fichier transmis en argument
+	 * 				s'il est en mémoire (et à jour), ou un pointeur nul. Le
+	 * 				fichier n'est jamais lu.
+	 */
+	static IN_STD shared_ptr<Lima::_MaillageInterne> findMesh (
+												const IN_STD string& fileName);
+
+	/**
+	 * @return		Le nombre de maillages actuellement en mémoire.
+	 */
+	static size_t getMeshesNum ( );
+
+	/**
+	 * @return		Le mutex sérialisant, à l'échelle du processus, les
+	 * 				lectures de fichiers <I>Lima</I> (<I>lire</I>,
+	 * 				<I>lire_structure</I>), dont la réentrance (lecteurs
+	 * 				<I>MLI</I>, <I>HDF5</I>) n'est pas documentée. A détenir
+	 * 				par toute lecture effectuée hors de ce cache.
+	 */
+	static IN_STD mutex& getReadingMutex ( );
+
+
+	private :
+
+	/**
+	 * Constructeurs, opérateur = et destructeur : interdits.
+	 */
+	LimaMeshCache ( );
+	LimaMeshCache (const LimaMeshCache&);
+	LimaMeshCache& operator = (const LimaMeshCache&);
+	~LimaMeshCache ( );
+
+	/**
+	 * Un maillage du cache.
+	 */
+	struct Entry
+	{
+		Entry ( )
+			: modificationTime (0), loadingMutex ( ), mesh ( )
+		{ }
+
+		/** Date de dernière modification du fichier (ns). */
+		long long								modificationTime;
+
+		/** Protège le chargement du maillage. */
+		IN_STD mutex							loadingMutex;
+
+		/** Le maillage, détenu par les utilisateurs du cache. */
+		IN_STD weak_ptr<Lima::_MaillageInterne>	mesh;
+	};	// struct Entry
+
+	/** Protège l'accès aux entrées du cache. */
+	static IN_STD mutex										_mutex;
+
+	/** Sérialise les lectures de fichiers. */
+	static IN_STD mutex										_readingMutex;
+
+	/** Les maillages, par chemin canonique de fichier. */
+	static IN_STD map<IN_STD string, IN_STD shared_ptr<Entry> >	_entries;
+};	// class LimaMeshCache
+
+}	// namespace GQualif
+
+#endif	// LIMA_MESH_CACHE_H
@@ -2,12 +2,16 @@
 #define LIMA_QUALIF_SERIE_H
 
 #include "GQualif/AbstractQualifSerieAdapter.h"
+#include "GQualif/QualifGroupMetadata.h"
 
 #include <LimaP/maillage_it.h>
 #include <LimaP/surface_it.h>
 #include <LimaP/volume_it.h>
 
 #include <memory>
+#include <vector>
+
+#include <stdint.h>
 
 namespace GQualif
 {
@@ -24,6 +28,15 @@ namespace GQualif
  * <P>Classe représentant une série de mailles issues d'un maillage Lima
  * à soumettre à <I>Qualif</I> en vue d'être analysée (ex : surface composée de
  * polygones, ...).</P>
+ *
+ * <P>L'accès aux noeuds d'une maille <I>Lima</I> passe par plusieurs
+ * indirections vers des objets dispersés en mémoire. La méthode
+ * <I>createSnapshot</I> permet de recopier, en parallèle, la connectivité des
+ * mailles dans des tableaux contigus et les coordonnées des noeuds dans une
+ * structure de tableaux (numérotation locale des noeuds). Les mailles sont
+ * ensuite lues dans ces tableaux, et les structures <I>Lima</I> ne sont plus
+ * utilisées.
+ * </P>
  */
 class LimaQualifSerie : public AbstractQualifSerieAdapter
 {
@@ -31,8 +44,9 @@ class LimaQualifSerie : public AbstractQualifSerieAdapter
 
 	/**
 	 * Constructeur 1. Charge les données depuis le fichier <I>fileName</I>.
-	 * Les données du maillage seront détruites lors de la destruction de cette
-	 * série.
+	 * Le maillage est obtenu via <I>LimaMeshCache</I> : il est partagé avec
+	 * les autres séries issues du même fichier, et détruit avec la dernière
+	 * d'entre-elles.
 	 * @param		Nom du fichier d'où est chargée la série.
 	 * @param		Nom de la série (groupe au sens <I>Lima</I>).
 	 * @param		Dimension des données.
@@ -57,16 +71,23 @@ class LimaQualifSerie : public AbstractQualifSerieAdapter
 	 * Constructeur 3. Les données reçues en argument ne seront pas détruites
 	 * lors de la destruction de cette série.
 	 * @param		Surface représentée.
+	 * @param		Eventuel maillage contenant la surface, permettant de
+	 * 				partager ses mailles avec les autres séries de ce maillage
+	 * 				(<I>getMeshInstance</I>).
 	 */
 	LimaQualifSerie (const Lima::_SurfaceInterne& surface, Lima::dim_t dimension,
-			const IN_STD string& fileName);
+			const IN_STD string& fileName,
+			const Lima::_MaillageInterne* mesh = 0);
 
 	/**
 	 * Constructeur 4. Les données reçues en argument ne seront pas détruites
 	 * lors de la destruction de cette série.
 	 * @param		Surface représentée.
+	 * @param		Eventuel maillage contenant le volume (cf. constructeur
+	 * 				3).
 	 */
-	LimaQualifSerie (const Lima::_VolumeInterne& volume, const IN_STD string& fileName);
+	LimaQualifSerie (const Lima::_VolumeInterne& volume, const IN_STD string& fileName,
+			const Lima::_MaillageInterne* mesh = 0);
 
 	/**
 	 * Destructeur. RAS.
@@ -103,6 +124,82 @@ class LimaQualifSerie : public AbstractQualifSerieAdapter
 	 */
 	virtual bool isThreadable ( ) const;
 
+	/**
+	 * @return		<I>true</I>
+	 */
+	virtual bool hasMeshCellIds ( ) const;
+
+	/**
+	 * @return		L'identifiant <I>Lima</I> de la i-ème maille (polygone ou
+	 * 				polyèdre), lu dans l'instantané le cas échéant.
+	 */
+	virtual size_t getMeshCellId (size_t i) const;
+
+	/**
+	 * @return		Le maillage <I>Lima</I> dont est issue la série (0 s'il
+	 * 				n'a pas été transmis au constructeur 3 ou 4), y compris
+	 * 				après création de l'instantané.
+	 */
+	virtual const void* getMeshInstance ( ) const;
+
+	/**
+	 * @return		En retour, le centre de la i-ème maille, lu dans
+	 * 				l'instantané ou dans le maillage <I>Lima</I>.
+	 * @exception	Une exception est levée si la maille est invalide.
+	 */
+	virtual void getCellCentroid (
+						size_t i, double& x, double& y, double& z) const;
+
+	/**
+	 * @return		<I>true</I> (lecture seule des structures <I>Lima</I> ou
+	 * 				de l'instantané).
+	 */
+	virtual bool isCentroidReentrant ( ) const;
+
+	/**
+	 * Crée un instantané des mailles de la série : connectivité (numérotation
+	 * locale des noeuds) et décalages dans des tableaux contigus, coordonnées
+	 * des noeuds dans 3 tableaux (x, y, z). Les mailles sont ensuite lues dans
+	 * ces tableaux. Les structures <I>Lima</I> ne sont plus référencées par la
+	 * série : un maillage adopté est détruit, un maillage non adopté peut
+	 * l'être par l'appelant dès lors qu'aucune autre série ne l'utilise.
+	 * @param		Nombre de threads utilisés (0 : nombre de processeurs).
+	 * @exception	Une exception est levée en cas d'erreur, la série étant
+	 * 				alors inchangée.
+	 * @see			hasSnapshot
+	 */
+	virtual void createSnapshot (size_t threadsNum = 0);
+
+	/**
+	 * @return		<I>true</I> si les mailles sont lues dans un instantané,
+	 * 				<I>false</I> si elles le sont dans le maillage
+	 * 				<I>Lima</I>.
+	 * @see			createSnapshot
+	 */
+	virtual bool hasSnapshot ( ) const;
+
+	/**
+	 * Crée l'instantané des mailles de la série s'il n'existe pas déjà.
+	 * @return		<I>true</I> si l'instantané a été créé par cet appel.
+	 * @see			createSnapshot
+	 */
+	virtual bool flattenCoordinates (size_t threadsNum);
+
+	/**
+	 * @return		La description sommaire des groupes de mailles (volumes
+	 * 				puis surfaces) du maillage contenu dans le fichier
+	 * 				transmis en argument. Si le maillage est déjà en mémoire
+	 * 				(<I>LimaMeshCache</I>) la description est complète
+	 * 				(nombre de mailles par type). A défaut seule la structure
+	 * 				du fichier est lue (noms des groupes et, selon le format,
+	 * 				nombres de mailles), sauf si le format ne le permet pas,
+	 * 				auquel cas le maillage est chargé via
+	 * 				<I>LimaMeshCache</I>.
+	 * @exception	Une exception est levée en cas d'erreur de lecture.
+	 */
+	static IN_STD vector<QualifGroupMetadata> getMetadata (
+												const IN_STD string& fileName);
+
 
 	protected :
 
@@ -111,6 +208,16 @@ class LimaQualifSerie : public AbstractQualifSerieAdapter
 	 */
 	virtual void initialize ( ) const;
 
+	/**
+	 * Renumérote les noeuds de l'instantané dans leur ordre de première
+	 * utilisation par les mailles parcourues dans l'ordre d'évaluation.
+	 * @return		<I>true</I> si la série dispose d'un instantané,
+	 * 				<I>false</I> dans le cas contraire (les noeuds du maillage
+	 * 				<I>Lima</I> ne sont pas renumérotés).
+	 * @see			createSnapshot
+	 */
+	virtual bool renumberNodes (size_t threadsNum);
+
 
 	private :
 
@@ -120,11 +227,23 @@ class LimaQualifSerie : public AbstractQualifSerieAdapter
 	LimaQualifSerie (const LimaQualifSerie&);
 	LimaQualifSerie& operator = (const LimaQualifSerie&);
 
-	/** Le maillage éventuellement chargé par cette instance. */
-	IN_STD unique_ptr <Lima::_MaillageInterne>		_mesh;
+	/**
+	 * @return		La i-ème maille de l'instantané.
+	 */
+	Qualif::Maille& getSnapshotCell (size_t i) const;
+
+	/**
+	 * @return		Le type, au sens <I>QualifHelper</I>, de la i-ème maille
+	 * 				de l'instantané.
+	 */
+	size_t getSnapshotCellType (size_t i) const;
+
+	/** Le maillage éventuellement utilisé par cette instance. */
+	Lima::_MaillageInterne*							_mesh;
 
-	/** Faut-il détruire ce maillageà la fin ? */
-	bool											_destroy;
+	/** L'éventuel détenteur de ce maillage : maillage partagé (cf.
+	 * <I>LimaMeshCache</I>) ou maillage transmis à détruire. */
+	IN_STD shared_ptr <Lima::_MaillageInterne>		_sharedMesh;
 
 	/** L'éventuelle surface représentée. */
 	const Lima::_SurfaceInterne*				_surface;
@@ -132,12 +251,27 @@ class LimaQualifSerie : public AbstractQualifSerieAdapter
 	/** L'éventuel volume représenté. */
 	const Lima::_VolumeInterne*				_volume;
 
+	/** Le maillage dont est issue la série, conservé après création de
+	 * l'instantané (cf. <I>getMeshInstance</I>). */
+	const void*								_meshInstance;
+
 	/** La dimension des mailles (polygones : 2, polyèdres : 3). Elle peut être
 	 * différente de la dimension du maillage (ex : triangles dans l'espace), et
 	 * Qualif fait bien cette distinction (ex : calcul du jacobien des
 	 * triangles).
 	 */
 	mutable unsigned char					_cellsDimension;
+
+	/** L'éventuel instantané des mailles : coordonnées des noeuds
+	 * (numérotation locale), connectivité et décalages (<I>cellsNum + 1</I>
+	 * valeurs). */
+	bool									_snapshot;
+	IN_STD vector<double>					_xs, _ys, _zs;
+	IN_STD vector<uint32_t>					_connectivity;
+	IN_STD vector<uint64_t>					_offsets;
+
+	/** Les identifiants <I>Lima</I> des mailles de l'instantané. */
+	IN_STD vector<size_t>					_cellIds;
 };	// class LimaQualifSerie
 
 }	// namespace GQualif
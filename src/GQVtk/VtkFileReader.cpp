@@ -0,0 +1,1367 @@
+#include "GQVtk/VtkFileReader.h"
+#include "GQualif/QualifHelper.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/UTF8String.h>
+
+#if defined (__has_include)
+#if __has_include (<charconv>)
+#include <charconv>
+#endif	// __has_include (<charconv>)
+#endif	// defined (__has_include)
+
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif	// USE_ZLIB
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+USING_UTIL
+USING_STD
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                           FONCTIONS UTILITAIRES
+// ============================================================================
+
+/** En deçà de cette taille (en octets) les traitements ne sont pas
+ * parallélisés. */
+static const size_t		parallelThreshold	= 1 << 20;
+
+
+static bool isLittleEndian ( )
+{
+	const uint16_t	value	= 1;
+	return 1 == *(const unsigned char*)&value;
+}	// isLittleEndian
+
+
+static inline bool isSpace (char c)
+{
+	return (' ' == c) || ('\n' == c) || ('\r' == c) || ('\t' == c) ||
+	       ('\f' == c) || ('\v' == c);
+}	// isSpace
+
+
+static inline const char* skipSpaces (const char* p, const char* end)
+{
+	while ((p < end) && (true == isSpace (*p)))
+		p++;
+	return p;
+}	// skipSpaces
+
+
+static string toUpper (const string& str)
+{
+	string	upper (str);
+	for (string::iterator it = upper.begin ( ); upper.end ( ) != it; it++)
+		*it	= (char)toupper ((unsigned char)*it);
+	return upper;
+}	// toUpper
+
+
+/**
+ * @return		La ligne débutant en <I>p</I> (sans fin de ligne). <I>p</I>
+ * 				est positionné au début de la ligne suivante.
+ */
+static string nextLine (const char*& p, const char* end)
+{
+	const char*	eol	= (const char*)memchr (p, '\n', end - p);
+	if (0 == eol)
+		eol	= end;
+	string	line (p, eol);
+	if ((false == line.empty ( )) && ('\r' == line [line.length ( ) - 1]))
+		line.resize (line.length ( ) - 1);
+	p	= eol < end ? eol + 1 : end;
+
+	return line;
+}	// nextLine
+
+
+/**
+ * @return		Le début de la première ligne débutant par une majuscule
+ * 				(mot clé <I>VTK legacy</I>) située après <I>p</I>, ou
+ * 				<I>end</I>.
+ */
+static const char* nextKeyword (const char* p, const char* end)
+{
+	while (p < end)
+	{
+		const char*	eol	= (const char*)memchr (p, '\n', end - p);
+		if (0 == eol)
+			return end;
+		p	= eol + 1;
+		if ((p < end) && ('A' <= *p) && ('Z' >= *p))
+			return p;
+	}	// while (p < end)
+
+	return end;
+}	// nextKeyword
+
+
+static const char* findString (const char* p, const char* end, const char* str)
+{
+	const size_t	length	= strlen (str);
+	const char*		found	= std::search (p, end, str, str + length);
+	return end == found ? 0 : found;
+}	// findString
+
+
+/**
+ * Les types scalaires des tableaux.
+ */
+enum SCALAR_TYPE
+{
+	INT8, UINT8, INT16, UINT16, INT32, UINT32, INT64, UINT64, FLOAT32, FLOAT64,
+	UNKNOWN_SCALAR
+};
+
+
+/**
+ * @return		La table des types scalaires par nom (noms <I>XML</I> ou
+ * 				<I>legacy</I>).
+ */
+static map<string, SCALAR_TYPE> scalarTypes ( )
+{
+	map<string, SCALAR_TYPE>	types;
+	types ["Int8"]			= INT8;		types ["char"]			= INT8;
+	types ["UInt8"]			= UINT8;	types ["unsigned_char"]	= UINT8;
+	types ["Int16"]			= INT16;	types ["short"]			= INT16;
+	types ["UInt16"]		= UINT16;	types ["unsigned_short"]= UINT16;
+	types ["Int32"]			= INT32;	types ["int"]			= INT32;
+	types ["vtktypeint32"]	= INT32;
+	types ["UInt32"]		= UINT32;	types ["unsigned_int"]	= UINT32;
+	types ["Int64"]			= INT64;	types ["vtktypeint64"]	= INT64;
+	types ["long"]			= INT64;	types ["vtkIdType"]		= INT64;
+	types ["UInt64"]		= UINT64;	types ["vtktypeuint64"]	= UINT64;
+	types ["unsigned_long"]	= UINT64;
+	types ["Float32"]		= FLOAT32;	types ["float"]			= FLOAT32;
+	types ["Float64"]		= FLOAT64;	types ["double"]		= FLOAT64;
+
+	return types;
+}	// scalarTypes
+
+
+/**
+ * @return		Le type scalaire correspondant au nom transmis en argument
+ * 				(noms <I>XML</I> ou <I>legacy</I>).
+ */
+static SCALAR_TYPE scalarType (const string& name)
+{
+	// Initialisation unique et thread-safe (lectures parallèles) :
+	static const map<string, SCALAR_TYPE>	types	= scalarTypes ( );
+	map<string, SCALAR_TYPE>::const_iterator	it	= types.find (name);
+
+	return types.end ( ) == it ? UNKNOWN_SCALAR : it->second;
+}	// scalarType
+
+
+static size_t scalarSize (SCALAR_TYPE type)
+{
+	switch (type)
+	{
+		case INT8		:
+		case UINT8		: return 1;
+		case INT16		:
+		case UINT16		: return 2;
+		case INT32		:
+		case UINT32		:
+		case FLOAT32	: return 4;
+		case INT64		:
+		case UINT64		:
+		case FLOAT64	: return 8;
+		default			: break;
+	}	// switch (type)
+
+	return 0;
+}	// scalarSize
+
+
+template <typename S> static inline S loadValue (const unsigned char* p, bool swap)
+{
+	S	value;
+	if (true == swap)
+	{
+		unsigned char	bytes [sizeof (S)];
+		for (size_t b = 0; b < sizeof (S); b++)
+			bytes [b]	= p [sizeof (S) - 1 - b];
+		memcpy (&value, bytes, sizeof (S));
+	}	// if (true == swap)
+	else
+		memcpy (&value, p, sizeof (S));
+
+	return value;
+}	// loadValue
+
+
+template <typename S, typename T> static void convertValues (
+	const unsigned char* data, size_t count, bool swap, T* out, size_t threads)
+{
+	QualifHelper::parallelFor (
+				count, count * sizeof (S) < parallelThreshold ? 1 : threads,
+				[=] (size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+			out [i]	= (T)loadValue<S> (data + i * sizeof (S), swap);
+	});
+}	// convertValues
+
+
+/**
+ * Convertit <I>count</I> valeurs de type <I>type</I> débutant en <I>data</I>
+ * en valeurs de type <I>T</I>.
+ * @param		<I>true</I> si l'ordre des octets doit être inversé.
+ */
+template <typename T> static void convertArray (
+			const unsigned char* data, SCALAR_TYPE type, size_t count,
+			bool swap, T* out, size_t threads)
+{
+	switch (type)
+	{
+		case INT8	: convertValues<int8_t, T> (data, count, swap, out, threads);	break;
+		case UINT8	: convertValues<uint8_t, T> (data, count, swap, out, threads);	break;
+		case INT16	: convertValues<int16_t, T> (data, count, swap, out, threads);	break;
+		case UINT16	: convertValues<uint16_t, T> (data, count, swap, out, threads);	break;
+		case INT32	: convertValues<int32_t, T> (data, count, swap, out, threads);	break;
+		case UINT32	: convertValues<uint32_t, T> (data, count, swap, out, threads);	break;
+		case INT64	: convertValues<int64_t, T> (data, count, swap, out, threads);	break;
+		case UINT64	: convertValues<uint64_t, T> (data, count, swap, out, threads);	break;
+		case FLOAT32: convertValues<float, T> (data, count, swap, out, threads);	break;
+		case FLOAT64: convertValues<double, T> (data, count, swap, out, threads);	break;
+		default		:
+			throw Exception (UTF8String ("Type de données non supporté.", charset));
+	}	// switch (type)
+}	// convertArray
+
+
+static void throwParseError (const char* begin, const char* end)
+{
+	UTF8String	message (charset);
+	message << "Valeur numérique invalide : \""
+	        << string (begin, min (end, begin + 32)) << "\".";
+	throw Exception (message);
+}	// throwParseError
+
+
+/**
+ * Lit le nombre situé dans [begin, end[.
+ */
+static void parseNumber (const char* begin, const char* end, double& value)
+{
+	if ('+' == *begin)
+		begin++;
+#if defined (__cpp_lib_to_chars)
+	const from_chars_result	result	= from_chars (begin, end, value);
+	if ((errc::result_out_of_range == result.ec) && (end == result.ptr))
+	{	// Valeurs dénormalisées, ... : strtod les gère.
+		char	buffer [128];
+		const size_t	length	= min ((size_t)(end - begin), sizeof (buffer) - 1);
+		memcpy (buffer, begin, length);
+		buffer [length]	= '\0';
+		value	= strtod (buffer, 0);
+	}
+	else if ((errc ( ) != result.ec) || (end != result.ptr))
+		throwParseError (begin, end);
+#else	// defined (__cpp_lib_to_chars)
+	char	buffer [128];
+	if ((size_t)(end - begin) >= sizeof (buffer))
+		throwParseError (begin, end);
+	memcpy (buffer, begin, end - begin);
+	buffer [end - begin]	= '\0';
+	char*	last	= 0;
+	value	= strtod (buffer, &last);
+	if (last != buffer + (end - begin))
+		throwParseError (begin, end);
+#endif	// defined (__cpp_lib_to_chars)
+}	// parseNumber
+
+
+static void parseNumber (const char* begin, const char* end, int64_t& value)
+{
+	if ('+' == *begin)
+		begin++;
+#if defined (__cpp_lib_to_chars)
+	const from_chars_result	result	= from_chars (begin, end, value);
+	if ((errc ( ) != result.ec) || (end != result.ptr))
+		throwParseError (begin, end);
+#else	// defined (__cpp_lib_to_chars)
+	char	buffer [64];
+	if ((size_t)(end - begin) >= sizeof (buffer))
+		throwParseError (begin, end);
+	memcpy (buffer, begin, end - begin);
+	buffer [end - begin]	= '\0';
+	char*	last	= 0;
+	value	= strtoll (buffer, &last, 10);
+	if (last != buffer + (end - begin))
+		throwParseError (begin, end);
+#endif	// defined (__cpp_lib_to_chars)
+}	// parseNumber
+
+
+static size_t countTokens (const char* p, const char* end)
+{
+	size_t	count	= 0;
+	bool	space	= true;
+	for ( ; p < end; p++)
+	{
+		const bool	s	= isSpace (*p);
+		if ((true == space) && (false == s))
+			count++;
+		space	= s;
+	}	// for ( ; p < end; p++)
+
+	return count;
+}	// countTokens
+
+
+/**
+ * Lit les <I>count</I> nombres situés dans [begin, end[. La zone est découpée
+ * en intervalles ne coupant pas de nombre, chaque intervalle étant traité par
+ * un thread : comptage des nombres de chaque intervalle, puis lecture directe
+ * à la bonne position du tableau de sortie.
+ * @exception	Une exception est levée si la zone ne contient pas exactement
+ * 				<I>count</I> nombres valides.
+ */
+template <typename T> static void parseAsciiValues (
+		const char* begin, const char* end, size_t count, T* out,
+		size_t threadsNum, const string& what)
+{
+	typedef typename conditional<is_floating_point<T>::value, double, int64_t>::type	Parsed;
+
+	const size_t		num	=
+		(size_t)(end - begin) < parallelThreshold ? 1 : max (threadsNum, (size_t)1);
+	vector<const char*>	bounds (num + 1, begin);
+	bounds [num]	= end;
+	for (size_t k = 1; k < num; k++)
+	{
+		const char*	p	= begin + (end - begin) * k / num;
+		while ((p < end) && (false == isSpace (*p)))
+			p++;
+		bounds [k]	= max (p, bounds [k - 1]);
+	}	// for (size_t k = 1; k < num; k++)
+
+	vector<size_t>	firsts (num + 1, 0);
+	QualifHelper::parallelFor (num, num, [&] (size_t first, size_t last)
+	{
+		for (size_t k = first; k < last; k++)
+			firsts [k + 1]	= countTokens (bounds [k], bounds [k + 1]);
+	});
+	for (size_t k = 0; k < num; k++)
+		firsts [k + 1]	+= firsts [k];
+	if (count != firsts [num])
+	{
+		UTF8String	message (charset);
+		message << (unsigned long)firsts [num] << " valeurs lues pour "
+		        << what << " alors que " << (unsigned long)count
+		        << " sont attendues.";
+		throw Exception (message);
+	}	// if (count != firsts [num])
+
+	QualifHelper::parallelFor (num, num, [&] (size_t first, size_t last)
+	{
+		for (size_t k = first; k < last; k++)
+		{
+			T*			o	= out + firsts [k];
+			const char*	p	= bounds [k];
+			const char*	e	= bounds [k + 1];
+			while (true)
+			{
+				p	= skipSpaces (p, e);
+				if (p >= e)
+					break;
+				const char*	tokenEnd	= p;
+				while ((tokenEnd < e) && (false == isSpace (*tokenEnd)))
+					tokenEnd++;
+				Parsed	value;
+				parseNumber (p, tokenEnd, value);
+				*o++	= (T)value;
+				p		= tokenEnd;
+			}	// while (true)
+		}	// for (size_t k = first; k < last; k++)
+	});
+}	// parseAsciiValues
+
+
+/**
+ * La table de décodage base 64 : valeur de chaque caractère, -1 s'il est
+ * invalide.
+ */
+struct Base64Table
+{
+	signed char	values [256];
+};	// struct Base64Table
+
+
+static Base64Table base64Table ( )
+{
+	const char*	alphabet	=
+			"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	Base64Table	table;
+	memset (table.values, -1, sizeof (table.values));
+	for (int i = 0; i < 64; i++)
+		table.values [(unsigned char)alphabet [i]]	= (signed char)i;
+	table.values [(unsigned char)'=']	= 0;
+
+	return table;
+}	// base64Table
+
+
+/**
+ * Décode les <I>chars</I> caractères base 64 débutant en <I>src</I> dans
+ * <I>out</I>, dans la limite de <I>outBytes</I> octets.
+ */
+static void decodeBase64 (const char* src, size_t chars, unsigned char* out,
+                          size_t outBytes, size_t threadsNum)
+{
+	// Initialisation unique et thread-safe (décodages parallèles) :
+	static const Base64Table	table	= base64Table ( );
+
+	if (0 != chars % 4)
+		throw Exception (UTF8String ("Données base 64 tronquées.", charset));
+	const size_t	groups	= chars / 4;
+	QualifHelper::parallelFor (
+				groups, chars < parallelThreshold ? 1 : threadsNum,
+				[=] (size_t begin, size_t end)
+	{
+		for (size_t g = begin; g < end; g++)
+		{
+			const unsigned char*	c		= (const unsigned char*)src + 4 * g;
+			const int				v0		= table.values [c [0]];
+			const int				v1		= table.values [c [1]];
+			const int				v2		= table.values [c [2]];
+			const int				v3		= table.values [c [3]];
+			if ((0 > v0) || (0 > v1) || (0 > v2) || (0 > v3))
+				throw Exception (UTF8String ("Caractère base 64 invalide.", charset));
+			const uint32_t			bits	= (v0 << 18) | (v1 << 12) | (v2 << 6) | v3;
+			const size_t			o		= 3 * g;
+			if (o < outBytes)
+				out [o]		= (unsigned char)(bits >> 16);
+			if (o + 1 < outBytes)
+				out [o + 1]	= (unsigned char)(bits >> 8);
+			if (o + 2 < outBytes)
+				out [o + 2]	= (unsigned char)bits;
+		}	// for (size_t g = begin; g < end; g++)
+	});
+}	// decodeBase64
+
+
+static size_t base64Length (size_t bytes)
+{
+	return 4 * ((bytes + 2) / 3);
+}	// base64Length
+
+
+// ============================================================================
+//                          LA STRUCTURE VtkMeshArrays
+// ============================================================================
+
+VtkMeshArrays::VtkMeshArrays ( )
+	: nodesNum (0), cellsNum (0), floatCoordinates ( ), doubleCoordinates ( ),
+	  connectivity ( ), offsets ( ), types ( )
+{
+}	// VtkMeshArrays::VtkMeshArrays
+
+
+void VtkMeshArrays::clear ( )
+{
+	nodesNum	= cellsNum	= 0;
+	vector<float> ( ).swap (floatCoordinates);
+	vector<double> ( ).swap (doubleCoordinates);
+	vector<int64_t> ( ).swap (connectivity);
+	vector<int64_t> ( ).swap (offsets);
+	vector<unsigned char> ( ).swap (types);
+}	// VtkMeshArrays::clear
+
+
+// ============================================================================
+//                           LA CLASSE VtkFileReader
+// ============================================================================
+
+VtkFileReader::VtkFileReader (const string& fileName, size_t threadsNum)
+	: _fileName (fileName),
+	  _threadsNum (QualifHelper::getThreadsNum (threadsNum)),
+	  _data (0), _size (0)
+{
+
+	const int	fd	= open (fileName.c_str ( ), O_RDONLY);
+	struct stat	status;
+	if ((-1 == fd) || (0 != fstat (fd, &status)) || (0 == status.st_size))
+	{
+		if (-1 != fd)
+			close (fd);
+		UTF8String	message (charset);
+		message << "Impossibilité d'ouvrir le fichier " << fileName
+		        << " en lecture, ou fichier vide.";
+		throw Exception (message);
+	}	// if ((-1 == fd) || ...
+	void*	data	= mmap (0, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close (fd);
+	if (MAP_FAILED == data)
+	{
+		UTF8String	message (charset);
+		message << "Impossibilité de projeter en mémoire le fichier "
+		        << fileName << ".";
+		throw Exception (message);
+	}	// if (MAP_FAILED == data)
+	_data	= (const char*)data;
+	_size	= status.st_size;
+}	// VtkFileReader::VtkFileReader
+
+
+VtkFileReader::VtkFileReader (const VtkFileReader&)
+	: _fileName ( ), _threadsNum (0), _data (0), _size (0)
+{
+	assert (0 && "VtkFileReader copy constructor is not allowed.");
+}	// VtkFileReader::VtkFileReader
+
+
+VtkFileReader& VtkFileReader::operator = (const VtkFileReader&)
+{
+	assert (0 && "VtkFileReader assignment operator is not allowed.");
+	return *this;
+}	// VtkFileReader::operator =
+
+
+VtkFileReader::~VtkFileReader ( )
+{
+	if (0 != _data)
+		munmap ((void*)_data, _size);
+}	// VtkFileReader::~VtkFileReader
+
+
+VtkFileReader::FORMAT VtkFileReader::getFormat ( ) const
+{
+	const char*	end	= _data + _size;
+	const char*	p	= _data;
+	if ((3 <= _size) && (0 == memcmp (p, "\xEF\xBB\xBF", 3)))	// BOM
+		p	+= 3;
+	p	= skipSpaces (p, end);
+
+	if ((size_t)(end - p) >= 14 && (0 == strncmp (p, "# vtk DataFile", 14)))
+	{
+		nextLine (p, end);	// Version
+		nextLine (p, end);	// Titre
+		const string	type	= toUpper (nextLine (p, end));
+		if (0 == type.compare (0, 6, "BINARY"))
+			return LEGACY_BINARY;
+		if (0 == type.compare (0, 5, "ASCII"))
+			return LEGACY_ASCII;
+		return UNKNOWN_FORMAT;
+	}	// if ((size_t)(end - p) >= 14 && ...
+	if (((size_t)(end - p) >= 5) && (0 == strncmp (p, "<?xml", 5)))
+		return XML_FORMAT;
+	if (((size_t)(end - p) >= 8) && (0 == strncmp (p, "<VTKFile", 8)))
+		return XML_FORMAT;
+
+	return UNKNOWN_FORMAT;
+}	// VtkFileReader::getFormat
+
+
+bool VtkFileReader::read (VtkMeshArrays& arrays)
+{
+	// Les threads liront simultanément différentes parties du fichier :
+	madvise ((void*)_data, _size, MADV_WILLNEED);
+	if (false == read (arrays, ALL_CONTENTS))
+		return false;
+
+	// Contrôle de cohérence, sans quoi des accès hors des tableaux seraient
+	// effectués lors de l'analyse :
+	const size_t	coordinatesNum	= arrays.floatCoordinates.empty ( ) ?
+			arrays.doubleCoordinates.size ( ) : arrays.floatCoordinates.size ( );
+	bool	valid	= (3 * arrays.nodesNum == coordinatesNum) &&
+			(arrays.cellsNum + 1 == arrays.offsets.size ( )) &&
+			(arrays.cellsNum == arrays.types.size ( )) &&
+			(0 == arrays.offsets [0]) &&
+			((size_t)arrays.offsets [arrays.cellsNum] == arrays.connectivity.size ( ));
+	for (size_t c = 0; (true == valid) && (c < arrays.cellsNum); c++)
+		valid	= arrays.offsets [c] <= arrays.offsets [c + 1];
+	if (false == valid)
+	{
+		arrays.clear ( );
+		UTF8String	message (charset);
+		message << "Le fichier " << _fileName
+		        << " décrit un maillage incohérent (nombre de noeuds, de "
+		        << "mailles ou connectivité).";
+		throw Exception (message);
+	}	// if (false == valid)
+
+	return true;
+}	// VtkFileReader::read
+
+
+bool VtkFileReader::scan (VtkMeshArrays& arrays)
+{
+	if (false == read (arrays, TYPES_CONTENTS))
+		return false;
+
+	if (arrays.cellsNum != arrays.types.size ( ))
+	{
+		arrays.clear ( );
+		UTF8String	message (charset);
+		message << "Le fichier " << _fileName
+		        << " décrit un maillage incohérent (nombre de mailles).";
+		throw Exception (message);
+	}	// if (arrays.cellsNum != arrays.types.size ( ))
+
+	return true;
+}	// VtkFileReader::scan
+
+
+bool VtkFileReader::readPoints (VtkMeshArrays& arrays)
+{
+	if (false == read (arrays, POINTS_CONTENTS))
+		return false;
+
+	const size_t	coordinatesNum	= arrays.floatCoordinates.empty ( ) ?
+			arrays.doubleCoordinates.size ( ) : arrays.floatCoordinates.size ( );
+	if (3 * arrays.nodesNum != coordinatesNum)
+	{
+		arrays.clear ( );
+		UTF8String	message (charset);
+		message << "Le fichier " << _fileName
+		        << " décrit un maillage incohérent (nombre de noeuds).";
+		throw Exception (message);
+	}	// if (3 * arrays.nodesNum != coordinatesNum)
+
+	return true;
+}	// VtkFileReader::readPoints
+
+
+bool VtkFileReader::read (VtkMeshArrays& arrays, CONTENTS contents)
+{
+	arrays.clear ( );
+	bool	done	= false;
+	switch (getFormat ( ))
+	{
+		case LEGACY_ASCII	:
+		case LEGACY_BINARY	: done	= readLegacy (arrays, contents);	break;
+		case XML_FORMAT		: done	= readXml (arrays, contents);		break;
+		default				:
+		{
+			UTF8String	message (charset);
+			message << "Le fichier " << _fileName
+			        << " n'est pas un fichier VTK valide.";
+			throw Exception (message);
+		}
+	}	// switch (getFormat ( ))
+	if (false == done)
+		arrays.clear ( );
+
+	return done;
+}	// VtkFileReader::read
+
+
+/**
+ * Vérifie, avant toute allocation, que la fin du fichier peut contenir un
+ * tableau <I>legacy</I> débutant en <I>p</I> de <I>count</I> n-uplets de
+ * <I>components</I> valeurs de type <I>type</I> : en binaire la taille de ces
+ * valeurs, en ASCII autant de nombres séparés par des blancs. Les nombres lus
+ * dans l'en-tête pouvant être quelconques, les calculs sont faits sans
+ * débordement.
+ * @exception	Une exception est levée si le fichier est tronqué.
+ */
+static void checkLegacyArray (
+		const char* p, const char* end, bool binary, SCALAR_TYPE type,
+		size_t count, size_t components, const string& what)
+{
+	const size_t	remaining	= p < end ? (size_t)(end - p) : 0;
+	const size_t	size		= true == binary ? scalarSize (type) : 2;
+	const size_t	available	= true == binary ? remaining : remaining + 1;
+	if ((0 == size) || (count > available / size / components))
+	{
+		UTF8String	message (charset);
+		message << "Fichier tronqué ou type invalide pour " << what << ".";
+		throw Exception (message);
+	}	// if ((0 == size) || ...
+}	// checkLegacyArray
+
+
+/**
+ * Lit <I>count</I> valeurs de type <I>type</I> d'un tableau <I>legacy</I>
+ * débutant en <I>p</I>, positionné en retour après ce tableau.
+ */
+template <typename T> static void readLegacyArray (
+		const char*& p, const char* end, bool binary, SCALAR_TYPE type,
+		size_t count, T* out, size_t threadsNum, const string& what)
+{
+	if (true == binary)
+	{
+		const size_t	size	= scalarSize (type);
+		checkLegacyArray (p, end, binary, type, count, 1, what);
+		// Les données binaires legacy sont grand-boutistes :
+		convertArray ((const unsigned char*)p, type, count, isLittleEndian ( ),
+		              out, threadsNum);
+		p	+= count * size;
+	}	// if (true == binary)
+	else
+	{
+		const char*	last	= nextKeyword (p, end);
+		parseAsciiValues (p, last, count, out, threadsNum, what);
+		p	= last;
+	}	// else if (true == binary)
+}	// readLegacyArray
+
+
+/**
+ * Saute les <I>count</I> valeurs de type <I>type</I> d'un tableau
+ * <I>legacy</I> débutant en <I>p</I>, positionné en retour après ce tableau.
+ * Les données binaires ne sont pas lues.
+ */
+static void skipLegacyArray (
+		const char*& p, const char* end, bool binary, SCALAR_TYPE type,
+		size_t count, const string& what)
+{
+	if (true == binary)
+	{
+		checkLegacyArray (p, end, binary, type, count, 1, what);
+		p	+= count * scalarSize (type);
+	}	// if (true == binary)
+	else
+		p	= nextKeyword (p, end);
+}	// skipLegacyArray
+
+
+bool VtkFileReader::readLegacy (VtkMeshArrays& arrays, CONTENTS contents)
+{
+	const char*		end		= _data + _size;
+	const char*		p		= skipSpaces (_data, end);
+	if ((3 <= _size) && (0 == memcmp (_data, "\xEF\xBB\xBF", 3)))
+		p	= skipSpaces (_data + 3, end);
+	const string	header	= nextLine (p, end);
+	int				major	= 0,	minor	= 0;
+	const size_t	pos		= header.find ("Version");
+	if ((string::npos != pos) &&
+	    (2 != sscanf (header.c_str ( ) + pos + 7, "%d.%d", &major, &minor)))
+		major	= minor	= 0;
+	const bool		v51		= (5 < major) || ((5 == major) && (1 <= minor));
+	nextLine (p, end);	// Titre
+	const bool		binary	=
+			0 == toUpper (nextLine (p, end)).compare (0, 6, "BINARY");
+
+	bool	dataset	= false;
+	size_t	connectivitySize	= 0;
+	while (p < end)
+	{
+		p	= skipSpaces (p, end);
+		if (p >= end)
+			break;
+		const string	line	= nextLine (p, end);
+		istringstream	stream (line);
+		string			keyword, type;
+		size_t			n	= 0,	size	= 0;
+		stream >> keyword;
+		keyword	= toUpper (keyword);
+
+		if ("DATASET" == keyword)
+		{
+			stream >> type;
+			if ("UNSTRUCTURED_GRID" != toUpper (type))
+				return false;
+			dataset	= true;
+		}	// if ("DATASET" == keyword)
+		else if (false == dataset)
+			return false;
+		else if ("POINTS" == keyword)
+		{
+			stream >> n >> type;
+			const SCALAR_TYPE	st	= scalarType (type);
+			if ((true == stream.fail ( )) || (UNKNOWN_SCALAR == st))
+				return false;
+			arrays.nodesNum	= n;
+			checkLegacyArray (p, end, binary, st, n, 3, "POINTS");
+			if (TYPES_CONTENTS == contents)
+				skipLegacyArray (p, end, binary, st, 3 * n, "POINTS");
+			else if (FLOAT32 == st)
+			{
+				arrays.floatCoordinates.resize (3 * n);
+				readLegacyArray (p, end, binary, st, 3 * n,
+				        arrays.floatCoordinates.data ( ), _threadsNum, "POINTS");
+			}
+			else
+			{
+				arrays.doubleCoordinates.resize (3 * n);
+				readLegacyArray (p, end, binary, st, 3 * n,
+				        arrays.doubleCoordinates.data ( ), _threadsNum, "POINTS");
+			}
+			// Les mailles suivent, inutile de les parcourir :
+			if (POINTS_CONTENTS == contents)
+				return true;
+		}	// if ("POINTS" == keyword)
+		else if ("CELLS" == keyword)
+		{
+			stream >> n >> size;
+			if (true == stream.fail ( ))
+				return false;
+			if (true == v51)
+			{	// Suivent les sections OFFSETS et CONNECTIVITY :
+				arrays.cellsNum		= 0 == n ? 0 : n - 1;
+				connectivitySize	= size;
+			}	// if (true == v51)
+			else if (ALL_CONTENTS != contents)
+			{
+				arrays.cellsNum	= n;
+				skipLegacyArray (p, end, binary, INT32, size, "CELLS");
+			}	// else if (ALL_CONTENTS != contents)
+			else
+			{	// n mailles décrites par [nombre de noeuds, noeuds ...] :
+				checkLegacyArray (p, end, binary, INT32, size, 1, "CELLS");
+				if (n > size)
+				{
+					UTF8String	message (charset);
+					message << "Section CELLS invalide dans le fichier "
+					        << _fileName << ".";
+					throw Exception (message);
+				}	// if (n > size)
+				vector<int64_t>	cells (size);
+				readLegacyArray (p, end, binary, INT32, size, cells.data ( ),
+				                 _threadsNum, "CELLS");
+				arrays.cellsNum	= n;
+				arrays.offsets.resize (n + 1);
+				arrays.connectivity.resize (size >= n ? size - n : 0);
+				size_t	k	= 0,	offset	= 0;
+				for (size_t c = 0; c < n; c++)
+				{
+					const int64_t	nodesNum	= k < size ? cells [k++] : -1;
+					if ((0 > nodesNum) || (k + nodesNum > size))
+					{
+						UTF8String	message (charset);
+						message << "Section CELLS invalide dans le fichier "
+						        << _fileName << ".";
+						throw Exception (message);
+					}	// if ((0 > nodesNum) || ...
+					arrays.offsets [c]	= offset;
+					memcpy (arrays.connectivity.data ( ) + offset,
+					        cells.data ( ) + k, nodesNum * sizeof (int64_t));
+					offset	+= nodesNum;
+					k		+= nodesNum;
+				}	// for (size_t c = 0; c < n; c++)
+				arrays.offsets [n]	= offset;
+			}	// else if (true == v51)
+		}	// if ("CELLS" == keyword)
+		else if ("OFFSETS" == keyword)
+		{
+			stream >> type;
+			if (ALL_CONTENTS != contents)
+			{
+				skipLegacyArray (p, end, binary, scalarType (type),
+				                 arrays.cellsNum + 1, "OFFSETS");
+				continue;
+			}	// if (ALL_CONTENTS != contents)
+			checkLegacyArray (p, end, binary, scalarType (type),
+			                  arrays.cellsNum + 1, 1, "OFFSETS");
+			arrays.offsets.resize (arrays.cellsNum + 1);
+			readLegacyArray (p, end, binary, scalarType (type),
+			                 arrays.cellsNum + 1, arrays.offsets.data ( ),
+			                 _threadsNum, "OFFSETS");
+		}	// if ("OFFSETS" == keyword)
+		else if ("CONNECTIVITY" == keyword)
+		{
+			stream >> type;
+			if (ALL_CONTENTS != contents)
+			{
+				skipLegacyArray (p, end, binary, scalarType (type),
+				                 connectivitySize, "CONNECTIVITY");
+				continue;
+			}	// if (ALL_CONTENTS != contents)
+			checkLegacyArray (p, end, binary, scalarType (type),
+			                  connectivitySize, 1, "CONNECTIVITY");
+			arrays.connectivity.resize (connectivitySize);
+			readLegacyArray (p, end, binary, scalarType (type),
+			                 connectivitySize, arrays.connectivity.data ( ),
+			                 _threadsNum, "CONNECTIVITY");
+		}	// if ("CONNECTIVITY" == keyword)
+		else if ("CELL_TYPES" == keyword)
+		{
+			stream >> n;
+			if (POINTS_CONTENTS == contents)
+			{
+				skipLegacyArray (p, end, binary, INT32, n, "CELL_TYPES");
+				continue;
+			}	// if (POINTS_CONTENTS == contents)
+			checkLegacyArray (p, end, binary, INT32, n, 1, "CELL_TYPES");
+			arrays.types.resize (n);
+			readLegacyArray (p, end, binary, INT32, n, arrays.types.data ( ),
+			                 _threadsNum, "CELL_TYPES");
+		}	// if ("CELL_TYPES" == keyword)
+		else if ("METADATA" == keyword)
+		{	// Informations terminées par une ligne vide :
+			while (p < end)
+				if (string::npos ==
+				    nextLine (p, end).find_first_not_of (" \t\r"))
+					break;
+		}	// if ("METADATA" == keyword)
+		else if (("POINT_DATA" == keyword) || ("CELL_DATA" == keyword))
+			break;	// Données non utilisées par l'analyse
+		else
+			return false;	// FIELD, ...
+	}	// while (p < end)
+
+	return true == dataset;
+}	// VtkFileReader::readLegacy
+
+
+/**
+ * Balise XML : nom et attributs.
+ */
+struct XmlTag
+{
+	string				name;
+	map<string, string>	attributes;
+	bool				closing, empty;
+
+	string attribute (const string& key, const string& def = string ( )) const
+	{
+		map<string, string>::const_iterator	it	= attributes.find (key);
+		return attributes.end ( ) == it ? def : it->second;
+	}
+};	// struct XmlTag
+
+
+/**
+ * Lit la prochaine balise située entre <I>p</I> et <I>end</I> (commentaires
+ * et instructions exclus). En retour <I>p</I> est positionné après la balise.
+ * @return		<I>false</I> s'il n'y a plus de balise.
+ */
+static bool nextTag (const char*& p, const char* end, XmlTag& tag)
+{
+	while (true)
+	{
+		p	= (const char*)memchr (p, '<', end - p);
+		if (0 == p)
+		{
+			p	= end;
+			return false;
+		}	// if (0 == p)
+		if ((p + 1 < end) && (('?' == p [1]) || ('!' == p [1])))
+		{
+			const char*	close	= findString (p, end, '!' == p [1] ? "-->" : ">");
+			p	= 0 == close ? end : close + 1;
+			continue;
+		}	// if ((p + 1 < end) && ...
+		break;
+	}	// while (true)
+
+	const char*	close	= (const char*)memchr (p, '>', end - p);
+	if (0 == close)
+		throw Exception (UTF8String ("Balise XML non terminée.", charset));
+	const char*	q	= p + 1;
+	tag.closing		= (q < close) && ('/' == *q);
+	tag.empty		= '/' == close [-1];
+	tag.attributes.clear ( );
+	if (true == tag.closing)
+		q++;
+	const char*	nameEnd	= q;
+	while ((nameEnd < close) && (false == isSpace (*nameEnd)) &&
+	       ('/' != *nameEnd))
+		nameEnd++;
+	tag.name.assign (q, nameEnd);
+	q	= nameEnd;
+	while (q < close)
+	{
+		q	= skipSpaces (q, close);
+		const char*	equal	= (const char*)memchr (q, '=', close - q);
+		if (0 == equal)
+			break;
+		const char*	keyEnd	= equal;
+		while ((keyEnd > q) && (true == isSpace (keyEnd [-1])))
+			keyEnd--;
+		const char*	quote	= skipSpaces (equal + 1, close);
+		if ((quote >= close) || (('"' != *quote) && ('\'' != *quote)))
+			throw Exception (UTF8String ("Attribut XML invalide.", charset));
+		const char*	valueEnd	=
+				(const char*)memchr (quote + 1, *quote, close - quote - 1);
+		if (0 == valueEnd)
+			throw Exception (UTF8String ("Attribut XML invalide.", charset));
+		tag.attributes [string (q, keyEnd)]	= string (quote + 1, valueEnd);
+		q	= valueEnd + 1;
+	}	// while (q < close)
+	p	= close + 1;
+
+	return true;
+}	// nextTag
+
+
+/**
+ * Tableau de données XML (<I>DataArray</I>).
+ */
+struct XmlArray
+{
+	XmlArray ( )
+		: found (false), type ( ), format ( ), components (1), offset (0),
+		  begin (0), end (0)
+	{ }
+
+	bool		found;
+	string		type, format;
+	size_t		components, offset;
+	/** Contenu de la balise (formats ascii et binary). */
+	const char	*begin, *end;
+};	// struct XmlArray
+
+
+/**
+ * Le contexte de décodage des tableaux de données XML.
+ */
+struct XmlContext
+{
+	size_t		headerSize;
+	bool		swap, zlib, base64Appended;
+	const char	*appended, *end;
+	size_t		threadsNum;
+	string		fileName;
+};	// struct XmlContext
+
+
+static uint64_t loadHeader (const unsigned char* p, const XmlContext& context)
+{
+	return 4 == context.headerSize ?
+	       loadValue<uint32_t> (p, context.swap) :
+	       loadValue<uint64_t> (p, context.swap);
+}	// loadHeader
+
+
+static void throwTruncated (const XmlContext& context)
+{
+	UTF8String	message (charset);
+	message << "Données tronquées ou invalides dans le fichier "
+	        << context.fileName << ".";
+	throw Exception (message);
+}	// throwTruncated
+
+
+/**
+ * Décode un bloc de données binaires (éventuellement en base 64 et/ou
+ * compressé) débutant en <I>src</I>.
+ * @return		Les <I>bytes</I> octets décodés, soit directement dans le
+ * 				fichier, soit dans <I>buffer</I>.
+ */
+static const unsigned char* decodeBlock (
+		const char* src, const char* srcEnd, bool base64, size_t bytes,
+		vector<unsigned char>& buffer, const XmlContext& context)
+{
+	const size_t	hs	= context.headerSize;
+	if (false == context.zlib)
+	{	// [nombre d'octets][données]
+		if (false == base64)
+		{
+			if ((size_t)(srcEnd - src) < hs + bytes)
+				throwTruncated (context);
+			if (loadHeader ((const unsigned char*)src, context) < bytes)
+				throwTruncated (context);
+			return (const unsigned char*)src + hs;
+		}	// if (false == base64)
+		const size_t	chars	= base64Length (hs + bytes);
+		if ((size_t)(srcEnd - src) < chars)
+			throwTruncated (context);
+		buffer.resize (hs + bytes);
+		decodeBase64 (src, chars, buffer.data ( ), hs + bytes,
+		              context.threadsNum);
+		if (loadHeader (buffer.data ( ), context) < bytes)
+			throwTruncated (context);
+		return buffer.data ( ) + hs;
+	}	// if (false == context.zlib)
+
+#ifdef USE_ZLIB
+	// [nombre de blocs][taille des blocs][taille du dernier bloc]
+	// [tailles compressées des blocs][blocs compressés]
+	// En base 64 l'entête et les blocs sont encodés séparément.
+	vector<unsigned char>	header;
+	const unsigned char*	headerData	= (const unsigned char*)src;
+	size_t					blocksNum	= 0;
+	if (true == base64)
+	{
+		header.resize (3 * hs);
+		if ((size_t)(srcEnd - src) < base64Length (hs))
+			throwTruncated (context);
+		decodeBase64 (src, base64Length (hs), header.data ( ), hs, 1);
+		blocksNum	= loadHeader (header.data ( ), context);
+		const size_t	headerBytes	= (3 + blocksNum) * hs;
+		if ((size_t)(srcEnd - src) < base64Length (headerBytes))
+			throwTruncated (context);
+		header.resize (headerBytes);
+		decodeBase64 (src, base64Length (headerBytes), header.data ( ),
+		              headerBytes, 1);
+		headerData	= header.data ( );
+		src			+= base64Length (headerBytes);
+	}	// if (true == base64)
+	else
+	{
+		if ((size_t)(srcEnd - src) < 3 * hs)
+			throwTruncated (context);
+		blocksNum	= loadHeader (headerData, context);
+		if ((size_t)(srcEnd - src) < (3 + blocksNum) * hs)
+			throwTruncated (context);
+		src	+= (3 + blocksNum) * hs;
+	}	// else if (true == base64)
+	const size_t	blockSize	= loadHeader (headerData + hs, context);
+	const size_t	lastSize	= loadHeader (headerData + 2 * hs, context);
+	vector<size_t>	compressedOffsets (blocksNum + 1, 0);
+	for (size_t b = 0; b < blocksNum; b++)
+		compressedOffsets [b + 1]	= compressedOffsets [b] +
+				loadHeader (headerData + (3 + b) * hs, context);
+	const size_t	total	= 0 == blocksNum ? 0 : (blocksNum - 1) * blockSize +
+				(0 == lastSize ? blockSize : lastSize);
+	if (total < bytes)
+		throwTruncated (context);
+
+	vector<unsigned char>	decoded;
+	const unsigned char*	compressed	= (const unsigned char*)src;
+	if (true == base64)
+	{
+		const size_t	chars	= base64Length (compressedOffsets [blocksNum]);
+		if ((size_t)(srcEnd - src) < chars)
+			throwTruncated (context);
+		decoded.resize (compressedOffsets [blocksNum]);
+		decodeBase64 (src, chars, decoded.data ( ), decoded.size ( ),
+		              context.threadsNum);
+		compressed	= decoded.data ( );
+	}	// if (true == base64)
+	else if ((size_t)(srcEnd - src) < compressedOffsets [blocksNum])
+		throwTruncated (context);
+
+	buffer.resize (total);
+	unsigned char*	out	= buffer.data ( );
+	QualifHelper::parallelFor (blocksNum, context.threadsNum,
+	                           [&] (size_t first, size_t last)
+	{
+		for (size_t b = first; b < last; b++)
+		{
+			const size_t	expected	= b + 1 == blocksNum ?
+								total - b * blockSize : blockSize;
+			uLongf			length		= expected;
+			if ((Z_OK != uncompress (out + b * blockSize, &length,
+			                compressed + compressedOffsets [b],
+			                compressedOffsets [b + 1] - compressedOffsets [b]))
+			    || (expected != length))
+				throw Exception (UTF8String (
+						"Erreur lors de la décompression (zlib) de données.",
+						charset));
+		}	// for (size_t b = first; b < last; b++)
+	});
+
+	return buffer.data ( );
+#else	// USE_ZLIB
+	throwTruncated (context);
+	return 0;
+#endif	// USE_ZLIB
+}	// decodeBlock
+
+
+/**
+ * Décode les <I>count</I> valeurs du tableau <I>array</I> dans <I>out</I>.
+ * @return		<I>false</I> si le format du tableau n'est pas supporté.
+ */
+template <typename T> static bool decodeXmlArray (
+		const XmlArray& array, size_t count, T* out, const XmlContext& context,
+		const string& what)
+{
+	const SCALAR_TYPE	type	= scalarType (array.type);
+	if (UNKNOWN_SCALAR == type)
+		return false;
+
+	if ("ascii" == array.format)
+	{
+		parseAsciiValues (array.begin, array.end, count, out,
+		                  context.threadsNum, what);
+		return true;
+	}	// if ("ascii" == array.format)
+
+	const char*	src		= 0;
+	const char*	srcEnd	= 0;
+	bool		base64	= true;
+	if ("binary" == array.format)
+	{
+		src		= skipSpaces (array.begin, array.end);
+		srcEnd	= array.end;
+	}	// if ("binary" == array.format)
+	else if (("appended" == array.format) && (0 != context.appended))
+	{
+		if (array.offset > (size_t)(context.end - context.appended))
+			throwTruncated (context);
+		src		= context.appended + array.offset;
+		srcEnd	= context.end;
+		base64	= context.base64Appended;
+	}	// if ("appended" == array.format)
+	else
+		return false;
+
+	vector<unsigned char>	buffer;
+	const unsigned char*	data	= decodeBlock (src, srcEnd, base64,
+								count * scalarSize (type), buffer, context);
+	convertArray (data, type, count, context.swap, out, context.threadsNum);
+
+	return true;
+}	// decodeXmlArray
+
+
+bool VtkFileReader::readXml (VtkMeshArrays& arrays, CONTENTS contents)
+{
+	const char*	end			= _data + _size;
+	const char*	appended	= findString (_data, end, "<AppendedData");
+	const char*	headerEnd	= 0 == appended ? end : appended;
+
+	XmlContext	context;
+	context.headerSize		= 4;
+	context.swap			= false;
+	context.zlib			= false;
+	context.base64Appended	= false;
+	context.appended		= 0;
+	context.end				= end;
+	context.threadsNum		= _threadsNum;
+	context.fileName		= _fileName;
+
+	XmlTag		tag;
+	const char*	p			= _data;
+	size_t		piecesNum	= 0;
+	enum { OTHER, POINTS, CELLS }	section	= OTHER;
+	XmlArray	points, connectivity, offsets, types;
+	while (true == nextTag (p, headerEnd, tag))
+	{
+		if (true == tag.closing)
+		{
+			if (("Points" == tag.name) || ("Cells" == tag.name))
+				section	= OTHER;
+			continue;
+		}	// if (true == tag.closing)
+
+		if ("VTKFile" == tag.name)
+		{
+			if ("UnstructuredGrid" != tag.attribute ("type"))
+				return false;
+			context.swap	= ("BigEndian" == tag.attribute ("byte_order")) ==
+			                  isLittleEndian ( );
+			context.headerSize	=
+				"UInt64" == tag.attribute ("header_type", "UInt32") ? 8 : 4;
+			const string	compressor	= tag.attribute ("compressor");
+			if ("vtkZLibDataCompressor" == compressor)
+			{
+#ifdef USE_ZLIB
+				context.zlib	= true;
+#else	// USE_ZLIB
+				return false;
+#endif	// USE_ZLIB
+			}
+			else if (false == compressor.empty ( ))
+				return false;	// LZ4, LZMA
+		}	// if ("VTKFile" == tag.name)
+		else if ("Piece" == tag.name)
+		{
+			if (1 < ++piecesNum)
+				return false;
+			arrays.nodesNum	= strtoull (
+						tag.attribute ("NumberOfPoints", "0").c_str ( ), 0, 10);
+			arrays.cellsNum	= strtoull (
+						tag.attribute ("NumberOfCells", "0").c_str ( ), 0, 10);
+		}	// if ("Piece" == tag.name)
+		else if (("Points" == tag.name) && (false == tag.empty))
+			section	= POINTS;
+		else if (("Cells" == tag.name) && (false == tag.empty))
+			section	= CELLS;
+		else if ("DataArray" == tag.name)
+		{
+			XmlArray*		array	= 0;
+			const string	name	= tag.attribute ("Name");
+			if ((POINTS == section) && (false == points.found))
+				array	= &points;
+			else if (CELLS == section)
+				array	= "connectivity" == name ? &connectivity :
+				          "offsets" == name ? &offsets :
+				          "types" == name ? &types : 0;
+			if (0 == array)
+				continue;
+			array->found		= true;
+			array->type			= tag.attribute ("type");
+			array->format		= tag.attribute ("format");
+			array->components	= strtoull (
+				tag.attribute ("NumberOfComponents", "1").c_str ( ), 0, 10);
+			array->offset		= strtoull (
+				tag.attribute ("offset", "0").c_str ( ), 0, 10);
+			if (false == tag.empty)
+			{
+				array->begin	= p;
+				array->end		= findString (p, headerEnd, "</DataArray>");
+				if (0 == array->end)
+					throwTruncated (context);
+				p	= array->end;
+			}	// if (false == tag.empty)
+		}	// if ("DataArray" == tag.name)
+	}	// while (true == nextTag (p, headerEnd, tag))
+
+	if ((1 != piecesNum) || (false == points.found) ||
+	    (3 != points.components))
+		return false;
+	if ((POINTS_CONTENTS != contents) && ((false == connectivity.found) ||
+	    (false == offsets.found) || (false == types.found)))
+		return false;
+
+	if (0 != appended)
+	{	// <AppendedData encoding="raw|base64"> _données
+		p	= appended;
+		if (false == nextTag (p, end, tag))
+			throwTruncated (context);
+		context.base64Appended	= "base64" == tag.attribute ("encoding");
+		p	= skipSpaces (p, end);
+		if ((p >= end) || ('_' != *p))
+			throwTruncated (context);
+		context.appended	= p + 1;
+	}	// if (0 != appended)
+
+	if (TYPES_CONTENTS == contents)
+	{
+		arrays.types.resize (arrays.cellsNum);
+		return decodeXmlArray (
+				types, arrays.cellsNum, arrays.types.data ( ), context, "types");
+	}	// if (TYPES_CONTENTS == contents)
+
+	if (ALL_CONTENTS == contents)
+	{
+		// Les décalages XML sont ceux de fin de maille :
+		arrays.offsets.resize (arrays.cellsNum + 1);
+		arrays.offsets [0]	= 0;
+		if (false == decodeXmlArray (offsets, arrays.cellsNum,
+		                    arrays.offsets.data ( ) + 1, context, "offsets"))
+			return false;
+		const int64_t	connectivitySize	= arrays.offsets [arrays.cellsNum];
+		if (0 > connectivitySize)
+			throwTruncated (context);
+		arrays.connectivity.resize (connectivitySize);
+		arrays.types.resize (arrays.cellsNum);
+		if ((false == decodeXmlArray (connectivity, connectivitySize,
+		                arrays.connectivity.data ( ), context, "connectivity")) ||
+		    (false == decodeXmlArray (types, arrays.cellsNum,
+		                arrays.types.data ( ), context, "types")))
+			return false;
+	}	// if (ALL_CONTENTS == contents)
+	if ("Float32" == points.type)
+	{
+		arrays.floatCoordinates.resize (3 * arrays.nodesNum);
+		return decodeXmlArray (points, 3 * arrays.nodesNum,
+		            arrays.floatCoordinates.data ( ), context, "Points");
+	}	// if ("Float32" == points.type)
+	arrays.doubleCoordinates.resize (3 * arrays.nodesNum);
+
+	return decodeXmlArray (points, 3 * arrays.nodesNum,
+	            arrays.doubleCoordinates.data ( ), context, "Points");
+}	// VtkFileReader::readXml
+
+
+}	// namespace GQualif
@@ -9,8 +9,14 @@
 #include <TkUtil/MemoryError.h>
 #include <TkUtil/UTF8String.h>
 
+#include <vtkCellArray.h>
 #include <vtkCellType.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkPoints.h>
+#include <vtkUnsignedCharArray.h>
 #include <vtkUnstructuredGridReader.h>
+#include <vtkXMLUnstructuredGridReader.h>
 
 /*#ifdef VTK_8
 #include <vtkAutoInit.h>
@@ -33,7 +39,7 @@ namespace GQualif
 
 VtkQualifSerie::VtkQualifSerie (const string& fileName, const string& name)
 	: AbstractQualifSerieAdapter (fileName, name, 3),
-	  _mesh (0), _cell (0)
+	  _mesh (0), _cell (0), _arraySerie ( ), _arrays ( )
 {
 	try
 	{
@@ -51,6 +57,38 @@ VtkQualifSerie::VtkQualifSerie (const string& fileName, const string& name)
 			        << "pas accessible en lecture.";
 			throw Exception (message);
 		}	// if (false == file.isReadable ( ))
+		_cell	= vtkGenericCell::New ( );
+
+		// Lecture rapide, sans VTK :
+		if (true == loadArrays ( ))
+			return;
+
+		if (VtkFileReader::XML_FORMAT ==
+						VtkFileReader (fileName, 1).getFormat ( ))
+		{
+			vtkXMLUnstructuredGridReader*	reader	=
+									vtkXMLUnstructuredGridReader::New ( );
+			CHECK_NULL_PTR_ERROR (reader)
+			if (0 == reader->CanReadFile (fileName.c_str ( )))
+			{
+				reader->Delete ( );		reader	= 0;
+				UTF8String	message (charset);
+				message << "Le fichier " << fileName
+				        << " ne contient pas un maillage VTK de type supporté."
+				        << "\n" << "Types supportés : "
+				        << "vtkUnstructuredGrid";
+				throw Exception (message);
+			}	// if (0 == reader->CanReadFile (fileName.c_str ( )))
+			reader->SetFileName (fileName.c_str ( ));
+			reader->Update ( );
+			_mesh	= reader->GetOutput ( );
+			CHECK_NULL_PTR_ERROR (_mesh)
+			_mesh->Register (0);
+			reader->Delete ( );		reader	= 0;
+			initializeDirectAccess ( );
+			return;
+		}	// if (VtkFileReader::XML_FORMAT == ...
+
 		 vtkUnstructuredGridReader*	reader	= vtkUnstructuredGridReader::New( );
 		CHECK_NULL_PTR_ERROR (reader)
 		reader->SetFileName (fileName.c_str ( ));
@@ -71,7 +109,7 @@ VtkQualifSerie::VtkQualifSerie (const string& fileName, const string& name)
 #endif	// VTK_5
 		reader->Delete ( );		reader	= 0;
 
-		_cell	= vtkGenericCell::New ( );
+		initializeDirectAccess ( );
 	}
 	catch (const Exception& e)
 	{
@@ -98,7 +136,7 @@ VtkQualifSerie::VtkQualifSerie (const string& fileName, const string& name)
 VtkQualifSerie::VtkQualifSerie (
 		vtkUnstructuredGrid& mesh, const string& name, const string& fileName)
 	: AbstractQualifSerieAdapter (fileName, name, 3),
-	  _mesh (&mesh), _cell (0)
+	  _mesh (&mesh), _cell (0), _arraySerie ( ), _arrays ( )
 {
 	if (0 != _mesh)
 	{
@@ -109,13 +147,14 @@ VtkQualifSerie::VtkQualifSerie (
 	}	// if (0 != _mesh)
 
 	_cell	= vtkGenericCell::New ( );
+	initializeDirectAccess ( );
 }	// VtkQualifSerie::VtkQualifSerie
 
 
 VtkQualifSerie::VtkQualifSerie (const VtkQualifSerie&)
 	: AbstractQualifSerieAdapter (
 						"Invalid file name", "Invalid name", (unsigned char)-1),
-	  _mesh (0), _cell (0)
+	  _mesh (0), _cell (0), _arraySerie ( ), _arrays ( )
 {
 	assert (0 && "VtkQualifSerie copy constructor is not allowed.");
 }	// VtkQualifSerie::VtkQualifSerie
@@ -130,6 +169,8 @@ VtkQualifSerie& VtkQualifSerie::operator = (const VtkQualifSerie&)
 
 VtkQualifSerie::~VtkQualifSerie ( )
 {
+	_arraySerie.reset ( );
+	_arrays.reset ( );
 	if (0 != _mesh)
 		_mesh->UnRegister (0);
 	_mesh	= 0;
@@ -141,6 +182,8 @@ VtkQualifSerie::~VtkQualifSerie ( )
 
 size_t VtkQualifSerie::getCellCount ( ) const
 {
+	if (0 != _arraySerie.get ( ))
+		return _arraySerie->getCellCount ( );
 	if (0 == _mesh)
 	{
 		INTERNAL_ERROR (exc, "Absence de groupe de mailles.", "VtkQualifSerie::getCellCount")
@@ -163,6 +206,10 @@ Qualif::Maille& VtkQualifSerie::getCell (size_t i) const
 
 	try
 	{
+		// Accès direct aux tableaux du maillage :
+		if (0 != _arraySerie.get ( ))
+			return _arraySerie->getCell (i);
+
 		CHECK_NULL_PTR_ERROR (_mesh)
 		CHECK_NULL_PTR_ERROR (_cell)
 		_mesh->GetCell (i, _cell);
@@ -286,6 +333,9 @@ size_t VtkQualifSerie::getCellType (size_t i) const
 
 	try
 	{
+		// Accès direct aux tableaux du maillage :
+		if (0 != _arraySerie.get ( ))
+			return _arraySerie->getCellType (i);
 
 		CHECK_NULL_PTR_ERROR (_cell)
 		CHECK_NULL_PTR_ERROR (_mesh)
@@ -355,6 +405,76 @@ size_t VtkQualifSerie::getCellType (size_t i) const
 }	// VtkQualifSerie::getCellType
 
 
+size_t VtkQualifSerie::evaluateCriterion (
+				Qualif::Critere criterion, size_t cellTypes,
+				size_t first, size_t last,
+				double* values, unsigned char* status) const
+{
+	if (0 != _arraySerie.get ( ))
+		return _arraySerie->evaluateCriterion (
+						criterion, cellTypes, first, last, values, status);
+
+	return AbstractQualifSerieAdapter::evaluateCriterion (
+						criterion, cellTypes, first, last, values, status);
+}	// VtkQualifSerie::evaluateCriterion
+
+
+double VtkQualifSerie::computeEvaluationOrder (size_t threadsNum, bool renumber)
+{
+	if (0 == _arraySerie.get ( ))
+		return AbstractQualifSerieAdapter::computeEvaluationOrder (
+														threadsNum, renumber);
+
+	const double	time	=
+				_arraySerie->computeEvaluationOrder (threadsNum, renumber);
+	AbstractQualifSerieAdapter::setEvaluationOrder (
+										_arraySerie->getEvaluationOrder ( ));
+
+	return time;
+}	// VtkQualifSerie::computeEvaluationOrder
+
+
+void VtkQualifSerie::setEvaluationOrder (const vector<size_t>& order)
+{
+	AbstractQualifSerieAdapter::setEvaluationOrder (order);
+	if (0 != _arraySerie.get ( ))
+		_arraySerie->setEvaluationOrder (order);
+}	// VtkQualifSerie::setEvaluationOrder
+
+
+void VtkQualifSerie::releaseEvaluationOrder ( )
+{
+	AbstractQualifSerieAdapter::releaseEvaluationOrder ( );
+	if (0 != _arraySerie.get ( ))
+		_arraySerie->releaseEvaluationOrder ( );
+}	// VtkQualifSerie::releaseEvaluationOrder
+
+
+double VtkQualifSerie::getEvaluationOrderTime ( ) const
+{
+	if (0 != _arraySerie.get ( ))
+		return _arraySerie->getEvaluationOrderTime ( );
+
+	return AbstractQualifSerieAdapter::getEvaluationOrderTime ( );
+}	// VtkQualifSerie::getEvaluationOrderTime
+
+
+void VtkQualifSerie::getCellCentroid (
+						size_t i, double& x, double& y, double& z) const
+{
+	if (0 != _arraySerie.get ( ))
+		_arraySerie->getCellCentroid (i, x, y, z);
+	else
+		AbstractQualifSerieAdapter::getCellCentroid (i, x, y, z);
+}	// VtkQualifSerie::getCellCentroid
+
+
+bool VtkQualifSerie::isCentroidReentrant ( ) const
+{
+	return 0 != _arraySerie.get ( );
+}	// VtkQualifSerie::isCentroidReentrant
+
+
 bool VtkQualifSerie::isVolumic ( ) const
 {
 	try
@@ -380,6 +500,139 @@ bool VtkQualifSerie::isThreadable ( ) const
 }	// VtkQualifSerie::isThreadable ( )
 
 
+bool VtkQualifSerie::hasDirectAccess ( ) const
+{
+	return 0 != _arraySerie.get ( );
+}	// VtkQualifSerie::hasDirectAccess
+
+
+void VtkQualifSerie::initializeDirectAccess ( )
+{
+	_arraySerie.reset ( );
+
+#if VTK_MAJOR_VERSION >= 9
+	// Les tableaux des décalages et de la connectivité de vtkCellArray ne sont
+	// disponibles qu'à partir de VTK 9. Auparavant le nombre de noeuds de
+	// chaque maille précède ses noeuds => API générique.
+	try
+	{
+		if ((0 == _mesh) || (0 == _mesh->GetPoints ( )) ||
+		    (0 == _mesh->GetCells ( )) || (0 == _mesh->GetCellTypesArray ( )))
+			return;
+
+		const size_t			cellsNum	= _mesh->GetNumberOfCells ( );
+		const size_t			nodesNum	= _mesh->GetNumberOfPoints ( );
+		vtkUnsignedCharArray*	typesArray	= _mesh->GetCellTypesArray ( );
+		if ((size_t)typesArray->GetNumberOfTuples ( ) < cellsNum)
+			return;
+		const unsigned char*	types		=
+							0 == cellsNum ? 0 : typesArray->GetPointer (0);
+		// Les polygones, bandes de triangles, ... relèvent de l'API générique :
+		for (size_t c = 0; c < cellsNum; c++)
+			if (0 == ArrayQualifSerie::nodesNum (types [c]))
+				return;
+
+		unique_ptr<ArrayQualifSerie>	serie (
+				new ArrayQualifSerie (getName ( ), 3, getFileName ( )));
+		vtkDataArray*	coordinates	= _mesh->GetPoints ( )->GetData ( );
+		if ((0 == coordinates) || (3 != coordinates->GetNumberOfComponents ( )))
+			return;
+		vtkFloatArray*	floatCoordinates	=
+								vtkFloatArray::SafeDownCast (coordinates);
+		vtkDoubleArray*	doubleCoordinates	=
+								vtkDoubleArray::SafeDownCast (coordinates);
+		if (0 != floatCoordinates)
+			serie->setCoordinates (
+				0 == nodesNum ? 0 : floatCoordinates->GetPointer (0), nodesNum);
+		else if (0 != doubleCoordinates)
+			serie->setCoordinates (
+				0 == nodesNum ? 0 : doubleCoordinates->GetPointer (0), nodesNum);
+		else
+			return;
+
+		vtkCellArray*	cells	= _mesh->GetCells ( );
+		if (0 == cellsNum)
+			serie->setCells (0, (const int64_t*)0, (const int64_t*)0, types);
+		else if (true == cells->IsStorage64Bit ( ))
+			serie->setCells (cellsNum,
+				reinterpret_cast<const int64_t*>(
+						cells->GetConnectivityArray64 ( )->GetPointer (0)),
+				reinterpret_cast<const int64_t*>(
+						cells->GetOffsetsArray64 ( )->GetPointer (0)),
+				types);
+		else
+			serie->setCells (cellsNum,
+				reinterpret_cast<const int32_t*>(
+						cells->GetConnectivityArray32 ( )->GetPointer (0)),
+				reinterpret_cast<const int32_t*>(
+						cells->GetOffsetsArray32 ( )->GetPointer (0)),
+				types);
+
+		_arraySerie.reset (serie.release ( ));
+	}
+	catch (...)
+	{	// L'API générique reste utilisable.
+		_arraySerie.reset ( );
+	}
+#endif	// VTK_MAJOR_VERSION >= 9
+}	// VtkQualifSerie::initializeDirectAccess
+
+
+QualifGroupMetadata VtkQualifSerie::getMetadata (const string& fileName)
+{
+	QualifGroupMetadata	metadata ("", 2);
+	VtkMeshArrays		arrays;
+	VtkFileReader		reader (fileName, 1);
+	if (false == reader.scan (arrays))
+		return metadata;
+
+	metadata.cellsNum	= 0;
+	for (vector<unsigned char>::const_iterator itt = arrays.types.begin ( );
+	     arrays.types.end ( ) != itt; itt++)
+	{
+		const size_t	type	= ArrayQualifSerie::qualifType (*itt);
+		metadata.addCells (type);
+		if ((QualifHelper::TETRAEDRON == type) ||
+		    (QualifHelper::PYRAMID == type) ||
+		    (QualifHelper::TRIANGULAR_PRISM == type) ||
+		    (QualifHelper::HEXAEDRON == type))
+			metadata.dimension	= 3;
+	}	// for (vector<unsigned char>::const_iterator itt = ...
+
+	return metadata;
+}	// VtkQualifSerie::getMetadata
+
+
+bool VtkQualifSerie::loadArrays ( )
+{
+	unique_ptr<VtkMeshArrays>	arrays (new VtkMeshArrays ( ));
+	VtkFileReader				reader (getFileName ( ));
+	if (false == reader.read (*arrays))
+		return false;
+	// Les polygones, ... relèvent de l'API générique de VTK :
+	for (vector<unsigned char>::const_iterator itt = arrays->types.begin ( );
+	     arrays->types.end ( ) != itt; itt++)
+		if (0 == ArrayQualifSerie::nodesNum (*itt))
+			return false;
+
+	unique_ptr<ArrayQualifSerie>	serie (
+				new ArrayQualifSerie (getName ( ), 3, getFileName ( )));
+	if (false == arrays->floatCoordinates.empty ( ))
+		serie->setCoordinates (
+					arrays->floatCoordinates.data ( ), arrays->nodesNum);
+	else
+		serie->setCoordinates (
+					arrays->doubleCoordinates.data ( ), arrays->nodesNum);
+	serie->setCells (arrays->cellsNum, arrays->connectivity.data ( ),
+	                 arrays->offsets.data ( ), arrays->types.data ( ));
+
+	_arrays.reset (arrays.release ( ));
+	_arraySerie.reset (serie.release ( ));
+
+	return true;
+}	// VtkQualifSerie::loadArrays
+
+
 
 }	// namespace GQualif
 
@@ -0,0 +1,139 @@
+#include "GQVtk/VtkTimeStepsSource.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/UTF8String.h>
+
+#include <assert.h>
+
+
+USING_UTIL
+USING_STD
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                         LA CLASSE VtkTimeStepsSource
+// ============================================================================
+
+VtkTimeStepsSource::VtkTimeStepsSource (
+						const vector<string>& fileNames, size_t threadsNum)
+	: QualifTimeStepsSource ( ),
+	  _fileNames (fileNames), _threadsNum (threadsNum), _topology ( ),
+	  _topologyRead (false)
+{
+}	// VtkTimeStepsSource::VtkTimeStepsSource
+
+
+VtkTimeStepsSource::VtkTimeStepsSource (const VtkTimeStepsSource&)
+	: QualifTimeStepsSource ( ),
+	  _fileNames ( ), _threadsNum (1), _topology ( ), _topologyRead (false)
+{
+	assert (0 && "VtkTimeStepsSource copy constructor is not allowed.");
+}	// VtkTimeStepsSource::VtkTimeStepsSource
+
+
+VtkTimeStepsSource& VtkTimeStepsSource::operator = (const VtkTimeStepsSource&)
+{
+	assert (0 && "VtkTimeStepsSource assignment operator is not allowed.");
+	return *this;
+}	// VtkTimeStepsSource::operator =
+
+
+VtkTimeStepsSource::~VtkTimeStepsSource ( )
+{
+}	// VtkTimeStepsSource::~VtkTimeStepsSource
+
+
+const vector<string>& VtkTimeStepsSource::getFileNames ( ) const
+{
+	return _fileNames;
+}	// VtkTimeStepsSource::getFileNames
+
+
+size_t VtkTimeStepsSource::getStepsNum ( ) const
+{
+	return _fileNames.size ( );
+}	// VtkTimeStepsSource::getStepsNum
+
+
+string VtkTimeStepsSource::getStepName (size_t step) const
+{
+	return step < _fileNames.size ( ) ?
+	       _fileNames [step] : QualifTimeStepsSource::getStepName (step);
+}	// VtkTimeStepsSource::getStepName
+
+
+void VtkTimeStepsSource::initializeCells (ArrayQualifSerie& serie)
+{
+	if (true == _fileNames.empty ( ))
+	{
+		UTF8String	error (charset);
+		error << "Série " << serie.getName ( )
+		      << " : absence de fichier de pas de temps.";
+		throw Exception (error);
+	}	// if (true == _fileNames.empty ( ))
+
+	if (false == _topologyRead)
+	{
+		VtkFileReader	reader (_fileNames [0], _threadsNum);
+		if (false == reader.read (_topology))
+		{
+			UTF8String	error (charset);
+			error << "Le fichier " << _fileNames [0] << " fait appel à des "
+			      << "fonctionnalités non supportées par VtkFileReader.";
+			throw Exception (error);
+		}	// if (false == reader.read (_topology))
+		// Les coordonnées sont lues à chaque pas de temps :
+		vector<float> ( ).swap (_topology.floatCoordinates);
+		vector<double> ( ).swap (_topology.doubleCoordinates);
+		_topologyRead	= true;
+	}	// if (false == _topologyRead)
+
+	serie.setCells (_topology.cellsNum, _topology.connectivity.data ( ),
+	                _topology.offsets.data ( ), _topology.types.data ( ));
+}	// VtkTimeStepsSource::initializeCells
+
+
+void VtkTimeStepsSource::readStep (
+						size_t step, QualifStepCoordinates& coordinates)
+{
+	if (step >= _fileNames.size ( ))
+	{
+		UTF8String	error (charset);
+		error << "VtkTimeStepsSource::readStep : pas de temps invalide ("
+		      << (unsigned long)step << "), " << (unsigned long)_fileNames.size ( )
+		      << " fichiers.";
+		throw Exception (error);
+	}	// if (step >= _fileNames.size ( ))
+
+	VtkFileReader	reader (_fileNames [step], _threadsNum);
+	VtkMeshArrays	arrays;
+	if (false == reader.readPoints (arrays))
+	{
+		UTF8String	error (charset);
+		error << "Le fichier " << _fileNames [step] << " fait appel à des "
+		      << "fonctionnalités non supportées par VtkFileReader.";
+		throw Exception (error);
+	}	// if (false == reader.readPoints (arrays))
+	if ((true == _topologyRead) && (arrays.nodesNum != _topology.nodesNum))
+	{
+		UTF8String	error (charset);
+		error << "Le fichier " << _fileNames [step] << " comporte "
+		      << (unsigned long)arrays.nodesNum << " noeuds, contre "
+		      << (unsigned long)_topology.nodesNum << " pour le fichier "
+		      << _fileNames [0] << ".";
+		throw Exception (error);
+	}	// if ((true == _topologyRead) && ...
+
+	coordinates.nodesNum	= arrays.nodesNum;
+	coordinates.stride		= 3;
+	coordinates.floatCoordinates.swap (arrays.floatCoordinates);
+	coordinates.doubleCoordinates.swap (arrays.doubleCoordinates);
+}	// VtkTimeStepsSource::readStep
+
+
+}	// namespace GQualif
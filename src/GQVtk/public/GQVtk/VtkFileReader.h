@@ -0,0 +1,162 @@
+#ifndef VTK_FILE_READER_H
+#define VTK_FILE_READER_H
+
+#include <TkUtil/util_config.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * Les tableaux décrivant un maillage non structuré, tels que lus par
+ * <I>VtkFileReader</I> : coordonnées des noeuds (simple ou double précision
+ * selon le fichier), connectivité, décalages (<I>cellsNum + 1</I> valeurs) et
+ * types <I>VTK</I> des mailles.
+ * @see		ArrayQualifSerie
+ */
+struct VtkMeshArrays
+{
+	VtkMeshArrays ( );
+
+	/**
+	 * Libère la mémoire.
+	 */
+	void clear ( );
+
+	size_t						nodesNum, cellsNum;
+	/** Seul l'un des deux tableaux de coordonnées est renseigné. */
+	IN_STD vector<float>		floatCoordinates;
+	IN_STD vector<double>		doubleCoordinates;
+	IN_STD vector<int64_t>		connectivity, offsets;
+	IN_STD vector<unsigned char>	types;
+};	// struct VtkMeshArrays
+
+
+/**
+ * <P>Lecteur rapide de maillages non structurés <I>VTK</I>, ne chargeant que
+ * les noeuds, la connectivité et les types des mailles (les données aux
+ * noeuds et aux mailles sont ignorées), sans recourir à <I>VTK</I>.
+ * </P>
+ *
+ * <P>Formats supportés :
+ * <UL>
+ * <LI><I>VTK legacy</I> binaire : le fichier est projeté en mémoire
+ * (<I>mmap</I>), la conversion (grand-boutiste) est parallélisée,
+ * <LI><I>VTK legacy</I> ASCII : la lecture des nombres est répartie entre
+ * plusieurs threads (<I>std::from_chars</I>),
+ * <LI><I>VTK XML</I> (<I>.vtu</I>, une seule pièce) : données <I>ascii</I>,
+ * <I>binary</I> (base 64) ou <I>appended</I> (brutes ou base 64),
+ * éventuellement compressées par <I>zlib</I> (décompression parallèle des
+ * blocs, nécessite que <I>GQVtk</I> soit compilé avec <I>zlib</I>),
+ * </UL>
+ * Les versions 5.1 et antérieures du format <I>legacy</I> sont supportées.
+ * </P>
+ *
+ * <P>Lorsque le fichier utilise des fonctionnalités non supportées
+ * (plusieurs pièces, compresseur <I>LZ4</I> ou <I>LZMA</I>, données de champ
+ * préalables aux noeuds, ...) la méthode <I>read</I> retourne <I>false</I>, à
+ * charge pour l'appelant de recourir aux lecteurs de <I>VTK</I>.
+ * </P>
+ */
+class VtkFileReader
+{
+	public :
+
+	/**
+	 * Les formats de fichiers.
+	 */
+	enum FORMAT { UNKNOWN_FORMAT, LEGACY_ASCII, LEGACY_BINARY, XML_FORMAT };
+
+	/**
+	 * Constructeur. Projette le fichier en mémoire.
+	 * @param		Nom du fichier à lire.
+	 * @param		Nombre de threads utilisés (0 : nombre de processeurs).
+	 * @exception	Une exception est levée si le fichier ne peut être ouvert.
+	 */
+	VtkFileReader (const IN_STD string& fileName, size_t threadsNum = 0);
+
+	/**
+	 * Destructeur. Libère la projection en mémoire du fichier.
+	 */
+	~VtkFileReader ( );
+
+	/**
+	 * @return		Le format du fichier, déterminé d'après son contenu.
+	 */
+	FORMAT getFormat ( ) const;
+
+	/**
+	 * Lit le maillage.
+	 * @param		En retour, les tableaux décrivant le maillage.
+	 * @return		<I>true</I> en cas de succès, <I>false</I> si le fichier
+	 * 				fait appel à des fonctionnalités non supportées.
+	 * @exception	Une exception est levée si le fichier est invalide.
+	 */
+	bool read (VtkMeshArrays& arrays);
+
+	/**
+	 * Lecture rapide des seuls nombres de noeuds et de mailles et des types
+	 * des mailles, sans lecture des coordonnées ni de la connectivité (les
+	 * données binaires correspondantes ne sont pas parcourues).
+	 * @param		En retour, les tableaux décrivant le maillage, dont seul
+	 *				<I>types</I> est renseigné.
+	 * @return		<I>true</I> en cas de succès, <I>false</I> si le fichier
+	 * 				fait appel à des fonctionnalités non supportées.
+	 * @exception	Une exception est levée si le fichier est invalide.
+	 */
+	bool scan (VtkMeshArrays& arrays);
+
+	/**
+	 * Lecture des seules coordonnées des noeuds, sans lecture de la
+	 * connectivité ni des types des mailles (ex : pas de temps successifs
+	 * d'un maillage mobile de connectivité constante).
+	 * @param		En retour, les tableaux décrivant le maillage, dont seuls
+	 *				<I>nodesNum</I> et les coordonnées sont renseignés.
+	 * @return		<I>true</I> en cas de succès, <I>false</I> si le fichier
+	 * 				fait appel à des fonctionnalités non supportées.
+	 * @exception	Une exception est levée si le fichier est invalide.
+	 */
+	bool readPoints (VtkMeshArrays& arrays);
+
+
+	private :
+
+	/**
+	 * Les données lues : toutes, types des mailles seuls, coordonnées des
+	 * noeuds seules.
+	 */
+	enum CONTENTS { ALL_CONTENTS, TYPES_CONTENTS, POINTS_CONTENTS };
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	VtkFileReader (const VtkFileReader&);
+	VtkFileReader& operator = (const VtkFileReader&);
+
+	/**
+	 * Lecture des formats <I>legacy</I> et <I>XML</I>, éventuellement
+	 * restreinte aux types des mailles ou aux coordonnées des noeuds
+	 * (<I>contents</I>).
+	 */
+	bool read (VtkMeshArrays& arrays, CONTENTS contents);
+	bool readLegacy (VtkMeshArrays& arrays, CONTENTS contents);
+	bool readXml (VtkMeshArrays& arrays, CONTENTS contents);
+
+	/** Le nom du fichier. */
+	IN_STD string			_fileName;
+
+	/** Le nombre de threads utilisés. */
+	size_t					_threadsNum;
+
+	/** Le contenu du fichier, projeté en mémoire. */
+	const char*				_data;
+	size_t					_size;
+};	// class VtkFileReader
+
+}	// namespace GQualif
+
+#endif	// VTK_FILE_READER_H
@@ -2,6 +2,9 @@
 #define VTK_QUALIF_SERIE_H
 
 #include "GQualif/AbstractQualifSerieAdapter.h"
+#include "GQualif/ArrayQualifSerie.h"
+#include "GQualif/QualifGroupMetadata.h"
+#include "GQVtk/VtkFileReader.h"
 
 #include <vtkUnstructuredGrid.h>
 #include <vtkGenericCell.h>
@@ -24,15 +27,35 @@ namespace GQualif
  * à soumettre à <I>Qualif</I> en vue d'être analysée (ex : surface composée de
  * polygones, ...).</P>
  *
+ * <P>Lorsque c'est possible (<I>VTK 9</I> et plus, coordonnées de type
+ * <I>float</I> ou <I>double</I>, mailles toutes de types supportés par
+ * <I>Qualif</I>) les mailles sont directement lues dans les tableaux des
+ * coordonnées, de la connectivité, des décalages et des types du maillage, via
+ * une instance de <I>ArrayQualifSerie</I>, sans passer par
+ * <I>vtkGenericCell</I>. Les autres cas (polygones, ...) sont traités par
+ * l'API générique de <I>VTK</I>.
+ * </P>
+ *
+ * <P>Les fichiers sont lus, lorsque c'est possible, par <I>VtkFileReader</I>
+ * (lecture parallèle des formats <I>legacy</I> ASCII et binaire, et
+ * <I>XML</I> <I>.vtu</I>) : les tableaux ainsi obtenus sont alors exploités
+ * directement, aucun maillage <I>VTK</I> n'étant construit. A défaut
+ * (fonctionnalités non supportées par ce lecteur) ce sont les lecteurs de
+ * <I>VTK</I> qui sont utilisés.
+ * </P>
+ *
  * @warning		Seuls les maillages <I>VTK</I> non structurés sont actuellement
  * 				supportés.
+ * @warning		Le maillage ne doit pas être modifié durant la durée de vie
+ * 				de la série.
  */
 class VtkQualifSerie : public AbstractQualifSerieAdapter
 {
 	public :
 
 	/**
-	 * Constructeur 1. Charge les données depuis le fichier <I>fileName</I>.
+	 * Constructeur 1. Charge les données depuis le fichier <I>fileName</I>
+	 * (formats <I>VTK legacy</I> ou <I>XML</I> <I>.vtu</I>).
 	 * Les données du maillage seront détruites lors de la destruction de cette
 	 * série.
 	 * @param		Nom du fichier d'où est chargée la série.
@@ -77,6 +100,34 @@ class VtkQualifSerie : public AbstractQualifSerieAdapter
 	 */
 	virtual size_t getCellType (size_t i) const;
 
+	/**
+	 * Evalue le critère pour les mailles [first, last[. En cas d'accès
+	 * direct aux tableaux du maillage l'évaluation est déléguée à la série
+	 * <I>ArrayQualifSerie</I> associée (chaîne d'évaluation spécialisée par
+	 * type de maille).
+	 * @see			AbstractQualifSerie::evaluateCriterion
+	 * @see			hasDirectAccess
+	 */
+	virtual size_t evaluateCriterion (
+				Qualif::Critere criterion, size_t cellTypes,
+				size_t first, size_t last,
+				double* values, unsigned char* status) const;
+
+	/**
+	 * En cas d'accès direct aux tableaux du maillage l'ordre est calculé
+	 * par la série <I>ArrayQualifSerie</I> associée, et partagé avec
+	 * elle.
+	 * @see			AbstractQualifSerie::computeEvaluationOrder
+	 */
+	virtual double computeEvaluationOrder (
+							size_t threadsNum = 0, bool renumber = false);
+	virtual void setEvaluationOrder (const IN_STD vector<size_t>& order);
+	virtual void releaseEvaluationOrder ( );
+	virtual double getEvaluationOrderTime ( ) const;
+	virtual void getCellCentroid (
+						size_t i, double& x, double& y, double& z) const;
+	virtual bool isCentroidReentrant ( ) const;
+
 	/**
 	 * @return		<I>true</I> si les mailles de la série sont volumiques,
 	 *				savoir si ce sont des polyèdres.
@@ -89,6 +140,25 @@ class VtkQualifSerie : public AbstractQualifSerieAdapter
 	 */
 	virtual bool isThreadable ( ) const;
 
+	/**
+	 * @return		<I>true</I> si les mailles sont directement lues dans les
+	 * 				tableaux du maillage, <I>false</I> si elles le sont via
+	 * 				l'API générique de <I>VTK</I>.
+	 */
+	virtual bool hasDirectAccess ( ) const;
+
+	/**
+	 * @return		La description sommaire du maillage contenu dans le
+	 * 				fichier transmis en argument, obtenue sans lecture des
+	 * 				coordonnées ni de la connectivité (seuls les types des
+	 * 				mailles sont lus). Le nombre de mailles est
+	 * 				<I>QualifGroupMetadata::UNKNOWN</I> si le fichier n'est pas
+	 * 				lisible par <I>VtkFileReader</I>.
+	 * @exception	Une exception est levée si le fichier est invalide.
+	 * @see			VtkFileReader::scan
+	 */
+	static QualifGroupMetadata getMetadata (const IN_STD string& fileName);
+
 
 	protected :
 
@@ -101,12 +171,31 @@ class VtkQualifSerie : public AbstractQualifSerieAdapter
 	VtkQualifSerie (const VtkQualifSerie&);
 	VtkQualifSerie& operator = (const VtkQualifSerie&);
 
-	/** Le maillage représenté. */
+	/**
+	 * Initialise, si possible, l'accès direct aux tableaux du maillage.
+	 */
+	void initializeDirectAccess ( );
+
+	/**
+	 * Charge, si possible, le fichier via <I>VtkFileReader</I>.
+	 * @return		<I>true</I> en cas de succès, <I>false</I> s'il faut
+	 * 				recourir aux lecteurs de <I>VTK</I>.
+	 */
+	bool loadArrays ( );
+
+	/** Le maillage représenté. Nul si le fichier a été chargé par
+	 * <I>VtkFileReader</I>. */
 	// mutable car VTK ne sait pas trop ce que c'est que "const".
 	mutable vtkUnstructuredGrid*				_mesh;
 
 	/** Pour une bonne gestion des accès concurrents. */
 	vtkGenericCell*								_cell;
+
+	/** L'éventuel accès direct aux tableaux du maillage. */
+	IN_STD unique_ptr<ArrayQualifSerie>			_arraySerie;
+
+	/** Les éventuels tableaux lus par <I>VtkFileReader</I>. */
+	IN_STD unique_ptr<VtkMeshArrays>			_arrays;
 };	// class VtkQualifSerie
 
 }	// namespace GQualif
@@ -0,0 +1,106 @@
+#ifndef VTK_TIME_STEPS_SOURCE_H
+#define VTK_TIME_STEPS_SOURCE_H
+
+#include "GQVtk/VtkFileReader.h"
+#include "GQualif/TimeSeriesQualifSerie.h"
+
+#include <string>
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Pas de temps d'un maillage mobile enregistrés dans des fichiers
+ * <I>VTK</I> non structurés (un fichier par pas de temps, de même
+ * connectivité), lus par <I>VtkFileReader</I>.
+ * </P>
+ *
+ * <P>La connectivité et les types des mailles ne sont lus qu'une fois, dans
+ * le premier fichier (<I>initializeCells</I>). Seules les coordonnées des
+ * noeuds sont ensuite lues pour chaque pas de temps, les données binaires de
+ * la connectivité n'étant pas parcourues.
+ * </P>
+ *
+ * @see		TimeSeriesQualifSerie
+ * @see		QualifTimeSeriesTask
+ */
+class VtkTimeStepsSource : public QualifTimeStepsSource
+{
+	public :
+
+	/**
+	 * Constructeur.
+	 * @param		Noms des fichiers, un par pas de temps, dans l'ordre des
+	 * 				pas de temps.
+	 * @param		Nombre de threads utilisés par la lecture d'un fichier
+	 * 				(0 : nombre de processeurs).
+	 */
+	VtkTimeStepsSource (const std::vector<IN_STD string>& fileNames,
+	                    size_t threadsNum = 1);
+
+	/**
+	 * Destructeur. RAS.
+	 */
+	virtual ~VtkTimeStepsSource ( );
+
+	/**
+	 * @return		Les noms des fichiers des pas de temps.
+	 */
+	virtual const std::vector<IN_STD string>& getFileNames ( ) const;
+
+	/**
+	 * @return		Le nombre de pas de temps.
+	 */
+	virtual size_t getStepsNum ( ) const;
+
+	/**
+	 * @return		Le nom du fichier du pas de temps transmis en argument.
+	 */
+	virtual IN_STD string getStepName (size_t step) const;
+
+	/**
+	 * Lit la connectivité et les types des mailles dans le fichier du premier
+	 * pas de temps et les affecte à la série transmise en argument. Ces
+	 * tableaux sont détenus par cette instance.
+	 * @exception	Une exception est levée s'il n'y a pas de pas de temps ou
+	 * 				si le fichier ne peut être lu.
+	 * @warning		Cette instance doit être utilisable pendant toute la durée
+	 * 				de vie de la série.
+	 */
+	virtual void initializeCells (ArrayQualifSerie& serie);
+
+	/**
+	 * Lit les seules coordonnées des noeuds du pas de temps transmis en
+	 * argument.
+	 * @exception	Une exception est levée si le fichier ne peut être lu ou si
+	 * 				son nombre de noeuds diffère de celui du premier pas de
+	 * 				temps.
+	 */
+	virtual void readStep (size_t step, QualifStepCoordinates& coordinates);
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	VtkTimeStepsSource (const VtkTimeStepsSource&);
+	VtkTimeStepsSource& operator = (const VtkTimeStepsSource&);
+
+	/** Les fichiers des pas de temps. */
+	std::vector<IN_STD string>		_fileNames;
+
+	/** Le nombre de threads utilisés par la lecture d'un fichier. */
+	size_t							_threadsNum;
+
+	/** La connectivité et les types des mailles, communs à tous les pas de
+	 * temps (coordonnées non conservées). */
+	VtkMeshArrays					_topology;
+	bool							_topologyRead;
+};	// class VtkTimeStepsSource
+
+}	// namespace GQualif
+
+#endif	// VTK_TIME_STEPS_SOURCE_H
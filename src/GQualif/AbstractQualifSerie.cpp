@@ -7,8 +7,14 @@
 #include <TkUtil/NumericServices.h>
 #include <TkUtil/UTF8String.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <assert.h>
+#include <stdint.h>
 
 #include <cmath>
 
@@ -19,9 +25,301 @@ using namespace Qualif;
 
 static const Charset	charset ("àéèùô");
 
+/** Nombre de mailles des paquets évalués par <I>getDataRange</I>. */
+static const size_t		evaluationChunkSize	= 4096;
+
+/** Date d'utilisation courante des données en cache (cf.
+ * <I>applyMemoryBudget</I>), et budget mémoire de ces données. */
+static atomic<size_t>	useDate (1);
+static atomic<size_t>	memoryBudget (0);
+
+/** Mode de stockage des valeurs des critères et erreur maximale tolérée en
+ * mode quantifié. */
+static atomic<int>		storageMode (GQualif::AbstractQualifSerie::FULL_STORAGE);
+static atomic<double>	storageMaxError (1. / 131070);
+
+/** Demande d'interruption des évaluations du thread courant (cf.
+ * <I>setInterruption</I>). */
+static thread_local function<bool ( )>	interruption;
+
+/** Nombre de pas de quantification sur 16 bits, et erreur relative
+ * correspondante (demi pas). */
+static const double		quantizationSteps	= 65535.;
+static const double		quantizationError	= 0.5 / quantizationSteps;
+
 namespace GQualif
 {
 
+// ============================================================================
+//                           FONCTIONS UTILITAIRES
+// ============================================================================
+
+/**
+ * @return		Les 21 bits de poids faible de <I>v</I> espacés de 2 bits
+ * 				(entrelacement des clés de Morton).
+ */
+static uint64_t spreadBits (uint64_t v)
+{
+	v	&= 0x1fffff;
+	v	= (v | v << 32) & 0x1f00000000ffffULL;
+	v	= (v | v << 16) & 0x1f0000ff0000ffULL;
+	v	= (v | v << 8)  & 0x100f00f00f00f00fULL;
+	v	= (v | v << 4)  & 0x10c30c30c30c30c3ULL;
+	v	= (v | v << 2)  & 0x1249249249249249ULL;
+
+	return v;
+}	// spreadBits
+
+
+/**
+ * @return		La coordonnée transmise en argument quantifiée sur 21 bits
+ * 				dans le domaine [min, min + extent].
+ */
+static uint64_t quantize (double value, double min, double extent)
+{
+	static const double	maxCode	= (double)0x1fffff;
+	const double		code	= 0. < extent ?
+								(value - min) / extent * maxCode : 0.;
+
+	return code <= 0. ? 0 : code >= maxCode ? 0x1fffff : (uint64_t)code;
+}	// quantize
+
+
+/**
+ * Trie <I>keys</I> en parallèle : tri par morceaux puis fusion.
+ */
+static void parallelSort (vector< pair<uint64_t, size_t> >& keys, size_t chunks)
+{
+	const size_t	count	= keys.size ( );
+	QualifHelper::parallelFor (chunks, chunks, [&] (size_t first, size_t last)
+	{
+		for (size_t k = first; k < last; k++)
+			sort (keys.begin ( ) + count * k / chunks,
+			      keys.begin ( ) + count * (k + 1) / chunks);
+	});
+	for (size_t width = 1; width < chunks; width *= 2)
+		QualifHelper::parallelFor ((chunks + 2 * width - 1) / (2 * width),
+		                           chunks, [&] (size_t first, size_t last)
+		{
+			for (size_t m = first; m < last; m++)
+			{
+				const size_t	k	= 2 * width * m;
+				if (k + width < chunks)
+					inplace_merge (keys.begin ( ) + count * k / chunks,
+					    keys.begin ( ) + count * (k + width) / chunks,
+					    keys.begin ( ) + count * min (k + 2 * width, chunks) / chunks);
+			}	// for (size_t m = first; m < last; m++)
+		});
+}	// parallelSort
+
+
+/**
+ * @return		La valeur <I>value</I> quantifiée sur 16 bits, avec pour
+ * 				origine <I>origin</I> et pour pas <I>step</I>.
+ */
+static uint16_t quantizeValue (double value, double origin, double step)
+{
+	if (0. >= step)
+		return 0;
+
+	const double	code	= floor ((value - origin) / step + 0.5);
+
+	return 0. > code ? 0 :
+	       quantizationSteps < code ? (uint16_t)quantizationSteps : (uint16_t)code;
+}	// quantizeValue
+
+
+/**
+ * @return		La mémoire nécessaire au stockage des valeurs du critère
+ * 				transmis en argument pour <I>count</I> mailles, selon le
+ * 				mode de stockage courant.
+ */
+static size_t storageSize (Critere criterion, size_t count)
+{
+	const size_t	bits	= (count + 7) / 8;
+	if (AbstractQualifSerie::QUANTIZED_STORAGE != storageMode)
+		return count * sizeof (double) + bits;
+	if (true == QualifHelper::isBinaryCriterion (criterion))
+		return 2 * bits;
+
+	return count * sizeof (uint16_t) + bits;
+}	// storageSize
+
+
+/**
+ * Evalue le critère pour toutes les mailles de la série, par paquets et dans
+ * son ordre d'évaluation, et transmet chaque valeur obtenue à
+ * <I>store (c, value)</I>, c étant l'indice de la maille.
+ * @param		En retour, <I>defined [c]</I> vaut <I>false</I> si le critère
+ * 				n'a pu être évalué pour la maille c.
+ * @param		En retour, les extrema des valeurs obtenues.
+ */
+template <typename F> static void evaluateCells (
+		const AbstractQualifSerie& serie, Critere criterion,
+		vector<bool>& defined, double& min, double& max, F store)
+{
+	const size_t	count	= serie.getCellCount ( );
+	vector<double>	chunk (evaluationChunkSize);
+	unsigned char	status [evaluationChunkSize];
+	min	= DBL_MAX;	max	= -DBL_MAX;
+	defined.assign (count, true);
+	for (size_t first = 0; first < count; first += evaluationChunkSize)
+	{
+		if ((interruption) && (true == interruption ( )))
+		{
+			UTF8String	msg (charset);
+			msg << "Evaluation du critère interrompue pour la série "
+			    << serie.getName ( ) << ".";
+			throw Exception (msg);
+		}	// if ((interruption) && (true == interruption ( )))
+		const size_t	last	= first + evaluationChunkSize < count ?
+								  first + evaluationChunkSize : count;
+		serie.evaluateCriterion (criterion, AbstractQualifSerie::ALL_TYPES,
+		                         first, last, &chunk [0], status);
+		for (size_t p = first; p < last; p++)
+		{
+			const size_t	c	= serie.getEvaluatedCell (p);
+			if (AbstractQualifSerie::CELL_EVALUATED != status [p - first])
+			{	// Certains types ne sont pas supportés (pentagone, ...).
+				// On ne s'arrête pas à ça.
+				defined [c]	= false;
+				continue;
+			}	// if (AbstractQualifSerie::CELL_EVALUATED != ...
+			const double	value	= chunk [p - first];
+			store (c, value);
+			min	= value < min ? value : min;
+			max	= value > max ? value : max;
+		}	// for (size_t p = first; p < last; p++)
+	}	// for (size_t first = 0; first < count; ...
+}	// evaluateCells
+
+
+/**
+ * Répartit en classes les mailles de rangs [first, last[ de la série, de
+ * valeurs <I>value (c)</I>, par paquets : sélection des mailles, valeurs, puis
+ * classes sans branchement, les mailles non retenues étant affectées à la
+ * classe supplémentaire <I>counts [classesNum]</I>.
+ * @param		Indices des mailles par rang (0 : la maille de rang p est la
+ * 				maille d'indice p).
+ * @param		Types des mailles (<I>AbstractQualifSerie::rebin</I>).
+ * @param		Mailles pour lesquelles le critère est défini.
+ * @param		Erreur maximale sur les valeurs. Si elle est non nulle les
+ * 				mailles dont la classe est ambiguë ne sont pas réparties mais
+ * 				ajoutées à <I>ambiguous</I>.
+ */
+template <typename F> static void binCells (
+		size_t first, size_t last, const size_t* indexes,
+		const unsigned char* types, size_t cellTypes,
+		const vector<bool>& defined, F value, double min, double max,
+		double classWidth, size_t classesNum, bool strict, double error,
+		vector<size_t>& counts, vector<size_t>& ambiguous)
+{
+	const unsigned char	all		= false == strict ? 1 : 0;
+	size_t			cells [evaluationChunkSize];
+	double			values [evaluationChunkSize];
+	size_t			classes [evaluationChunkSize];
+	unsigned char	selected [evaluationChunkSize];
+	for (size_t block = first; block < last; block += evaluationChunkSize)
+	{
+		const size_t	num	= block + evaluationChunkSize < last ?
+							  evaluationChunkSize : last - block;
+		for (size_t k = 0; k < num; k++)
+			cells [k]	= 0 == indexes ? block + k : indexes [block + k];
+		for (size_t k = 0; k < num; k++)
+			selected [k]	= (0 != (types [cells [k]] & cellTypes)) &&
+			                  (true == defined [cells [k]]) ? 1 : 0;
+		for (size_t k = 0; k < num; k++)
+			values [k]	= value (cells [k]);
+		for (size_t k = 0; k < num; k++)
+		{
+			const double		v		= values [k];
+			const unsigned char	inside	= (unsigned char)(v >= min) &
+										  (unsigned char)(v <= max);
+			const size_t		cl		= QualifHelper::getClassIndex (
+									v, min, classWidth, classesNum);
+			classes [k]	= 0 != (selected [k] & (all | inside)) ?
+						  cl : classesNum;
+		}	// for (size_t k = 0; k < num; k++)
+		if (0. != error)
+		{
+			for (size_t k = 0; k < num; k++)
+			{
+				if ((0 != selected [k]) && (true ==
+				    QualifHelper::isClassAmbiguous (
+								values [k], error, min, max, classWidth)))
+				{
+					classes [k]	= classesNum;
+					ambiguous.push_back (cells [k]);
+				}	// if ((0 != selected [k]) && ...
+			}	// for (size_t k = 0; k < num; k++)
+		}	// if (0. != error)
+		for (size_t k = 0; k < num; k++)
+			counts [classes [k]]++;
+	}	// for (size_t block = first; block < last; ...
+}	// binCells
+
+
+/**
+ * @return		Le représentant du groupe de la série d'indice <I>s</I>
+ * 				(<I>AbstractQualifSerie::groupSharingSeries</I>), <I>groups</I>
+ * 				associant à chaque série une série de son groupe d'indice
+ * 				inférieur ou égal (union-find).
+ */
+static size_t findGroup (vector<size_t>& groups, size_t s)
+{
+	while (groups [s] != s)
+	{
+		groups [s]	= groups [groups [s]];
+		s			= groups [s];
+	}	// while (groups [s] != s)
+
+	return s;
+}	// findGroup
+
+
+/**
+ * Les séries existantes, dont les données en cache sont soumises au budget
+ * mémoire (cf. <I>applyMemoryBudget</I>), et le mutex protégeant cette liste
+ * et les verrous des données en cache (<I>lockStoredData</I>).
+ */
+static set<AbstractQualifSerie*>& liveSeries ( )
+{
+	static set<AbstractQualifSerie*>	series;
+	return series;
+}	// liveSeries
+
+
+static mutex& liveSeriesMutex ( )
+{
+	static mutex	seriesMutex;
+	return seriesMutex;
+}	// liveSeriesMutex
+
+
+/**
+ * Donnée en cache candidate à la libération par <I>applyMemoryBudget</I> :
+ * valeurs d'un critère ou, si <I>classes</I> vaut <I>true</I>, index des
+ * mailles par classe.
+ */
+struct CachedData
+{
+	AbstractQualifSerie*	serie;
+	bool					classes;
+	Critere					criterion;
+	size_t					lastUse, bytes;
+
+	bool operator < (const CachedData& data) const
+	{ return lastUse < data.lastUse; }
+};	// struct CachedData
+
+
+// ============================================================================
+//                         LA CLASSE AbstractQualifSerie
+// ============================================================================
+
+const size_t	AbstractQualifSerie::ALL_TYPES	= (size_t)-1;
+
+
 AbstractQualifSerie::AbstractQualifSerie (
 			const string& fileName, const string& name, unsigned char dimension)
 	: _fileName (fileName), _name (name),
@@ -29,8 +327,15 @@ AbstractQualifSerie::AbstractQualifSerie (
 	  _coordinatesValidityEvaluated (false), _coordinatesValidity (false),
 	  _coordinatesValidityErrorMsg (charset),
 	  _storedValues ( ), _minValues ( ), _maxValues ( ),
-	  _storedValuesDefined ( ), _classesCellsIndexes ( )
+	  _storedValuesDefined ( ), _quantizedValues ( ), _quantizations ( ),
+	  _binaryValues ( ), _classesCellsIndexes ( ), _classesRequest ( ),
+	  _cellsTypes ( ),
+	  _lastUses ( ), _classesLastUse (0), _storedDataLocks (0),
+	  _lockedMemoryUsage (0), _revision (0),
+	  _evaluationOrder ( ), _evaluationOrderTime (0.)
 {
+	lock_guard<mutex>	lock (liveSeriesMutex ( ));
+	liveSeries ( ).insert (this);
 }	// AbstractQualifSerie::AbstractQualifSerie
 
 
@@ -40,9 +345,16 @@ AbstractQualifSerie::AbstractQualifSerie (const AbstractQualifSerie&)
 	  _coordinatesValidityEvaluated (false), _coordinatesValidity (false),
 	  _coordinatesValidityErrorMsg (charset),
 	  _storedValues ( ), _minValues ( ), _maxValues ( ),
-	  _storedValuesDefined ( ), _classesCellsIndexes ( )
+	  _storedValuesDefined ( ), _quantizedValues ( ), _quantizations ( ),
+	  _binaryValues ( ), _classesCellsIndexes ( ), _classesRequest ( ),
+	  _cellsTypes ( ),
+	  _lastUses ( ), _classesLastUse (0), _storedDataLocks (0),
+	  _lockedMemoryUsage (0), _revision (0),
+	  _evaluationOrder ( ), _evaluationOrderTime (0.)
 {
 	assert (0 && "AbstractQualifSerie copy constructor is not allowed.");
+	lock_guard<mutex>	lock (liveSeriesMutex ( ));
+	liveSeries ( ).insert (this);
 }	// AbstractQualifSerie::AbstractQualifSerie
 
 
@@ -56,6 +368,8 @@ AbstractQualifSerie& AbstractQualifSerie::operator = (
 
 AbstractQualifSerie::~AbstractQualifSerie ( )
 {
+	lock_guard<mutex>	lock (liveSeriesMutex ( ));
+	liveSeries ( ).erase (this);
 }	// AbstractQualifSerie::~AbstractQualifSerie
 
 
@@ -77,6 +391,27 @@ unsigned char AbstractQualifSerie::getDimension ( ) const
 }	// AbstractQualifSerie::getDimension
 
 
+bool AbstractQualifSerie::hasMeshCellIds ( ) const
+{
+	return false;
+}	// AbstractQualifSerie::hasMeshCellIds
+
+
+size_t AbstractQualifSerie::getMeshCellId (size_t) const
+{
+	UTF8String	msg (charset);
+	msg << "La série " << getName ( ) << " ne connaît pas les identifiants "
+	    << "de ses mailles dans le maillage.";
+	throw Exception (msg);
+}	// AbstractQualifSerie::getMeshCellId
+
+
+const void* AbstractQualifSerie::getMeshInstance ( ) const
+{
+	return 0;
+}	// AbstractQualifSerie::getMeshInstance
+
+
 void AbstractQualifSerie::getDataRange (
 					Qualif::Critere criterion, double& min, double& max) const
 {
@@ -85,45 +420,137 @@ void AbstractQualifSerie::getDataRange (
 
 	// Ce calcul a t-il déjà été fait ?
 	if (false == isCriteriaStored (criterion))
-	{	// Non => allocation et calcul pour toutes les mailles. On en profite
-		// pour récupérer min/max :
-		_storedValues.insert(std::pair<Qualif::Critere,std::vector<double> > (criterion, std::vector<double> (count)));
-		_storedValuesDefined.insert(std::pair<Qualif::Critere,std::vector<bool> > (criterion, std::vector<bool> (count,true)));
-		_minValues.insert(pair <Qualif::Critere, double> (criterion, -DBL_MAX));
-		_maxValues.insert(pair <Qualif::Critere, double> (criterion, DBL_MAX));
-
-		for (size_t c = 0; c < count; c++)
-		{
-
+	{	// Non => calcul pour toutes les mailles, évaluées par paquets dans
+		// l'ordre d'évaluation, et stockage selon le mode de stockage. On en
+		// profite pour récupérer min/max :
+		vector<bool>	defined;
+		bool			stored	= false;
+		if ((QUANTIZED_STORAGE == storageMode) &&
+		    (true == QualifHelper::isBinaryCriterion (criterion)))
+		{	// 1 bit par maille :
+			vector<bool>	bits (count, false);
+			bool			binary	= true;
+			evaluateCells (*this, criterion, defined, min, max,
+			               [&bits, &binary] (size_t c, double value)
+			{
+				bits [c]	= 1. == value;
+				binary		= binary && ((0. == value) || (1. == value));
+			});
+			if (true == binary)
+			{
+				_binaryValues [criterion].swap (bits);
+				stored	= true;
+			}	// if (true == binary)
+		}	// if ((QUANTIZED_STORAGE == storageMode) && ...
+		else if ((QUANTIZED_STORAGE == storageMode) &&
+		         (quantizationError <= storageMaxError))
+		{	// 16 bits par maille, dans le domaine théorique s'il est borné
+			// et contient les valeurs obtenues, dans le domaine observé sinon :
+			vector<uint16_t>	codes (count, 0);
+			double				origin	= 0.,	end	= -1.,	step	= 0.;
+			bool				finite	= true,	bounded	= false;
 			try
 			{
-				Maille&	cell	= getCell (c);
-				double	value	= cell.AppliqueCritere (criterion);
-				min	= value < min ? value : min;
-				max	= value > max ? value : max;
-
-				_storedValues [criterion][c] = value;
+				QualifHelper::getDomain (
+								criterion, getDataTypes ( ), origin, end);
+				bounded	= (true == NumericServices::isValidAndNotMax (origin)) &&
+				          (true == NumericServices::isValidAndNotMax (end)) &&
+				          (origin <= end);
 			}
 			catch (...)
-			{	// Certains types ne sont pas supportés (pentagone, ...).
-				// On ne s'arrête pas à ça.
-				_storedValuesDefined[criterion][c] = false;
+			{
 			}
+			if (true == bounded)
+			{
+				step	= (end - origin) / quantizationSteps;
+				evaluateCells (*this, criterion, defined, min, max,
+				               [&] (size_t c, double value)
+				{
+					finite		= finite && NumericServices::isValid (value);
+					codes [c]	= quantizeValue (value, origin, step);
+				});
+				stored	= (true == finite) && (origin <= min) && (max <= end);
+			}	// if (true == bounded)
+			else
+				evaluateCells (*this, criterion, defined, min, max,
+				               [&finite] (size_t, double value)
+				{
+					finite	= finite && NumericServices::isValid (value);
+				});
+			if ((false == stored) && (true == finite) && (min <= max))
+			{	// Domaine observé, 2nd passage :
+				origin	= min;
+				step	= (max - min) / quantizationSteps;
+				evaluateCells (*this, criterion, defined, min, max,
+				               [&] (size_t c, double value)
+				{
+					codes [c]	= quantizeValue (value, origin, step);
+				});
+				stored	= true;
+			}	// if ((false == stored) && (true == finite) && (min <= max))
+			if (true == stored)
+			{
+				_quantizedValues [criterion].swap (codes);
+				_quantizations [criterion]	= pair<double, double> (origin, step);
+			}	// if (true == stored)
+		}	// else if ((QUANTIZED_STORAGE == storageMode) && ...
+		if (false == stored)
+		{	// Double précision :
+			vector<double>	values (count);
+			evaluateCells (*this, criterion, defined, min, max,
+			               [&values] (size_t c, double value)
+			{
+				values [c]	= value;
+			});
+			_storedValues [criterion].swap (values);
+		}	// if (false == stored)
 
-		}	// for (size_t c = 0; c < count; c++)
-
+		_storedValuesDefined [criterion].swap (defined);
 		_minValues [criterion]	= min;
 		_maxValues [criterion]	= max;
-
+		_lastUses [criterion]	= useDate.load (memory_order_relaxed);
 	}	// if (false == isCriteriaStored (criterion))
 	else
 	{	// Calcul déjà fait => on récupère min/max :
 		min	= _minValues [criterion];
 		max	= _maxValues [criterion];
+		_lastUses [criterion]	= useDate.load (memory_order_relaxed);
 	}	// else if (false == isCriteriaStored (criterion))
 }	// AbstractQualifSerie::getDataRange
 
 
+size_t AbstractQualifSerie::evaluateCriterion (
+				Qualif::Critere criterion, size_t cellTypes,
+				size_t first, size_t last,
+				double* values, unsigned char* status) const
+{
+	size_t	evaluated	= 0;
+	for (size_t p = first; p < last; p++, values++, status++)
+	{
+		try
+		{
+			const size_t	c	= getEvaluatedCell (p);
+			if ((ALL_TYPES != cellTypes) && (0 == (getCellType (c) & cellTypes)))
+			{
+				*status	= CELL_SKIPPED;
+				continue;
+			}	// if ((ALL_TYPES != cellTypes) && ...
+
+			Maille&	cell	= getCell (c);
+			*values	= cell.AppliqueCritere (criterion);
+			*status	= CELL_EVALUATED;
+			evaluated++;
+		}
+		catch (...)
+		{	// Certains types ne sont pas supportés (pentagone, ...).
+			*status	= CELL_FAILED;
+		}
+	}	// for (size_t p = first; p < last; p++, values++, status++)
+
+	return evaluated;
+}	// AbstractQualifSerie::evaluateCriterion
+
+
 size_t AbstractQualifSerie::getDataTypes ( ) const
 {
 	if (0 == _dataTypes)
@@ -182,6 +609,12 @@ void AbstractQualifSerie::validateCoordinates ( )
 }	// AbstractQualifSerie::validateCoordinates
 
 
+bool AbstractQualifSerie::flattenCoordinates (size_t)
+{
+	return false;
+}	// AbstractQualifSerie::flattenCoordinates
+
+
 void AbstractQualifSerie::setCoordinatesValidity (bool evaluated, bool valid, const UTF8String& msg)
 {
 	_coordinatesValidityEvaluated	= evaluated;
@@ -190,6 +623,27 @@ void AbstractQualifSerie::setCoordinatesValidity (bool evaluated, bool valid, co
 }	// AbstractQualifSerie::setCoordinatesValidity
 
 
+size_t AbstractQualifSerie::getRevision ( ) const
+{
+	// Les numéros de révision ne font que croître, leur somme aussi :
+	size_t	revision	= _revision;
+	const vector<const AbstractQualifSerie*>	underlying	=
+													getUnderlyingSeries ( );
+	for (vector<const AbstractQualifSerie*>::const_iterator its =
+	     underlying.begin ( ); underlying.end ( ) != its; its++)
+		if (this != *its)
+			revision	+= (*its)->_revision;
+
+	return revision;
+}	// AbstractQualifSerie::getRevision
+
+
+void AbstractQualifSerie::dataRevised ( )
+{
+	_revision++;
+}	// AbstractQualifSerie::dataRevised
+
+
 void AbstractQualifSerie::setName (const string& name)
 {
 	_name	= name;
@@ -198,25 +652,260 @@ void AbstractQualifSerie::setName (const string& name)
 
 bool AbstractQualifSerie::isCriteriaStored (Qualif::Critere criterion) const
 {
-	return _storedValues.find(criterion) != _storedValues.end();
+	return _storedValuesDefined.end ( ) != _storedValuesDefined.find (criterion);
 }	// AbstractQualifSerie::isCriteriaStored
 
 
+void AbstractQualifSerie::recordUse (Critere criterion) const
+{
+	const size_t	date	= useDate.load (memory_order_relaxed);
+	const vector<const AbstractQualifSerie*>	underlying	=
+													getUnderlyingSeries ( );
+	for (vector<const AbstractQualifSerie*>::const_iterator its =
+	     underlying.begin ( ); underlying.end ( ) != its; its++)
+	{
+		CHECK_NULL_PTR_ERROR (*its)
+		map<Critere, size_t>::iterator	itu	= (*its)->_lastUses.find (criterion);
+		if ((*its)->_lastUses.end ( ) != itu)
+			(*itu).second	= date;
+	}	// for (vector<const AbstractQualifSerie*>::const_iterator its = ...
+}	// AbstractQualifSerie::recordUse
+
+
 double AbstractQualifSerie::getStoredCriteria (Qualif::Critere criterion, size_t i) const
 {
-	if(_storedValuesDefined[criterion][i]) {
-		return _storedValues[criterion][i];
-	} else {
+	map<Critere, vector<bool> >::const_iterator	itd	=
+										_storedValuesDefined.find (criterion);
+	if ((_storedValuesDefined.end ( ) == itd) || (false == (*itd).second [i]))
+	{
 		UTF8String	msg (charset);
 		msg << "Ce critère n'a pas été stocké pour cette maille.";
 		throw Exception (msg);
-	}
+	}	// if ((_storedValuesDefined.end ( ) == itd) || ...
+
+	map<Critere, vector<double> >::const_iterator	itv	=
+												_storedValues.find (criterion);
+	if (_storedValues.end ( ) != itv)
+		return (*itv).second [i];
+	map<Critere, vector<uint16_t> >::const_iterator	itq	=
+											_quantizedValues.find (criterion);
+	if (_quantizedValues.end ( ) != itq)
+	{
+		const pair<double, double>&	quantization	= _quantizations [criterion];
+		return quantization.first + (*itq).second [i] * quantization.second;
+	}	// if (_quantizedValues.end ( ) != itq)
+
+	return true == _binaryValues [criterion][i] ? 1. : 0.;
 }	// AbstractQualifSerie::getStoredCriteria
 
 
+void AbstractQualifSerie::setStorageMode (STORAGE_MODE mode, double maxError)
+{
+	storageMode		= mode;
+	storageMaxError	= maxError;
+}	// AbstractQualifSerie::setStorageMode
+
+
+AbstractQualifSerie::STORAGE_MODE AbstractQualifSerie::getStorageMode ( )
+{
+	return (STORAGE_MODE)storageMode.load ( );
+}	// AbstractQualifSerie::getStorageMode
+
+
+double AbstractQualifSerie::getStorageMaxError ( )
+{
+	return storageMaxError;
+}	// AbstractQualifSerie::getStorageMaxError
+
+
+void AbstractQualifSerie::setInterruption (const function<bool ( )>& interrupted)
+{
+	interruption	= interrupted;
+}	// AbstractQualifSerie::setInterruption
+
+
+double AbstractQualifSerie::getStoredCriteriaError (Critere criterion) const
+{
+	map<Critere, pair<double, double> >::const_iterator	itq	=
+											_quantizations.find (criterion);
+	if (_quantizations.end ( ) == itq)
+		return 0.;
+
+	// Demi pas, majoré des erreurs d'arrondi du décodage :
+	const pair<double, double>&	quantization	= (*itq).second;
+	const double	magnitude	= fabs (quantization.first) +
+								  quantizationSteps * quantization.second;
+
+	return 0.5 * quantization.second + 4. * DBL_EPSILON * magnitude;
+}	// AbstractQualifSerie::getStoredCriteriaError
+
+
+double AbstractQualifSerie::getCriteriaValue (Critere criterion, size_t i) const
+{
+	if ((true == isCriteriaStored (criterion)) &&
+	    (0. == getStoredCriteriaError (criterion)))
+		return getStoredCriteria (criterion, i);
+
+	return getCell (i).AppliqueCritere (criterion);
+}	// AbstractQualifSerie::getCriteriaValue
+
+
+bool AbstractQualifSerie::rebin (
+			Critere criterion, size_t cellTypes, size_t classesNum,
+			double min, double max, bool strict, vector<size_t>& counts,
+			size_t threadsNum) const
+{
+	return rebinCells (criterion, cellTypes, classesNum, min, max, strict,
+	                   0, getCellCount ( ), counts, threadsNum);
+}	// AbstractQualifSerie::rebin
+
+
+bool AbstractQualifSerie::rebin (
+			Critere criterion, size_t cellTypes, size_t classesNum,
+			double min, double max, bool strict, const vector<size_t>& cells,
+			vector<size_t>& counts, size_t threadsNum) const
+{
+	const size_t	cellsNum	= getCellCount ( );
+	for (vector<size_t>::const_iterator itc = cells.begin ( );
+	     cells.end ( ) != itc; itc++)
+	{
+		if (*itc >= cellsNum)
+		{
+			UTF8String	msg (charset);
+			msg << "AbstractQualifSerie::rebin : indice de maille invalide ("
+			    << (unsigned long)*itc << ") pour la série " << getName ( )
+			    << " de " << (unsigned long)cellsNum << " mailles.";
+			throw Exception (msg);
+		}	// if (*itc >= cellsNum)
+	}	// for (vector<size_t>::const_iterator itc = cells.begin ( ); ...
+
+	return rebinCells (criterion, cellTypes, classesNum, min, max, strict,
+	                   cells.data ( ), cells.size ( ),
+	                   counts, threadsNum);
+}	// AbstractQualifSerie::rebin
+
+
+bool AbstractQualifSerie::rebinCells (
+			Critere criterion, size_t cellTypes, size_t classesNum,
+			double min, double max, bool strict, const size_t* cells,
+			size_t count, vector<size_t>& counts, size_t threadsNum) const
+{
+	if (0 == classesNum)
+		throw Exception (UTF8String ("AbstractQualifSerie::rebin : nombre de classes nul.", charset));
+	map<Critere, vector<bool> >::const_iterator	itd	=
+										_storedValuesDefined.find (criterion);
+	if (_storedValuesDefined.end ( ) == itd)
+		return false;
+	if (0 == count)
+	{	// Série ou sélection vide : rien à répartir.
+		counts.assign (classesNum, 0);
+		return true;
+	}	// if (0 == count)
+
+	// Les types des mailles, une fois pour toutes :
+	const size_t	cellsNum	= getCellCount ( );
+	if (_cellsTypes.size ( ) != cellsNum)
+	{
+		vector<unsigned char>	types (cellsNum, 0);
+		for (size_t c = 0; c < cellsNum; c++)
+		{
+			try
+			{
+				const size_t	type	= getCellType (c);
+				types [c]	= type <= 0xff ? (unsigned char)type : 0;
+			}
+			catch (...)
+			{
+			}
+		}	// for (size_t c = 0; c < cellsNum; c++)
+		_cellsTypes.swap (types);
+	}	// if (_cellsTypes.size ( ) != cellsNum)
+
+	// Répartition par paquets en parallèle, selon le mode de stockage :
+	const vector<bool>&		defined		= (*itd).second;
+	const double			classWidth	= max / classesNum - min / classesNum;
+	const double			error		= getStoredCriteriaError (criterion);
+	const unsigned char*	types		= _cellsTypes.data ( );
+	const size_t			blocksNum	=
+						(count + evaluationChunkSize - 1) / evaluationChunkSize;
+	vector<size_t>			total (classesNum + 1, 0),	ambiguous;
+	mutex					merging;
+	QualifHelper::parallelFor (blocksNum, threadsNum,
+	                           [&] (size_t firstBlock, size_t lastBlock)
+	{
+		vector<size_t>	local (classesNum + 1, 0),	localAmbiguous;
+		const size_t	first	= firstBlock * evaluationChunkSize;
+		const size_t	last	= lastBlock * evaluationChunkSize < count ?
+								  lastBlock * evaluationChunkSize : count;
+		map<Critere, vector<double> >::const_iterator	itv	=
+												_storedValues.find (criterion);
+		map<Critere, vector<uint16_t> >::const_iterator	itq	=
+											_quantizedValues.find (criterion);
+		if (_storedValues.end ( ) != itv)
+		{
+			const double*	values	= (*itv).second.data ( );
+			binCells (first, last, cells, types, cellTypes, defined,
+			          [values] (size_t c) { return values [c]; },
+			          min, max, classWidth, classesNum, strict, error,
+			          local, localAmbiguous);
+		}	// if (_storedValues.end ( ) != itv)
+		else if (_quantizedValues.end ( ) != itq)
+		{
+			const uint16_t*	codes	= (*itq).second.data ( );
+			const pair<double, double>	quantization	=
+								(*_quantizations.find (criterion)).second;
+			const double	origin	= quantization.first;
+			const double	step	= quantization.second;
+			binCells (first, last, cells, types, cellTypes, defined,
+			          [codes, origin, step] (size_t c)
+			          { return origin + codes [c] * step; },
+			          min, max, classWidth, classesNum, strict, error,
+			          local, localAmbiguous);
+		}	// else if (_quantizedValues.end ( ) != itq)
+		else
+		{
+			const vector<bool>&	bits	=
+								(*_binaryValues.find (criterion)).second;
+			binCells (first, last, cells, types, cellTypes, defined,
+			          [&bits] (size_t c) { return true == bits [c] ? 1. : 0.; },
+			          min, max, classWidth, classesNum, strict, error,
+			          local, localAmbiguous);
+		}	// else if (_quantizedValues.end ( ) != itq)
+		unique_lock<mutex>	lock (merging);
+		for (size_t cl = 0; cl < classesNum; cl++)
+			total [cl]	+= local [cl];
+		ambiguous.insert (
+				ambiguous.end ( ), localAmbiguous.begin ( ), localAmbiguous.end ( ));
+	});
+
+	// Les mailles de classe ambiguë, recalculées en pleine précision :
+	for (vector<size_t>::const_iterator ita = ambiguous.begin ( );
+	     ambiguous.end ( ) != ita; ita++)
+	{
+		try
+		{
+			const double	value	= getCriteriaValue (criterion, *ita);
+			if ((true == strict) && ((value < min) || (value > max)))
+				continue;
+			total [QualifHelper::getClassIndex (
+								value, min, classWidth, classesNum)]++;
+		}
+		catch (...)
+		{
+		}
+	}	// for (vector<size_t>::const_iterator ita = ambiguous.begin ( ); ...
+
+	total.resize (classesNum);
+	counts.swap (total);
+
+	return true;
+}	// AbstractQualifSerie::rebinCells
+
+
 const std::vector < std::vector <size_t> >&
 						AbstractQualifSerie::getClassesCellsIndexes ( ) const
 {
+	updateClassesCellsIndexes ( );
 	return _classesCellsIndexes;
 }	// AbstractQualifSerie::getClassesCellsIndexes
 
@@ -224,6 +913,7 @@ const std::vector < std::vector <size_t> >&
 std::vector < std::vector <size_t> >&
 						AbstractQualifSerie::getClassesCellsIndexes ( )
 {
+	updateClassesCellsIndexes ( );
 	return _classesCellsIndexes;
 }	// AbstractQualifSerie::getClassesCellsIndexes
 
@@ -231,6 +921,7 @@ std::vector < std::vector <size_t> >&
 void AbstractQualifSerie::getCellsIndexes (
 								vector<size_t>& indexes, size_t clas) const
 {
+	updateClassesCellsIndexes ( );
 	if (clas >= _classesCellsIndexes.size ( ))
 		throw Exception (UTF8String ("AbstractQualifSerie::getCellsIndexes : index de classe invalide.", charset));
 
@@ -238,6 +929,73 @@ void AbstractQualifSerie::getCellsIndexes (
 }	// AbstractQualifSerie::getCellsIndexes
 
 
+void AbstractQualifSerie::deferClassesCellsIndexes (
+			Critere criterion, size_t cellTypes, size_t classesNum,
+			double min, double max, bool strict)
+{
+	if (0 == classesNum)
+		throw Exception (UTF8String ("AbstractQualifSerie::deferClassesCellsIndexes : nombre de classes nul.", charset));
+
+	releaseClassesCellsIndexes ( );
+	_classesRequest.pending		= true;
+	_classesRequest.criterion	= criterion;
+	_classesRequest.cellTypes	= cellTypes;
+	_classesRequest.classesNum	= classesNum;
+	_classesRequest.min			= min;
+	_classesRequest.max			= max;
+	_classesRequest.strict		= strict;
+}	// AbstractQualifSerie::deferClassesCellsIndexes
+
+
+void AbstractQualifSerie::updateClassesCellsIndexes ( ) const
+{
+	if (false == _classesRequest.pending)
+		return;
+
+	// Même répartition que QualifAnalysisTask::execute, et donc que rebin :
+	const ClassesRequest	request		= _classesRequest;
+	const double			classWidth	=
+			request.max / request.classesNum - request.min / request.classesNum;
+	const bool				stored		= isCriteriaStored (request.criterion);
+	const double			error		= true == stored ?
+							getStoredCriteriaError (request.criterion) : 0.;
+	const size_t			count		= getCellCount ( );
+	vector< vector<size_t> >	indexes (request.classesNum);
+	for (size_t c = 0; c < count; c++)
+	{
+		try
+		{
+			if (0 == (getCellType (c) & request.cellTypes))
+				continue;
+
+			double	value;
+			if (true == stored)
+			{
+				value	= getStoredCriteria (request.criterion, c);
+				if ((0. != error) &&
+				    (true == QualifHelper::isClassAmbiguous (
+							value, error, request.min, request.max, classWidth)))
+					value	= getCriteriaValue (request.criterion, c);
+			}	// if (true == stored)
+			else
+				value	= getCell (c).AppliqueCritere (request.criterion);
+			if ((true == request.strict) &&
+			    ((value < request.min) || (value > request.max)))
+				continue;
+			indexes [QualifHelper::getClassIndex (
+					value, request.min, classWidth, request.classesNum)].push_back (c);
+		}
+		catch (...)
+		{	// Certains types ne sont pas supportés (pentagone, ...).
+		}
+	}	// for (size_t c = 0; c < count; c++)
+
+	_classesCellsIndexes.swap (indexes);
+	_classesRequest.pending	= false;
+	_classesLastUse			= useDate.load (memory_order_relaxed);
+}	// AbstractQualifSerie::updateClassesCellsIndexes
+
+
 void AbstractQualifSerie::storeIndex (size_t cl, size_t c)
 {
 	_classesCellsIndexes [cl].push_back (c);
@@ -246,8 +1004,10 @@ void AbstractQualifSerie::storeIndex (size_t cl, size_t c)
 
 void AbstractQualifSerie::setClassesNum (size_t nb)
 {
+	_classesRequest.pending	= false;
 	_classesCellsIndexes.clear ( );
 	_classesCellsIndexes.resize (nb);
+	_classesLastUse	= useDate.load (memory_order_relaxed);
 }	// AbstractQualifSerie::setClassesNum
 
 
@@ -257,14 +1017,496 @@ void AbstractQualifSerie::releaseStoredData ( )
 	_minValues.clear ( );
 	_maxValues.clear ( );
 	_storedValuesDefined.clear ( );
+	_quantizedValues.clear ( );
+	_quantizations.clear ( );
+	_binaryValues.clear ( );
 	_classesCellsIndexes.clear ( );
+	_classesRequest.pending	= false;
+	vector<unsigned char> ( ).swap (_cellsTypes);
+	_lastUses.clear ( );
+	_classesLastUse	= 0;
 }	// AbstractQualifSerie::releaseStoredData
 
 
+size_t AbstractQualifSerie::getMemoryUsage ( ) const
+{
+	size_t	usage	= getClassesMemoryUsage ( ) + _cellsTypes.capacity ( );
+	for (map<Critere, vector<bool> >::const_iterator itd =
+	     _storedValuesDefined.begin ( ); _storedValuesDefined.end ( ) != itd;
+	     itd++)
+		usage	+= getMemoryUsage ((*itd).first);
+
+	return usage;
+}	// AbstractQualifSerie::getMemoryUsage
+
+
+size_t AbstractQualifSerie::getMemoryUsage (Critere criterion) const
+{
+	map<Critere, vector<bool> >::const_iterator		itd	=
+										_storedValuesDefined.find (criterion);
+	if (_storedValuesDefined.end ( ) == itd)
+		return 0;
+
+	size_t	usage	= ((*itd).second.capacity ( ) + 7) / 8;
+	map<Critere, vector<double> >::const_iterator	itv	=
+												_storedValues.find (criterion);
+	if (_storedValues.end ( ) != itv)
+		usage	+= (*itv).second.capacity ( ) * sizeof (double);
+	map<Critere, vector<uint16_t> >::const_iterator	itq	=
+											_quantizedValues.find (criterion);
+	if (_quantizedValues.end ( ) != itq)
+		usage	+= (*itq).second.capacity ( ) * sizeof (uint16_t);
+	map<Critere, vector<bool> >::const_iterator		itb	=
+												_binaryValues.find (criterion);
+	if (_binaryValues.end ( ) != itb)
+		usage	+= ((*itb).second.capacity ( ) + 7) / 8;
+
+	return usage;
+}	// AbstractQualifSerie::getMemoryUsage
+
+
+size_t AbstractQualifSerie::getClassesMemoryUsage ( ) const
+{
+	size_t	usage	=
+				_classesCellsIndexes.capacity ( ) * sizeof (vector<size_t>);
+	for (vector< vector<size_t> >::const_iterator itc =
+	     _classesCellsIndexes.begin ( ); _classesCellsIndexes.end ( ) != itc;
+	     itc++)
+		usage	+= (*itc).capacity ( ) * sizeof (size_t);
+
+	return usage;
+}	// AbstractQualifSerie::getClassesMemoryUsage
+
+
+vector<Critere> AbstractQualifSerie::getStoredCriteriaList ( ) const
+{
+	vector<Critere>	criteria;
+	for (map<Critere, vector<bool> >::const_iterator itd =
+	     _storedValuesDefined.begin ( ); _storedValuesDefined.end ( ) != itd;
+	     itd++)
+		criteria.push_back ((*itd).first);
+
+	return criteria;
+}	// AbstractQualifSerie::getStoredCriteriaList
+
+
+void AbstractQualifSerie::releaseStoredCriterion (Critere criterion)
+{
+	_storedValues.erase (criterion);
+	_minValues.erase (criterion);
+	_maxValues.erase (criterion);
+	_storedValuesDefined.erase (criterion);
+	_quantizedValues.erase (criterion);
+	_quantizations.erase (criterion);
+	_binaryValues.erase (criterion);
+	_lastUses.erase (criterion);
+}	// AbstractQualifSerie::releaseStoredCriterion
+
+
+void AbstractQualifSerie::releaseClassesCellsIndexes ( )
+{
+	vector< vector<size_t> > ( ).swap (_classesCellsIndexes);
+	_classesRequest.pending	= false;
+	_classesLastUse	= 0;
+}	// AbstractQualifSerie::releaseClassesCellsIndexes
+
+
+size_t AbstractQualifSerie::getLastUse (Critere criterion) const
+{
+	map<Critere, size_t>::const_iterator	itu	= _lastUses.find (criterion);
+
+	return _lastUses.end ( ) == itu ? 0 : (*itu).second;
+}	// AbstractQualifSerie::getLastUse
+
+
+size_t AbstractQualifSerie::getClassesLastUse ( ) const
+{
+	return _classesLastUse;
+}	// AbstractQualifSerie::getClassesLastUse
+
+
+void AbstractQualifSerie::setMemoryBudget (size_t bytes)
+{
+	memoryBudget	= bytes;
+}	// AbstractQualifSerie::setMemoryBudget
+
+
+size_t AbstractQualifSerie::getMemoryBudget ( )
+{
+	return memoryBudget;
+}	// AbstractQualifSerie::getMemoryBudget
+
+
+size_t AbstractQualifSerie::applyMemoryBudget (
+					const vector<AbstractQualifSerie*>& series, Critere criterion)
+{
+	useDate++;
+	const size_t	budget	= memoryBudget;
+	if (0 == budget)
+		return 0;
+
+	// Les séries à analyser et celles dont elles partagent les données en
+	// cache (vues), dont les valeurs du critère à analyser sont conservées,
+	// et la mémoire nécessaire à ce critère :
+	set<const AbstractQualifSerie*>	analysed;
+	size_t							required	= 0;
+	for (vector<AbstractQualifSerie*>::const_iterator its = series.begin ( );
+	     series.end ( ) != its; its++)
+	{
+		CHECK_NULL_PTR_ERROR (*its)
+		vector<AbstractQualifSerie*>	underlying	=
+											(*its)->getUnderlyingSeries ( );
+		underlying.insert (underlying.begin ( ), *its);
+		for (vector<AbstractQualifSerie*>::const_iterator itu =
+		     underlying.begin ( ); underlying.end ( ) != itu; itu++)
+		{
+			CHECK_NULL_PTR_ERROR (*itu)
+			AbstractQualifSerie&	serie	= **itu;
+			if (false == analysed.insert (&serie).second)
+				continue;
+			const vector<AbstractQualifSerie*>	roots	=
+											serie.getUnderlyingSeries ( );
+			if ((1 == roots.size ( )) && (&serie == roots [0]) &&
+			    (serie._storedValuesDefined.end ( ) ==
+			     serie._storedValuesDefined.find (criterion)))
+				required	+= storageSize (criterion, serie.getCellCount ( ));
+		}	// for (vector<AbstractQualifSerie*>::const_iterator itu = ...
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+
+	// La mémoire utilisée par l'ensemble des séries existantes, et les
+	// données libérables. Les données verrouillées sont en cours de
+	// modification par un autre thread : elles ne sont pas consultées, leur
+	// mémoire étant celle relevée lors de leur verrouillage. Les index des
+	// mailles par classe ne sont libérables que pour les séries à analyser,
+	// ceux des autres séries pouvant être affichés par ailleurs
+	// (extractions, ...) :
+	lock_guard<mutex>	lock (liveSeriesMutex ( ));
+	const set<AbstractQualifSerie*>&	all	= liveSeries ( );
+	size_t				usage	= 0;
+	vector<CachedData>	candidates;
+	for (set<AbstractQualifSerie*>::const_iterator its = all.begin ( );
+	     all.end ( ) != its; its++)
+	{
+		AbstractQualifSerie&	serie	= **its;
+		if (0 != serie._storedDataLocks)
+		{
+			usage	+= serie._lockedMemoryUsage;
+			continue;
+		}	// if (0 != serie._storedDataLocks)
+		usage	+= serie.AbstractQualifSerie::getMemoryUsage ( );
+		const bool	keepCriterion	= analysed.end ( ) != analysed.find (&serie);
+		for (map<Critere, vector<bool> >::const_iterator itd =
+		     serie._storedValuesDefined.begin ( );
+		     serie._storedValuesDefined.end ( ) != itd; itd++)
+		{
+			if ((true == keepCriterion) && (criterion == (*itd).first))
+				continue;
+			CachedData	data	= { &serie, false, (*itd).first,
+						serie.AbstractQualifSerie::getLastUse ((*itd).first),
+						serie.AbstractQualifSerie::getMemoryUsage ((*itd).first) };
+			candidates.push_back (data);
+		}	// for (map<Critere, vector<bool> >::const_iterator itd = ...
+		const size_t	classesUsage	= false == keepCriterion ? 0 :
+							serie.AbstractQualifSerie::getClassesMemoryUsage ( );
+		if (0 != classesUsage)
+		{
+			CachedData	data	= { &serie, true, criterion,
+						serie._classesLastUse, classesUsage };
+			candidates.push_back (data);
+		}	// if (0 != classesUsage)
+	}	// for (set<AbstractQualifSerie*>::const_iterator its = ...
+
+	// Libération des données utilisées le moins récemment :
+	stable_sort (candidates.begin ( ), candidates.end ( ));
+	size_t	released	= 0;
+	for (vector<CachedData>::const_iterator itc = candidates.begin ( );
+	     (candidates.end ( ) != itc) && (usage + required > budget); itc++)
+	{
+		if (true == (*itc).classes)
+			(*itc).serie->releaseClassesCellsIndexes ( );
+		else
+			(*itc).serie->releaseStoredCriterion ((*itc).criterion);
+		usage		-= (*itc).bytes;
+		released	+= (*itc).bytes;
+	}	// for (vector<CachedData>::const_iterator itc = ...
+
+	return released;
+}	// AbstractQualifSerie::applyMemoryBudget
+
+
+void AbstractQualifSerie::lockStoredData (AbstractQualifSerie& serie)
+{
+	vector<AbstractQualifSerie*>	underlying	= serie.getUnderlyingSeries ( );
+	if (underlying.end ( ) == find (underlying.begin ( ), underlying.end ( ), &serie))
+		underlying.push_back (&serie);
+	lock_guard<mutex>	lock (liveSeriesMutex ( ));
+	for (vector<AbstractQualifSerie*>::const_iterator its =
+	     underlying.begin ( ); underlying.end ( ) != its; its++)
+	{	// Mémoire relevée avant toute modification par le thread qui
+		// verrouille :
+		if (0 == (*its)->_storedDataLocks)
+			(*its)->_lockedMemoryUsage	=
+							(*its)->AbstractQualifSerie::getMemoryUsage ( );
+		(*its)->_storedDataLocks++;
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+}	// AbstractQualifSerie::lockStoredData
+
+
+void AbstractQualifSerie::unlockStoredData (AbstractQualifSerie& serie)
+{
+	vector<AbstractQualifSerie*>	underlying	= serie.getUnderlyingSeries ( );
+	if (underlying.end ( ) == find (underlying.begin ( ), underlying.end ( ), &serie))
+		underlying.push_back (&serie);
+	lock_guard<mutex>	lock (liveSeriesMutex ( ));
+	for (vector<AbstractQualifSerie*>::const_iterator its =
+	     underlying.begin ( ); underlying.end ( ) != its; its++)
+		if (0 != (*its)->_storedDataLocks)
+			(*its)->_storedDataLocks--;
+}	// AbstractQualifSerie::unlockStoredData
+
+
 bool AbstractQualifSerie::isThreadable ( ) const
 {
 	return false;
 }	// AbstractQualifSerie::isThreadable
 
+
+vector<AbstractQualifSerie*> AbstractQualifSerie::getUnderlyingSeries ( )
+{
+	return vector<AbstractQualifSerie*> (1, this);
+}	// AbstractQualifSerie::getUnderlyingSeries
+
+
+vector<const AbstractQualifSerie*>
+							AbstractQualifSerie::getUnderlyingSeries ( ) const
+{
+	return vector<const AbstractQualifSerie*> (1, this);
+}	// AbstractQualifSerie::getUnderlyingSeries
+
+
+vector< vector<size_t> > AbstractQualifSerie::groupSharingSeries (
+							const vector<const AbstractQualifSerie*>& series)
+{
+	// Union des séries ayant une série sous-jacente commune :
+	vector<size_t>							groups (series.size ( ));
+	map<const AbstractQualifSerie*, size_t>	owners;
+	for (size_t s = 0; s < series.size ( ); s++)
+	{
+		CHECK_NULL_PTR_ERROR (series [s])
+		groups [s]	= s;
+		const vector<const AbstractQualifSerie*>	underlying	=
+										series [s]->getUnderlyingSeries ( );
+		for (vector<const AbstractQualifSerie*>::const_iterator itu =
+		     underlying.begin ( ); underlying.end ( ) != itu; itu++)
+		{
+			const pair<map<const AbstractQualifSerie*, size_t>::iterator, bool>
+				inserted	= owners.insert (
+						pair<const AbstractQualifSerie*, size_t> (*itu, s));
+			if (true == inserted.second)
+				continue;
+			const size_t	first	= findGroup (groups, (*inserted.first).second);
+			const size_t	second	= findGroup (groups, s);
+			groups [first < second ? second : first]	=
+											first < second ? first : second;
+		}	// for (vector<const AbstractQualifSerie*>::const_iterator itu = ...
+	}	// for (size_t s = 0; s < series.size ( ); s++)
+
+	// Les groupes, selon l'ordre de leur premier élément :
+	vector< vector<size_t> >	result;
+	vector<size_t>				indexes (series.size ( ), (size_t)-1);
+	for (size_t s = 0; s < series.size ( ); s++)
+	{
+		const size_t	group	= findGroup (groups, s);
+		if ((size_t)-1 == indexes [group])
+		{
+			indexes [group]	= result.size ( );
+			result.push_back (vector<size_t> ( ));
+		}	// if ((size_t)-1 == indexes [group])
+		result [indexes [group]].push_back (s);
+	}	// for (size_t s = 0; s < series.size ( ); s++)
+
+	return result;
+}	// AbstractQualifSerie::groupSharingSeries
+
+
+double AbstractQualifSerie::computeEvaluationOrder (
+										size_t threadsNum, bool renumber)
+{
+	typedef chrono::steady_clock	Clock;
+	const Clock::time_point	start	= Clock::now ( );
+	const size_t			count	= getCellCount ( );
+	const size_t			chunks	= QualifHelper::getThreadsNum (threadsNum);
+	_evaluationOrder.clear ( );
+
+	// Les centres des mailles (NaN pour une maille invalide) :
+	vector<double>	centroids (3 * count);
+	QualifHelper::parallelFor (count,
+			true == isCentroidReentrant ( ) ? threadsNum : 1,
+			[&] (size_t first, size_t last)
+	{
+		for (size_t c = first; c < last; c++)
+		{
+			double*	centroid	= &centroids [3 * c];
+			try
+			{
+				getCellCentroid (c, centroid [0], centroid [1], centroid [2]);
+			}
+			catch (...)
+			{
+				centroid [0]	= centroid [1]	= centroid [2]	=
+											NumericServices::qNaN ( );
+			}
+		}	// for (size_t c = first; c < last; c++)
+	});
+
+	// La boite englobante, par morceaux puis fusion :
+	vector<double>	bounds (6 * chunks);
+	QualifHelper::parallelFor (chunks, chunks, [&] (size_t first, size_t last)
+	{
+		for (size_t k = first; k < last; k++)
+		{
+			double*	box	= &bounds [6 * k];
+			box [0]	= box [1]	= box [2]	= DBL_MAX;
+			box [3]	= box [4]	= box [5]	= -DBL_MAX;
+			for (size_t c = count * k / chunks; c < count * (k + 1) / chunks;
+			     c++)
+				for (size_t d = 0; d < 3; d++)
+				{	// Rem : comparaisons fausses pour NaN.
+					const double	value	= centroids [3 * c + d];
+					box [d]		= value < box [d] ? value : box [d];
+					box [d + 3]	= value > box [d + 3] ? value : box [d + 3];
+				}	// for (size_t d = 0; d < 3; d++)
+		}	// for (size_t k = first; k < last; k++)
+	});
+	double	box [6]	= { DBL_MAX, DBL_MAX, DBL_MAX, -DBL_MAX, -DBL_MAX, -DBL_MAX };
+	for (size_t k = 0; k < chunks; k++)
+		for (size_t d = 0; d < 3; d++)
+		{
+			box [d]		= bounds [6 * k + d] < box [d] ?
+						  bounds [6 * k + d] : box [d];
+			box [d + 3]	= bounds [6 * k + d + 3] > box [d + 3] ?
+						  bounds [6 * k + d + 3] : box [d + 3];
+		}	// for (size_t d = 0; d < 3; d++)
+	// Même facteur d'échelle dans les 3 directions :
+	double	extent	= 0.;
+	for (size_t d = 0; d < 3; d++)
+		extent	= box [d + 3] - box [d] > extent ? box [d + 3] - box [d] : extent;
+
+	// Les clés de Morton (mailles invalides en fin), puis le tri :
+	vector< pair<uint64_t, size_t> >	keys (count);
+	QualifHelper::parallelFor (count, threadsNum,
+	                           [&] (size_t first, size_t last)
+	{
+		for (size_t c = first; c < last; c++)
+		{
+			const double*	centroid	= &centroids [3 * c];
+			if (false == NumericServices::isValid (centroid [0]))
+			{
+				keys [c]	= pair<uint64_t, size_t> (UINT64_MAX, c);
+				continue;
+			}	// if (false == NumericServices::isValid (centroid [0]))
+			const uint64_t	key	=
+					spreadBits (quantize (centroid [0], box [0], extent)) |
+					spreadBits (quantize (centroid [1], box [1], extent)) << 1 |
+					spreadBits (quantize (centroid [2], box [2], extent)) << 2;
+			keys [c]	= pair<uint64_t, size_t> (key, c);
+		}	// for (size_t c = first; c < last; c++)
+	});
+	vector<double> ( ).swap (centroids);
+	parallelSort (keys, min (chunks, max (count, (size_t)1)));
+
+	vector<size_t>	order (count);
+	QualifHelper::parallelFor (count, threadsNum,
+	                           [&] (size_t first, size_t last)
+	{
+		for (size_t p = first; p < last; p++)
+			order [p]	= keys [p].second;
+	});
+	_evaluationOrder.swap (order);
+	if (true == renumber)
+		renumberNodes (threadsNum);
+
+	_evaluationOrderTime	=
+			chrono::duration<double> (Clock::now ( ) - start).count ( );
+
+	return _evaluationOrderTime;
+}	// AbstractQualifSerie::computeEvaluationOrder
+
+
+void AbstractQualifSerie::setEvaluationOrder (const vector<size_t>& order)
+{
+	const size_t	count	= getCellCount ( );
+	bool			valid	= order.size ( ) == count;
+	vector<bool>	used (true == valid ? count : 0, false);
+	for (size_t p = 0; (true == valid) && (p < count); p++)
+	{
+		valid	= (order [p] < count) && (false == used [order [p]]);
+		if (true == valid)
+			used [order [p]]	= true;
+	}	// for (size_t p = 0; (true == valid) && (p < count); p++)
+	if (false == valid)
+	{
+		UTF8String	msg (charset);
+		msg << "Série " << getName ( ) << " : l'ordre d'évaluation transmis "
+		    << "n'est pas une permutation des indices des "
+		    << (unsigned long)count << " mailles.";
+		throw Exception (msg);
+	}	// if (false == valid)
+
+	_evaluationOrder	= order;
+}	// AbstractQualifSerie::setEvaluationOrder
+
+
+void AbstractQualifSerie::releaseEvaluationOrder ( )
+{
+	vector<size_t> ( ).swap (_evaluationOrder);
+}	// AbstractQualifSerie::releaseEvaluationOrder
+
+
+const vector<size_t>& AbstractQualifSerie::getEvaluationOrder ( ) const
+{
+	return _evaluationOrder;
+}	// AbstractQualifSerie::getEvaluationOrder
+
+
+double AbstractQualifSerie::getEvaluationOrderTime ( ) const
+{
+	return _evaluationOrderTime;
+}	// AbstractQualifSerie::getEvaluationOrderTime
+
+
+void AbstractQualifSerie::getCellCentroid (
+						size_t i, double& x, double& y, double& z) const
+{
+	const Maille&	cell	= getCell (i);
+	const int		nbNodes	= cell.NombreSommets ( );
+	x	= y	= z	= 0.;
+	for (int n = 0; n < nbNodes; n++)
+	{
+		const Vecteur	node (cell.Sommet (n));
+		x	+= node.GetCoor (0);
+		y	+= node.GetCoor (1);
+		z	+= 3 == cell.Dimension ( ) ? node.GetCoor (2) : 0.;
+	}	// for (int n = 0; n < nbNodes; n++)
+	if (0 != nbNodes)
+	{
+		x	/= nbNodes;
+		y	/= nbNodes;
+		z	/= nbNodes;
+	}	// if (0 != nbNodes)
+}	// AbstractQualifSerie::getCellCentroid
+
+
+bool AbstractQualifSerie::isCentroidReentrant ( ) const
+{
+	return false;
+}	// AbstractQualifSerie::isCentroidReentrant
+
+
+bool AbstractQualifSerie::renumberNodes (size_t)
+{
+	return false;
+}	// AbstractQualifSerie::renumberNodes
+
 }	// namespace GQualif
 
@@ -21,14 +21,15 @@ namespace GQualif
 
 AbstractQualifTask::AbstractQualifTask (
 	size_t types, Critere criterion, const vector<AbstractQualifSerie*>& series)
-	: _types (types), _criterion (criterion), _series (series), _seriesValues( )
+	: _types (types), _criterion (criterion), _series (series), _seriesValues( ),
+	  _profile ( )
 {
 }	// AbstractQualifTask::AbstractQualifTask
 
 
 AbstractQualifTask::AbstractQualifTask (const AbstractQualifTask&)
 	: _types ((size_t)-1), _criterion ((Critere)-1), _series ( ),
-	  _seriesValues ( )
+	  _seriesValues ( ), _profile ( )
 {
 	assert (0 && "AbstractQualifTask copy constructor is not allowed.");
 }	// AbstractQualifTask::AbstractQualifTask
@@ -95,6 +96,17 @@ void AbstractQualifTask::initializeSeriesValues (
 }	// AbstractQualifTask::initializeSeriesValues
 
 
+void AbstractQualifTask::recordSeriesUse ( )
+{
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+	{
+		CHECK_NULL_PTR_ERROR (*its)
+		(*its)->recordUse (_criterion);
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+}	// AbstractQualifTask::recordSeriesUse
+
+
 bool AbstractQualifTask::isThreadable ( ) const
 {
 	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
@@ -124,6 +136,18 @@ vector< vector <size_t> >&  AbstractQualifTask::getSeriesValues ( )
 }	// AbstractQualifTask::getSeriesValues
 
 
+const QualifProfile& AbstractQualifTask::getProfile ( ) const
+{
+	return _profile;
+}	// AbstractQualifTask::getProfile
+
+
+QualifProfile& AbstractQualifTask::getProfile ( )
+{
+	return _profile;
+}	// AbstractQualifTask::getProfile
+
+
 
 
 }	// namespace GQualif
@@ -0,0 +1,805 @@
+#include "GQualif/ArrayQualifSerie.h"
+#include "GQualif/QualifHelper.h"
+#include "GQualif/StaticQualifPipeline.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/InternalError.h>
+#include <TkUtil/UTF8String.h>
+
+#include <assert.h>
+#include <string.h>
+
+
+USING_UTIL
+USING_STD
+using namespace Qualif;
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+// =============================================================================
+//                         LA CLASSE ArrayQualifSerie
+// =============================================================================
+
+ArrayQualifSerie::ArrayQualifSerie (
+		const string& name, unsigned char dimension, const string& fileName)
+	: AbstractQualifSerieAdapter (fileName, name, dimension),
+	  _nodesNum (0), _stride (dimension), _coordinates64 (0),
+	  _coordinates32 (0), _cellsNum (0), _connectivity64 (0), _offsets64 (0),
+	  _connectivity32 (0), _offsets32 (0), _types (0), _type (0),
+	  _nodesPerCell (0), _dataTypes (0), _displacements64 (0),
+	  _displacements32 (0), _displacementsStride (dimension),
+	  _displacementScale (0.)
+{
+	if ((2 != dimension) && (3 != dimension))
+	{
+		UTF8String	error (charset);
+		error << "Série " << name << " : dimension invalide ("
+		      << (unsigned long)dimension << "), 2 ou 3 attendu.";
+		throw Exception (error);
+	}	// if ((2 != dimension) && (3 != dimension))
+}	// ArrayQualifSerie::ArrayQualifSerie
+
+
+ArrayQualifSerie::ArrayQualifSerie (const ArrayQualifSerie&)
+	: AbstractQualifSerieAdapter (
+						"Invalid file name", "Invalid name", (unsigned char)-1),
+	  _nodesNum (0), _stride (0), _coordinates64 (0), _coordinates32 (0),
+	  _cellsNum (0), _connectivity64 (0), _offsets64 (0), _connectivity32 (0),
+	  _offsets32 (0), _types (0), _type (0), _nodesPerCell (0), _dataTypes (0),
+	  _displacements64 (0), _displacements32 (0), _displacementsStride (0),
+	  _displacementScale (0.)
+{
+	assert (0 && "ArrayQualifSerie copy constructor is not allowed.");
+}	// ArrayQualifSerie::ArrayQualifSerie
+
+
+ArrayQualifSerie& ArrayQualifSerie::operator = (const ArrayQualifSerie&)
+{
+	assert (0 && "ArrayQualifSerie assignment operator is not allowed.");
+	return *this;
+}	// ArrayQualifSerie::operator =
+
+
+ArrayQualifSerie::~ArrayQualifSerie ( )
+{
+}	// ArrayQualifSerie::~ArrayQualifSerie
+
+
+void ArrayQualifSerie::setCoordinates (
+						const double* coordinates, size_t nodesNum, size_t stride)
+{
+	if (0 == stride)
+		stride	= getDimension ( );
+	if (((0 == coordinates) && (0 != nodesNum)) || (stride < getDimension ( )))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : tableau des coordonnées nul "
+		      << "ou pas (" << (unsigned long)stride
+		      << ") inférieur à la dimension.";
+		throw Exception (error);
+	}	// if (((0 == coordinates) && (0 != nodesNum)) || ...
+
+	_coordinates64	= coordinates;
+	_coordinates32	= 0;
+	_nodesNum		= nodesNum;
+	_stride			= stride;
+	coordinatesModified ( );
+}	// ArrayQualifSerie::setCoordinates
+
+
+void ArrayQualifSerie::setCoordinates (
+						const float* coordinates, size_t nodesNum, size_t stride)
+{
+	if (0 == stride)
+		stride	= getDimension ( );
+	if (((0 == coordinates) && (0 != nodesNum)) || (stride < getDimension ( )))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : tableau des coordonnées nul "
+		      << "ou pas (" << (unsigned long)stride
+		      << ") inférieur à la dimension.";
+		throw Exception (error);
+	}	// if (((0 == coordinates) && (0 != nodesNum)) || ...
+
+	_coordinates64	= 0;
+	_coordinates32	= coordinates;
+	_nodesNum		= nodesNum;
+	_stride			= stride;
+	coordinatesModified ( );
+}	// ArrayQualifSerie::setCoordinates
+
+
+void ArrayQualifSerie::setCells (size_t cellsNum, const int64_t* connectivity,
+                                 const int64_t* offsets, const unsigned char* types)
+{
+	if ((0 != cellsNum) &&
+	    ((0 == connectivity) || (0 == offsets) || (0 == types)))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : tableau de connectivité, de "
+		      << "décalages ou de types nul.";
+		throw Exception (error);
+	}	// if ((0 != cellsNum) && ...
+
+	resetCells ( );
+	_cellsNum		= cellsNum;
+	_connectivity64	= connectivity;
+	_offsets64		= offsets;
+	_types			= types;
+	dataModified ( );
+}	// ArrayQualifSerie::setCells
+
+
+void ArrayQualifSerie::setCells (size_t cellsNum, const int32_t* connectivity,
+                                 const int32_t* offsets, const unsigned char* types)
+{
+	if ((0 != cellsNum) &&
+	    ((0 == connectivity) || (0 == offsets) || (0 == types)))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : tableau de connectivité, de "
+		      << "décalages ou de types nul.";
+		throw Exception (error);
+	}	// if ((0 != cellsNum) && ...
+
+	resetCells ( );
+	_cellsNum		= cellsNum;
+	_connectivity32	= connectivity;
+	_offsets32		= offsets;
+	_types			= types;
+	dataModified ( );
+}	// ArrayQualifSerie::setCells
+
+
+void ArrayQualifSerie::setCells (
+			size_t cellsNum, const int64_t* connectivity, unsigned char type)
+{
+	if (((0 != cellsNum) && (0 == connectivity)) || (0 == nodesNum (type)))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : tableau de connectivité nul ou "
+		      << "type de maille non supporté (" << (unsigned long)type << ").";
+		throw Exception (error);
+	}	// if (((0 != cellsNum) && (0 == connectivity)) || ...
+
+	resetCells ( );
+	_cellsNum		= cellsNum;
+	_connectivity64	= connectivity;
+	_type			= type;
+	_nodesPerCell	= nodesNum (type);
+	dataModified ( );
+}	// ArrayQualifSerie::setCells
+
+
+void ArrayQualifSerie::setCells (
+			size_t cellsNum, const int32_t* connectivity, unsigned char type)
+{
+	if (((0 != cellsNum) && (0 == connectivity)) || (0 == nodesNum (type)))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : tableau de connectivité nul ou "
+		      << "type de maille non supporté (" << (unsigned long)type << ").";
+		throw Exception (error);
+	}	// if (((0 != cellsNum) && (0 == connectivity)) || ...
+
+	resetCells ( );
+	_cellsNum		= cellsNum;
+	_connectivity32	= connectivity;
+	_type			= type;
+	_nodesPerCell	= nodesNum (type);
+	dataModified ( );
+}	// ArrayQualifSerie::setCells
+
+
+void ArrayQualifSerie::setCells (const ArrayQualifSerie& serie)
+{
+	resetCells ( );
+	_cellsNum		= serie._cellsNum;
+	_connectivity64	= serie._connectivity64;
+	_offsets64		= serie._offsets64;
+	_connectivity32	= serie._connectivity32;
+	_offsets32		= serie._offsets32;
+	_types			= serie._types;
+	_type			= serie._type;
+	_nodesPerCell	= serie._nodesPerCell;
+	dataModified ( );
+	_dataTypes		= serie._dataTypes;
+}	// ArrayQualifSerie::setCells
+
+
+void ArrayQualifSerie::dataModified ( )
+{
+	_dataTypes	= 0;
+	releaseStoredData ( );
+	releaseEvaluationOrder ( );
+	setCoordinatesValidity (false, false, UTF8String (charset));
+	dataRevised ( );
+}	// ArrayQualifSerie::dataModified
+
+
+void ArrayQualifSerie::coordinatesModified ( )
+{
+	const vector<Critere>	criteria	= getStoredCriteriaList ( );
+	for (vector<Critere>::const_iterator itc = criteria.begin ( );
+	     criteria.end ( ) != itc; itc++)
+		releaseStoredCriterion (*itc);
+	releaseClassesCellsIndexes ( );
+	setCoordinatesValidity (false, false, UTF8String (charset));
+	dataRevised ( );
+}	// ArrayQualifSerie::coordinatesModified
+
+
+void ArrayQualifSerie::setDisplacements (
+						const double* displacements, size_t stride)
+{
+	if (0 == stride)
+		stride	= getDimension ( );
+	if (stride < getDimension ( ))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : pas (" << (unsigned long)stride
+		      << ") des déplacements inférieur à la dimension.";
+		throw Exception (error);
+	}	// if (stride < getDimension ( ))
+
+	_displacements64		= displacements;
+	_displacements32		= 0;
+	_displacementsStride	= stride;
+	coordinatesModified ( );
+}	// ArrayQualifSerie::setDisplacements
+
+
+void ArrayQualifSerie::setDisplacements (
+						const float* displacements, size_t stride)
+{
+	if (0 == stride)
+		stride	= getDimension ( );
+	if (stride < getDimension ( ))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : pas (" << (unsigned long)stride
+		      << ") des déplacements inférieur à la dimension.";
+		throw Exception (error);
+	}	// if (stride < getDimension ( ))
+
+	_displacements64		= 0;
+	_displacements32		= displacements;
+	_displacementsStride	= stride;
+	coordinatesModified ( );
+}	// ArrayQualifSerie::setDisplacements
+
+
+bool ArrayQualifSerie::hasDisplacements ( ) const
+{
+	return (0 != _displacements64) || (0 != _displacements32);
+}	// ArrayQualifSerie::hasDisplacements
+
+
+void ArrayQualifSerie::setDisplacementScale (double scale)
+{
+	if (scale == _displacementScale)
+		return;
+
+	_displacementScale	= scale;
+	coordinatesModified ( );
+}	// ArrayQualifSerie::setDisplacementScale
+
+
+double ArrayQualifSerie::getDisplacementScale ( ) const
+{
+	return _displacementScale;
+}	// ArrayQualifSerie::getDisplacementScale
+
+
+size_t ArrayQualifSerie::getNodeCount ( ) const
+{
+	return _nodesNum;
+}	// ArrayQualifSerie::getNodeCount
+
+
+size_t ArrayQualifSerie::getCellCount ( ) const
+{
+	return _cellsNum;
+}	// ArrayQualifSerie::getCellCount
+
+
+Qualif::Maille& ArrayQualifSerie::getCell (size_t i) const
+{
+	if (i >= _cellsNum)
+	{
+		UTF8String	error (charset);
+		error << "Le groupe de données ne contient que " << _cellsNum
+		      << " mailles. Accès à la " << i << "-ème maille impossible.";
+		throw Exception (error);
+	}	// if (i >= _cellsNum)
+
+	const unsigned char	type	= cellType (i);
+	switch (type)
+	{
+		case TRIANGLE_CELL			:
+			fillCell<3> (i, _triangle);
+			return _triangle;
+		case QUADRANGLE_CELL		:
+			fillCell<4> (i, _quadrangle);
+			return _quadrangle;
+		case TETRAEDRON_CELL		:
+			fillCell<4> (i, _tetraedron);
+			return _tetraedron;
+		case PYRAMID_CELL			:
+			fillCell<5> (i, _pyramid);
+			return _pyramid;
+		case TRIANGULAR_PRISM_CELL	:
+			fillCell<6> (i, _prism);
+			return _prism;
+		case HEXAEDRON_CELL			:
+			fillCell<8> (i, _hexaedron);
+			return _hexaedron;
+	}	// switch (type)
+
+	UTF8String	error (charset);
+	error << "Maille " << i << " du groupe " << getName ( )
+	      << " : type non supporté (" << (unsigned long)type << ").";
+	throw Exception (error);
+}	// ArrayQualifSerie::getCell
+
+
+size_t ArrayQualifSerie::getCellType (size_t i) const
+{
+	if (i >= _cellsNum)
+	{
+		UTF8String	error (charset);
+		error << "Le groupe de données ne contient que " << _cellsNum
+		      << " mailles. Accès à la " << i << "-ème maille impossible.";
+		throw Exception (error);
+	}	// if (i >= _cellsNum)
+
+	const size_t	type	= qualifType (cellType (i));
+	if (0 == type)
+	{
+		UTF8String	error (charset);
+		error << "Maille " << i << " du groupe " << getName ( )
+		      << " : type non supporté (" << (unsigned long)cellType (i)
+		      << ").";
+		throw Exception (error);
+	}	// if (0 == type)
+
+	return type;
+}	// ArrayQualifSerie::getCellType
+
+
+size_t ArrayQualifSerie::evaluateCriterion (
+				Qualif::Critere criterion, size_t cellTypes,
+				size_t first, size_t last,
+				double* values, unsigned char* status) const
+{
+	const size_t	count		= last < _cellsNum ? last : _cellsNum;
+	size_t			evaluated	= 0;
+	size_t			end			= first;
+	for (size_t c = first; c < count; c = end)
+	{
+		// La séquence de rangs [c, end[ de mailles de même type :
+		const unsigned char	type	= cellType (getEvaluatedCell (c));
+		end	= 0 == _types ? count : c + 1;
+		while ((end < count) && (type == _types [getEvaluatedCell (end)]))
+			end++;
+		double*			v		= values + (c - first);
+		unsigned char*	s		= status + (c - first);
+		const size_t	qtype	= qualifType (type);
+		if ((0 != qtype) && (ALL_TYPES != cellTypes) &&
+		    (0 == (qtype & cellTypes)))
+		{
+			memset (s, CELL_SKIPPED, end - c);
+			continue;
+		}	// if ((0 != qtype) && (ALL_TYPES != cellTypes) && ...
+
+		switch (type)
+		{
+			case TRIANGLE_CELL			:
+				evaluated	+= StaticQualifPipeline<ArrayQualifSerie,
+					Triangle, 3>::evaluate (
+						*this, _triangle, criterion, c, end, v, s);
+				break;
+			case QUADRANGLE_CELL		:
+				evaluated	+= StaticQualifPipeline<ArrayQualifSerie,
+					Quadrangle, 4>::evaluate (
+						*this, _quadrangle, criterion, c, end, v, s);
+				break;
+			case TETRAEDRON_CELL		:
+				evaluated	+= StaticQualifPipeline<ArrayQualifSerie,
+					Tetraedre, 4>::evaluate (
+						*this, _tetraedron, criterion, c, end, v, s);
+				break;
+			case PYRAMID_CELL			:
+				evaluated	+= StaticQualifPipeline<ArrayQualifSerie,
+					Pyramide, 5>::evaluate (
+						*this, _pyramid, criterion, c, end, v, s);
+				break;
+			case TRIANGULAR_PRISM_CELL	:
+				evaluated	+= StaticQualifPipeline<ArrayQualifSerie,
+					Prisme, 6>::evaluate (
+						*this, _prism, criterion, c, end, v, s);
+				break;
+			case HEXAEDRON_CELL			:
+				evaluated	+= StaticQualifPipeline<ArrayQualifSerie,
+					Hexaedre, 8>::evaluate (
+						*this, _hexaedron, criterion, c, end, v, s);
+				break;
+			default						:
+				// Type non supporté :
+				memset (s, CELL_FAILED, end - c);
+		}	// switch (type)
+	}	// for (size_t c = first; c < count; c = end)
+	// Mailles inexistantes :
+	for (size_t c = first > count ? first : count; c < last; c++)
+		status [c - first]	= CELL_FAILED;
+
+	return evaluated;
+}	// ArrayQualifSerie::evaluateCriterion
+
+
+size_t ArrayQualifSerie::findDisplacementLimits (
+				Critere criterion, size_t cellTypes, double threshold,
+				double maxScale, size_t iterations, size_t first, size_t last,
+				double* scales, unsigned char* status) const
+{
+	if (false == hasDisplacements ( ))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : absence de champ de "
+		      << "déplacements.";
+		throw Exception (error);
+	}	// if (false == hasDisplacements ( ))
+
+	// Mailles propres à l'appel, la méthode étant réentrante :
+	Vecteur			noeuds [8];
+	Triangle		triangle (2, noeuds);
+	Quadrangle		quadrangle (2, noeuds);
+	Tetraedre		tetraedron (noeuds);
+	Pyramide		pyramid (noeuds);
+	Prisme			prism (noeuds);
+	Hexaedre		hexaedron (noeuds);
+	const size_t	count	= last < _cellsNum ? last : _cellsNum;
+	size_t			processed	= 0;
+	for (size_t p = first; p < count; p++)
+	{
+		const size_t		i		= getEvaluatedCell (p);
+		const unsigned char	type	= cellType (i);
+		const size_t		qtype	= qualifType (type);
+		double&				scale	= scales [p - first];
+		unsigned char&		state	= status [p - first];
+		if ((0 != qtype) && (ALL_TYPES != cellTypes) &&
+		    (0 == (qtype & cellTypes)))
+		{
+			state	= CELL_SKIPPED;
+			continue;
+		}	// if ((0 != qtype) && (ALL_TYPES != cellTypes) && ...
+
+		state	= CELL_FAILED;
+		try
+		{
+			switch (type)
+			{
+				case TRIANGLE_CELL			:
+					scale	= displacementLimit<Triangle, 3> (i, triangle,
+							criterion, threshold, maxScale, iterations);
+					break;
+				case QUADRANGLE_CELL		:
+					scale	= displacementLimit<Quadrangle, 4> (i, quadrangle,
+							criterion, threshold, maxScale, iterations);
+					break;
+				case TETRAEDRON_CELL		:
+					scale	= displacementLimit<Tetraedre, 4> (i, tetraedron,
+							criterion, threshold, maxScale, iterations);
+					break;
+				case PYRAMID_CELL			:
+					scale	= displacementLimit<Pyramide, 5> (i, pyramid,
+							criterion, threshold, maxScale, iterations);
+					break;
+				case TRIANGULAR_PRISM_CELL	:
+					scale	= displacementLimit<Prisme, 6> (i, prism,
+							criterion, threshold, maxScale, iterations);
+					break;
+				case HEXAEDRON_CELL			:
+					scale	= displacementLimit<Hexaedre, 8> (i, hexaedron,
+							criterion, threshold, maxScale, iterations);
+					break;
+				default						:
+					continue;	// Type non supporté
+			}	// switch (type)
+			state	= CELL_EVALUATED;
+			processed++;
+		}
+		catch (...)
+		{
+		}
+	}	// for (size_t p = first; p < count; p++)
+	// Mailles inexistantes :
+	for (size_t c = first > count ? first : count; c < last; c++)
+		status [c - first]	= CELL_FAILED;
+
+	return processed;
+}	// ArrayQualifSerie::findDisplacementLimits
+
+
+size_t ArrayQualifSerie::getDataTypes ( ) const
+{
+	if ((0 == _dataTypes) && (0 != _cellsNum))
+	{
+		if (0 == _types)
+			_dataTypes	= qualifType (_type);
+		else
+		{	// Parcours du seul tableau des types, sans lever d'exception :
+			bool	present [256]	= { false };
+			for (size_t c = 0; c < _cellsNum; c++)
+				present [_types [c]]	= true;
+			for (size_t t = 0; t < 256; t++)
+				if (true == present [t])
+					_dataTypes	|= qualifType ((unsigned char)t);
+		}	// else if (0 == _types)
+	}	// if ((0 == _dataTypes) && (0 != _cellsNum))
+
+	return _dataTypes;
+}	// ArrayQualifSerie::getDataTypes
+
+
+bool ArrayQualifSerie::isVolumic ( ) const
+{
+	try
+	{
+		const size_t	volumicTypes	= QualifHelper::TETRAEDRON |
+				QualifHelper::PYRAMID | QualifHelper::TRIANGULAR_PRISM |
+				QualifHelper::HEXAEDRON;
+		return 0 != (getDataTypes ( ) & volumicTypes);
+	}
+	catch (...)
+	{
+	}
+
+	return false;
+}	// ArrayQualifSerie::isVolumic
+
+
+bool ArrayQualifSerie::isThreadable ( ) const
+{
+	return true;
+}	// ArrayQualifSerie::isThreadable
+
+
+void ArrayQualifSerie::getCellCentroid (
+						size_t i, double& x, double& y, double& z) const
+{
+	if (i >= _cellsNum)
+	{
+		UTF8String	error (charset);
+		error << "Le groupe de données ne contient que " << _cellsNum
+		      << " mailles. Accès à la " << i << "-ème maille impossible.";
+		throw Exception (error);
+	}	// if (i >= _cellsNum)
+
+	const size_t	first	= cellOffset (i);
+	const size_t	count	= 0 == _types ?
+							  _nodesPerCell : cellOffset (i + 1) - first;
+	double			nx	= 0.,	ny	= 0.,	nz	= 0.;
+	x	= y	= z	= 0.;
+	for (size_t s = 0; s < count; s++)
+	{
+		nodeCoordinates (first + s, nx, ny, nz);
+		x	+= nx;
+		y	+= ny;
+		z	+= nz;
+	}	// for (size_t s = 0; s < count; s++)
+	if (0 != count)
+	{
+		x	/= count;
+		y	/= count;
+		z	/= count;
+	}	// if (0 != count)
+}	// ArrayQualifSerie::getCellCentroid
+
+
+bool ArrayQualifSerie::isCentroidReentrant ( ) const
+{
+	return true;
+}	// ArrayQualifSerie::isCentroidReentrant
+
+
+size_t ArrayQualifSerie::nodesNum (unsigned char type)
+{
+	switch (type)
+	{
+		case TRIANGLE_CELL			: return 3;
+		case QUADRANGLE_CELL		: return 4;
+		case TETRAEDRON_CELL		: return 4;
+		case PYRAMID_CELL			: return 5;
+		case TRIANGULAR_PRISM_CELL	: return 6;
+		case HEXAEDRON_CELL			: return 8;
+	}	// switch (type)
+
+	return 0;
+}	// ArrayQualifSerie::nodesNum
+
+
+size_t ArrayQualifSerie::qualifType (unsigned char type)
+{
+	switch (type)
+	{
+		case TRIANGLE_CELL			: return QualifHelper::TRIANGLE;
+		case QUADRANGLE_CELL		: return QualifHelper::QUADRANGLE;
+		case TETRAEDRON_CELL		: return QualifHelper::TETRAEDRON;
+		case PYRAMID_CELL			: return QualifHelper::PYRAMID;
+		case TRIANGULAR_PRISM_CELL	: return QualifHelper::TRIANGULAR_PRISM;
+		case HEXAEDRON_CELL			: return QualifHelper::HEXAEDRON;
+	}	// switch (type)
+
+	return 0;
+}	// ArrayQualifSerie::qualifType
+
+
+template <size_t NODES>
+void ArrayQualifSerie::fillCell (size_t i, Maille& cell) const
+{
+	const size_t	first	= cellOffset (i);
+	if ((0 != _types) && (cellOffset (i + 1) - first != NODES))
+	{
+		UTF8String	error (charset);
+		error << "Maille " << i << " du groupe " << getName ( )
+		      << " : nombre de noeuds ("
+		      << (unsigned long)(cellOffset (i + 1) - first)
+		      << ") incohérent avec le type ("
+		      << (unsigned long)cellType (i) << ").";
+		throw Exception (error);
+	}	// if ((0 != _types) && ...
+
+	double	x	= 0.,	y	= 0.,	z	= 0.;
+	for (size_t s = 0; s < NODES; s++)
+	{
+		nodeCoordinates (first + s, x, y, z);
+		cell.Modifier_Sommet (s, x, y, z);
+	}	// for (size_t s = 0; s < NODES; s++)
+}	// ArrayQualifSerie::fillCell
+
+
+template <class Cell, size_t NODES>
+double ArrayQualifSerie::displacementLimit (
+				size_t i, Cell& cell, Critere criterion, double threshold,
+				double maxScale, size_t iterations) const
+{
+	const size_t	first	= cellOffset (i);
+	if ((0 != _types) && (cellOffset (i + 1) - first != NODES))
+	{
+		UTF8String	error (charset);
+		error << "Maille " << i << " du groupe " << getName ( )
+		      << " : nombre de noeuds ("
+		      << (unsigned long)(cellOffset (i + 1) - first)
+		      << ") incohérent avec le type ("
+		      << (unsigned long)cellType (i) << ").";
+		throw Exception (error);
+	}	// if ((0 != _types) && ...
+
+	// Les sommets et leurs déplacements ne sont lus qu'une fois :
+	double	coordinates [NODES][3],	displacements [NODES][3];
+	for (size_t s = 0; s < NODES; s++)
+		nodeGeometry (first + s, coordinates [s], displacements [s]);
+	auto	acceptable	= [&] (double scale) -> bool
+	{
+		for (size_t s = 0; s < NODES; s++)
+			cell.Modifier_Sommet (s,
+					coordinates [s][0] + scale * displacements [s][0],
+					coordinates [s][1] + scale * displacements [s][1],
+					coordinates [s][2] + scale * displacements [s][2]);
+		// Une valeur NaN (maille dégénérée) n'est pas acceptable :
+		return cell.Cell::AppliqueCritere (criterion) >= threshold;
+	};
+
+	if (false == acceptable (0.))
+		return -1.;
+	if (true == acceptable (maxScale))
+		return maxScale;
+	double	lower	= 0.,	upper	= maxScale;
+	for (size_t it = 0; it < iterations; it++)
+	{
+		const double	middle	= (lower + upper) / 2.;
+		if (true == acceptable (middle))
+			lower	= middle;
+		else
+			upper	= middle;
+	}	// for (size_t it = 0; it < iterations; it++)
+
+	return lower;
+}	// ArrayQualifSerie::displacementLimit
+
+
+void ArrayQualifSerie::nodeCoordinates (
+							size_t k, double& x, double& y, double& z) const
+{
+	const size_t	node	= nodeId (k);
+	if (node >= _nodesNum)
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : noeud " << node
+		      << " inexistant (" << _nodesNum << " noeuds).";
+		throw Exception (error);
+	}	// if (node >= _nodesNum)
+
+	const size_t	index	= node * _stride;
+	if (0 != _coordinates64)
+	{
+		x	= _coordinates64 [index];
+		y	= _coordinates64 [index + 1];
+		z	= 3 == getDimension ( ) ? _coordinates64 [index + 2] : 0.;
+	}	// if (0 != _coordinates64)
+	else
+	{
+		x	= _coordinates32 [index];
+		y	= _coordinates32 [index + 1];
+		z	= 3 == getDimension ( ) ? _coordinates32 [index + 2] : 0.;
+	}	// else if (0 != _coordinates64)
+
+	// Couche virtuelle des déplacements :
+	if ((0. != _displacementScale) && (true == hasDisplacements ( )))
+	{
+		const size_t	dindex	= node * _displacementsStride;
+		if (0 != _displacements64)
+		{
+			x	+= _displacementScale * _displacements64 [dindex];
+			y	+= _displacementScale * _displacements64 [dindex + 1];
+			if (3 == getDimension ( ))
+				z	+= _displacementScale * _displacements64 [dindex + 2];
+		}	// if (0 != _displacements64)
+		else
+		{
+			x	+= _displacementScale * _displacements32 [dindex];
+			y	+= _displacementScale * _displacements32 [dindex + 1];
+			if (3 == getDimension ( ))
+				z	+= _displacementScale * _displacements32 [dindex + 2];
+		}	// else if (0 != _displacements64)
+	}	// if ((0. != _displacementScale) && ...
+}	// ArrayQualifSerie::nodeCoordinates
+
+
+void ArrayQualifSerie::nodeGeometry (
+				size_t k, double* coordinates, double* displacement) const
+{
+	const size_t	node	= nodeId (k);
+	if (node >= _nodesNum)
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : noeud " << node
+		      << " inexistant (" << _nodesNum << " noeuds).";
+		throw Exception (error);
+	}	// if (node >= _nodesNum)
+
+	const size_t	dimension	= getDimension ( );
+	const size_t	index		= node * _stride;
+	const size_t	dindex		= node * _displacementsStride;
+	coordinates [2]		= 0.;
+	displacement [2]	= 0.;
+	for (size_t d = 0; d < dimension; d++)
+	{
+		coordinates [d]		= 0 != _coordinates64 ?
+				_coordinates64 [index + d] : _coordinates32 [index + d];
+		displacement [d]	= 0 != _displacements64 ?
+				_displacements64 [dindex + d] :
+				0 != _displacements32 ? _displacements32 [dindex + d] : 0.;
+	}	// for (size_t d = 0; d < dimension; d++)
+}	// ArrayQualifSerie::nodeGeometry
+
+
+void ArrayQualifSerie::resetCells ( )
+{
+	_cellsNum		= 0;
+	_connectivity64	= 0;
+	_offsets64		= 0;
+	_connectivity32	= 0;
+	_offsets32		= 0;
+	_types			= 0;
+	_type			= 0;
+	_nodesPerCell	= 0;
+}	// ArrayQualifSerie::resetCells
+
+
+}	// namespace GQualif
@@ -0,0 +1,412 @@
+#include "GQualif/CompositeQualifSerie.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/InternalError.h>
+#include <TkUtil/UTF8String.h>
+
+#include <algorithm>
+#include <assert.h>
+
+#include <cfloat>
+
+
+USING_UTIL
+USING_STD
+using namespace Qualif;
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                           FONCTIONS UTILITAIRES
+// ============================================================================
+
+/**
+ * @return		Le nom du fichier commun aux séries transmises en argument,
+ * 				une chaîne vide si elles ne sont pas issues d'un même fichier.
+ */
+static string commonFileName (const vector<AbstractQualifSerie*>& series)
+{
+	if (true == series.empty ( ))
+		return string ( );
+
+	CHECK_NULL_PTR_ERROR (series [0])
+	const string	fileName	= series [0]->getFileName ( );
+	for (vector<AbstractQualifSerie*>::const_iterator its = series.begin ( );
+	     series.end ( ) != its; its++)
+	{
+		CHECK_NULL_PTR_ERROR (*its)
+		if (fileName != (*its)->getFileName ( ))
+			return string ( );
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+
+	return fileName;
+}	// commonFileName
+
+
+/**
+ * @return		La plus grande des dimensions des séries transmises en
+ * 				argument.
+ */
+static unsigned char maxDimension (const vector<AbstractQualifSerie*>& series)
+{
+	unsigned char	dimension	= 0;
+	for (vector<AbstractQualifSerie*>::const_iterator its = series.begin ( );
+	     series.end ( ) != its; its++)
+	{
+		CHECK_NULL_PTR_ERROR (*its)
+		dimension	= (*its)->getDimension ( ) > dimension ?
+					  (*its)->getDimension ( ) : dimension;
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+
+	return dimension;
+}	// maxDimension
+
+
+// ============================================================================
+//                        LA CLASSE CompositeQualifSerie
+// ============================================================================
+
+CompositeQualifSerie::CompositeQualifSerie (
+		const vector<AbstractQualifSerie*>& series, const string& name)
+	: AbstractQualifSerie (commonFileName (series), name, maxDimension (series)),
+	  _series (series), _offsets ( ), _offsetsRevision (0), _offsetsMutex ( )
+{
+	if (true == series.empty ( ))
+	{
+		UTF8String	error (charset);
+		error << "Série " << name << " : aucune série à concaténer.";
+		throw Exception (error);
+	}	// if (true == series.empty ( ))
+
+	const bool	volumic	= series [0]->isVolumic ( );
+	for (vector<AbstractQualifSerie*>::const_iterator its = series.begin ( );
+	     series.end ( ) != its; its++)
+	{
+		if (volumic != (*its)->isVolumic ( ))
+		{
+			UTF8String	error (charset);
+			error << "Série " << name << " : les mailles des séries "
+			      << series [0]->getName ( ) << " et " << (*its)->getName ( )
+			      << " ne sont pas de même nature.";
+			throw Exception (error);
+		}	// if (volumic != (*its)->isVolumic ( ))
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+	updateOffsets ( );
+	_offsetsRevision	= getRevision ( );
+}	// CompositeQualifSerie::CompositeQualifSerie
+
+
+CompositeQualifSerie::CompositeQualifSerie (const CompositeQualifSerie&)
+	: AbstractQualifSerie ("Invalid file name", "Invalid name", (unsigned char)-1),
+	  _series ( ), _offsets ( ), _offsetsRevision (0), _offsetsMutex ( )
+{
+	assert (0 && "CompositeQualifSerie copy constructor is not allowed.");
+}	// CompositeQualifSerie::CompositeQualifSerie
+
+
+CompositeQualifSerie& CompositeQualifSerie::operator = (
+												const CompositeQualifSerie&)
+{
+	assert (0 && "CompositeQualifSerie assignment operator is not allowed.");
+	return *this;
+}	// CompositeQualifSerie::operator =
+
+
+CompositeQualifSerie::~CompositeQualifSerie ( )
+{
+}	// CompositeQualifSerie::~CompositeQualifSerie
+
+
+const vector<AbstractQualifSerie*>& CompositeQualifSerie::getSeries ( ) const
+{
+	return _series;
+}	// CompositeQualifSerie::getSeries
+
+
+size_t CompositeQualifSerie::getCellCount ( ) const
+{
+	// Une série concaténée a pu être modifiée depuis le dernier calcul des
+	// indices des premières mailles :
+	lock_guard<mutex>	lock (_offsetsMutex);
+	const size_t		revision	= getRevision ( );
+	if (revision != _offsetsRevision)
+	{
+		updateOffsets ( );
+		_offsetsRevision	= revision;
+	}	// if (revision != _offsetsRevision)
+
+	return _offsets.back ( );
+}	// CompositeQualifSerie::getCellCount
+
+
+Maille& CompositeQualifSerie::getCell (size_t i) const
+{
+	const size_t	s	= getSerieIndex (i);
+
+	return _series [s]->getCell (i - _offsets [s]);
+}	// CompositeQualifSerie::getCell
+
+
+size_t CompositeQualifSerie::getCellType (size_t i) const
+{
+	const size_t	s	= getSerieIndex (i);
+
+	return _series [s]->getCellType (i - _offsets [s]);
+}	// CompositeQualifSerie::getCellType
+
+
+bool CompositeQualifSerie::isVolumic ( ) const
+{
+	return _series [0]->isVolumic ( );
+}	// CompositeQualifSerie::isVolumic
+
+
+bool CompositeQualifSerie::hasMeshCellIds ( ) const
+{
+	if ((true == getFileName ( ).empty ( )) || (0 == getMeshInstance ( )))
+		return false;
+
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+		if (false == (*its)->hasMeshCellIds ( ))
+			return false;
+
+	return true;
+}	// CompositeQualifSerie::hasMeshCellIds
+
+
+size_t CompositeQualifSerie::getMeshCellId (size_t i) const
+{
+	if (false == hasMeshCellIds ( ))
+		return AbstractQualifSerie::getMeshCellId (i);
+
+	const size_t	s	= getSerieIndex (i);
+
+	return _series [s]->getMeshCellId (i - _offsets [s]);
+}	// CompositeQualifSerie::getMeshCellId
+
+
+const void* CompositeQualifSerie::getMeshInstance ( ) const
+{
+	const void*	instance	= _series [0]->getMeshInstance ( );
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+		if (instance != (*its)->getMeshInstance ( ))
+			return 0;
+
+	return instance;
+}	// CompositeQualifSerie::getMeshInstance
+
+
+void CompositeQualifSerie::getDataRange (
+					Critere criterion, double& min, double& max) const
+{
+	min	= DBL_MAX;	max	= -DBL_MAX;
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+	{
+		double	serieMin	= DBL_MAX,	serieMax	= -DBL_MAX;
+		(*its)->getDataRange (criterion, serieMin, serieMax);
+		min	= serieMin < min ? serieMin : min;
+		max	= serieMax > max ? serieMax : max;
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+}	// CompositeQualifSerie::getDataRange
+
+
+bool CompositeQualifSerie::isCriteriaStored (Critere criterion) const
+{
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+		if (false == (*its)->isCriteriaStored (criterion))
+			return false;
+
+	return true;
+}	// CompositeQualifSerie::isCriteriaStored
+
+
+double CompositeQualifSerie::getStoredCriteria (
+										Critere criterion, size_t i) const
+{
+	const size_t	s	= getSerieIndex (i);
+
+	return _series [s]->getStoredCriteria (criterion, i - _offsets [s]);
+}	// CompositeQualifSerie::getStoredCriteria
+
+
+double CompositeQualifSerie::getStoredCriteriaError (Critere criterion) const
+{
+	double	error	= 0.;
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+	{
+		const double	serieError	= (*its)->getStoredCriteriaError (criterion);
+		error	= serieError > error ? serieError : error;
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+
+	return error;
+}	// CompositeQualifSerie::getStoredCriteriaError
+
+
+double CompositeQualifSerie::getCriteriaValue (Critere criterion, size_t i) const
+{
+	const size_t	s	= getSerieIndex (i);
+
+	return _series [s]->getCriteriaValue (criterion, i - _offsets [s]);
+}	// CompositeQualifSerie::getCriteriaValue
+
+
+bool CompositeQualifSerie::rebin (
+			Critere criterion, size_t cellTypes, size_t classesNum,
+			double min, double max, bool strict, vector<size_t>& counts,
+			size_t threadsNum) const
+{
+	if (false == isCriteriaStored (criterion))
+		return false;
+
+	vector<size_t>	total (classesNum, 0),	serieCounts;
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+	{
+		if (false == (*its)->rebin (criterion, cellTypes, classesNum,
+		                            min, max, strict, serieCounts, threadsNum))
+			return false;
+		for (size_t cl = 0; cl < classesNum; cl++)
+			total [cl]	+= serieCounts [cl];
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+	counts.swap (total);
+
+	return true;
+}	// CompositeQualifSerie::rebin
+
+
+bool CompositeQualifSerie::rebin (
+			Critere criterion, size_t cellTypes, size_t classesNum,
+			double min, double max, bool strict, const vector<size_t>& cells,
+			vector<size_t>& counts, size_t threadsNum) const
+{
+	if (false == isCriteriaStored (criterion))
+		return false;
+
+	// Les mailles, réparties par série concaténée :
+	const size_t				count	= getCellCount ( );
+	vector< vector<size_t> >	serieCells (_series.size ( ));
+	for (vector<size_t>::const_iterator itc = cells.begin ( );
+	     cells.end ( ) != itc; itc++)
+	{
+		if (*itc >= count)
+		{
+			UTF8String	error (charset);
+			error << "Série " << getName ( ) << " : indice de maille invalide ("
+			      << (unsigned long)*itc << ").";
+			throw Exception (error);
+		}	// if (*itc >= count)
+		const size_t	s	= getSerieIndex (*itc);
+		serieCells [s].push_back (*itc - _offsets [s]);
+	}	// for (vector<size_t>::const_iterator itc = cells.begin ( ); ...
+
+	vector<size_t>	total (classesNum, 0),	serieCounts;
+	for (size_t s = 0; s < _series.size ( ); s++)
+	{
+		if (true == serieCells [s].empty ( ))
+			continue;
+		if (false == _series [s]->rebin (criterion, cellTypes, classesNum,
+		                                 min, max, strict, serieCells [s],
+		                                 serieCounts, threadsNum))
+			return false;
+		vector<size_t> ( ).swap (serieCells [s]);
+		for (size_t cl = 0; cl < classesNum; cl++)
+			total [cl]	+= serieCounts [cl];
+	}	// for (size_t s = 0; s < _series.size ( ); s++)
+	counts.swap (total);
+
+	return true;
+}	// CompositeQualifSerie::rebin
+
+
+bool CompositeQualifSerie::isThreadable ( ) const
+{
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+		if (false == (*its)->isThreadable ( ))
+			return false;
+
+	return true;
+}	// CompositeQualifSerie::isThreadable
+
+
+vector<AbstractQualifSerie*> CompositeQualifSerie::getUnderlyingSeries ( )
+{
+	vector<AbstractQualifSerie*>	underlying;
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+	{
+		const vector<AbstractQualifSerie*>	series	=
+											(*its)->getUnderlyingSeries ( );
+		underlying.insert (underlying.end ( ), series.begin ( ), series.end ( ));
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+
+	return underlying;
+}	// CompositeQualifSerie::getUnderlyingSeries
+
+
+vector<const AbstractQualifSerie*>
+							CompositeQualifSerie::getUnderlyingSeries ( ) const
+{
+	vector<const AbstractQualifSerie*>	underlying;
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+	{
+		const AbstractQualifSerie&					serie	= **its;
+		const vector<const AbstractQualifSerie*>	series	=
+												serie.getUnderlyingSeries ( );
+		underlying.insert (underlying.end ( ), series.begin ( ), series.end ( ));
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+
+	return underlying;
+}	// CompositeQualifSerie::getUnderlyingSeries
+
+
+void CompositeQualifSerie::getCellCentroid (
+						size_t i, double& x, double& y, double& z) const
+{
+	const size_t	s	= getSerieIndex (i);
+
+	_series [s]->getCellCentroid (i - _offsets [s], x, y, z);
+}	// CompositeQualifSerie::getCellCentroid
+
+
+bool CompositeQualifSerie::isCentroidReentrant ( ) const
+{
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+		if (false == (*its)->isCentroidReentrant ( ))
+			return false;
+
+	return true;
+}	// CompositeQualifSerie::isCentroidReentrant
+
+
+void CompositeQualifSerie::updateOffsets ( ) const
+{
+	vector<size_t>	offsets (1, 0);
+	for (vector<AbstractQualifSerie*>::const_iterator its = _series.begin ( );
+	     _series.end ( ) != its; its++)
+		offsets.push_back (offsets.back ( ) + (*its)->getCellCount ( ));
+	_offsets.swap (offsets);
+}	// CompositeQualifSerie::updateOffsets
+
+
+size_t CompositeQualifSerie::getSerieIndex (size_t i) const
+{
+	// Dernière série débutant à un indice inférieur ou égal à i (les séries
+	// vides sont ignorées) :
+	return upper_bound (_offsets.begin ( ), _offsets.end ( ) - 1, i) -
+	       _offsets.begin ( ) - 1;
+}	// CompositeQualifSerie::getSerieIndex
+
+
+}	// namespace GQualif
@@ -1,11 +1,15 @@
 #include "GQualif/QCalQualThread.h"
+#include "GQualif/QualifHelper.h"
+#include "GQualif/QualifTracer.h"
 #include <TkUtil/MemoryError.h>
 #include <TkUtil/NumericServices.h>
 #include <TkUtil/UTF8String.h>
 
 #include <Maille.h>	// Qualif
 
+#include <algorithm>
 #include <iostream>
+#include <queue>
 #include <assert.h>
 
 using namespace std;
@@ -15,10 +19,33 @@ using namespace TkUtil;
 
 static const Charset	charset ("àéèùô");
 
+/** Nombre de mailles des paquets enregistrés dans la chronologie
+ * (<I>QualifTracer</I>). */
+static const size_t		traceChunkSize	= 65536;
+
+/** Nombre de mailles des paquets évalués par
+ * <I>AbstractQualifSerie::evaluateCriterion</I> (diviseur de
+ * <I>traceChunkSize</I>). */
+static const size_t		evaluationChunkSize	= 4096;
+
 
 namespace GQualif
 {
 
+/**
+ * @return		Le complément d'information d'un paquet de mailles
+ * 				[first, last[ de la chronologie.
+ */
+static string chunkDetail (size_t first, size_t last)
+{
+	UTF8String	detail (charset);
+	detail << "Mailles " << (unsigned long)first << " à "
+	       << (unsigned long)(last - 1);
+
+	return detail.utf8 ( );
+}	// chunkDetail
+
+
 // ============================================================================
 //                         LA CLASSE QCalQualThread
 // ============================================================================
@@ -51,63 +78,192 @@ QCalQualThread::~QCalQualThread ( )
 void QCalQualThread::execute ( )
 {
 	QualifSerieData*	data	= dynamic_cast<QualifSerieData*>(getData ( ));
+	if (0 != data)
+		analyse (*data);
+}	// QCalQualThread::execute
+
+
+void QCalQualThread::analyse (QualifSerieData& data)
+{
 	try
 	{
-		CHECK_NULL_PTR_ERROR (data)
-		const size_t				classNum	= data->classNum ( );
+		const size_t				classNum	= data.classNum ( );
 		if (0 == classNum)
 			throw Exception (UTF8String ("Nombre de classes nul.", charset));
-		const AbstractQualifSerie&	serie		= data->serie ( );
+		const AbstractQualifSerie&	serie		= data.serie ( );
 		const size_t				count		= serie.getCellCount ( );
-		const Qualif::Critere		criterion	= data->criterion ( );
-		const size_t				cellTypes	= data->cellTypes ( );
-		const double				min			= data->min ( );
-		const double				max			= data->max ( );
-		const bool					strictMode	= data->strictMode ( );
+		const Qualif::Critere		criterion	= data.criterion ( );
+		const size_t				cellTypes	= data.cellTypes ( );
+		const double				min			= data.min ( );
+		const double				max			= data.max ( );
+		const bool					strictMode	= data.strictMode ( );
 		const double				cnRatio		= max/classNum - min/classNum;
-		for (size_t c = 0; c < count; c++)
+		// Erreur commise sur les valeurs en cache (valeurs quantifiées) :
+		const double				error		=
+								serie.getStoredCriteriaError (criterion);
+		// Instrumentation : en mode détaillé chaque appel est chronométré,
+		// sinon le temps de parcours de la série est attribué à l'évaluation
+		// du critère.
+		QualifProfile&				profile		= data.profile ( );
+		const bool					detailed	=
+										QualifProfile::detailedTimings ( );
+		QualifHardwareCounters		hardwareCounters;
+		QualifPhaseTimer			serieTimer (profile,
+							QualifProfile::CRITERION_EVALUATION, !detailed);
+		// Chronologie : le thread, et des paquets de traceChunkSize mailles.
+		const bool					tracing		= QualifTracer::enabled ( );
+		if (true == tracing)
+			QualifTracer::setThreadName ("QCalQualThread " + serie.getName ( ));
+		QualifTraceScope			threadScope ("QCalQualThread", "thread",
+													serie.getName ( ));
+		QualifTracer::Clock::time_point	chunkStart;
+		if (true == tracing)
+			chunkStart	= QualifTracer::Clock::now ( );
+		const bool					chunked		= (false == detailed) &&
+							(false == serie.isCriteriaStored (criterion));
+		if (true == chunked)
+		{	// Evaluation par paquets : la série traite chaque paquet par type
+			// de maille (cf. StaticQualifPipeline) plutôt que maille par
+			// maille, et dans son ordre d'évaluation (les mailles sont
+			// classées selon leur indice d'origine).
+			vector<double>			values (evaluationChunkSize);
+			vector<unsigned char>	status (evaluationChunkSize);
+			for (size_t first = 0; first < count; first += evaluationChunkSize)
+			{
+				const size_t	last	= first + evaluationChunkSize < count ?
+										  first + evaluationChunkSize : count;
+				serie.evaluateCriterion (criterion, cellTypes, first, last,
+				                         &values [0], &status [0]);
+				for (size_t p = first; p < last; p++)
+				{
+					switch (status [p - first])
+					{
+						case AbstractQualifSerie::CELL_SKIPPED	:
+							profile.increment (QualifProfile::CELLS_SKIPPED);
+							continue;
+						case AbstractQualifSerie::CELL_FAILED	:
+							profile.increment (
+										QualifProfile::EXCEPTIONS_CAUGHT);
+							continue;
+					}	// switch (status [p - first])
+					const double	value	= values [p - first];
+					profile.increment (QualifProfile::CELLS_EVALUATED);
+					if ((true == strictMode) &&
+					    ((value < min) || (value > max)))
+					{
+						profile.increment (QualifProfile::CELLS_SKIPPED);
+						continue;
+					}	// if ((true == strictMode) && ...
+					const size_t	cl	= QualifHelper::getClassIndex (
+											value, min, cnRatio, classNum);
+					data.increment (cl, serie.getEvaluatedCell (p));
+				}	// for (size_t p = first; p < last; p++)
+
+				if ((true == tracing) &&
+				    ((0 == last % traceChunkSize) || (last == count)))
+				{
+					const QualifTracer::Clock::time_point	now	=
+												QualifTracer::Clock::now ( );
+					QualifTracer::addEvent ("Paquet", "chunk", chunkStart, now,
+						chunkDetail (((last - 1) / traceChunkSize) *
+						             traceChunkSize, last));
+					chunkStart	= now;
+				}	// if ((true == tracing) && ...
+			}	// for (size_t first = 0; first < count; ...
+		}	// if (true == chunked)
+		else
 		{
-			try
+			for (size_t c = 0; c < count; c++)
 			{
-				if (0 == (serie.getCellType (c) & cellTypes))
-					continue;
-
-				double value;
-				if(serie.isCriteriaStored (criterion))
-					value = serie.getStoredCriteria (criterion,c);
-				else
+				if ((true == tracing) && (0 != c) && (0 == c % traceChunkSize))
+				{
+					const QualifTracer::Clock::time_point	now	=
+													QualifTracer::Clock::now ( );
+					QualifTracer::addEvent ("Paquet", "chunk", chunkStart, now,
+					                        chunkDetail (c - traceChunkSize, c));
+					chunkStart	= now;
+				}	// if ((true == tracing) && (0 != c) && ...
+
+				try
 				{
-					Maille&	cell	= serie.getCell (c);
-					value	= cell.AppliqueCritere (criterion);
+					{
+						QualifPhaseTimer	timer (
+								profile, QualifProfile::TYPE_SCANNING, detailed);
+						if (0 == (serie.getCellType (c) & cellTypes))
+						{
+							profile.increment (QualifProfile::CELLS_SKIPPED);
+							continue;
+						}	// if (0 == (serie.getCellType (c) & cellTypes))
+					}
+
+					double value;
+					if(serie.isCriteriaStored (criterion))
+					{
+						QualifPhaseTimer	timer (profile,
+								QualifProfile::CRITERION_EVALUATION, detailed);
+						value = serie.getStoredCriteria (criterion,c);
+						if ((0. != error) &&
+						    (true == QualifHelper::isClassAmbiguous (
+										value, error, min, max, cnRatio)))
+							value	= serie.getCriteriaValue (criterion, c);
+					}
+					else
+					{
+						Maille*	cell	= 0;
+						{
+							QualifPhaseTimer	timer (profile,
+								QualifProfile::COORDINATES_GATHERING, detailed);
+							cell	= &serie.getCell (c);
+						}
+						QualifPhaseTimer	timer (profile,
+								QualifProfile::CRITERION_EVALUATION, detailed);
+						value	= cell->AppliqueCritere (criterion);
+					}
+					profile.increment (QualifProfile::CELLS_EVALUATED);
+					QualifPhaseTimer	timer (
+								profile, QualifProfile::BINNING, detailed);
+					if ((true == strictMode) && ((value < min) || (value > max)))
+					{
+						profile.increment (QualifProfile::CELLS_SKIPPED);
+						continue;
+					}	// if ((true == strictMode) && ...
+					const size_t	cl	= QualifHelper::getClassIndex (
+											value, min, cnRatio, classNum);
+					data.increment (cl, c);
 				}
-				if ((true == strictMode) && ((value < min) || (value > max)))
-					continue;
-				size_t	cl	= (value - min) / cnRatio;
-				if (cl >= classNum)
-					cl	= classNum - 1;
-				data->increment (cl, c);
-			}
-			catch (...)
-			{	// Certains types ne sont pas supportés (pentagone, ...).
-					// On ne s'arrête pas à ça.
-			}
-		}	// for (size_t c = 0; c < count; c++)
-		data->setCompletionStatus (true);
+				catch (...)
+				{	// Certains types ne sont pas supportés (pentagone, ...).
+						// On ne s'arrête pas à ça.
+					profile.increment (QualifProfile::EXCEPTIONS_CAUGHT);
+				}
+			}	// for (size_t c = 0; c < count; c++)
+			if ((true == tracing) && (0 != count))
+				QualifTracer::addEvent ("Paquet", "chunk", chunkStart,
+						QualifTracer::Clock::now ( ),
+						chunkDetail (((count - 1) / traceChunkSize) * traceChunkSize,
+						             count));
+		}	// else if (true == chunked)
+		serieTimer.stop ( );
+		{
+			QualifPhaseTimer	timer (profile, QualifProfile::BINNING);
+			data.sortClassment ( );
+		}
+		threadScope.stop ( );
+		hardwareCounters.stop (profile);
+		data.setCompletionStatus (true);
 	}
 	catch (const Exception& e)
 	{
 		UTF8String	message (charset);
 		message << "Erreur lors de l'analyse de qualité : "
 		        << "\n" << e.getFullMessage ( );
-		if (0 != data)
-			data->setCompletionStatus (false, message);
+		data.setCompletionStatus (false, message);
 	}
 	catch (...)
 	{
-		if (0 != data)
-			data->setCompletionStatus (false, "Erreur non documentée dans l'analyse de qualité.");
+		data.setCompletionStatus (false, "Erreur non documentée dans l'analyse de qualité.");
 	}
-}	// QCalQualThread::execute
+}	// QCalQualThread::analyse
 
 
 // ============================================================================
@@ -120,11 +276,13 @@ QualifSerieData::QualifSerieData (
 			bool strictMode)
 	: _serie (serie), _criterion (criterion),
 	  _classNum (classNum), _cellTypes (cellTypes), _min (min), _max (max),
-	  _strictMode (strictMode), _classment ( )
+	  _strictMode (strictMode), _cells ( ), _classes ( ),
+	  _offsets (classNum + 1, 0), _sorted (false), _profile ( )
 {
 	if (0 == classNum)
 		throw Exception (UTF8String ("Constructeur de QualifSerieData : nombre de classes nul.", charset));
-	_classment.resize (classNum);
+	if (classNum > (size_t)UINT32_MAX)
+		throw Exception (UTF8String ("Constructeur de QualifSerieData : nombre de classes trop élevé.", charset));
 }	// QualifSerieData::QualifSerieData
 
 
@@ -132,7 +290,8 @@ QualifSerieData::QualifSerieData (const QualifSerieData& qsd)
 	: _serie (qsd._serie), _criterion (qsd._criterion),
 	  _classNum (qsd._classNum), _cellTypes (qsd._cellTypes),
 	  _min (qsd._min), _max (qsd._max), _strictMode (qsd._strictMode),
-	  _classment (qsd._classment)
+	  _cells (qsd._cells), _classes (qsd._classes),
+	  _offsets (qsd._offsets), _sorted (qsd._sorted), _profile (qsd._profile)
 {
 }	// QualifSerieData::QualifSerieData
 
@@ -149,12 +308,34 @@ QualifSerieData::~QualifSerieData ( )
 }	// QualifSerieData::~QualifSerieData
 
 
-void QualifSerieData::increment (unsigned char cl, size_t cell)
+void QualifSerieData::increment (size_t cl, size_t cell)
 {
-	_classment [cl]	.push_back (cell);
+	if (true == _sorted)
+		throw Exception (UTF8String ("QualifSerieData::increment : classement déjà effectué.", charset));
+	_cells.push_back (cell);
+	_classes.push_back ((uint32_t)cl);
+	_offsets [cl + 1]++;
 }	// QualifSerieData::increment
 
 
+void QualifSerieData::sortClassment ( )
+{
+	if (true == _sorted)
+		return;
+
+	// Indice de la première maille de chaque classe, puis rangement :
+	for (size_t cl = 1; cl <= _classNum; cl++)
+		_offsets [cl]	+= _offsets [cl - 1];
+	vector<size_t>	next (_offsets.begin ( ), _offsets.end ( ) - 1);
+	vector<size_t>	cells (_cells.size ( ));
+	for (size_t k = 0; k < _cells.size ( ); k++)
+		cells [next [_classes [k]]++]	= _cells [k];
+	_cells.swap (cells);
+	vector<uint32_t> ( ).swap (_classes);
+	_sorted	= true;
+}	// QualifSerieData::sortClassment
+
+
 void QualifSerieData::setRange (double min, double max)
 {
 	_min	= min;
@@ -162,9 +343,19 @@ void QualifSerieData::setRange (double min, double max)
 }	// QualifSerieData::setRange
 
 
-size_t QualifSerieData::cellNum (unsigned char cl) const
+const size_t* QualifSerieData::classCells (size_t cl) const
 {
-	return _classment [cl].size ( );
+	if (false == _sorted)
+		throw Exception (UTF8String ("QualifSerieData::classCells : classement non effectué.", charset));
+
+	return true == _cells.empty ( ) ? 0 : &_cells [0] + _offsets [cl];
+}	// QualifSerieData::classCells
+
+
+size_t QualifSerieData::cellNum (size_t cl) const
+{
+	return true == _sorted ?
+	       _offsets [cl + 1] - _offsets [cl] : _offsets [cl + 1];
 }	// QualifSerieData::cellNum
 
 
@@ -200,57 +391,254 @@ QSerieRangeThread::~QSerieRangeThread ( )
 void QSerieRangeThread::execute ( )
 {
 	QualifSerieData*	data	= dynamic_cast<QualifSerieData*>(getData ( ));
+	if (0 != data)
+		computeRange (*data);
+}	// QSerieRangeThread::execute
+
+
+void QSerieRangeThread::computeRange (QualifSerieData& data)
+{
 	try
 	{
-		CHECK_NULL_PTR_ERROR (data)
+		QualifProfile&			profile		= data.profile ( );
+		QualifHardwareCounters	hardwareCounters;
 		double	min	= NumericServices::doubleMachMax ( );
 		double	max	= -NumericServices::doubleMachMax ( );
-		const AbstractQualifSerie&	serie	= data->serie ( );
-		serie.getDataRange (data->criterion ( ), min, max);
+		const AbstractQualifSerie&	serie	= data.serie ( );
+		if (true == QualifTracer::enabled ( ))
+			QualifTracer::setThreadName ("QSerieRangeThread " + serie.getName ( ));
+		QualifTraceScope		threadScope ("QSerieRangeThread", "thread",
+		                                     serie.getName ( ));
+		const size_t			count		= serie.getCellCount ( );
+		const size_t			cellTypes	= data.cellTypes ( );
+		const Qualif::Critere	criterion	= data.criterion ( );
+		if (false == serie.isCriteriaStored (criterion))
+		{	// Evaluation et mise en cache du critère pour toutes les mailles :
+			QualifPhaseTimer	timer (
+							profile, QualifProfile::CRITERION_EVALUATION);
+			QualifTraceScope	scope (QualifProfile::phaseName (
+					QualifProfile::CRITERION_EVALUATION), "phase", "getDataRange");
+			serie.getDataRange (criterion, min, max);
+			profile.increment (QualifProfile::CELLS_EVALUATED, count);
+			profile.increment (QualifProfile::BYTES_CACHED,
+			                   serie.getMemoryUsage (criterion));
+		}	// if (false == serie.isCriteriaStored (criterion))
 
 		// Le domaine obtenu ne prend pas en compte les types de mailles :
+		QualifPhaseTimer	timer (profile, QualifProfile::TYPE_SCANNING);
+		QualifTraceScope	scope (
+			QualifProfile::phaseName (QualifProfile::TYPE_SCANNING), "phase");
 		min	= NumericServices::doubleMachMax ( );
 		max	= -NumericServices::doubleMachMax ( );
-		const size_t			count		= serie.getCellCount ( );
-		const size_t			cellTypes	= data->cellTypes ( );
-		const Qualif::Critere	criterion	= data->criterion ( );
 		for (size_t c = 0; c < count; c++)
 		{
 			if (0 == (serie.getCellType (c) & cellTypes))
+			{
+				profile.increment (QualifProfile::CELLS_SKIPPED);
 				continue;
+			}	// if (0 == (serie.getCellType (c) & cellTypes))
 
 			try
 			{
-				if (0 == (serie.getCellType (c) & cellTypes))
-					continue;
-
 				double value	= serie.getStoredCriteria (criterion, c);
 				min	= value < min ? value : min;
 				max	= value > max ? value : max;
 			}
 			catch (...)
 			{
+				profile.increment (QualifProfile::EXCEPTIONS_CAUGHT);
 			}
 		}	// for (size_t c = 0; c < count; c++)
 
-		data->setRange (min, max);
-		data->setCompletionStatus (true);
+		// Valeurs quantifiées : les extrema sont recalculés en pleine
+		// précision parmi les mailles susceptibles de les atteindre :
+		const double	error	= serie.getStoredCriteriaError (criterion);
+		if ((0. != error) && (min <= max))
+		{
+			const double	lower	= min + 2. * error;
+			const double	upper	= max - 2. * error;
+			min	= NumericServices::doubleMachMax ( );
+			max	= -NumericServices::doubleMachMax ( );
+			for (size_t c = 0; c < count; c++)
+			{
+				if (0 == (serie.getCellType (c) & cellTypes))
+					continue;
+
+				try
+				{
+					double value	= serie.getStoredCriteria (criterion, c);
+					if ((value > lower) && (value < upper))
+						continue;
+					value	= serie.getCriteriaValue (criterion, c);
+					min	= value < min ? value : min;
+					max	= value > max ? value : max;
+				}
+				catch (...)
+				{
+				}
+			}	// for (size_t c = 0; c < count; c++)
+		}	// if ((0. != error) && (min <= max))
+		timer.stop ( );
+		scope.stop ( );
+		threadScope.stop ( );
+		hardwareCounters.stop (profile);
+
+		data.setRange (min, max);
+		data.setCompletionStatus (true);
 	}
 	catch (const Exception& e)
 	{
 		UTF8String	message (charset);
 		message << "Erreur lors de l'analyse de qualité : "
 		        << "\n" << e.getFullMessage ( );
-		if (0 != data)
-			data->setCompletionStatus (false, message);
+		data.setCompletionStatus (false, message);
 	}
 	catch (...)
 	{
-		if (0 != data)
-			data->setCompletionStatus (false, "Erreur non documentée dans l'analyse de qualité.");
+		data.setCompletionStatus (false, "Erreur non documentée dans l'analyse de qualité.");
 	}
-}	// QSerieRangeThread::execute
+}	// QSerieRangeThread::computeRange
 
 
-}	// namespace GQualif
+// ============================================================================
+//                         LA CLASSE QualifSeriesBatch
+// ============================================================================
+
+QualifSeriesBatch::QualifSeriesBatch (bool range)
+	: _range (range), _series ( ), _cellCount (0)
+{
+}	// QualifSeriesBatch::QualifSeriesBatch
+
+
+QualifSeriesBatch::QualifSeriesBatch (const QualifSeriesBatch&)
+	: _range (false), _series ( ), _cellCount (0)
+{
+	assert (0 && "QualifSeriesBatch copy constructor is not allowed.");
+}	// QualifSeriesBatch::QualifSeriesBatch
+
+
+QualifSeriesBatch& QualifSeriesBatch::operator = (const QualifSeriesBatch&)
+{
+	assert (0 && "QualifSeriesBatch assignment operator is not allowed.");
+	return *this;
+}	// QualifSeriesBatch::operator =
 
+
+QualifSeriesBatch::~QualifSeriesBatch ( )
+{
+}	// QualifSeriesBatch::~QualifSeriesBatch
+
+
+void QualifSeriesBatch::add (QualifSerieData& data)
+{
+	_series.push_back (&data);
+	_cellCount	+= data.serie ( ).getCellCount ( );
+}	// QualifSeriesBatch::add
+
+
+vector<QualifSeriesBatch*> QualifSeriesBatch::pack (
+				const vector<QualifSerieData*>& data, bool range, size_t batchesNum)
+{
+	batchesNum	= QualifHelper::getThreadsNum (batchesNum);
+
+	// Les séries partageant une série sous-jacente (vues) sont affectées à
+	// un même lot. Les groupes de séries, par ordre décroissant de nombre de
+	// mailles :
+	vector<const AbstractQualifSerie*>	series;
+	series.reserve (data.size ( ));
+	for (size_t i = 0; i < data.size ( ); i++)
+	{
+		CHECK_NULL_PTR_ERROR (data [i])
+		series.push_back (&data [i]->serie ( ));
+	}	// for (size_t i = 0; i < data.size ( ); i++)
+	const vector< vector<size_t> >	groups	=
+							AbstractQualifSerie::groupSharingSeries (series);
+	vector< pair<size_t, size_t> >	sizes;
+	sizes.reserve (groups.size ( ));
+	for (size_t g = 0; g < groups.size ( ); g++)
+	{
+		size_t	count	= 0;
+		for (vector<size_t>::const_iterator iti = groups [g].begin ( );
+		     groups [g].end ( ) != iti; iti++)
+			count	+= series [*iti]->getCellCount ( );
+		sizes.push_back (pair<size_t, size_t> (count, g));
+	}	// for (size_t g = 0; g < groups.size ( ); g++)
+	sort (sizes.rbegin ( ), sizes.rend ( ));
+
+	// Affectation de chaque groupe au lot le moins chargé (tas des couples
+	// nombre de mailles/indice du lot) :
+	vector<QualifSeriesBatch*>	batches;
+	priority_queue< pair<size_t, size_t>, vector< pair<size_t, size_t> >,
+	                greater< pair<size_t, size_t> > >	loads;
+	for (vector< pair<size_t, size_t> >::const_iterator its = sizes.begin ( );
+	     sizes.end ( ) != its; its++)
+	{
+		size_t	b	= batches.size ( );
+		if (b < batchesNum)
+			batches.push_back (new QualifSeriesBatch (range));
+		else
+		{
+			b	= loads.top ( ).second;
+			loads.pop ( );
+		}	// else if (b < batchesNum)
+		const vector<size_t>&	group	= groups [(*its).second];
+		for (vector<size_t>::const_iterator iti = group.begin ( );
+		     group.end ( ) != iti; iti++)
+			batches [b]->add (*(data [*iti]));
+		loads.push (pair<size_t, size_t> (batches [b]->cellCount ( ), b));
+	}	// for (vector< pair<size_t, size_t> >::const_iterator its = ...
+
+	return batches;
+}	// QualifSeriesBatch::pack
+
+
+// ============================================================================
+//                         LA CLASSE QSeriesBatchThread
+// ============================================================================
+
+QSeriesBatchThread::QSeriesBatchThread (QualifSeriesBatch& batch)
+	: ReportedJoinableThread < QualifSeriesBatch > (&batch)
+{
+}	// QSeriesBatchThread::QSeriesBatchThread
+
+
+QSeriesBatchThread::QSeriesBatchThread (const QSeriesBatchThread&)
+	: ReportedJoinableThread < QualifSeriesBatch > (0)
+{
+	assert (0 && "QSeriesBatchThread copy constructor is not allowed.");
+}	// QSeriesBatchThread::QSeriesBatchThread
+
+
+QSeriesBatchThread& QSeriesBatchThread::operator = (const QSeriesBatchThread&)
+{
+	assert (0 && "QSeriesBatchThread assignment operator is not allowed.");
+	return *this;
+}	// QSeriesBatchThread::operator =
+
+
+QSeriesBatchThread::~QSeriesBatchThread ( )
+{
+}	// QSeriesBatchThread::~QSeriesBatchThread
+
+
+void QSeriesBatchThread::execute ( )
+{
+	QualifSeriesBatch*	batch	= dynamic_cast<QualifSeriesBatch*>(getData ( ));
+	if (0 == batch)
+		return;
+
+	// Chaque série renseigne son propre statut d'achèvement :
+	const vector<QualifSerieData*>&	series	= batch->series ( );
+	for (vector<QualifSerieData*>::const_iterator its = series.begin ( );
+	     series.end ( ) != its; its++)
+	{
+		if (true == batch->range ( ))
+			QSerieRangeThread::computeRange (**its);
+		else
+			QCalQualThread::analyse (**its);
+	}	// for (vector<QualifSerieData*>::const_iterator its = ...
+	batch->setCompletionStatus (true);
+}	// QSeriesBatchThread::execute
+
+
+}	// namespace GQualif
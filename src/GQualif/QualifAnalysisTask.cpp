@@ -1,5 +1,7 @@
 #include "GQualif/QualifAnalysisTask.h"
 #include "GQualif/QCalQualThread.h"
+#include "GQualif/QualifHelper.h"
+#include "GQualif/QualifTracer.h"
 
 #include <TkUtil/Exception.h>
 #include <TkUtil/InternalError.h>
@@ -98,6 +100,10 @@ void QualifAnalysisTask::execute ( )
 	if (0 == classNum)
 		throw Exception (UTF8String ("QualifAnalysisTask::execute : nombre de classes nul.", charset));
 	initializeSeriesValues (classNum, seriesNum);
+	QualifProfile&					profile	= getProfile ( );
+	profile.reset ( );
+	QualifTraceScope				taskScope ("QualifAnalysisTask", "task");
+	recordSeriesUse ( );
 	vector<AbstractQualifSerie*>&	series	= getSeries ( );
 	for (i = 0; i < seriesNum; i++)
 	{
@@ -121,23 +127,34 @@ void QualifAnalysisTask::execute ( )
 			QualifSerieData*	threadData	= new QualifSerieData (
 				*serie, criterion, classNum, cellTypes, min, max, strict);
 			threadsData.push_back (threadData);
-			QCalQualThread*	thread	= new QCalQualThread (*threadData);
-			ThreadManager::instance ( ).addTask (thread);
 		}	// for (i = 0; i < seriesNum; i++)
+		// Les séries sont réparties en lots (un thread par lot) :
+		vector<QualifSeriesBatch*>	batches	=
+								QualifSeriesBatch::pack (threadsData, false);
+		for (vector<QualifSeriesBatch*>::iterator itb = batches.begin ( );
+		     batches.end ( ) != itb; itb++)
+			ThreadManager::instance ( ).addTask (new QSeriesBatchThread (**itb));
 		ThreadManager::instance ( ).join ( );
+		for (vector<QualifSeriesBatch*>::iterator itb = batches.begin ( );
+		     batches.end ( ) != itb; itb++)
+			delete *itb;
+		QualifPhaseTimer	timer (profile, QualifProfile::MERGE);
+		QualifTraceScope	scope (
+					QualifProfile::phaseName (QualifProfile::MERGE), "phase");
 		i	= 0;
 		for (vector<QualifSerieData*>::iterator ittd = threadsData.begin ( );
 		     threadsData.end ( ) != ittd; ittd++, i++)
 		{
 			CHECK_NULL_PTR_ERROR (*ittd)
-			const vector< vector <size_t> >& classment	= (*ittd)->classment( );
-			for (unsigned char cl = 0; cl < classNum; cl++)
+			profile.merge ((*ittd)->profile ( ));
+			(*ittd)->sortClassment ( );
+			for (size_t cl = 0; cl < classNum; cl++)
 			{
-				const vector<size_t>&	ids	= classment [cl];
-				for (vector<size_t>::const_iterator iti = ids.begin ( );
-				     ids.end ( ) != iti; iti++)
-					increment (cl, i, *iti);
-			}	// for (unsigned char cl = 0; cl < classNum; cl++)
+				const size_t*	ids	= (*ittd)->classCells (cl);
+				const size_t	num	= (*ittd)->cellNum (cl);
+				for (size_t k = 0; k < num; k++)
+					increment (cl, i, ids [k]);
+			}	// for (size_t cl = 0; cl < classNum; cl++)
 			delete *ittd;
 		}	// for (vector<QualifSerieData*>::iterator ittd = ...
 		threadsData.clear ( );
@@ -145,41 +162,57 @@ void QualifAnalysisTask::execute ( )
 	else
 	{
 //cout << "LANCEMENT ANALYSE QUALIF EN MODE MONOTHREAD" << endl;
-		const double	cnRatio	= max / classNum - min / classNum;
+		const double		cnRatio	= max / classNum - min / classNum;
+		QualifPhaseTimer	timer (profile, QualifProfile::CRITERION_EVALUATION);
+		QualifTraceScope	scope (QualifProfile::phaseName (
+			QualifProfile::CRITERION_EVALUATION), "phase", "monothread");
 		for (i = 0; i < seriesNum; i++)
 		{
 			AbstractQualifSerie*	serie	= series [i];
 			CHECK_NULL_PTR_ERROR (serie)
 			const size_t			count	= serie->getCellCount ( );
+			const double			error	=
+								serie->getStoredCriteriaError (criterion);
 			for (size_t c = 0; c < count; c++)
 			{
 				try
 				{
 
 					if (0 == (serie->getCellType (c) & cellTypes))
+					{
+						profile.increment (QualifProfile::CELLS_SKIPPED);
 						continue;
+					}	// if (0 == (serie->getCellType (c) & cellTypes))
 
 					double value;
 					if(serie->isCriteriaStored (criterion))
 					{
 						value = serie->getStoredCriteria(criterion,c);
+						if ((0. != error) &&
+						    (true == QualifHelper::isClassAmbiguous (
+										value, error, min, max, cnRatio)))
+							value	= serie->getCriteriaValue (criterion, c);
 					}
 					else
 					{
 						Maille&	cell	= serie->getCell (c);
 						value	= cell.AppliqueCritere (criterion);
 					}
+					profile.increment (QualifProfile::CELLS_EVALUATED);
 					if ((true == strict) && ((value < min) || (value > max)))
+					{
+						profile.increment (QualifProfile::CELLS_SKIPPED);
 						continue;
-					size_t	cl	= (value - min) / cnRatio;
-					if (cl >= classNum)
-						cl	= classNum - 1;
+					}	// if ((true == strict) && ...
+					const size_t	cl	= QualifHelper::getClassIndex (
+											value, min, cnRatio, classNum);
 					increment (cl, i, c);
 
 				}
 				catch (...)
 				{	// Certains types ne sont pas supportés (pentagone, ...).
 					// On ne s'arrête pas à ça.
+					profile.increment (QualifProfile::EXCEPTIONS_CAUGHT);
 				}
 
 			}	// for (size_t c = 0; c < count; c++)
@@ -0,0 +1,250 @@
+#include "GQualif/QualifDisplacementSweepTask.h"
+#include "GQualif/QualifHelper.h"
+#include "GQualif/QualifTracer.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/InternalError.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <assert.h>
+
+
+USING_UTIL
+USING_STD
+using namespace Qualif;
+
+static const	Charset	charset ("àéèùô");
+
+/** Nombre de mailles des paquets traités par
+ * <I>ArrayQualifSerie::findDisplacementLimits</I> (chaque maille coûtant de
+ * l'ordre de <I>iterations</I> évaluations du critère). */
+static const size_t		sweepChunkSize	= 512;
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                    LA CLASSE QualifDisplacementSweepTask
+// ============================================================================
+
+QualifDisplacementSweepTask::QualifDisplacementSweepTask (
+			size_t types, Critere criterion, double threshold, double maxScale,
+			size_t classesNum, ArrayQualifSerie& serie, size_t worstCellsNum,
+			size_t iterations, size_t threadsNum)
+	: AbstractQualifTask (types, criterion,
+	                      vector<AbstractQualifSerie*> (1, &serie)),
+	  _serie (&serie), _threshold (threshold), _maxScale (maxScale),
+	  _classesNum (classesNum), _worstCellsNum (worstCellsNum),
+	  _iterations (iterations), _threadsNum (threadsNum),
+	  _invalidCellsNum (0), _acceptableCellsNum (0), _worstCells ( ),
+	  _limits ( )
+{
+}	// QualifDisplacementSweepTask::QualifDisplacementSweepTask
+
+
+QualifDisplacementSweepTask::QualifDisplacementSweepTask (
+										const QualifDisplacementSweepTask&)
+	: AbstractQualifTask ((size_t)-1, (Critere)-1,
+	                      vector<AbstractQualifSerie*> ( )),
+	  _serie (0), _threshold (0.), _maxScale (0.), _classesNum (0),
+	  _worstCellsNum (0), _iterations (0), _threadsNum (0),
+	  _invalidCellsNum (0), _acceptableCellsNum (0), _worstCells ( ),
+	  _limits ( )
+{
+	assert (0 && "QualifDisplacementSweepTask copy constructor is not allowed.");
+}	// QualifDisplacementSweepTask::QualifDisplacementSweepTask
+
+
+QualifDisplacementSweepTask& QualifDisplacementSweepTask::operator = (
+										const QualifDisplacementSweepTask&)
+{
+	assert (0 && "QualifDisplacementSweepTask assignment operator is not allowed.");
+	return *this;
+}	// QualifDisplacementSweepTask::operator =
+
+
+QualifDisplacementSweepTask::~QualifDisplacementSweepTask ( )
+{
+}	// QualifDisplacementSweepTask::~QualifDisplacementSweepTask
+
+
+double QualifDisplacementSweepTask::getThreshold ( ) const
+{
+	return _threshold;
+}	// QualifDisplacementSweepTask::getThreshold
+
+
+double QualifDisplacementSweepTask::getMaxScale ( ) const
+{
+	return _maxScale;
+}	// QualifDisplacementSweepTask::getMaxScale
+
+
+size_t QualifDisplacementSweepTask::getClassesNum ( ) const
+{
+	return _classesNum;
+}	// QualifDisplacementSweepTask::getClassesNum
+
+
+size_t QualifDisplacementSweepTask::getIterations ( ) const
+{
+	return _iterations;
+}	// QualifDisplacementSweepTask::getIterations
+
+
+size_t QualifDisplacementSweepTask::getInvalidCellsNum ( ) const
+{
+	return _invalidCellsNum;
+}	// QualifDisplacementSweepTask::getInvalidCellsNum
+
+
+size_t QualifDisplacementSweepTask::getAcceptableCellsNum ( ) const
+{
+	return _acceptableCellsNum;
+}	// QualifDisplacementSweepTask::getAcceptableCellsNum
+
+
+const vector< pair<size_t, double> >&
+						QualifDisplacementSweepTask::getWorstCells ( ) const
+{
+	return _worstCells;
+}	// QualifDisplacementSweepTask::getWorstCells
+
+
+const vector<double>& QualifDisplacementSweepTask::getCellsLimits ( ) const
+{
+	return _limits;
+}	// QualifDisplacementSweepTask::getCellsLimits
+
+
+void QualifDisplacementSweepTask::execute ( )
+{
+	CHECK_NULL_PTR_ERROR (_serie)
+	const ArrayQualifSerie&	serie		= *_serie;
+	const	size_t	classesNum		= _classesNum;
+	const	Critere	criterion		= getCriterion ( );
+	const	size_t	cellTypes		= getDataTypes ( );
+	const	double	threshold		= _threshold;
+	const	double	maxScale		= _maxScale;
+	if ((0 == classesNum) || (false == (0. < maxScale)))
+	{
+		UTF8String	error (charset);
+		error << "QualifDisplacementSweepTask::execute : nombre de classes nul "
+		      << "ou facteur d'échelle maximal (" << maxScale
+		      << ") non strictement positif.";
+		throw Exception (error);
+	}	// if ((0 == classesNum) || ...
+	if (false == serie.hasDisplacements ( ))
+	{
+		UTF8String	error (charset);
+		error << "QualifDisplacementSweepTask::execute : la série "
+		      << serie.getName ( ) << " n'a pas de champ de déplacements.";
+		throw Exception (error);
+	}	// if (false == serie.hasDisplacements ( ))
+	const	double	ratio			= maxScale / classesNum;
+	initializeSeriesValues (classesNum, 1);
+	vector< vector<size_t> >&		seriesValues	= getSeriesValues ( );
+	QualifProfile&					profile	= getProfile ( );
+	profile.reset ( );
+	QualifTraceScope				taskScope (
+									"QualifDisplacementSweepTask", "task");
+	const size_t					count	= serie.getCellCount ( );
+	_invalidCellsNum	= _acceptableCellsNum	= 0;
+	vector< pair<size_t, double> > ( ).swap (_worstCells);
+	_limits.assign (count, numeric_limits<double>::quiet_NaN ( ));
+
+	size_t	threadsNum	= QualifHelper::getThreadsNum (_threadsNum);
+	const size_t	chunksNum	= (count + sweepChunkSize - 1) / sweepChunkSize;
+	threadsNum	= (0 != chunksNum) && (chunksNum < threadsNum) ?
+				  chunksNum : threadsNum;
+
+	// Les threads s'attribuent les paquets de mailles au fil de l'eau, et
+	// cumulent localement leurs résultats :
+	atomic<size_t>	next (0);
+	mutex			resultsMutex;
+	{
+		QualifTraceScope	scope (QualifProfile::phaseName (
+							QualifProfile::CRITERION_EVALUATION), "phase");
+		QualifHelper::parallelFor (threadsNum, threadsNum, [&] (size_t, size_t)
+		{
+			QualifProfile			localProfile;
+			vector<double>			scales (sweepChunkSize);
+			vector<unsigned char>	status (sweepChunkSize);
+			vector<size_t>			counts (classesNum, 0);
+			size_t					invalid	= 0,	acceptable	= 0;
+			size_t					evaluated	= 0,	skipped	= 0,	failures	= 0;
+			{
+				QualifPhaseTimer	timer (localProfile,
+										QualifProfile::CRITERION_EVALUATION);
+				for (size_t first = next.fetch_add (sweepChunkSize);
+				     first < count; first = next.fetch_add (sweepChunkSize))
+				{
+					const size_t	last	= first + sweepChunkSize < count ?
+											  first + sweepChunkSize : count;
+					serie.findDisplacementLimits (criterion, cellTypes,
+							threshold, maxScale, _iterations, first, last,
+							&scales [0], &status [0]);
+					for (size_t p = 0; p < last - first; p++)
+					{
+						if (AbstractQualifSerie::CELL_EVALUATED != status [p])
+						{
+							if (AbstractQualifSerie::CELL_SKIPPED == status [p])
+								skipped++;
+							else
+								failures++;
+							continue;
+						}	// if (AbstractQualifSerie::CELL_EVALUATED != ...
+						const double	limit	= scales [p];
+						// Chaque maille n'est traitée que par un thread :
+						_limits [serie.getEvaluatedCell (first + p)]	= limit;
+						evaluated++;
+						if (0. > limit)
+							invalid++;
+						else if (limit >= maxScale)
+							acceptable++;
+						else
+						{
+							size_t	cl	= limit / ratio;
+							if (cl >= classesNum)
+								cl	= classesNum - 1;
+							counts [cl]++;
+						}
+					}	// for (size_t p = 0; p < last - first; p++)
+				}	// for (size_t first = next.fetch_add (sweepChunkSize); ...
+			}
+			localProfile.increment (QualifProfile::CELLS_EVALUATED, evaluated);
+			localProfile.increment (QualifProfile::CELLS_SKIPPED, skipped);
+			localProfile.increment (QualifProfile::EXCEPTIONS_CAUGHT, failures);
+
+			lock_guard<mutex>	lock (resultsMutex);
+			for (size_t cl = 0; cl < classesNum; cl++)
+				seriesValues [cl][0]	+= counts [cl];
+			_invalidCellsNum	+= invalid;
+			_acceptableCellsNum	+= acceptable;
+			profile.merge (localProfile);
+		});
+	}
+
+	// Les mailles de plus petits facteurs limites :
+	QualifPhaseTimer	timer (profile, QualifProfile::MERGE);
+	vector< pair<double, size_t> >	candidates;
+	for (size_t c = 0; c < count; c++)
+		if (_limits [c] < maxScale)	// NaN exclus
+			candidates.push_back (pair<double, size_t> (_limits [c], c));
+	const size_t	worstNum	= _worstCellsNum < candidates.size ( ) ?
+								  _worstCellsNum : candidates.size ( );
+	partial_sort (candidates.begin ( ), candidates.begin ( ) + worstNum,
+	              candidates.end ( ));
+	_worstCells.reserve (worstNum);
+	for (size_t w = 0; w < worstNum; w++)
+		_worstCells.push_back (
+				pair<size_t, double> (candidates [w].second, candidates [w].first));
+}	// QualifDisplacementSweepTask::execute
+
+
+}	// namespace GQualif
@@ -0,0 +1,99 @@
+#include "GQualif/QualifGroupMetadata.h"
+#include "GQualif/QualifHelper.h"
+
+#include <string.h>
+
+
+USING_UTIL
+USING_STD
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+const size_t	QualifGroupMetadata::UNKNOWN	= (size_t)-1;
+
+
+/**
+ * @return		L'indice dans <I>typesCellsNum</I> du type transmis en argument.
+ */
+static size_t typeIndex (size_t type)
+{
+	for (size_t i = 0; i < 6; i++)
+		if ((size_t)1 << i == type)
+			return i;
+
+	return 6;
+}	// typeIndex
+
+
+QualifGroupMetadata::QualifGroupMetadata (
+							const string& n, unsigned char d)
+	: name (n), dimension (d), cellsNum (UNKNOWN)
+{
+	memset (typesCellsNum, 0, sizeof (typesCellsNum));
+}	// QualifGroupMetadata::QualifGroupMetadata
+
+
+void QualifGroupMetadata::addCells (size_t type, size_t count)
+{
+	if (UNKNOWN == cellsNum)
+		cellsNum	= 0;
+	cellsNum							+= count;
+	typesCellsNum [typeIndex (type)]	+= count;
+}	// QualifGroupMetadata::addCells
+
+
+size_t QualifGroupMetadata::getCellsNum (size_t type) const
+{
+	const size_t	index	= typeIndex (type);
+
+	return 6 == index ? 0 : typesCellsNum [index];
+}	// QualifGroupMetadata::getCellsNum
+
+
+size_t QualifGroupMetadata::getDataTypes ( ) const
+{
+	size_t	types	= 0;
+	for (size_t i = 0; i < 6; i++)
+		if (0 != typesCellsNum [i])
+			types	|= (size_t)1 << i;
+
+	return types;
+}	// QualifGroupMetadata::getDataTypes
+
+
+UTF8String QualifGroupMetadata::getDescription ( ) const
+{
+	UTF8String	description (charset);
+	description << (true == name.empty ( ) ? "Maillage" : name)
+	            << " (dimension " << (unsigned long)dimension;
+	if (UNKNOWN == cellsNum)
+	{
+		description << ")";
+		return description;
+	}	// if (UNKNOWN == cellsNum)
+
+	description << ", " << (unsigned long)cellsNum << " maille"
+	            << (1 < cellsNum ? "s" : "");
+	const char*	separator	= " : ";
+	for (size_t i = 0; i < 6; i++)
+		if (0 != typesCellsNum [i])
+		{
+			description << separator
+			            << QualifHelper::dataTypeToName ((size_t)1 << i)
+			            << " " << (unsigned long)typesCellsNum [i];
+			separator	= ", ";
+		}	// if (0 != typesCellsNum [i])
+	if (0 != typesCellsNum [6])
+		description << separator << "non supportées "
+		            << (unsigned long)typesCellsNum [6];
+	description << ")";
+
+	return description;
+}	// QualifGroupMetadata::getDescription
+
+
+}	// namespace GQualif
@@ -4,12 +4,16 @@
 #include <TkUtil/NumericServices.h>
 #include <TkUtil/UTF8String.h>
 
+#include <algorithm>
 #include <assert.h>
 //#include <float.h>		// DBL_*
 //#include <values.h>		// DBL_* sous Linux
 #include <math.h>		// isinf (norme C 99)
+#include <stdio.h>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 /*
 #ifndef isinf
@@ -265,6 +269,24 @@ bool QualifHelper::isTypeSupported (size_t type, Critere criteria)
 }	// QualifHelper::isTypeSupported (size_t type, Critere criteria)
 
 
+bool QualifHelper::isBinaryCriterion (Critere criteria)
+{
+	return VALIDITY == criteria ? true : false;
+}	// QualifHelper::isBinaryCriterion
+
+
+bool QualifHelper::isClassAmbiguous (
+		double value, double error, double min, double max, double classWidth)
+{
+	const double	lower	= value - error,	upper	= value + error;
+	if (((lower < min) != (upper < min)) || ((lower > max) != (upper > max)))
+		return true;
+
+	return floor ((lower - min) / classWidth) !=
+	       floor ((upper - min) / classWidth) ? true : false;
+}	// QualifHelper::isClassAmbiguous
+
+
 double QualifHelper::getTriangleMinValue (Critere criteria)
 {
 	switch (criteria)
@@ -637,6 +659,92 @@ bool QualifHelper::hasValideCoordinates (const Maille& cell, bool exc)
 }	// QualifHelper::hasValideCoordinates
 
 
+size_t QualifHelper::getThreadsNum (size_t threadsNum)
+{
+	if (0 != threadsNum)
+		return threadsNum;
+
+	const size_t	processors	= thread::hardware_concurrency ( );
+	return 0 == processors ? 1 : processors;
+}	// QualifHelper::getThreadsNum
+
+
+void QualifHelper::parallelFor (
+		size_t count, size_t threadsNum, const function<void (size_t, size_t)>& task)
+{
+	const size_t	num	= min (getThreadsNum (threadsNum), max (count, (size_t)1));
+	if (1 == num)
+	{
+		task (0, count);
+		return;
+	}	// if (1 == num)
+
+	vector<thread>	threads;
+	vector<string>	errors (num);
+	for (size_t t = 0; t < num; t++)
+		threads.push_back (thread ([&, t] ( )
+		{
+			try
+			{
+				task (count * t / num, count * (t + 1) / num);
+			}
+			catch (const Exception& exc)
+			{
+				errors [t]	= exc.getFullMessage ( ).utf8 ( );
+			}
+			catch (const exception& exc)
+			{
+				errors [t]	= exc.what ( );
+			}
+			catch (...)
+			{
+				errors [t]	= "Erreur non documentée.";
+			}
+		}));
+	for (vector<thread>::iterator itt = threads.begin ( );
+	     threads.end ( ) != itt; itt++)
+		(*itt).join ( );
+	for (vector<string>::const_iterator ite = errors.begin ( );
+	     errors.end ( ) != ite; ite++)
+		if (false == (*ite).empty ( ))
+		{
+			UTF8String	message (charset);
+			message << *ite;
+			throw Exception (message);
+		}	// if (false == (*ite).empty ( ))
+}	// QualifHelper::parallelFor
+
+
+string QualifHelper::jsonString (const string& str)
+{
+	string	json ("\"");
+	for (string::const_iterator it = str.begin ( ); str.end ( ) != it; it++)
+	{
+		switch (*it)
+		{
+			case '"'	: json += "\\\"";	break;
+			case '\\'	: json += "\\\\";	break;
+			case '\n'	: json += "\\n";	break;
+			case '\r'	: json += "\\r";	break;
+			case '\t'	: json += "\\t";	break;
+			default		:
+				if ((unsigned char)*it < 0x20)
+				{
+					char	buffer [8];
+					snprintf (buffer, sizeof (buffer), "\\u%04x",
+					          (unsigned int)(unsigned char)*it);
+					json += buffer;
+				}
+				else
+					json += *it;
+		}	// switch (*it)
+	}	// for (string::const_iterator it = str.begin ( ); ...
+	json += "\"";
+
+	return json;
+}	// QualifHelper::jsonString
+
+
 
 }	// namespace GQualif
 
@@ -0,0 +1,243 @@
+#include "GQualif/QualifProfile.h"
+
+#include <assert.h>
+
+#ifdef USE_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+#endif	// USE_PERF_EVENT
+
+
+USING_UTIL
+USING_STD
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                           LA CLASSE QualifProfile
+// ============================================================================
+
+bool	QualifProfile::_detailedTimings		= false;
+bool	QualifProfile::_hardwareCounters	= false;
+
+
+QualifProfile::QualifProfile ( )
+{
+	reset ( );
+}	// QualifProfile::QualifProfile
+
+
+QualifProfile::QualifProfile (const QualifProfile& profile)
+{
+	reset ( );
+	merge (profile);
+}	// QualifProfile::QualifProfile
+
+
+QualifProfile& QualifProfile::operator = (const QualifProfile& profile)
+{
+	if (&profile != this)
+	{
+		reset ( );
+		merge (profile);
+	}	// if (&profile != this)
+
+	return *this;
+}	// QualifProfile::operator =
+
+
+QualifProfile::~QualifProfile ( )
+{
+}	// QualifProfile::~QualifProfile
+
+
+void QualifProfile::reset ( )
+{
+	for (size_t p = 0; p < PHASES_NUM; p++)
+		_times [p]	= 0.;
+	for (size_t c = 0; c < COUNTERS_NUM; c++)
+		_counters [c]	= 0;
+}	// QualifProfile::reset
+
+
+void QualifProfile::merge (const QualifProfile& profile)
+{
+	for (size_t p = 0; p < PHASES_NUM; p++)
+		_times [p]	+= profile._times [p];
+	for (size_t c = 0; c < COUNTERS_NUM; c++)
+		_counters [c]	+= profile._counters [c];
+}	// QualifProfile::merge
+
+
+UTF8String QualifProfile::toString ( ) const
+{
+	UTF8String	text (charset);
+	for (size_t p = 0; p < PHASES_NUM; p++)
+		if (0. != _times [p])
+			text << phaseName ((PHASE)p) << " : " << _times [p] << " s\n";
+	for (size_t c = 0; c < COUNTERS_NUM; c++)
+		if (0 != _counters [c])
+			text << counterName ((COUNTER)c) << " : "
+			     << (unsigned long)_counters [c] << "\n";
+
+	return text;
+}	// QualifProfile::toString
+
+
+string QualifProfile::phaseName (PHASE phase)
+{
+	switch (phase)
+	{
+		case LOADING				: return "Chargement";
+		case TYPE_SCANNING			: return "Parcours des types";
+		case COORDINATES_GATHERING	: return "Recueil des coordonnées";
+		case CRITERION_EVALUATION	: return "Evaluation du critère";
+		case BINNING				: return "Classement";
+		case MERGE					: return "Fusion des résultats";
+		case RENDERING				: return "Affichage";
+		default						: break;
+	}	// switch (phase)
+
+	return "Phase inconnue";
+}	// QualifProfile::phaseName
+
+
+string QualifProfile::counterName (COUNTER counter)
+{
+	switch (counter)
+	{
+		case CELLS_EVALUATED	: return "Mailles évaluées";
+		case CELLS_SKIPPED		: return "Mailles ignorées";
+		case EXCEPTIONS_CAUGHT	: return "Exceptions interceptées";
+		case BYTES_CACHED		: return "Octets mis en cache";
+		case CELLS_SHARED		: return "Mailles partagées";
+		case CPU_CYCLES			: return "Cycles";
+		case INSTRUCTIONS		: return "Instructions";
+		case CACHE_MISSES		: return "Défauts de cache";
+		case BRANCH_MISSES		: return "Erreurs de prédiction de branchement";
+		default					: break;
+	}	// switch (counter)
+
+	return "Compteur inconnu";
+}	// QualifProfile::counterName
+
+
+void QualifProfile::enableDetailedTimings (bool enable)
+{
+	_detailedTimings	= enable;
+}	// QualifProfile::enableDetailedTimings
+
+
+bool QualifProfile::detailedTimings ( )
+{
+	return _detailedTimings;
+}	// QualifProfile::detailedTimings
+
+
+void QualifProfile::enableHardwareCounters (bool enable)
+{
+	_hardwareCounters	= enable;
+}	// QualifProfile::enableHardwareCounters
+
+
+bool QualifProfile::hardwareCounters ( )
+{
+	return _hardwareCounters;
+}	// QualifProfile::hardwareCounters
+
+
+// ============================================================================
+//                       LA CLASSE QualifHardwareCounters
+// ============================================================================
+
+QualifHardwareCounters::QualifHardwareCounters ( )
+{
+	for (size_t i = 0; i < 4; i++)
+		_descriptors [i]	= -1;
+
+#ifdef USE_PERF_EVENT
+	if (false == QualifProfile::hardwareCounters ( ))
+		return;
+
+	static const unsigned long long	configs [4]	=
+		{ PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+		  PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+	for (size_t i = 0; i < 4; i++)
+	{
+		struct perf_event_attr	attributes;
+		memset (&attributes, 0, sizeof (attributes));
+		attributes.type				= PERF_TYPE_HARDWARE;
+		attributes.size				= sizeof (attributes);
+		attributes.config			= configs [i];
+		attributes.disabled			= 1;
+		attributes.exclude_kernel	= 1;
+		attributes.exclude_hv		= 1;
+		// Thread courant, tout processeur :
+		_descriptors [i]	=
+			(int)syscall (__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+		if (-1 != _descriptors [i])
+		{
+			ioctl (_descriptors [i], PERF_EVENT_IOC_RESET, 0);
+			ioctl (_descriptors [i], PERF_EVENT_IOC_ENABLE, 0);
+		}	// if (-1 != _descriptors [i])
+	}	// for (size_t i = 0; i < 4; i++)
+#endif	// USE_PERF_EVENT
+}	// QualifHardwareCounters::QualifHardwareCounters
+
+
+QualifHardwareCounters::QualifHardwareCounters (const QualifHardwareCounters&)
+{
+	for (size_t i = 0; i < 4; i++)
+		_descriptors [i]	= -1;
+	assert (0 && "QualifHardwareCounters copy constructor is not allowed.");
+}	// QualifHardwareCounters::QualifHardwareCounters
+
+
+QualifHardwareCounters& QualifHardwareCounters::operator = (
+											const QualifHardwareCounters&)
+{
+	assert (0 && "QualifHardwareCounters assignment operator is not allowed.");
+	return *this;
+}	// QualifHardwareCounters::operator =
+
+
+QualifHardwareCounters::~QualifHardwareCounters ( )
+{
+#ifdef USE_PERF_EVENT
+	for (size_t i = 0; i < 4; i++)
+		if (-1 != _descriptors [i])
+			close (_descriptors [i]);
+#endif	// USE_PERF_EVENT
+}	// QualifHardwareCounters::~QualifHardwareCounters
+
+
+void QualifHardwareCounters::stop (QualifProfile& profile)
+{
+#ifdef USE_PERF_EVENT
+	static const QualifProfile::COUNTER	counters [4]	=
+		{ QualifProfile::CPU_CYCLES, QualifProfile::INSTRUCTIONS,
+		  QualifProfile::CACHE_MISSES, QualifProfile::BRANCH_MISSES };
+	for (size_t i = 0; i < 4; i++)
+	{
+		if (-1 == _descriptors [i])
+			continue;
+
+		unsigned long long	value	= 0;
+		ioctl (_descriptors [i], PERF_EVENT_IOC_DISABLE, 0);
+		if ((ssize_t)sizeof (value) == read (_descriptors [i], &value, sizeof (value)))
+			profile.increment (counters [i], value);
+		close (_descriptors [i]);
+		_descriptors [i]	= -1;
+	}	// for (size_t i = 0; i < 4; i++)
+#endif	// USE_PERF_EVENT
+}	// QualifHardwareCounters::stop
+
+
+}	// namespace GQualif
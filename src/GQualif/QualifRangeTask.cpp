@@ -1,11 +1,13 @@
 #include "GQualif/QualifRangeTask.h"
 #include "GQualif/QCalQualThread.h"
+#include "GQualif/QualifTracer.h"
 
 #include <TkUtil/Exception.h>
 #include <TkUtil/InternalError.h>
 #include <TkUtil/MemoryError.h>
 #include <TkUtil/NumericServices.h>
 #include <TkUtil/ThreadManager.h>
+#include <TkUtil/UTF8String.h>
 
 #include <iostream>
 #include <assert.h>
@@ -17,6 +19,9 @@ USING_UTIL
 USING_STD
 using namespace Qualif;
 
+static const Charset	charset ("àéèùô");
+
+
 namespace GQualif
 {
 
@@ -24,7 +29,7 @@ QualifRangeTask::QualifRangeTask (
 	size_t types, Critere criterion, const vector<AbstractQualifSerie*>& series)
 	: AbstractQualifTask (types, criterion, series),
 	  _min (-NumericServices::doubleMachMax ( )),
-	  _max (NumericServices::doubleMachMax ( ))
+	  _max (NumericServices::doubleMachMax ( )), _seriesRanges ( )
 {
 }	// QualifRangeTask::QualifRangeTask
 
@@ -33,7 +38,7 @@ QualifRangeTask::QualifRangeTask (const QualifRangeTask&)
 	: AbstractQualifTask (
 			(size_t)-1, (Critere)-1, vector<AbstractQualifSerie*> ( )),
 	  _min (-NumericServices::doubleMachMax ( )),
-	  _max (NumericServices::doubleMachMax ( ))
+	  _max (NumericServices::doubleMachMax ( )), _seriesRanges ( )
 {
 	assert (0 && "QualifRangeTask copy constructor is not allowed.");
 }	// QualifRangeTask::QualifRangeTask
@@ -59,9 +64,13 @@ void QualifRangeTask::execute ( )
 	const	size_t	seriesNum		= getSeriesNum ( );
 	const	Critere	criterion		= getCriterion ( );
 	const	size_t	cellTypes		= getDataTypes ( );
-	bool	minOK	= false,	maxOK	= false;
 	_min	= NumericServices::doubleMachMax ( );
 	_max	= -NumericServices::doubleMachMax ( );
+	_seriesRanges.assign (seriesNum, pair<double, double> (_min, _max));
+	QualifProfile&					profile	= getProfile ( );
+	profile.reset ( );
+	QualifTraceScope				taskScope ("QualifRangeTask", "task");
+	recordSeriesUse ( );
 	vector<AbstractQualifSerie*>&	series	= getSeries ( );
 	for (i = 0; i < seriesNum; i++)
 	{
@@ -86,25 +95,28 @@ void QualifRangeTask::execute ( )
 			QualifSerieData*	threadData	= new QualifSerieData (
 				*serie, criterion, 1, cellTypes, _min, _max, false);
 			threadsData.push_back (threadData);
-			QSerieRangeThread*	thread	= new QSerieRangeThread (*threadData);
-			ThreadManager::instance ( ).addTask (thread);
 		}	// for (i = 0; i < seriesNum; i++)
+		// Les séries sont réparties en lots (un thread par lot) :
+		vector<QualifSeriesBatch*>	batches	=
+								QualifSeriesBatch::pack (threadsData, true);
+		for (vector<QualifSeriesBatch*>::iterator itb = batches.begin ( );
+		     batches.end ( ) != itb; itb++)
+			ThreadManager::instance ( ).addTask (new QSeriesBatchThread (**itb));
 		ThreadManager::instance ( ).join ( );
+		for (vector<QualifSeriesBatch*>::iterator itb = batches.begin ( );
+		     batches.end ( ) != itb; itb++)
+			delete *itb;
+		QualifPhaseTimer	timer (profile, QualifProfile::MERGE);
+		QualifTraceScope	scope (
+					QualifProfile::phaseName (QualifProfile::MERGE), "phase");
 		i	= 0;
 		for (vector<QualifSerieData*>::iterator ittd = threadsData.begin ( );
 		     threadsData.end ( ) != ittd; ittd++, i++)
 		{
 			CHECK_NULL_PTR_ERROR (*ittd)
-			if (true == NumericServices::isValidAndNotMax ((*ittd)->min ( )))
-			{
-				minOK	= true;
-				_min	= (*ittd)->min ( ) < _min ? (*ittd)->min ( ) : _min;
-			}	// if (true == NumericServices::isValidAndNotMax (...
-			if (true == NumericServices::isValidAndNotMax ((*ittd)->max ( )))
-			{
-				maxOK	= true;
-				_max	= (*ittd)->max ( ) > _max ? (*ittd)->max ( ) : _max;
-			}	// if (true == NumericServices::isValidAndNotMax (...
+			profile.merge ((*ittd)->profile ( ));
+			_seriesRanges [i]	=
+						pair<double, double> ((*ittd)->min ( ), (*ittd)->max ( ));
 			delete *ittd;
 		}	// for (vector<QualifSerieData*>::iterator ittd = ...
 		threadsData.clear ( );
@@ -113,45 +125,30 @@ void QualifRangeTask::execute ( )
 	{
 //cout << "LANCEMENT CALCUL DOMAINE QUALIF EN MODE MONOTHREAD" << endl;
 
+		QualifPhaseTimer	timer (profile, QualifProfile::CRITERION_EVALUATION);
+		QualifTraceScope	scope (QualifProfile::phaseName (
+			QualifProfile::CRITERION_EVALUATION), "phase", "monothread");
 		for (i = 0; i < seriesNum; i++)
 		{
 			AbstractQualifSerie*	serie	= series [i];
 			CHECK_NULL_PTR_ERROR (serie)
 			double	mn	= NumericServices::doubleMachMax ( );
 			double	mx	= -NumericServices::doubleMachMax ( );
+			const bool	stored	= serie->isCriteriaStored (criterion);
             serie->getDataRange (criterion, mn, mx);
-			if (true == NumericServices::isValidAndNotMax (mn))
-			{
-				minOK	= true;
-				_min	= mn < _min ? mn : _min;
-			}	// if (true == NumericServices::isValidAndNotMax (...
-			if (true == NumericServices::isValidAndNotMax (mx))
+			if (false == stored)
 			{
-				maxOK	= true;
-				_max	= mx > _max ? mx : _max;
-			}	// if (true == NumericServices::isValidAndNotMax (...
+				profile.increment (QualifProfile::CELLS_EVALUATED,
+				                   serie->getCellCount ( ));
+				profile.increment (QualifProfile::BYTES_CACHED,
+				                   serie->getMemoryUsage (criterion));
+			}	// if (false == stored)
+			_seriesRanges [i]	= pair<double, double> (mn, mx);
 		}	// for (i = 0; i < seriesNum; i++)
 
 	}	// else if (true == multiThreaded)
 
-	// Si une valeur est infinie il faut trouver quelque chose car Qwt risque
-	// de ne pas apprécier et de provoquer un bad_alloc dans les calculs de
-	// graduations
-	if (true == minOK)
-	{
-		if (false == maxOK)
-			_max	= _min + fabs (_min);
-	}
-	else
-	{
-		if (true == maxOK)
-			_min	= _max - fabs (_max);
-		else
-		{
-			_min	= -1000.;
-			_max	= 1000.;
-		}
-	}
+	mergeRanges (_seriesRanges, _min, _max);
 }	// QualifRangeTask::execute
 
 
@@ -174,5 +171,63 @@ double QualifRangeTask::getMax ( ) const
 }	// QualifRangeTask::getMax
 
 
+void QualifRangeTask::getSerieRange (size_t i, double& min, double& max) const
+{
+	if (i >= _seriesRanges.size ( ))
+	{
+		UTF8String	error (charset);
+		error << "QualifRangeTask::getSerieRange : série invalide ("
+		      << (unsigned long)i << "), " << (unsigned long)_seriesRanges.size ( )
+		      << " séries analysées.";
+		throw Exception (error);
+	}	// if (i >= _seriesRanges.size ( ))
+
+	min	= _seriesRanges [i].first;
+	max	= _seriesRanges [i].second;
+}	// QualifRangeTask::getSerieRange
+
+
+void QualifRangeTask::mergeRanges (
+		const vector< pair<double, double> >& ranges, double& min, double& max)
+{
+	bool	minOK	= false,	maxOK	= false;
+	min	= NumericServices::doubleMachMax ( );
+	max	= -NumericServices::doubleMachMax ( );
+	for (vector< pair<double, double> >::const_iterator itr = ranges.begin ( );
+	     ranges.end ( ) != itr; itr++)
+	{
+		if (true == NumericServices::isValidAndNotMax ((*itr).first))
+		{
+			minOK	= true;
+			min		= (*itr).first < min ? (*itr).first : min;
+		}	// if (true == NumericServices::isValidAndNotMax (...
+		if (true == NumericServices::isValidAndNotMax ((*itr).second))
+		{
+			maxOK	= true;
+			max		= (*itr).second > max ? (*itr).second : max;
+		}	// if (true == NumericServices::isValidAndNotMax (...
+	}	// for (vector< pair<double, double> >::const_iterator itr = ...
+
+	// Si une valeur est infinie il faut trouver quelque chose car Qwt risque
+	// de ne pas apprécier et de provoquer un bad_alloc dans les calculs de
+	// graduations
+	if (true == minOK)
+	{
+		if (false == maxOK)
+			max	= min + fabs (min);
+	}
+	else
+	{
+		if (true == maxOK)
+			min	= max - fabs (max);
+		else
+		{
+			min	= -1000.;
+			max	= 1000.;
+		}
+	}
+}	// QualifRangeTask::mergeRanges
+
+
 }	// namespace GQualif
 
@@ -0,0 +1,110 @@
+#include "GQualif/QualifRebinningTask.h"
+#include "GQualif/QualifTracer.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/InternalError.h>
+
+#include <assert.h>
+
+
+USING_UTIL
+USING_STD
+using namespace Qualif;
+
+static const	Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+QualifRebinningTask::QualifRebinningTask (
+			size_t types, Critere criterion, size_t classesNum,
+			double min, double max, bool strict,
+			const vector<AbstractQualifSerie*>& series)
+	: QualifAnalysisTask (types, criterion, classesNum, min, max, strict, series)
+{
+}	// QualifRebinningTask::QualifRebinningTask
+
+
+QualifRebinningTask::QualifRebinningTask (const QualifRebinningTask&)
+	: QualifAnalysisTask (
+			(size_t)-1, (Critere)-1, 1, 0., 1., false,
+			vector<AbstractQualifSerie*> ( ))
+{
+	assert (0 && "QualifRebinningTask copy constructor is not allowed.");
+}	// QualifRebinningTask::QualifRebinningTask
+
+
+QualifRebinningTask& QualifRebinningTask::operator = (
+												const QualifRebinningTask&)
+{
+	assert (0 && "QualifRebinningTask assignment operator is not allowed.");
+	return *this;
+}	// QualifRebinningTask::operator =
+
+
+QualifRebinningTask::~QualifRebinningTask ( )
+{
+}	// QualifRebinningTask::~QualifRebinningTask
+
+
+bool QualifRebinningTask::isApplicable (
+				Critere criterion, const vector<AbstractQualifSerie*>& series)
+{
+	for (vector<AbstractQualifSerie*>::const_iterator its = series.begin ( );
+	     series.end ( ) != its; its++)
+	{
+		CHECK_NULL_PTR_ERROR (*its)
+		if (false == (*its)->isCriteriaStored (criterion))
+			return false;
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+
+	return true;
+}	// QualifRebinningTask::isApplicable
+
+
+void QualifRebinningTask::execute ( )
+{
+	const	Critere	criterion	= getCriterion ( );
+	vector<AbstractQualifSerie*>&	series	= getSeries ( );
+	if (false == isApplicable (criterion, series))
+	{
+		QualifAnalysisTask::execute ( );
+		return;
+	}	// if (false == isApplicable (criterion, series))
+
+	const	size_t	seriesNum	= getSeriesNum ( );
+	const	size_t	classNum	= getClassesNum ( );
+	if (0 == classNum)
+		throw Exception (UTF8String ("QualifRebinningTask::execute : nombre de classes nul.", charset));
+	AbstractQualifTask::initializeSeriesValues (classNum, seriesNum);
+	QualifProfile&					profile	= getProfile ( );
+	profile.reset ( );
+	QualifTraceScope				taskScope ("QualifRebinningTask", "task");
+	recordSeriesUse ( );
+	QualifPhaseTimer				timer (profile, QualifProfile::BINNING);
+	QualifTraceScope				scope (
+				QualifProfile::phaseName (QualifProfile::BINNING), "phase");
+	vector< vector <size_t> >&		values	= getSeriesValues ( );
+	vector<size_t>					counts;
+	for (size_t i = 0; i < seriesNum; i++)
+	{
+		AbstractQualifSerie*	serie	= series [i];
+		CHECK_NULL_PTR_ERROR (serie)
+		serie->rebin (criterion, getDataTypes ( ), classNum, getMin ( ),
+		              getMax ( ), useStrictDomain ( ), counts);
+		serie->deferClassesCellsIndexes (criterion, getDataTypes ( ), classNum,
+		                getMin ( ), getMax ( ), useStrictDomain ( ));
+		size_t	binned	= 0;
+		for (size_t cl = 0; cl < classNum; cl++)
+		{
+			values [cl][i]	= counts [cl];
+			binned			+= counts [cl];
+		}	// for (size_t cl = 0; cl < classNum; cl++)
+		profile.increment (
+				QualifProfile::CELLS_SKIPPED, serie->getCellCount ( ) - binned);
+	}	// for (size_t i = 0; i < seriesNum; i++)
+}	// QualifRebinningTask::execute
+
+
+}	// namespace GQualif
@@ -0,0 +1,270 @@
+#include "GQualif/QualifSerieWarmUp.h"
+#include "GQualif/QualifTracer.h"
+
+#include <TkUtil/Exception.h>
+
+#include <algorithm>
+#include <assert.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif	// __linux__
+
+
+USING_UTIL
+USING_STD
+using namespace Qualif;
+
+
+/**
+ * Passe le thread courant en priorité minimale (<I>SCHED_IDLE</I>).
+ * @return		<I>true</I> en cas de succès, <I>false</I> en cas d'échec ou
+ * 				hors <I>Linux</I>.
+ * @warning		Un thread non privilégié ne peut ensuite repasser en
+ * 				priorité normale (<I>EPERM</I> si <I>RLIMIT_NICE</I> est
+ * 				nul), cette priorité est donc définitive.
+ */
+static bool setLowPriority ( )
+{
+#ifdef __linux__
+	sched_param	param;
+	param.sched_priority	= 0;
+	return 0 == pthread_setschedparam (pthread_self ( ), SCHED_IDLE, &param) ?
+	       true : false;
+#else	// __linux__
+	return false;
+#endif	// __linux__
+}	// setLowPriority
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                         LA CLASSE QualifSerieWarmUp
+// ============================================================================
+
+QualifSerieWarmUp::QualifSerieWarmUp (size_t steps, Critere criterion)
+	: _steps (steps), _criterion (criterion), _callback ( ), _queue ( ),
+	  _current (0), _abandoned (false), _completed ( ), _mutex ( ),
+	  _condition ( ), _thread ( ), _stopped (false)
+{
+}	// QualifSerieWarmUp::QualifSerieWarmUp
+
+
+QualifSerieWarmUp::QualifSerieWarmUp (const QualifSerieWarmUp&)
+	: _steps (0), _criterion ((Critere)-1), _callback ( ), _queue ( ),
+	  _current (0), _abandoned (false), _completed ( ), _mutex ( ),
+	  _condition ( ), _thread ( ), _stopped (false)
+{
+	assert (0 && "QualifSerieWarmUp copy constructor is not allowed.");
+}	// QualifSerieWarmUp::QualifSerieWarmUp
+
+
+QualifSerieWarmUp& QualifSerieWarmUp::operator = (const QualifSerieWarmUp&)
+{
+	assert (0 && "QualifSerieWarmUp assignment operator is not allowed.");
+	return *this;
+}	// QualifSerieWarmUp::operator =
+
+
+QualifSerieWarmUp::~QualifSerieWarmUp ( )
+{
+	{
+		unique_lock<mutex>	lock (_mutex);
+		_queue.clear ( );
+		waitCurrent (lock);
+		_stopped	= true;
+		_condition.notify_all ( );
+	}
+	if (true == _thread.joinable ( ))
+		_thread.join ( );
+}	// QualifSerieWarmUp::~QualifSerieWarmUp
+
+
+size_t QualifSerieWarmUp::getSteps ( ) const
+{
+	return _steps;
+}	// QualifSerieWarmUp::getSteps
+
+
+void QualifSerieWarmUp::setCriterion (Critere criterion)
+{
+	lock_guard<mutex>	lock (_mutex);
+	_criterion	= criterion;
+}	// QualifSerieWarmUp::setCriterion
+
+
+Critere QualifSerieWarmUp::getCriterion ( ) const
+{
+	lock_guard<mutex>	lock (_mutex);
+	return _criterion;
+}	// QualifSerieWarmUp::getCriterion
+
+
+void QualifSerieWarmUp::setCompletionCallback (const function<void ( )>& callback)
+{
+	lock_guard<mutex>	lock (_mutex);
+	_callback	= callback;
+}	// QualifSerieWarmUp::setCompletionCallback
+
+
+bool QualifSerieWarmUp::add (AbstractQualifSerie& serie)
+{
+	if (false == serie.isThreadable ( ))
+		return false;
+
+	lock_guard<mutex>	lock (_mutex);
+	if (false == _thread.joinable ( ))
+		_thread	= thread (&QualifSerieWarmUp::run, this);
+	_queue.push_back (&serie);
+	_condition.notify_all ( );
+
+	return true;
+}	// QualifSerieWarmUp::add
+
+
+void QualifSerieWarmUp::remove (AbstractQualifSerie& serie)
+{
+	unique_lock<mutex>	lock (_mutex);
+	_queue.erase (std::remove (_queue.begin ( ), _queue.end ( ), &serie),
+	              _queue.end ( ));
+	if (&serie == _current)
+		waitCurrent (lock);
+	for (vector< pair<AbstractQualifSerie*, size_t> >::iterator itc =
+	     _completed.begin ( ); _completed.end ( ) != itc; )
+	{
+		if (&serie == (*itc).first)
+			itc	= _completed.erase (itc);
+		else
+			itc++;
+	}	// for (vector< pair<AbstractQualifSerie*, size_t> >::iterator itc = ...
+}	// QualifSerieWarmUp::remove
+
+
+void QualifSerieWarmUp::cancel ( )
+{
+	unique_lock<mutex>	lock (_mutex);
+	_queue.clear ( );
+	waitCurrent (lock);
+}	// QualifSerieWarmUp::cancel
+
+
+void QualifSerieWarmUp::wait ( )
+{
+	unique_lock<mutex>	lock (_mutex);
+	_condition.wait (lock, [this] ( )
+	{ return (true == _queue.empty ( )) && (0 == _current); });
+}	// QualifSerieWarmUp::wait
+
+
+bool QualifSerieWarmUp::isIdle ( ) const
+{
+	lock_guard<mutex>	lock (_mutex);
+	return (true == _queue.empty ( )) && (0 == _current);
+}	// QualifSerieWarmUp::isIdle
+
+
+vector< pair<AbstractQualifSerie*, size_t> > QualifSerieWarmUp::takeCompleted ( )
+{
+	lock_guard<mutex>								lock (_mutex);
+	vector< pair<AbstractQualifSerie*, size_t> >	completed;
+	completed.swap (_completed);
+
+	return completed;
+}	// QualifSerieWarmUp::takeCompleted
+
+
+void QualifSerieWarmUp::run ( )
+{
+	// En cas d'échec le thread reste en priorité normale, les préparations
+	// étant de toute façon interrompues entre deux étapes à la demande :
+	setLowPriority ( );
+	// L'évaluation du critère, de loin l'étape la plus longue, est de plus
+	// interrompue entre deux paquets de mailles :
+	AbstractQualifSerie::setInterruption ([this] ( ) { return isAbandoned ( ); });
+
+	unique_lock<mutex>	lock (_mutex);
+	while (true)
+	{
+		_condition.wait (lock, [this] ( )
+		{ return (true == _stopped) || (false == _queue.empty ( )); });
+		if (true == _stopped)
+			break;
+
+		AbstractQualifSerie*	serie		= _queue.front ( );
+		const Critere			criterion	= _criterion;
+		_queue.pop_front ( );
+		_current	= serie;
+		_abandoned	= false;
+		lock.unlock ( );
+
+		// Les données en cache de la série ne doivent pas être libérées par
+		// un autre thread (applyMemoryBudget) pendant la préparation :
+		AbstractQualifSerie::lockStoredData (*serie);
+		const size_t	types	= prepare (*serie, criterion);
+		AbstractQualifSerie::unlockStoredData (*serie);
+
+		lock.lock ( );
+		_completed.push_back (pair<AbstractQualifSerie*, size_t> (serie, types));
+		const function<void ( )>	callback	= _callback;
+		lock.unlock ( );
+		if (callback)
+			callback ( );
+		lock.lock ( );
+		_current	= 0;
+		_condition.notify_all ( );
+	}	// while (true)
+}	// QualifSerieWarmUp::run
+
+
+size_t QualifSerieWarmUp::prepare (AbstractQualifSerie& serie, Critere criterion)
+{
+	QualifTraceScope	scope ("QualifSerieWarmUp", "task", serie.getName ( ));
+	size_t				types	= 0;
+	// Les erreurs sont ignorées, le calcul les signalera. Les étapes
+	// suivantes, et l'évaluation du critère en cours, sont abandonnées dès
+	// que la préparation est attendue (cancel, remove), le calcul qui suit
+	// les effectuant au besoin :
+	try
+	{
+		types	= 2 > serie.getDimension ( ) ? 0 : serie.getDataTypes ( );
+		if ((0 != (COORDINATES_FLATTENING & _steps)) &&
+		    (false == isAbandoned ( )))
+			serie.flattenCoordinates (1);
+		if ((0 != (COORDINATES_VALIDATION & _steps)) &&
+		    (false == isAbandoned ( )))
+			serie.validateCoordinates ( );	// Résultat conservé par la série
+		if ((0 != (CRITERION_EVALUATION & _steps)) &&
+		    ((Critere)-1 != criterion) && (false == isAbandoned ( )))
+		{
+			double	min	= 0.,	max	= 0.;
+			serie.getDataRange (criterion, min, max);
+		}	// if ((0 != (CRITERION_EVALUATION & _steps)) && ...
+	}
+	catch (...)
+	{
+	}
+
+	return types;
+}	// QualifSerieWarmUp::prepare
+
+
+bool QualifSerieWarmUp::isAbandoned ( ) const
+{
+	lock_guard<mutex>	lock (_mutex);
+	return _abandoned;
+}	// QualifSerieWarmUp::isAbandoned
+
+
+void QualifSerieWarmUp::waitCurrent (unique_lock<mutex>& lock)
+{
+	if (0 == _current)
+		return;
+
+	_abandoned	= true;
+	_condition.wait (lock, [this] ( ) { return 0 == _current; });
+}	// QualifSerieWarmUp::waitCurrent
+
+
+}	// namespace GQualif
@@ -0,0 +1,416 @@
+#include "GQualif/QualifSharedCellsTask.h"
+#include "GQualif/QualifHelper.h"
+#include "GQualif/QualifTracer.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/InternalError.h>
+
+#include <Maille.h>	// Qualif
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <assert.h>
+
+
+USING_UTIL
+USING_STD
+using namespace Qualif;
+
+static const	Charset	charset ("àéèùô");
+
+/** Nombre de mailles des paquets évalués par
+ * <I>AbstractQualifSerie::evaluateCriterion</I>. */
+static const size_t		evaluationChunkSize	= 4096;
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                           FONCTIONS UTILITAIRES
+// ============================================================================
+
+/**
+ * Identification des séries pouvant partager des mailles : instance du
+ * maillage dont elles sont issues, fichier de ce maillage (cf.
+ * <I>AbstractQualifSerie::getMeshInstance</I>), et nature des mailles.
+ */
+typedef pair< pair<const void*, string>, bool >	MeshKey;
+
+/** Identifiant de maille inconnu. */
+static const size_t		noId	= (size_t)-1;
+
+
+/**
+ * @return		<I>true</I> si les mailles de la série transmise en argument
+ * 				sont susceptibles d'être partagées avec une autre série.
+ */
+static bool isShareable (const AbstractQualifSerie& serie)
+{
+	return (true == serie.hasMeshCellIds ( )) &&
+	       (0 != serie.getMeshInstance ( ));
+}	// isShareable
+
+
+/**
+ * @return		L'identification du maillage de la série transmise en
+ * 				argument.
+ */
+static MeshKey meshKey (const AbstractQualifSerie& serie)
+{
+	return MeshKey (
+			pair<const void*, string> (
+					serie.getMeshInstance ( ), serie.getFileName ( )),
+			serie.isVolumic ( ));
+}	// meshKey
+
+
+/**
+ * Evalue le critère pour les mailles <I>cells</I> de la série. La valeur et
+ * le statut (<I>AbstractQualifSerie::CELL_EVALUATION</I>) de la maille c sont
+ * retournés dans <I>values</I> et <I>status</I> à l'indice
+ * <I>uniques [c]</I>.
+ */
+static void evaluateCells (
+		const AbstractQualifSerie& serie, const vector<size_t>& cells,
+		const vector<size_t>& uniques, Critere criterion, size_t cellTypes,
+		double min, double max, double cnRatio,
+		vector<double>& values, vector<unsigned char>& status)
+{
+	const size_t	count	= serie.getCellCount ( );
+	if ((cells.size ( ) == count) &&
+	    (false == serie.isCriteriaStored (criterion)))
+	{	// La série évalue toutes ses mailles : évaluation par paquets, dans
+		// son ordre d'évaluation (cf. QCalQualThread).
+		vector<double>			chunkValues (evaluationChunkSize);
+		vector<unsigned char>	chunkStatus (evaluationChunkSize);
+		for (size_t first = 0; first < count; first += evaluationChunkSize)
+		{
+			const size_t	last	= first + evaluationChunkSize < count ?
+									  first + evaluationChunkSize : count;
+			serie.evaluateCriterion (criterion, cellTypes, first, last,
+			                         &chunkValues [0], &chunkStatus [0]);
+			for (size_t p = first; p < last; p++)
+			{
+				const size_t	u	= uniques [serie.getEvaluatedCell (p)];
+				values [u]	= chunkValues [p - first];
+				status [u]	= chunkStatus [p - first];
+			}	// for (size_t p = first; p < last; p++)
+		}	// for (size_t first = 0; first < count; ...
+		return;
+	}	// if ((cells.size ( ) == count) && ...
+
+	// Erreur commise sur les valeurs en cache (valeurs quantifiées) :
+	const double	error	= serie.getStoredCriteriaError (criterion);
+	for (vector<size_t>::const_iterator itc = cells.begin ( );
+	     cells.end ( ) != itc; itc++)
+	{
+		const size_t	c	= *itc;
+		const size_t	u	= uniques [c];
+		status [u]	= AbstractQualifSerie::CELL_FAILED;
+		try
+		{
+			if (0 == (serie.getCellType (c) & cellTypes))
+			{
+				status [u]	= AbstractQualifSerie::CELL_SKIPPED;
+				continue;
+			}	// if (0 == (serie.getCellType (c) & cellTypes))
+
+			double	value;
+			if (true == serie.isCriteriaStored (criterion))
+			{
+				value	= serie.getStoredCriteria (criterion, c);
+				if ((0. != error) &&
+				    (true == QualifHelper::isClassAmbiguous (
+									value, error, min, max, cnRatio)))
+					value	= serie.getCriteriaValue (criterion, c);
+			}
+			else
+				value	= serie.getCell (c).AppliqueCritere (criterion);
+			values [u]	= value;
+			status [u]	= AbstractQualifSerie::CELL_EVALUATED;
+		}
+		catch (...)
+		{	// Certains types ne sont pas supportés (pentagone, ...).
+		}
+	}	// for (vector<size_t>::const_iterator itc = cells.begin ( ); ...
+}	// evaluateCells
+
+
+// ============================================================================
+//                       LA CLASSE QualifSharedCellsTask
+// ============================================================================
+
+QualifSharedCellsTask::QualifSharedCellsTask (
+			size_t types, Critere criterion, size_t classesNum,
+			double min, double max, bool strict,
+			const vector<AbstractQualifSerie*>& series)
+	: QualifAnalysisTask (types, criterion, classesNum, min, max, strict, series)
+{
+}	// QualifSharedCellsTask::QualifSharedCellsTask
+
+
+QualifSharedCellsTask::QualifSharedCellsTask (const QualifSharedCellsTask&)
+	: QualifAnalysisTask (
+			(size_t)-1, (Critere)-1, 1, 0., 1., false,
+			vector<AbstractQualifSerie*> ( ))
+{
+	assert (0 && "QualifSharedCellsTask copy constructor is not allowed.");
+}	// QualifSharedCellsTask::QualifSharedCellsTask
+
+
+QualifSharedCellsTask& QualifSharedCellsTask::operator = (
+												const QualifSharedCellsTask&)
+{
+	assert (0 && "QualifSharedCellsTask assignment operator is not allowed.");
+	return *this;
+}	// QualifSharedCellsTask::operator =
+
+
+QualifSharedCellsTask::~QualifSharedCellsTask ( )
+{
+}	// QualifSharedCellsTask::~QualifSharedCellsTask
+
+
+bool QualifSharedCellsTask::isApplicable (
+								const vector<AbstractQualifSerie*>& series)
+{
+	map<MeshKey, size_t>	meshes;
+	for (vector<AbstractQualifSerie*>::const_iterator its = series.begin ( );
+	     series.end ( ) != its; its++)
+	{
+		CHECK_NULL_PTR_ERROR (*its)
+		if ((true == isShareable (**its)) &&
+		    (2 == ++meshes [meshKey (**its)]))
+			return true;
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+
+	return false;
+}	// QualifSharedCellsTask::isApplicable
+
+
+void QualifSharedCellsTask::execute ( )
+{
+	vector<AbstractQualifSerie*>&	series	= getSeries ( );
+	if (false == isApplicable (series))
+	{
+		QualifAnalysisTask::execute ( );
+		return;
+	}	// if (false == isApplicable (series))
+
+	const	size_t	seriesNum		= getSeriesNum ( );
+	const	size_t	classNum		= getClassesNum ( );
+	const	Critere	criterion		= getCriterion ( );
+	const	size_t	cellTypes		= getDataTypes ( );
+	const	double	min				= getMin ( );
+	const	double	max				= getMax ( );
+	const	bool	strict			= useStrictDomain ( );
+	if (0 == classNum)
+		throw Exception (UTF8String ("QualifSharedCellsTask::execute : nombre de classes nul.", charset));
+	const	double	cnRatio			= max / classNum - min / classNum;
+	initializeSeriesValues (classNum, seriesNum);
+	QualifProfile&					profile	= getProfile ( );
+	profile.reset ( );
+	QualifTraceScope				taskScope ("QualifSharedCellsTask", "task");
+	recordSeriesUse ( );
+
+	// Les séries par ordre décroissant de nombre de mailles : une maille
+	// partagée est évaluée par la plus grande des séries qui la contiennent
+	// (le maillage entier le cas échéant).
+	bool							multiThreaded	= true;
+	size_t							cellsNum		= 0;
+	vector< pair<size_t, size_t> >	sizes;
+	for (size_t s = 0; s < seriesNum; s++)
+	{
+		AbstractQualifSerie*	serie	= series [s];
+		CHECK_NULL_PTR_ERROR (serie)
+		sizes.push_back (pair<size_t, size_t> (serie->getCellCount ( ), s));
+		cellsNum	+= sizes.back ( ).first;
+		if (false == serie->isThreadable ( ))
+			multiThreaded	= false;
+	}	// for (size_t s = 0; s < seriesNum; s++)
+	sort (sizes.rbegin ( ), sizes.rend ( ));
+
+	// Correspondance maille de série -> maille distincte (uniques), et
+	// mailles distinctes évaluées par chaque série (owned) :
+	vector< vector<size_t> >	uniques (seriesNum), owned (seriesNum);
+	size_t						uniqueNum	= 0;
+	{
+		QualifPhaseTimer	timer (profile, QualifProfile::MERGE);
+		QualifTraceScope	scope ("Correspondance des mailles", "phase");
+		// Les identifiants des mailles, provisoirement rangés dans uniques
+		// (noId si la maille est invalide), et par maillage le majorant
+		// strict de ces identifiants et le nombre de mailles des séries :
+		map< MeshKey, pair<size_t, size_t> >	bounds;
+		for (vector< pair<size_t, size_t> >::const_iterator its =
+		     sizes.begin ( ); sizes.end ( ) != its; its++)
+		{
+			const size_t				s		= (*its).second;
+			const size_t				count	= (*its).first;
+			const AbstractQualifSerie&	serie	= *(series [s]);
+			uniques [s].assign (count, noId);
+			if (false == isShareable (serie))
+				continue;
+			pair<size_t, size_t>&	bound	= bounds [meshKey (serie)];
+			bound.second	+= count;
+			for (size_t c = 0; c < count; c++)
+			{
+				try
+				{
+					const size_t	id	= serie.getMeshCellId (c);
+					uniques [s][c]	= id;
+					bound.first		= id >= bound.first ? id + 1 : bound.first;
+				}
+				catch (...)
+				{	// Maille invalide : évaluée par cette série.
+				}
+			}	// for (size_t c = 0; c < count; c++)
+		}	// for (vector< pair<size_t, size_t> >::const_iterator its = ...
+
+		// Correspondance identifiant -> maille distincte : tableau indexé par
+		// les identifiants s'ils sont denses (Lima, GMDS), table de hachage
+		// sinon (groupes de faible taille d'un grand maillage, ...) :
+		map< MeshKey, vector<size_t> >					denseIds;
+		map< MeshKey, unordered_map<size_t, size_t> >	sparseIds;
+		for (map< MeshKey, pair<size_t, size_t> >::const_iterator itb =
+		     bounds.begin ( ); bounds.end ( ) != itb; itb++)
+		{
+			if ((*itb).second.first / 2 <= (*itb).second.second)
+				denseIds [(*itb).first].assign ((*itb).second.first, noId);
+			else
+				sparseIds [(*itb).first];
+		}	// for (map< MeshKey, pair<size_t, size_t> >::const_iterator ...
+		for (vector< pair<size_t, size_t> >::const_iterator its =
+		     sizes.begin ( ); sizes.end ( ) != its; its++)
+		{
+			const size_t				s		= (*its).second;
+			const size_t				count	= (*its).first;
+			const AbstractQualifSerie&	serie	= *(series [s]);
+			vector<size_t>*					dense	= 0;
+			unordered_map<size_t, size_t>*	sparse	= 0;
+			if (true == isShareable (serie))
+			{
+				const MeshKey	key	= meshKey (serie);
+				map< MeshKey, vector<size_t> >::iterator	itd	=
+														denseIds.find (key);
+				if (denseIds.end ( ) != itd)
+					dense	= &(*itd).second;
+				else
+					sparse	= &sparseIds [key];
+			}	// if (true == isShareable (serie))
+			for (size_t c = 0; c < count; c++)
+			{
+				const size_t	id	= uniques [s][c];
+				uniques [s][c]	= uniqueNum;
+				if (noId != id)
+				{
+					size_t&	known	= 0 != dense ? (*dense) [id] :
+							(*sparse->insert (
+								pair<size_t, size_t> (id, noId)).first).second;
+					if (noId != known)
+					{	// Evaluée par une autre série
+						uniques [s][c]	= known;
+						continue;
+					}	// if (noId != known)
+					known	= uniqueNum;
+				}	// if (noId != id)
+				owned [s].push_back (c);
+				uniqueNum++;
+			}	// for (size_t c = 0; c < count; c++)
+		}	// for (vector< pair<size_t, size_t> >::const_iterator its = ...
+	}
+
+	// Evaluation des mailles distinctes, chaque série étant prise en charge
+	// par un seul thread (de même que les séries partageant une série
+	// sous-jacente), les threads s'attribuant les séries au fil de l'eau par
+	// ordre décroissant de taille :
+	vector<double>			values (uniqueNum, 0.);
+	vector<unsigned char>	status (
+								uniqueNum, AbstractQualifSerie::CELL_FAILED);
+	{
+		QualifPhaseTimer	timer (profile, QualifProfile::CRITERION_EVALUATION);
+		QualifTraceScope	scope (QualifProfile::phaseName (
+							QualifProfile::CRITERION_EVALUATION), "phase");
+		vector<size_t>						evaluators;
+		vector<const AbstractQualifSerie*>	evaluated;
+		for (vector< pair<size_t, size_t> >::const_iterator its =
+		     sizes.begin ( ); sizes.end ( ) != its; its++)
+		{
+			if (true == owned [(*its).second].empty ( ))
+				continue;
+			evaluators.push_back ((*its).second);
+			evaluated.push_back (series [(*its).second]);
+		}	// for (vector< pair<size_t, size_t> >::const_iterator its = ...
+		const vector< vector<size_t> >	groups	=
+							AbstractQualifSerie::groupSharingSeries (evaluated);
+		size_t				threadsNum	= true == multiThreaded ?
+									  QualifHelper::getThreadsNum (0) : 1;
+		threadsNum	= (0 != groups.size ( )) &&
+					  (groups.size ( ) < threadsNum) ?
+					  groups.size ( ) : threadsNum;
+		atomic<size_t>		next (0);
+		QualifHelper::parallelFor (threadsNum, threadsNum,
+		                           [&] (size_t, size_t)
+		{
+			for (size_t g = next++; g < groups.size ( ); g = next++)
+			{
+				for (vector<size_t>::const_iterator itk = groups [g].begin ( );
+				     groups [g].end ( ) != itk; itk++)
+				{
+					const size_t	s	= evaluators [*itk];
+					evaluateCells (*(series [s]), owned [s], uniques [s],
+					               criterion, cellTypes, min, max, cnRatio,
+					               values, status);
+					vector<size_t> ( ).swap (owned [s]);
+				}	// for (vector<size_t>::const_iterator itk = ...
+			}	// for (size_t g = next++; g < groups.size ( ); ...
+		});
+	}
+	for (vector<unsigned char>::const_iterator its = status.begin ( );
+	     status.end ( ) != its; its++)
+	{
+		switch (*its)
+		{
+			case AbstractQualifSerie::CELL_EVALUATED	:
+				profile.increment (QualifProfile::CELLS_EVALUATED);	break;
+			case AbstractQualifSerie::CELL_SKIPPED		:
+				profile.increment (QualifProfile::CELLS_SKIPPED);	break;
+			default										:
+				profile.increment (QualifProfile::EXCEPTIONS_CAUGHT);
+		}	// switch (*its)
+	}	// for (vector<unsigned char>::const_iterator its = status.begin ( ); ...
+	profile.increment (QualifProfile::CELLS_SHARED, cellsNum - uniqueNum);
+
+	// Les histogrammes des séries, déduits des valeurs des mailles
+	// distinctes :
+	QualifPhaseTimer	timer (profile, QualifProfile::BINNING);
+	QualifTraceScope	scope (
+				QualifProfile::phaseName (QualifProfile::BINNING), "phase");
+	for (size_t s = 0; s < seriesNum; s++)
+	{
+		const vector<size_t>&	ids		= uniques [s];
+		const size_t			count	= ids.size ( );
+		for (size_t c = 0; c < count; c++)
+		{
+			const size_t	u	= ids [c];
+			if (AbstractQualifSerie::CELL_EVALUATED != status [u])
+				continue;
+			const double	value	= values [u];
+			if ((true == strict) && ((value < min) || (value > max)))
+			{
+				profile.increment (QualifProfile::CELLS_SKIPPED);
+				continue;
+			}	// if ((true == strict) && ...
+			const size_t	cl	= QualifHelper::getClassIndex (
+									value, min, cnRatio, classNum);
+			increment (cl, s, c);
+		}	// for (size_t c = 0; c < count; c++)
+		vector<size_t> ( ).swap (uniques [s]);
+	}	// for (size_t s = 0; s < seriesNum; s++)
+}	// QualifSharedCellsTask::execute
+
+
+}	// namespace GQualif
@@ -0,0 +1,335 @@
+#include "GQualif/QualifTimeSeriesTask.h"
+#include "GQualif/QualifHelper.h"
+#include "GQualif/QualifTracer.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/InternalError.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <assert.h>
+#include <cfloat>
+
+
+USING_UTIL
+USING_STD
+using namespace Qualif;
+
+static const	Charset	charset ("àéèùô");
+
+/** Nombre de mailles des paquets évalués par
+ * <I>AbstractQualifSerie::evaluateCriterion</I>. */
+static const size_t		evaluationChunkSize	= 4096;
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                        LA CLASSE QualifTimeSeriesTask
+// ============================================================================
+
+QualifTimeSeriesTask::QualifTimeSeriesTask (
+			size_t types, Critere criterion, size_t classesNum,
+			double min, double max, bool strict, TimeSeriesQualifSerie& serie,
+			size_t prefetch, size_t threadsNum)
+	: QualifAnalysisTask (types, criterion, classesNum, min, max, strict,
+	                      vector<AbstractQualifSerie*> (1, &serie)),
+	  _serie (&serie), _prefetch (0 == prefetch ? 1 : prefetch),
+	  _threadsNum (threadsNum), _ranges ( )
+{
+}	// QualifTimeSeriesTask::QualifTimeSeriesTask
+
+
+QualifTimeSeriesTask::QualifTimeSeriesTask (const QualifTimeSeriesTask&)
+	: QualifAnalysisTask (
+			(size_t)-1, (Critere)-1, 1, 0., 1., false,
+			vector<AbstractQualifSerie*> ( )),
+	  _serie (0), _prefetch (1), _threadsNum (0), _ranges ( )
+{
+	assert (0 && "QualifTimeSeriesTask copy constructor is not allowed.");
+}	// QualifTimeSeriesTask::QualifTimeSeriesTask
+
+
+QualifTimeSeriesTask& QualifTimeSeriesTask::operator = (
+												const QualifTimeSeriesTask&)
+{
+	assert (0 && "QualifTimeSeriesTask assignment operator is not allowed.");
+	return *this;
+}	// QualifTimeSeriesTask::operator =
+
+
+QualifTimeSeriesTask::~QualifTimeSeriesTask ( )
+{
+}	// QualifTimeSeriesTask::~QualifTimeSeriesTask
+
+
+size_t QualifTimeSeriesTask::getSeriesNum ( ) const
+{
+	return 0 == _serie ? 0 : _serie->getStepsNum ( );
+}	// QualifTimeSeriesTask::getSeriesNum
+
+
+TimeSeriesQualifSerie& QualifTimeSeriesTask::getTimeSerie ( ) const
+{
+	CHECK_NULL_PTR_ERROR (_serie)
+	return *_serie;
+}	// QualifTimeSeriesTask::getTimeSerie
+
+
+void QualifTimeSeriesTask::getStepRange (
+								size_t step, double& min, double& max) const
+{
+	if (step >= _ranges.size ( ))
+	{
+		UTF8String	error (charset);
+		error << "QualifTimeSeriesTask::getStepRange : pas de temps invalide ("
+		      << (unsigned long)step << "), " << (unsigned long)_ranges.size ( )
+		      << " pas de temps analysés.";
+		throw Exception (error);
+	}	// if (step >= _ranges.size ( ))
+
+	min	= _ranges [step].first;
+	max	= _ranges [step].second;
+}	// QualifTimeSeriesTask::getStepRange
+
+
+void QualifTimeSeriesTask::execute ( )
+{
+	TimeSeriesQualifSerie&	serie		= getTimeSerie ( );
+	QualifTimeStepsSource&	source		= serie.getSource ( );
+	const	size_t	stepsNum		= getSeriesNum ( );
+	const	size_t	classNum		= getClassesNum ( );
+	const	Critere	criterion		= getCriterion ( );
+	const	size_t	cellTypes		= getDataTypes ( );
+	const	double	min				= getMin ( );
+	const	double	max				= getMax ( );
+	const	bool	strict			= useStrictDomain ( );
+	if (0 == classNum)
+		throw Exception (UTF8String ("QualifTimeSeriesTask::execute : nombre de classes nul.", charset));
+	const	double	cnRatio			= max / classNum - min / classNum;
+	// Pas d'enregistrement de l'appartenance des mailles aux classes :
+	AbstractQualifTask::initializeSeriesValues (classNum, stepsNum);
+	vector< vector<size_t> >&		seriesValues	= getSeriesValues ( );
+	_ranges.assign (stepsNum, pair<double, double> (DBL_MAX, -DBL_MAX));
+	QualifProfile&					profile	= getProfile ( );
+	profile.reset ( );
+	QualifTraceScope				taskScope ("QualifTimeSeriesTask", "task");
+	if (0 == stepsNum)
+		return;
+
+	size_t	threadsNum	= QualifHelper::getThreadsNum (_threadsNum);
+	threadsNum	= stepsNum < threadsNum ? stepsNum : threadsNum;
+
+	// Les types des mailles sont recensés une fois pour toutes, et repris
+	// avec la connectivité par les séries des threads d'évaluation :
+	serie.getDataTypes ( );
+	const vector<size_t>&	order	= serie.getEvaluationOrder ( );
+
+	// Les tampons des coordonnées : libres, lus (en attente d'évaluation), ou
+	// en cours de lecture ou d'évaluation. Le thread de lecture a au plus
+	// _prefetch pas de temps d'avance sur les threads d'évaluation.
+	vector<QualifStepCoordinates>	buffers (threadsNum + _prefetch);
+	vector<size_t>					bufferSteps (buffers.size ( ), 0);
+	deque<size_t>					freeBuffers, readBuffers;
+	for (size_t b = 0; b < buffers.size ( ); b++)
+		freeBuffers.push_back (b);
+	mutex							buffersMutex;
+	condition_variable				buffersCondition;
+	bool							readingCompleted	= false;
+	bool							failed				= false;
+	string							error;
+	function<void (const string&)>	fail	= [&] (const string& message)
+	{
+		lock_guard<mutex>	lock (buffersMutex);
+		if (false == failed)
+			error	= message;
+		failed	= true;
+		buffersCondition.notify_all ( );
+	};
+
+	thread	reader ([&] ( )
+	{
+		QualifProfile	readerProfile;
+		try
+		{
+			for (size_t step = 0; step < stepsNum; step++)
+			{
+				size_t	b	= 0;
+				{
+					unique_lock<mutex>	lock (buffersMutex);
+					buffersCondition.wait (lock, [&] ( )
+					{ return (true == failed) || (false == freeBuffers.empty ( )); });
+					if (true == failed)
+						break;
+					b	= freeBuffers.front ( );
+					freeBuffers.pop_front ( );
+				}
+				{
+					QualifPhaseTimer	timer (readerProfile, QualifProfile::LOADING);
+					QualifTraceScope	scope (QualifProfile::phaseName (
+								QualifProfile::LOADING), "phase",
+								source.getStepName (step));
+					source.readStep (step, buffers [b]);
+				}
+				lock_guard<mutex>	lock (buffersMutex);
+				bufferSteps [b]	= step;
+				readBuffers.push_back (b);
+				buffersCondition.notify_all ( );
+			}	// for (size_t step = 0; step < stepsNum; step++)
+		}
+		catch (const Exception& exc)
+		{
+			fail (exc.getFullMessage ( ).utf8 ( ));
+		}
+		catch (const exception& exc)
+		{
+			fail (exc.what ( ));
+		}
+		catch (...)
+		{
+			fail ("Erreur non documentée.");
+		}
+
+		lock_guard<mutex>	lock (buffersMutex);
+		readingCompleted	= true;
+		profile.merge (readerProfile);
+		buffersCondition.notify_all ( );
+	});
+
+	// Evaluation : chaque thread évalue un pas de temps à la fois, au fil de
+	// leur lecture.
+	try
+	{
+		QualifHelper::parallelFor (threadsNum, threadsNum, [&] (size_t, size_t)
+		{
+			QualifProfile			localProfile;
+			vector<double>			chunkValues (evaluationChunkSize);
+			vector<unsigned char>	chunkStatus (evaluationChunkSize);
+			vector<size_t>			counts (classNum, 0);
+			try
+			{
+				ArrayQualifSerie	stepSerie (serie.getName ( ),
+									serie.getDimension ( ), serie.getFileName ( ));
+				stepSerie.setCells (serie);
+				if (false == order.empty ( ))
+					stepSerie.setEvaluationOrder (order);
+				const size_t		count	= stepSerie.getCellCount ( );
+				while (true)
+				{
+					size_t	b	= 0;
+					{
+						unique_lock<mutex>	lock (buffersMutex);
+						buffersCondition.wait (lock, [&] ( )
+						{
+							return (true == failed) || (true == readingCompleted) ||
+							       (false == readBuffers.empty ( ));
+						});
+						if ((true == failed) || (true == readBuffers.empty ( )))
+							break;
+						b	= readBuffers.front ( );
+						readBuffers.pop_front ( );
+					}
+					const size_t	step	= bufferSteps [b];
+					QualifPhaseTimer	timer (localProfile,
+										QualifProfile::CRITERION_EVALUATION);
+					QualifTraceScope	scope (QualifProfile::phaseName (
+								QualifProfile::CRITERION_EVALUATION), "phase",
+								source.getStepName (step));
+					TimeSeriesQualifSerie::assignCoordinates (
+													stepSerie, buffers [b]);
+					double	stepMin	= DBL_MAX,	stepMax	= -DBL_MAX;
+					size_t	evaluated	= 0,	skipped	= 0,	failures	= 0;
+					fill (counts.begin ( ), counts.end ( ), 0);
+					for (size_t first = 0; first < count;
+					     first += evaluationChunkSize)
+					{
+						const size_t	last	= first + evaluationChunkSize < count ?
+												  first + evaluationChunkSize : count;
+						stepSerie.evaluateCriterion (criterion, cellTypes,
+								first, last, &chunkValues [0], &chunkStatus [0]);
+						for (size_t p = 0; p < last - first; p++)
+						{
+							if (AbstractQualifSerie::CELL_EVALUATED !=
+							    chunkStatus [p])
+							{
+								if (AbstractQualifSerie::CELL_SKIPPED ==
+								    chunkStatus [p])
+									skipped++;
+								else
+									failures++;
+								continue;
+							}	// if (AbstractQualifSerie::CELL_EVALUATED != ...
+							const double	value	= chunkValues [p];
+							evaluated++;
+							stepMin	= value < stepMin ? value : stepMin;
+							stepMax	= value > stepMax ? value : stepMax;
+							if ((true == strict) && ((value < min) || (value > max)))
+							{
+								skipped++;
+								continue;
+							}	// if ((true == strict) && ...
+							counts [QualifHelper::getClassIndex (
+										value, min, cnRatio, classNum)]++;
+						}	// for (size_t p = 0; p < last - first; p++)
+					}	// for (size_t first = 0; first < count; ...
+					stepSerie.setCoordinates ((const double*)0, 0);
+					{
+						lock_guard<mutex>	lock (buffersMutex);
+						freeBuffers.push_back (b);
+						buffersCondition.notify_all ( );
+					}
+
+					// Chaque pas de temps n'est traité que par un thread :
+					for (size_t cl = 0; cl < classNum; cl++)
+						seriesValues [cl][step]	= counts [cl];
+					_ranges [step]	= pair<double, double> (stepMin, stepMax);
+					localProfile.increment (
+								QualifProfile::CELLS_EVALUATED, evaluated);
+					localProfile.increment (QualifProfile::CELLS_SKIPPED, skipped);
+					localProfile.increment (
+								QualifProfile::EXCEPTIONS_CAUGHT, failures);
+				}	// while (true)
+			}
+			catch (const Exception& exc)
+			{
+				fail (exc.getFullMessage ( ).utf8 ( ));
+			}
+			catch (const exception& exc)
+			{
+				fail (exc.what ( ));
+			}
+			catch (...)
+			{
+				fail ("Erreur non documentée.");
+			}
+
+			lock_guard<mutex>	lock (buffersMutex);
+			profile.merge (localProfile);
+		});
+	}
+	catch (...)
+	{	// Création des threads impossible, ... : le thread de lecture est
+		// arrêté avant de propager l'erreur.
+		fail ("Evaluation des pas de temps interrompue.");
+		reader.join ( );
+		throw;
+	}
+	reader.join ( );
+
+	if (true == failed)
+	{
+		UTF8String	message (charset);
+		message << "Série " << serie.getName ( )
+		        << " : échec de l'analyse des pas de temps : " << error;
+		throw Exception (message);
+	}	// if (true == failed)
+}	// QualifTimeSeriesTask::execute
+
+
+}	// namespace GQualif
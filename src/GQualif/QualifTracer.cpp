@@ -0,0 +1,172 @@
+#include "GQualif/QualifTracer.h"
+#include "GQualif/QualifHelper.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/UTF8String.h>
+
+#include <fstream>
+#include <iomanip>
+#include <assert.h>
+
+
+USING_UTIL
+USING_STD
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                           LA CLASSE QualifTracer
+// ============================================================================
+
+atomic<bool>					QualifTracer::_enabled (false);
+mutex							QualifTracer::_mutex;
+QualifTracer::Clock::time_point	QualifTracer::_origin;
+vector<QualifTracer::Event>		QualifTracer::_events;
+
+
+QualifTracer::QualifTracer ( )
+{
+	assert (0 && "QualifTracer constructor is not allowed.");
+}	// QualifTracer::QualifTracer
+
+
+QualifTracer::QualifTracer (const QualifTracer&)
+{
+	assert (0 && "QualifTracer copy constructor is not allowed.");
+}	// QualifTracer::QualifTracer
+
+
+QualifTracer& QualifTracer::operator = (const QualifTracer&)
+{
+	assert (0 && "QualifTracer assignment operator is not allowed.");
+	return *this;
+}	// QualifTracer::operator =
+
+
+QualifTracer::~QualifTracer ( )
+{
+}	// QualifTracer::~QualifTracer
+
+
+void QualifTracer::start ( )
+{
+	lock_guard<mutex>	lock (_mutex);
+	_events.clear ( );
+	_origin	= Clock::now ( );
+	_enabled.store (true);
+}	// QualifTracer::start
+
+
+void QualifTracer::stop ( )
+{
+	_enabled.store (false);
+}	// QualifTracer::stop
+
+
+size_t QualifTracer::eventsNum ( )
+{
+	lock_guard<mutex>	lock (_mutex);
+	return _events.size ( );
+}	// QualifTracer::eventsNum
+
+
+void QualifTracer::write (const string& fileName)
+{
+	ofstream	stream (fileName.c_str ( ));
+	if (false == stream.good ( ))
+	{
+		UTF8String	message (charset);
+		message << "Impossibilité d'ouvrir le fichier " << fileName
+		        << " en écriture.";
+		throw Exception (message);
+	}	// if (false == stream.good ( ))
+
+	lock_guard<mutex>	lock (_mutex);
+	stream << fixed << setprecision (3)
+	       << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (vector<Event>::const_iterator ite = _events.begin ( );
+	     _events.end ( ) != ite; ite++)
+	{
+		stream << (_events.begin ( ) == ite ? "\n" : ",\n");
+		if (true == (*ite).metadata)
+			stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+			       << "\"tid\":" << (*ite).thread << ",\"args\":{\"name\":"
+			       << QualifHelper::jsonString ((*ite).name) << "}}";
+		else
+		{
+			stream << "{\"name\":" << QualifHelper::jsonString ((*ite).name)
+			       << ",\"cat\":" << QualifHelper::jsonString ((*ite).category)
+			       << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << (*ite).thread
+			       << ",\"ts\":" << (*ite).begin
+			       << ",\"dur\":" << (*ite).duration;
+			if (false == (*ite).detail.empty ( ))
+				stream << ",\"args\":{\"detail\":"
+				       << QualifHelper::jsonString ((*ite).detail) << "}";
+			stream << "}";
+		}	// else if (true == (*ite).metadata)
+	}	// for (vector<Event>::const_iterator ite = _events.begin ( ); ...
+	stream << "\n]}\n";
+	stream.flush ( );
+
+	if (false == stream.good ( ))
+	{
+		UTF8String	message (charset);
+		message << "Erreur lors de l'écriture de la trace dans le fichier "
+		        << fileName << ".";
+		throw Exception (message);
+	}	// if (false == stream.good ( ))
+}	// QualifTracer::write
+
+
+void QualifTracer::addEvent (
+				const string& name, const string& category,
+				const Clock::time_point& begin, const Clock::time_point& end,
+				const string& detail)
+{
+	if (false == enabled ( ))
+		return;
+
+	Event	event;
+	event.name		= name;
+	event.category	= category;
+	event.detail	= detail;
+	event.thread	= threadId ( );
+	event.metadata	= false;
+	lock_guard<mutex>	lock (_mutex);
+	event.begin		=
+			chrono::duration<double, micro> (begin - _origin).count ( );
+	event.duration	= chrono::duration<double, micro> (end - begin).count ( );
+	_events.push_back (event);
+}	// QualifTracer::addEvent
+
+
+void QualifTracer::setThreadName (const string& name)
+{
+	if (false == enabled ( ))
+		return;
+
+	Event	event;
+	event.name		= name;
+	event.begin		= 0.;
+	event.duration	= 0.;
+	event.thread	= threadId ( );
+	event.metadata	= true;
+	lock_guard<mutex>	lock (_mutex);
+	_events.push_back (event);
+}	// QualifTracer::setThreadName
+
+
+size_t QualifTracer::threadId ( )
+{
+	static atomic<size_t>	counter (1);
+	thread_local size_t		id	= counter.fetch_add (1);
+
+	return id;
+}	// QualifTracer::threadId
+
+
+}	// namespace GQualif
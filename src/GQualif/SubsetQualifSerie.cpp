@@ -0,0 +1,323 @@
+#include "GQualif/SubsetQualifSerie.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/UTF8String.h>
+
+#include <assert.h>
+
+#include <cfloat>
+
+
+USING_UTIL
+USING_STD
+using namespace Qualif;
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                         LA CLASSE SubsetQualifSerie
+// ============================================================================
+
+SubsetQualifSerie::SubsetQualifSerie (
+		AbstractQualifSerie& parent, const vector<size_t>& cells,
+		const string& name)
+	: AbstractQualifSerie (parent.getFileName ( ), name, parent.getDimension ( )),
+	  _parent (parent), _cells (cells), _ranges ( )
+{
+	const size_t	count	= parent.getCellCount ( );
+	for (vector<size_t>::const_iterator itc = cells.begin ( );
+	     cells.end ( ) != itc; itc++)
+	{
+		if (*itc >= count)
+		{
+			UTF8String	error (charset);
+			error << "Série " << name << " : indice de maille invalide ("
+			      << (unsigned long)*itc << ") pour la série "
+			      << parent.getName ( ) << " de " << (unsigned long)count
+			      << " mailles.";
+			throw Exception (error);
+		}	// if (*itc >= count)
+	}	// for (vector<size_t>::const_iterator itc = cells.begin ( ); ...
+}	// SubsetQualifSerie::SubsetQualifSerie
+
+
+SubsetQualifSerie::SubsetQualifSerie (
+		AbstractQualifSerie& parent, const vector<bool>& selection,
+		const string& name)
+	: AbstractQualifSerie (parent.getFileName ( ), name, parent.getDimension ( )),
+	  _parent (parent), _cells ( ), _ranges ( )
+{
+	const size_t	count	= parent.getCellCount ( );
+	if (selection.size ( ) != count)
+	{
+		UTF8String	error (charset);
+		error << "Série " << name << " : masque de "
+		      << (unsigned long)selection.size ( )
+		      << " mailles incompatible avec la série " << parent.getName ( )
+		      << " de " << (unsigned long)count << " mailles.";
+		throw Exception (error);
+	}	// if (selection.size ( ) != count)
+
+	for (size_t c = 0; c < count; c++)
+		if (true == selection [c])
+			_cells.push_back (c);
+	vector<size_t> (_cells).swap (_cells);
+}	// SubsetQualifSerie::SubsetQualifSerie
+
+
+SubsetQualifSerie::SubsetQualifSerie (const SubsetQualifSerie& serie)
+	: AbstractQualifSerie ("Invalid file name", "Invalid name", (unsigned char)-1),
+	  _parent (serie._parent), _cells ( ), _ranges ( )
+{
+	assert (0 && "SubsetQualifSerie copy constructor is not allowed.");
+}	// SubsetQualifSerie::SubsetQualifSerie
+
+
+SubsetQualifSerie& SubsetQualifSerie::operator = (const SubsetQualifSerie&)
+{
+	assert (0 && "SubsetQualifSerie assignment operator is not allowed.");
+	return *this;
+}	// SubsetQualifSerie::operator =
+
+
+SubsetQualifSerie::~SubsetQualifSerie ( )
+{
+}	// SubsetQualifSerie::~SubsetQualifSerie
+
+
+AbstractQualifSerie& SubsetQualifSerie::getParent ( ) const
+{
+	return _parent;
+}	// SubsetQualifSerie::getParent
+
+
+const vector<size_t>& SubsetQualifSerie::getParentCells ( ) const
+{
+	return _cells;
+}	// SubsetQualifSerie::getParentCells
+
+
+size_t SubsetQualifSerie::getParentCell (size_t i) const
+{
+	if (i >= _cells.size ( ))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : indice de maille invalide ("
+		      << (unsigned long)i << ").";
+		throw Exception (error);
+	}	// if (i >= _cells.size ( ))
+
+	return _cells [i];
+}	// SubsetQualifSerie::getParentCell
+
+
+size_t SubsetQualifSerie::getCellCount ( ) const
+{
+	return _cells.size ( );
+}	// SubsetQualifSerie::getCellCount
+
+
+Maille& SubsetQualifSerie::getCell (size_t i) const
+{
+	return _parent.getCell (_cells [i]);
+}	// SubsetQualifSerie::getCell
+
+
+size_t SubsetQualifSerie::getCellType (size_t i) const
+{
+	return _parent.getCellType (_cells [i]);
+}	// SubsetQualifSerie::getCellType
+
+
+bool SubsetQualifSerie::isVolumic ( ) const
+{
+	return _parent.isVolumic ( );
+}	// SubsetQualifSerie::isVolumic
+
+
+bool SubsetQualifSerie::hasMeshCellIds ( ) const
+{
+	return _parent.hasMeshCellIds ( );
+}	// SubsetQualifSerie::hasMeshCellIds
+
+
+size_t SubsetQualifSerie::getMeshCellId (size_t i) const
+{
+	return _parent.getMeshCellId (_cells [i]);
+}	// SubsetQualifSerie::getMeshCellId
+
+
+const void* SubsetQualifSerie::getMeshInstance ( ) const
+{
+	return _parent.getMeshInstance ( );
+}	// SubsetQualifSerie::getMeshInstance
+
+
+void SubsetQualifSerie::getDataRange (
+					Critere criterion, double& min, double& max) const
+{
+	// Mise en cache du critère par la série parente. Les extrema du
+	// sous-ensemble sont à recalculer si ses mailles ou coordonnées ont été
+	// modifiées entre temps, qu'elle ait ou non encore le critère en cache :
+	const size_t	revision	= _parent.getRevision ( );
+	_parent.getDataRange (criterion, min, max);
+	map<Critere, Range>::const_iterator	itr	= _ranges.find (criterion);
+	if ((_ranges.end ( ) != itr) && (revision == (*itr).second.revision))
+	{
+		min	= (*itr).second.min;
+		max	= (*itr).second.max;
+		return;
+	}	// if ((_ranges.end ( ) != itr) && ...
+
+	min	= DBL_MAX;	max	= -DBL_MAX;
+	for (vector<size_t>::const_iterator itc = _cells.begin ( );
+	     _cells.end ( ) != itc; itc++)
+	{
+		try
+		{
+			const double	value	= _parent.getStoredCriteria (criterion, *itc);
+			min	= value < min ? value : min;
+			max	= value > max ? value : max;
+		}
+		catch (...)
+		{	// Certains types ne sont pas supportés (pentagone, ...).
+		}
+	}	// for (vector<size_t>::const_iterator itc = _cells.begin ( ); ...
+
+	// Valeurs quantifiées : les extrema sont recalculés en pleine précision
+	// parmi les mailles susceptibles de les atteindre (cf.
+	// QSerieRangeThread) :
+	const double	error	= _parent.getStoredCriteriaError (criterion);
+	if ((0. != error) && (min <= max))
+	{
+		const double	lower	= min + 2. * error;
+		const double	upper	= max - 2. * error;
+		min	= DBL_MAX;	max	= -DBL_MAX;
+		for (vector<size_t>::const_iterator itc = _cells.begin ( );
+		     _cells.end ( ) != itc; itc++)
+		{
+			try
+			{
+				double	value	= _parent.getStoredCriteria (criterion, *itc);
+				if ((value > lower) && (value < upper))
+					continue;
+				value	= _parent.getCriteriaValue (criterion, *itc);
+				min	= value < min ? value : min;
+				max	= value > max ? value : max;
+			}
+			catch (...)
+			{
+			}
+		}	// for (vector<size_t>::const_iterator itc = _cells.begin ( ); ...
+	}	// if ((0. != error) && (min <= max))
+
+	Range&	range	= _ranges [criterion];
+	range.min		= min;
+	range.max		= max;
+	range.revision	= revision;
+}	// SubsetQualifSerie::getDataRange
+
+
+bool SubsetQualifSerie::isCriteriaStored (Critere criterion) const
+{
+	return _parent.isCriteriaStored (criterion);
+}	// SubsetQualifSerie::isCriteriaStored
+
+
+double SubsetQualifSerie::getStoredCriteria (Critere criterion, size_t i) const
+{
+	return _parent.getStoredCriteria (criterion, _cells [i]);
+}	// SubsetQualifSerie::getStoredCriteria
+
+
+double SubsetQualifSerie::getStoredCriteriaError (Critere criterion) const
+{
+	return _parent.getStoredCriteriaError (criterion);
+}	// SubsetQualifSerie::getStoredCriteriaError
+
+
+double SubsetQualifSerie::getCriteriaValue (Critere criterion, size_t i) const
+{
+	return _parent.getCriteriaValue (criterion, _cells [i]);
+}	// SubsetQualifSerie::getCriteriaValue
+
+
+bool SubsetQualifSerie::rebin (
+			Critere criterion, size_t cellTypes, size_t classesNum,
+			double min, double max, bool strict, vector<size_t>& counts,
+			size_t threadsNum) const
+{
+	return _parent.rebin (criterion, cellTypes, classesNum, min, max, strict,
+	                      _cells, counts, threadsNum);
+}	// SubsetQualifSerie::rebin
+
+
+bool SubsetQualifSerie::rebin (
+			Critere criterion, size_t cellTypes, size_t classesNum,
+			double min, double max, bool strict, const vector<size_t>& cells,
+			vector<size_t>& counts, size_t threadsNum) const
+{
+	vector<size_t>	parentCells;
+	parentCells.reserve (cells.size ( ));
+	for (vector<size_t>::const_iterator itc = cells.begin ( );
+	     cells.end ( ) != itc; itc++)
+		parentCells.push_back (getParentCell (*itc));
+
+	return _parent.rebin (criterion, cellTypes, classesNum, min, max, strict,
+	                      parentCells, counts, threadsNum);
+}	// SubsetQualifSerie::rebin
+
+
+void SubsetQualifSerie::releaseStoredData ( )
+{
+	AbstractQualifSerie::releaseStoredData ( );
+	_ranges.clear ( );
+}	// SubsetQualifSerie::releaseStoredData
+
+
+void SubsetQualifSerie::releaseStoredCriterion (Critere criterion)
+{
+	AbstractQualifSerie::releaseStoredCriterion (criterion);
+	_ranges.erase (criterion);
+}	// SubsetQualifSerie::releaseStoredCriterion
+
+
+bool SubsetQualifSerie::isThreadable ( ) const
+{
+	return _parent.isThreadable ( );
+}	// SubsetQualifSerie::isThreadable
+
+
+vector<AbstractQualifSerie*> SubsetQualifSerie::getUnderlyingSeries ( )
+{
+	return _parent.getUnderlyingSeries ( );
+}	// SubsetQualifSerie::getUnderlyingSeries
+
+
+vector<const AbstractQualifSerie*>
+							SubsetQualifSerie::getUnderlyingSeries ( ) const
+{
+	const AbstractQualifSerie&	parent	= _parent;
+
+	return parent.getUnderlyingSeries ( );
+}	// SubsetQualifSerie::getUnderlyingSeries
+
+
+void SubsetQualifSerie::getCellCentroid (
+						size_t i, double& x, double& y, double& z) const
+{
+	_parent.getCellCentroid (_cells [i], x, y, z);
+}	// SubsetQualifSerie::getCellCentroid
+
+
+bool SubsetQualifSerie::isCentroidReentrant ( ) const
+{
+	return _parent.isCentroidReentrant ( );
+}	// SubsetQualifSerie::isCentroidReentrant
+
+
+}	// namespace GQualif
@@ -0,0 +1,174 @@
+#include "GQualif/TimeSeriesQualifSerie.h"
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/UTF8String.h>
+
+#include <assert.h>
+
+
+USING_UTIL
+USING_STD
+
+static const Charset	charset ("àéèùô");
+
+
+namespace GQualif
+{
+
+// ============================================================================
+//                       LA STRUCTURE QualifStepCoordinates
+// ============================================================================
+
+QualifStepCoordinates::QualifStepCoordinates ( )
+	: nodesNum (0), stride (0), floatCoordinates ( ), doubleCoordinates ( )
+{
+}	// QualifStepCoordinates::QualifStepCoordinates
+
+
+void QualifStepCoordinates::clear ( )
+{
+	nodesNum	= 0;
+	stride		= 0;
+	vector<float> ( ).swap (floatCoordinates);
+	vector<double> ( ).swap (doubleCoordinates);
+}	// QualifStepCoordinates::clear
+
+
+// ============================================================================
+//                       LA CLASSE QualifTimeStepsSource
+// ============================================================================
+
+QualifTimeStepsSource::QualifTimeStepsSource ( )
+{
+}	// QualifTimeStepsSource::QualifTimeStepsSource
+
+
+QualifTimeStepsSource::QualifTimeStepsSource (const QualifTimeStepsSource&)
+{
+	assert (0 && "QualifTimeStepsSource copy constructor is not allowed.");
+}	// QualifTimeStepsSource::QualifTimeStepsSource
+
+
+QualifTimeStepsSource& QualifTimeStepsSource::operator = (
+												const QualifTimeStepsSource&)
+{
+	assert (0 && "QualifTimeStepsSource assignment operator is not allowed.");
+	return *this;
+}	// QualifTimeStepsSource::operator =
+
+
+QualifTimeStepsSource::~QualifTimeStepsSource ( )
+{
+}	// QualifTimeStepsSource::~QualifTimeStepsSource
+
+
+string QualifTimeStepsSource::getStepName (size_t step) const
+{
+	UTF8String	name (charset);
+	name << (unsigned long)step;
+
+	return name.utf8 ( );
+}	// QualifTimeStepsSource::getStepName
+
+
+// ============================================================================
+//                       LA CLASSE TimeSeriesQualifSerie
+// ============================================================================
+
+TimeSeriesQualifSerie::TimeSeriesQualifSerie (
+		const string& name, unsigned char dimension,
+		QualifTimeStepsSource& source, const string& fileName)
+	: ArrayQualifSerie (name, dimension, fileName),
+	  _source (source), _step ((size_t)-1), _coordinates ( )
+{
+}	// TimeSeriesQualifSerie::TimeSeriesQualifSerie
+
+
+TimeSeriesQualifSerie::TimeSeriesQualifSerie (
+										const TimeSeriesQualifSerie& serie)
+	: ArrayQualifSerie ("Invalid name", 3),
+	  _source (serie._source), _step ((size_t)-1), _coordinates ( )
+{
+	assert (0 && "TimeSeriesQualifSerie copy constructor is not allowed.");
+}	// TimeSeriesQualifSerie::TimeSeriesQualifSerie
+
+
+TimeSeriesQualifSerie& TimeSeriesQualifSerie::operator = (
+												const TimeSeriesQualifSerie&)
+{
+	assert (0 && "TimeSeriesQualifSerie assignment operator is not allowed.");
+	return *this;
+}	// TimeSeriesQualifSerie::operator =
+
+
+TimeSeriesQualifSerie::~TimeSeriesQualifSerie ( )
+{
+}	// TimeSeriesQualifSerie::~TimeSeriesQualifSerie
+
+
+QualifTimeStepsSource& TimeSeriesQualifSerie::getSource ( ) const
+{
+	return _source;
+}	// TimeSeriesQualifSerie::getSource
+
+
+size_t TimeSeriesQualifSerie::getStepsNum ( ) const
+{
+	return _source.getStepsNum ( );
+}	// TimeSeriesQualifSerie::getStepsNum
+
+
+void TimeSeriesQualifSerie::setStep (size_t step)
+{
+	if (step >= getStepsNum ( ))
+	{
+		UTF8String	error (charset);
+		error << "Série " << getName ( ) << " : pas de temps invalide ("
+		      << (unsigned long)step << "), " << (unsigned long)getStepsNum ( )
+		      << " pas de temps disponibles.";
+		throw Exception (error);
+	}	// if (step >= getStepsNum ( ))
+
+	// Les coordonnées courantes sont invalidées avant d'être remplacées :
+	_step	= (size_t)-1;
+	setCoordinates ((const double*)0, 0);
+	_source.readStep (step, _coordinates);
+	assignCoordinates (*this, _coordinates);
+	_step	= step;
+}	// TimeSeriesQualifSerie::setStep
+
+
+size_t TimeSeriesQualifSerie::getStep ( ) const
+{
+	return _step;
+}	// TimeSeriesQualifSerie::getStep
+
+
+void TimeSeriesQualifSerie::assignCoordinates (
+				ArrayQualifSerie& serie, const QualifStepCoordinates& coordinates)
+{
+	const size_t	stride	=
+				0 == coordinates.stride ? serie.getDimension ( ) : coordinates.stride;
+	const size_t	size	= false == coordinates.floatCoordinates.empty ( ) ?
+								coordinates.floatCoordinates.size ( ) :
+								coordinates.doubleCoordinates.size ( );
+	if ((0 != coordinates.nodesNum) &&
+	    (size < (coordinates.nodesNum - 1) * stride + serie.getDimension ( )))
+	{
+		UTF8String	error (charset);
+		error << "Série " << serie.getName ( ) << " : "
+		      << (unsigned long)size << " coordonnées pour "
+		      << (unsigned long)coordinates.nodesNum << " noeuds.";
+		throw Exception (error);
+	}	// if ((0 != coordinates.nodesNum) && ...
+
+	if (false == coordinates.floatCoordinates.empty ( ))
+		serie.setCoordinates (coordinates.floatCoordinates.data ( ),
+		                      coordinates.nodesNum, stride);
+	else
+		serie.setCoordinates (coordinates.doubleCoordinates.data ( ),
+		                      coordinates.nodesNum, stride);
+}	// TimeSeriesQualifSerie::assignCoordinates
+
+
+}	// namespace GQualif
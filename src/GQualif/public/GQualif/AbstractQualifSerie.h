@@ -5,9 +5,12 @@
 
 #include <Maille.h>
 
+#include <functional>
 #include <map>
 #include <vector>
 
+#include <stdint.h>
+
 namespace GQualif
 {
 
@@ -98,18 +101,94 @@ class AbstractQualifSerie
 	 */
 	virtual bool isVolumic ( ) const = 0;
 
+	/**
+	 * @return		<I>true</I> si la série connaît l'identifiant de ses
+	 * 				mailles dans le maillage dont elle est issue
+	 * 				(<I>getMeshCellId</I>), <I>false</I> par défaut.
+	 */
+	virtual bool hasMeshCellIds ( ) const;
+
+	/**
+	 * @return		L'identifiant de la i-ème maille dans le maillage dont est
+	 * 				issue la série. Deux séries issues d'une même instance de
+	 * 				maillage (<I>getMeshInstance</I>), dont les mailles sont
+	 * 				de même nature (<I>isVolumic</I>), partagent leurs mailles
+	 * 				de même identifiant (groupes se recouvrant).
+	 * @exception	Une exception est levée par défaut.
+	 * @see			hasMeshCellIds
+	 * @see			QualifSharedCellsTask
+	 */
+	virtual size_t getMeshCellId (size_t i) const;
+
+	/**
+	 * @return		L'instance du maillage chargé dont est issue la série, 0
+	 * 				si elle n'est pas connue (défaut). Elle n'identifie les
+	 * 				mailles partagées (<I>getMeshCellId</I>) que parmi les
+	 * 				séries issues d'un même fichier, l'adresse d'un maillage
+	 * 				détruit (instantanés) pouvant être réutilisée.
+	 * @see			QualifSharedCellsTask
+	 */
+	virtual const void* getMeshInstance ( ) const;
+
 	/**
  	 * Rem : cette méthode met en cache les valeurs du critère de qualité donné
  	 * pour les mailles de la série, de même que les valeurs min et max
  	 * rencontrées.
 	 * @return		Les extrema du domaine d'échantillonage pour le critère
 	 *				transmis en argument.
+	 * @exception	Une exception est levée si l'évaluation est interrompue
+	 * 				(<I>setInterruption</I>), rien n'étant alors mis en cache.
 	 * @see			getStoredCriteria
 	 * @see			releaseStoredData
 	 */
 	virtual void getDataRange (
 					Qualif::Critere criterion, double& min, double& max) const;
 	
+	/**
+	 * Statut d'une maille à l'issue de <I>evaluateCriterion</I>.
+	 */
+	enum CELL_EVALUATION { CELL_EVALUATED = 0, CELL_SKIPPED = 1, CELL_FAILED = 2 };
+
+	/**
+	 * Ensemble des types de mailles : pas de filtrage par type dans
+	 * <I>evaluateCriterion</I>.
+	 */
+	static const size_t		ALL_TYPES;
+
+	/**
+	 * Evalue le critère transmis en argument pour les mailles de rangs
+	 * [first, last[ dans l'ordre d'évaluation de la série, à savoir les
+	 * mailles <I>getEvaluatedCell (first)</I> à
+	 * <I>getEvaluatedCell (last - 1)</I>.
+	 * Par défaut chaque maille est obtenue par <I>getCellType</I> et
+	 * <I>getCell</I>. Les classes dérivées disposant d'un accès direct à
+	 * leurs données peuvent surcharger cette méthode afin de traiter le
+	 * paquet de mailles par type (cf. <I>StaticQualifPipeline</I>).
+	 * @param		Critère à appliquer.
+	 * @param		Types des mailles à évaluer, au sens <I>QualifHelper</I>
+	 * 				(<I>ALL_TYPES</I> : toutes, leur type n'étant alors pas
+	 * 				consulté).
+	 * @param		Rang de la première maille du paquet.
+	 * @param		Rang suivant celui de la dernière maille du paquet.
+	 * @param		En retour, <I>values [p - first]</I> est la valeur du
+	 * 				critère pour la maille de rang p (non affecté si la maille
+	 * 				n'est pas évaluée).
+	 * @param		En retour, <I>status [p - first]</I> est le statut
+	 * 				(<I>CELL_EVALUATION</I>) de la maille de rang p :
+	 * 				<I>CELL_SKIPPED</I> si son type n'est pas retenu,
+	 * 				<I>CELL_FAILED</I> si son évaluation a échoué (type non
+	 * 				supporté, ...).
+	 * @return		Le nombre de mailles évaluées.
+	 * @warning		Ne lève pas d'exception en cas d'échec de l'évaluation
+	 * 				d'une maille.
+	 * @see			getDataRange
+	 * @see			computeEvaluationOrder
+	 */
+	virtual size_t evaluateCriterion (
+				Qualif::Critere criterion, size_t cellTypes,
+				size_t first, size_t last,
+				double* values, unsigned char* status) const;
+
 	/**
 	 * @return		Les types de mailles au sens <I>QualifHelper</I>, définis
 	 * 				par un ou exclusif sur les types élémentaires
@@ -130,6 +209,16 @@ class AbstractQualifSerie
 	 */
 	virtual void validateCoordinates ( );
 
+	/**
+	 * Recopie si nécessaire les mailles et les coordonnées de leurs noeuds
+	 * dans des tableaux contigus, afin d'accélérer les évaluations
+	 * ultérieures. Ne fait rien par défaut, les mailles étant généralement
+	 * lues directement dans des tableaux.
+	 * @param		Nombre de threads utilisés (0 : nombre de processeurs).
+	 * @return		<I>true</I> si les données ont été recopiées.
+	 */
+	virtual bool flattenCoordinates (size_t threadsNum);
+
 	/**
  	 * Méthode à appeler en cas de validation des noeuds.
  	 * @param		<I>true</I> si les noeuds viennent d'être soumis au service
@@ -145,6 +234,23 @@ class AbstractQualifSerie
 	 */
 	virtual void setCoordinatesValidity (bool evaluated, bool valid, const IN_UTIL UTF8String& msg);
 
+	/**
+	 * @return		Le numéro de révision des mailles et des coordonnées de
+	 * 				la série et de ses séries sous-jacentes, qui croît à
+	 * 				chaque modification (coordonnées, pas de temps,
+	 * 				connectivité, ...). Permet de détecter qu'un résultat
+	 * 				d'analyse conservé est obsolète.
+	 * @see			dataRevised
+	 */
+	virtual size_t getRevision ( ) const;
+
+	/**
+	 * Incrémente le numéro de révision de la série. A invoquer en cas de
+	 * modification des mailles ou des coordonnées de leurs noeuds.
+	 * @see			getRevision
+	 */
+	virtual void dataRevised ( );
+
 	/**
 	 * @param		Un critère de qualité Qualif.
 	 * @return		<I>true</I> si la valeur pour chaque maille du critère
@@ -153,6 +259,18 @@ class AbstractQualifSerie
 	 */
 	virtual bool isCriteriaStored (Qualif::Critere criterion) const;
 
+	/**
+	 * Enregistre à la date courante (au sens de <I>applyMemoryBudget</I>)
+	 * l'utilisation des valeurs en cache du critère transmis en argument,
+	 * pour cette série et ses séries sous-jacentes. A appeler une fois par tâche, avant de consulter
+	 * ces valeurs (<I>isCriteriaStored</I> et <I>getStoredCriteria</I> ne
+	 * modifient pas la série).
+	 * @warning		Les séries ne doivent pas être en cours d'utilisation par
+	 * 				un autre thread.
+	 * @see			getLastUse
+	 */
+	virtual void recordUse (Qualif::Critere criterion) const;
+
 	/**
 	 * @param		Un critère de qualité Qualif.
 	 * @param		L'indice d'une maille dans cette série.
@@ -161,12 +279,133 @@ class AbstractQualifSerie
 	 *
 	 * @see			isCriteriaStored
 	 * @see			releaseStoredData
+	 * @see			getStoredCriteriaError
 	 */
 	virtual double getStoredCriteria (Qualif::Critere criterion, size_t i) const;
 
+	/**
+	 * Mode de stockage des valeurs des critères en cache :
+	 * <UL>
+	 * <LI><I>FULL_STORAGE</I> : en double précision (8 octets par maille),
+	 * <LI><I>QUANTIZED_STORAGE</I> : sur 16 bits, quantifiées dans le domaine
+	 * théorique du critère (<I>QualifHelper::getDomain</I>) s'il est borné et
+	 * contient les valeurs obtenues, dans le domaine observé sinon (les
+	 * mailles sont alors évaluées 2 fois). Les critères binaires
+	 * (<I>QualifHelper::isBinaryCriterion</I>) sont stockés sur 1 bit, sans
+	 * perte. Les critères pour lesquels l'erreur maximale demandée ne peut
+	 * être respectée sont stockés en double précision.
+	 * </UL>
+	 * L'erreur de quantification d'un critère est donnée par
+	 * <I>getStoredCriteriaError</I>. Les classifications utilisant des
+	 * valeurs quantifiées recalculent en pleine précision (
+	 * <I>getCriteriaValue</I>) les seules mailles dont la classe est
+	 * ambiguë (<I>QualifHelper::isClassAmbiguous</I>), ce qui garantit une
+	 * affectation aux classes identique à celle obtenue en pleine précision,
+	 * quel que soit le nombre de classes.
+	 */
+	enum STORAGE_MODE { FULL_STORAGE, QUANTIZED_STORAGE };
+
+	/**
+	 * @param		Mode de stockage des valeurs des critères mis en cache
+	 * 				ultérieurement, pour l'ensemble des séries
+	 * 				(<I>FULL_STORAGE</I> par défaut).
+	 * @param		Erreur maximale tolérée en mode quantifié, relative à
+	 * 				l'étendue du domaine de quantification (au moins
+	 * 				<I>1 / 131070</I>, demi pas de quantification sur 16
+	 * 				bits).
+	 */
+	static void setStorageMode (STORAGE_MODE mode, double maxError = 1. / 131070);
+
+	/**
+	 * @return		Le mode de stockage des valeurs des critères.
+	 */
+	static STORAGE_MODE getStorageMode ( );
+
+	/**
+	 * @return		L'erreur maximale tolérée en mode quantifié, relative à
+	 * 				l'étendue du domaine de quantification.
+	 */
+	static double getStorageMaxError ( );
+
+	/**
+	 * @param		Fonction consultée <U>par le thread courant</U> entre deux
+	 * 				paquets de mailles lors de la mise en cache d'un critère
+	 * 				(<I>getDataRange</I>). Si elle retourne <I>true</I>
+	 * 				l'évaluation est interrompue. Fonction vide (défaut) : pas
+	 * 				d'interruption.
+	 * @see			QualifSerieWarmUp
+	 */
+	static void setInterruption (const std::function<bool ( )>& interrupted);
+
+	/**
+	 * @return		L'erreur maximale (absolue) commise sur les valeurs en
+	 * 				cache du critère transmis en argument (0 si elles ne
+	 * 				sont pas quantifiées ou pas en cache).
+	 */
+	virtual double getStoredCriteriaError (Qualif::Critere criterion) const;
+
+	/**
+	 * @return		La valeur en pleine précision du critère pour la i-ème
+	 * 				maille : valeur en cache si elle n'est pas quantifiée,
+	 * 				recalculée dans le cas contraire (ou si elle n'est pas en
+	 * 				cache).
+	 * @exception	Une exception est levée si le critère ne peut être
+	 * 				évalué pour cette maille.
+	 */
+	virtual double getCriteriaValue (Qualif::Critere criterion, size_t i) const;
+
+	/**
+	 * Répartit en classes de même largeur du domaine [min, max] les mailles
+	 * de la série à partir des seules valeurs en cache du critère, sans appel
+	 * virtuel par maille (les types des mailles sont mis en cache au premier
+	 * appel). Les classes sont calculées par paquets de mailles, sans
+	 * branchement (produit par l'inverse de la largeur des classes, bornage
+	 * aux classes extrêmes), et en parallèle. Les mailles dont la valeur
+	 * quantifiée est de classe ambiguë sont recalculées en pleine précision
+	 * (<I>getCriteriaValue</I>).
+	 * @param		Critère dont les valeurs sont réparties.
+	 * @param		Types des mailles retenues, au sens <I>QualifHelper</I>.
+	 * @param		Nombre de classes (!= 0).
+	 * @param		Valeur minimale du domaine d'échantillonnage.
+	 * @param		Valeur maximale du domaine d'échantillonnage.
+	 * @param		<I>true</I> s'il ne faut pas prendre en compte les mailles
+	 * 				dont le critère est hors-domaine, <I>false</I> si elles
+	 * 				sont affectées à la classe extrême la plus proche.
+	 * @param		En retour, <I>counts [cl]</I> est le nombre de mailles de
+	 * 				la classe cl.
+	 * @param		Nombre de threads utilisés (0 : nombre de processeurs).
+	 * @return		<I>false</I> si les valeurs du critère ne sont pas en cache,
+	 * 				<I>counts</I> n'étant alors pas modifié.
+	 * @warning		Les index des mailles par classe
+	 * 				(<I>getClassesCellsIndexes</I>) ne sont pas mis à jour
+	 * 				(cf. <I>deferClassesCellsIndexes</I>).
+	 * @see			QualifRebinningTask
+	 */
+	virtual bool rebin (
+				Qualif::Critere criterion, size_t cellTypes, size_t classesNum,
+				double min, double max, bool strict,
+				std::vector<size_t>& counts, size_t threadsNum = 0) const;
+
+	/**
+	 * Répartit en classes, comme <I>rebin</I>, les seules mailles de la série
+	 * dont les indices sont transmis en argument (sous-ensemble de la série,
+	 * cf. <I>SubsetQualifSerie</I>).
+	 * @param		Indices des mailles à répartir. Une maille présente
+	 * 				plusieurs fois est comptée autant de fois.
+	 * @exception	Une exception est levée si un indice est invalide.
+	 */
+	virtual bool rebin (
+				Qualif::Critere criterion, size_t cellTypes, size_t classesNum,
+				double min, double max, bool strict,
+				const std::vector<size_t>& cells, std::vector<size_t>& counts,
+				size_t threadsNum = 0) const;
+
 	/**
 	 * @return		Les index des mailles rangés par classe.
 	 * Usage : getClassesCellsIndexes ( )[classe]
+	 * @warning		Si une répartition est en attente
+	 * 				(<I>deferClassesCellsIndexes</I>) les index sont au
+	 * 				préalable recalculés selon cette répartition.
 	 */
 	virtual const std::vector < std::vector <size_t> >& getClassesCellsIndexes ( ) const;
 	virtual std::vector < std::vector <size_t> >& getClassesCellsIndexes ( );
@@ -174,9 +413,25 @@ class AbstractQualifSerie
 	/**
 	 * @param		En retour les index des mailles dont l'index de la classe
 	 * 				est transmis en second argument.
+	 * @exception	Une exception est levée si l'index de classe est invalide.
+	 * @see			getClassesCellsIndexes
 	 */
 	virtual void getCellsIndexes (std::vector<size_t>& indexes, size_t clas) const;
 
+	/**
+	 * Invoqué après un <I>rebin</I> : libère les index des mailles rangés par
+	 * classe et mémorise la répartition transmise en argument (mêmes
+	 * arguments que <I>rebin</I>). Les index sont recalculés à partir des
+	 * valeurs en cache du critère (ou à défaut des mailles) lors de leur
+	 * prochaine consultation (<I>getClassesCellsIndexes</I>,
+	 * <I>getCellsIndexes</I>), et correspondent alors aux effectifs retournés
+	 * par <I>rebin</I>.
+	 * @see			QualifRebinningTask
+	 */
+	virtual void deferClassesCellsIndexes (
+				Qualif::Critere criterion, size_t cellTypes, size_t classesNum,
+				double min, double max, bool strict);
+
 	/**
 	 * Ajoute l'index de maille transmis en second argument aux index de la
 	 * classe transmise en premier argument.
@@ -196,9 +451,120 @@ class AbstractQualifSerie
 
 	/**
 	 * Libère la mémoire occupée par les données en cache.
+	 * @see			releaseStoredCriterion
+	 * @see			applyMemoryBudget
 	 */
 	virtual void releaseStoredData ( );
 
+	/**
+	 * Mémoire occupée par les données en cache (valeurs des critères, index
+	 * des mailles par classe), et libération de ces données, critère par
+	 * critère, selon un budget mémoire global à l'ensemble des séries
+	 * existantes : sont libérées en premier les données utilisées le moins
+	 * récemment (<I>LRU</I>), une donnée étant utilisée lorsqu'elle est
+	 * calculée (<I>getDataRange</I>, <I>setClassesNum</I>) ou consultée par
+	 * une tâche (<I>getDataRange</I>, <I>recordUse</I>).
+	 */
+	//@{
+
+	/**
+	 * @return		La mémoire, en octets, occupée par les données en cache de
+	 * 				la série (valeurs des critères, index des mailles par
+	 * 				classe et types des mailles utilisés par <I>rebin</I>).
+	 */
+	virtual size_t getMemoryUsage ( ) const;
+
+	/**
+	 * @return		La mémoire, en octets, occupée par les valeurs en cache
+	 * 				du critère transmis en argument (0 s'il n'est pas en
+	 * 				cache).
+	 */
+	virtual size_t getMemoryUsage (Qualif::Critere criterion) const;
+
+	/**
+	 * @return		La mémoire, en octets, occupée par les index des mailles
+	 * 				rangés par classe.
+	 */
+	virtual size_t getClassesMemoryUsage ( ) const;
+
+	/**
+	 * @return		Les critères dont les valeurs sont en cache.
+	 */
+	virtual std::vector<Qualif::Critere> getStoredCriteriaList ( ) const;
+
+	/**
+	 * Libère la mémoire occupée par les valeurs en cache du critère transmis
+	 * en argument.
+	 */
+	virtual void releaseStoredCriterion (Qualif::Critere criterion);
+
+	/**
+	 * Libère la mémoire occupée par les index des mailles rangés par classe,
+	 * et abandonne l'éventuelle répartition en attente
+	 * (<I>deferClassesCellsIndexes</I>).
+	 */
+	virtual void releaseClassesCellsIndexes ( );
+
+	/**
+	 * @return		La date (au sens de <I>applyMemoryBudget</I>) de la dernière
+	 * 				utilisation des valeurs en cache du critère transmis en
+	 * 				argument, 0 si elles ne sont pas en cache.
+	 */
+	virtual size_t getLastUse (Qualif::Critere criterion) const;
+
+	/**
+	 * @return		La date (au sens de <I>applyMemoryBudget</I>) de la dernière
+	 * 				utilisation des index des mailles rangés par classe.
+	 */
+	virtual size_t getClassesLastUse ( ) const;
+
+	/**
+	 * @param		Budget mémoire, en octets, des données en cache de
+	 * 				l'ensemble des séries (0 : pas de limite, valeur par
+	 * 				défaut).
+	 * @see			applyMemoryBudget
+	 */
+	static void setMemoryBudget (size_t bytes);
+
+	/**
+	 * @return		Le budget mémoire des données en cache (0 : pas de
+	 * 				limite).
+	 */
+	static size_t getMemoryBudget ( );
+
+	/**
+	 * A invoquer avant l'analyse des séries transmises en argument selon le
+	 * critère transmis en second argument. Débute une nouvelle date
+	 * d'utilisation puis, si un budget mémoire est défini, libère les
+	 * données en cache des séries existantes utilisées le moins récemment
+	 * jusqu'à ce que leur mémoire, augmentée de celle nécessaire au stockage
+	 * des valeurs du critère à analyser, respecte ce budget. Les valeurs du
+	 * critère à analyser des séries transmises et de leurs séries
+	 * sous-jacentes (<I>getUnderlyingSeries</I>) ne sont pas libérées, pas
+	 * plus que les données verrouillées (<I>lockStoredData</I>), qui ne sont
+	 * pas consultées (mémoire relevée lors de leur verrouillage). Les index
+	 * des mailles par classe ne sont libérés que pour ces séries et leurs
+	 * séries sous-jacentes.
+	 * @return		La mémoire libérée, en octets.
+	 * @warning		Les données en cache non verrouillées ne doivent pas être
+	 * 				en cours d'utilisation par un autre thread.
+	 */
+	static size_t applyMemoryBudget (
+					const std::vector<AbstractQualifSerie*>& series,
+					Qualif::Critere criterion);
+
+	/**
+	 * Verrouille (resp. déverrouille) les données en cache de la série
+	 * transmise en argument et de ses séries sous-jacentes : elles ne sont
+	 * pas libérées par <I>applyMemoryBudget</I>. A utiliser lorsqu'un autre
+	 * thread utilise la série. Les verrous se cumulent.
+	 * @see			applyMemoryBudget
+	 */
+	static void lockStoredData (AbstractQualifSerie& serie);
+	static void unlockStoredData (AbstractQualifSerie& serie);
+
+	//@}
+
 	/**
 	 * @return		<I>true</I> si la série est utilisable en contexte
 	 * 				multithread, <I>false</I> dans le cas contraire.
@@ -206,6 +572,110 @@ class AbstractQualifSerie
 	 */
 	virtual bool isThreadable ( ) const;
 
+	/**
+	 * @return		Les séries dont cette série utilise les mailles et les
+	 * 				données en cache (vues sur d'autres séries, cf.
+	 * 				<I>SubsetQualifSerie</I> et <I>CompositeQualifSerie</I>),
+	 * 				la série elle-même par défaut. Des séries ayant une série
+	 * 				sous-jacente commune ne doivent pas être consultées
+	 * 				simultanément par des threads différents.
+	 * @see			groupSharingSeries
+	 */
+	virtual std::vector<AbstractQualifSerie*> getUnderlyingSeries ( );
+	virtual std::vector<const AbstractQualifSerie*> getUnderlyingSeries ( ) const;
+
+	/**
+	 * @return		Les indices des séries transmises en argument regroupés
+	 * 				par série sous-jacente commune (transitivement) : les
+	 * 				séries d'un même groupe doivent être traitées par un même
+	 * 				thread. Les groupes sont ordonnés selon leur premier
+	 * 				élément, et les indices par ordre croissant au sein d'un
+	 * 				groupe.
+	 * @see			getUnderlyingSeries
+	 */
+	static std::vector< std::vector<size_t> > groupSharingSeries (
+						const std::vector<const AbstractQualifSerie*>& series);
+
+	/**
+	 * Ordre d'évaluation des mailles. Les mailles d'un maillage sont souvent
+	 * numérotées indépendamment de leurs noeuds, et le recueil des
+	 * coordonnées des sommets fait alors des accès dispersés en mémoire. La
+	 * série peut être évaluée (<I>evaluateCriterion</I>) dans l'ordre de
+	 * parcours d'une courbe de Morton des centres des mailles, les résultats
+	 * étant toujours associés aux indices d'origine des mailles.
+	 */
+	//@{
+
+	/**
+	 * Calcule l'ordre d'évaluation des mailles selon la courbe de Morton de
+	 * leurs centres, en parallèle (calcul des centres si
+	 * <I>isCentroidReentrant</I> retourne <I>true</I>, calcul des clés, tri).
+	 * @param		Nombre de threads utilisés (0 : nombre de processeurs).
+	 * @param		Si <I>true</I> les noeuds de la série sont, si elle le
+	 * 				permet, renumérotés dans leur ordre d'utilisation par les
+	 * 				mailles (cf. <I>renumberNodes</I>).
+	 * @return		La durée, en secondes, du calcul de l'ordre (et de
+	 * 				l'éventuelle renumérotation).
+	 * @see			getEvaluationOrder
+	 * @see			releaseEvaluationOrder
+	 */
+	virtual double computeEvaluationOrder (
+							size_t threadsNum = 0, bool renumber = false);
+
+	/**
+	 * Affecte l'ordre d'évaluation des mailles (ex : ordre fourni par le
+	 * générateur du maillage).
+	 * @param		Ordre d'évaluation : <I>order [p]</I> est l'indice de la
+	 * 				maille de rang p.
+	 * @exception	Une exception est levée si <I>order</I> n'est pas une
+	 * 				permutation des indices des mailles.
+	 */
+	virtual void setEvaluationOrder (const std::vector<size_t>& order);
+
+	/**
+	 * Les mailles sont ensuite évaluées dans l'ordre de leurs indices.
+	 */
+	virtual void releaseEvaluationOrder ( );
+
+	/**
+	 * @return		L'ordre d'évaluation des mailles (<I>order [p]</I> est
+	 * 				l'indice de la maille de rang p), vide si les mailles
+	 * 				sont évaluées dans l'ordre de leurs indices.
+	 */
+	virtual const std::vector<size_t>& getEvaluationOrder ( ) const;
+
+	/**
+	 * @return		L'indice de la maille de rang <I>p</I> dans l'ordre
+	 * 				d'évaluation.
+	 */
+	size_t getEvaluatedCell (size_t p) const
+	{ return true == _evaluationOrder.empty ( ) ? p : _evaluationOrder [p]; }
+
+	/**
+	 * @return		La durée, en secondes, du dernier calcul de l'ordre
+	 * 				d'évaluation.
+	 */
+	virtual double getEvaluationOrderTime ( ) const;
+
+	/**
+	 * @return		En retour, le centre (moyenne des sommets) de la i-ème
+	 * 				maille. Par défaut la maille est obtenue par
+	 * 				<I>getCell</I>.
+	 * @exception	Une exception est levée si la maille est invalide.
+	 * @see			isCentroidReentrant
+	 */
+	virtual void getCellCentroid (
+						size_t i, double& x, double& y, double& z) const;
+
+	/**
+	 * @return		<I>true</I> si <I>getCellCentroid</I> peut être invoquée
+	 * 				simultanément par plusieurs threads pour cette série,
+	 * 				<I>false</I> par défaut (cf. <I>getCell</I>).
+	 */
+	virtual bool isCentroidReentrant ( ) const;
+
+	//@}
+
 
 	protected :
 
@@ -224,6 +694,17 @@ class AbstractQualifSerie
 	 */
 	virtual void setName (const IN_STD string& name);
 
+	/**
+	 * Renumérote les noeuds de la série dans leur ordre de première
+	 * utilisation par les mailles parcourues dans l'ordre d'évaluation.
+	 * Ne fait rien par défaut, les noeuds n'étant généralement pas détenus
+	 * par la série.
+	 * @param		Nombre de threads utilisés (0 : nombre de processeurs).
+	 * @return		<I>true</I> si les noeuds ont été renumérotés.
+	 * @see			computeEvaluationOrder
+	 */
+	virtual bool renumberNodes (size_t threadsNum);
+
 
 	private :
 
@@ -233,6 +714,35 @@ class AbstractQualifSerie
 	AbstractQualifSerie (const AbstractQualifSerie&);
 	AbstractQualifSerie& operator = (const AbstractQualifSerie&);
 
+	/**
+	 * Mise en oeuvre de <I>rebin</I> : répartit les <I>count</I> mailles
+	 * d'indices <I>cells [0 ... count - 1]</I>, ou les <I>count</I> premières
+	 * mailles si <I>cells</I> est nul.
+	 */
+	bool rebinCells (
+				Qualif::Critere criterion, size_t cellTypes, size_t classesNum,
+				double min, double max, bool strict, const size_t* cells,
+				size_t count, std::vector<size_t>& counts,
+				size_t threadsNum) const;
+
+	/**
+	 * Recalcule, si une répartition est en attente
+	 * (<I>deferClassesCellsIndexes</I>), les index des mailles rangés par
+	 * classe, comme le ferait une analyse (<I>QualifAnalysisTask</I>).
+	 */
+	virtual void updateClassesCellsIndexes ( ) const;
+
+	/** Une répartition en classes en attente (cf.
+	 * <I>deferClassesCellsIndexes</I>). */
+	struct ClassesRequest
+	{
+		bool				pending;
+		Qualif::Critere		criterion;
+		size_t				cellTypes, classesNum;
+		double				min, max;
+		bool				strict;
+	};	// struct ClassesRequest
+
 	/** Le nom du fichier d'où est éventuellement issue la série. */
 	IN_STD string					_fileName;
 
@@ -264,8 +774,42 @@ class AbstractQualifSerie
 	 * (utile pour les critères non définis sur certains type de mailles). */
 	mutable std::map<Qualif::Critere,std::vector<bool> > _storedValuesDefined;
 
+	/** Stockage compact des valeurs des critères : valeurs quantifiées sur 16
+	 * bits et origine/pas de quantification, valeurs des critères binaires. */
+	mutable std::map<Qualif::Critere,std::vector<uint16_t> > _quantizedValues;
+	mutable std::map<Qualif::Critere, std::pair<double, double> >	_quantizations;
+	mutable std::map<Qualif::Critere,std::vector<bool> > _binaryValues;
+
 	/** Les index des mailles dans chaque classe. */
 	mutable std::vector < std::vector <size_t> >		_classesCellsIndexes;
+
+	/** L'éventuelle répartition en classes à appliquer aux index des mailles
+	 * lors de leur prochaine consultation. */
+	mutable ClassesRequest								_classesRequest;
+
+	/** Les types des mailles (au sens <I>QualifHelper</I>, 0 si non
+	 * supporté), utilisés par <I>rebin</I>. */
+	mutable std::vector<unsigned char>					_cellsTypes;
+
+	/** Les dates de dernière utilisation des données en cache. */
+	mutable std::map<Qualif::Critere, size_t>			_lastUses;
+	mutable size_t										_classesLastUse;
+
+	/** Le nombre de verrous posés sur les données en cache (cf.
+	 * <I>lockStoredData</I>, protégé par le mutex des séries existantes). */
+	size_t												_storedDataLocks;
+
+	/** La mémoire utilisée par les données en cache lors de la pose du
+	 * premier verrou (cf. <I>applyMemoryBudget</I>). */
+	size_t												_lockedMemoryUsage;
+
+	/** Le numéro de révision des mailles et des coordonnées. */
+	size_t												_revision;
+
+	/** L'éventuel ordre d'évaluation des mailles, et la durée de son
+	 * calcul. */
+	std::vector<size_t>									_evaluationOrder;
+	double												_evaluationOrderTime;
 };	// class AbstractQualifSerie
 
 }	// namespace GQualif
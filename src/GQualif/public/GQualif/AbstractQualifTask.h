@@ -4,6 +4,7 @@
 #include <TkUtil/util_config.h>
 
 #include "GQualif/AbstractQualifSerie.h"
+#include "GQualif/QualifProfile.h"
 
 #include <vector>
 
@@ -69,6 +70,14 @@ class AbstractQualifTask
 	const std::vector< std::vector <size_t> >&	getSeriesValues ( ) const;
 	std::vector< std::vector <size_t> >&	getSeriesValues ( );
 
+	/**
+	 * @return		L'instrumentation (temps par phase, compteurs) de la
+	 * 				dernière exécution de la tâche.
+	 * @see			QualifProfile
+	 */
+	const QualifProfile& getProfile ( ) const;
+	QualifProfile& getProfile ( );
+
 
 	protected :
 
@@ -123,6 +132,13 @@ class AbstractQualifTask
 	 */
 	virtual void initializeSeriesValues (size_t classesNum, size_t seriesNum);
 
+	/**
+	 * Enregistre l'utilisation des valeurs en cache du critère de la tâche
+	 * par ses séries (<I>AbstractQualifSerie::recordUse</I>). A invoquer une
+	 * fois, avant l'exécution en parallèle.
+	 */
+	virtual void recordSeriesUse ( );
+
 
 	private :
 
@@ -144,6 +160,9 @@ class AbstractQualifTask
 	/** La répartition en classes des différentes séries.
 	 * Utilisation : seriesValues [cl][s], cl : classe, s : série. */
 	std::vector< std::vector <size_t> >	_seriesValues;
+
+	/** L'instrumentation de la dernière exécution. */
+	QualifProfile						_profile;
 };	// class AbstractQualifTask
 
 }	// namespace GQualif
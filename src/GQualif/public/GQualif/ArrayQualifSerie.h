@@ -0,0 +1,398 @@
+#ifndef ARRAY_QUALIF_SERIE_H
+#define ARRAY_QUALIF_SERIE_H
+
+#include "GQualif/AbstractQualifSerieAdapter.h"
+
+#include <TkUtil/util_config.h>
+
+#include <stdint.h>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Série de mailles reposant sur des tableaux, appartenant à l'appelant,
+ * décrivant un maillage non structuré (coordonnées des noeuds, connectivité,
+ * décalages et types des mailles). Elle permet d'analyser un maillage issu
+ * des structures de données d'un code de calcul sans conversion préalable en
+ * maillage <I>Lima</I>, <I>VTK</I> ou <I>GMDS</I>.
+ * </P>
+ *
+ * <P>Les tableaux ne sont <B>pas copiés</B> : ils doivent rester valides durant
+ * toute la durée de vie de l'instance. En cas de modification de leur contenu
+ * il convient d'invoquer <I>dataModified</I> afin d'invalider les données en
+ * cache (critères, validité des coordonnées), ou <I>coordinatesModified</I>
+ * si seules les coordonnées des noeuds ont changé (maillage mobile).
+ * </P>
+ *
+ * <P>Conventions :
+ * <UL>
+ * <LI>Les coordonnées sont des <I>float</I> ou <I>double</I>, les
+ * <I>dimension</I> coordonnées du i-ème noeud débutant à l'indice
+ * <I>i * stride</I>. Un <I>stride</I> supérieur à la dimension permet de
+ * parcourir un tableau de structures (coordonnées suivies d'autres données),
+ * <LI>La connectivité est un tableau d'indices de noeuds (entiers 32 ou 64
+ * bits), les noeuds de la i-ème maille étant situés entre les indices
+ * <I>offsets [i]</I> et <I>offsets [i + 1]</I> (<I>offsets</I> a donc
+ * <I>cellsNum + 1</I> éléments, convention <I>VTK</I>). En l'absence de
+ * décalages le maillage est supposé homogène,
+ * <LI>Les types des mailles et l'ordre de leurs noeuds sont ceux de
+ * <I>VTK</I> (cf. <I>CELL_TYPE</I>), ce qui est l'ordre attendu par
+ * <I>Qualif</I>,
+ * <LI>Un éventuel champ de déplacements aux noeuds, de mêmes conventions que
+ * les coordonnées, est ajouté aux coordonnées après multiplication par un
+ * facteur d'échelle (<I>setDisplacements</I>). Il s'agit d'une couche
+ * virtuelle : aucun tableau de coordonnées n'est créé,
+ * </UL>
+ * </P>
+ *
+ * <P>Cette classe est utilisable en contexte multithread (lectures seules),
+ * et ne dépend d'aucune bibliothèque de maillage.
+ * </P>
+ */
+class ArrayQualifSerie : public AbstractQualifSerieAdapter
+{
+	public :
+
+	/**
+	 * Les types de mailles supportés (valeurs identiques à celles de
+	 * <I>VTK</I>).
+	 */
+	enum CELL_TYPE
+	{
+		TRIANGLE_CELL = 5, QUADRANGLE_CELL = 9, TETRAEDRON_CELL = 10,
+		HEXAEDRON_CELL = 12, TRIANGULAR_PRISM_CELL = 13, PYRAMID_CELL = 14
+	};
+
+	/**
+	 * Constructeur. La série est vide tant que <I>setCoordinates</I> et
+	 * <I>setCells</I> n'ont pas été invoqués.
+	 * @param		Nom de la série.
+	 * @param		Dimension de l'espace (2 ou 3).
+	 * @param		Nom de l'éventuel fichier d'où sont issues les données.
+	 * @exception	Une exception est levée si la dimension est invalide.
+	 */
+	ArrayQualifSerie (const IN_STD string& name, unsigned char dimension,
+	                  const IN_STD string& fileName = IN_STD string ( ));
+
+	/**
+	 * Destructeur. RAS (les tableaux ne sont pas détruits).
+	 */
+	virtual ~ArrayQualifSerie ( );
+
+	/**
+	 * Affecte les coordonnées des noeuds. Les types des mailles et l'ordre
+	 * d'évaluation sont conservés (cf. <I>coordinatesModified</I>).
+	 * @param		Coordonnées des noeuds.
+	 * @param		Nombre de noeuds.
+	 * @param		Nombre de valeurs séparant 2 noeuds consécutifs dans le
+	 * 				tableau (0 : dimension de l'espace).
+	 * @exception	Une exception est levée si le tableau est nul ou si
+	 * 				<I>stride</I> est inférieur à la dimension.
+	 */
+	virtual void setCoordinates (
+				const double* coordinates, size_t nodesNum, size_t stride = 0);
+	virtual void setCoordinates (
+				const float* coordinates, size_t nodesNum, size_t stride = 0);
+
+	/**
+	 * Affecte les mailles, de types éventuellement différents.
+	 * @param		Nombre de mailles.
+	 * @param		Connectivité (indices des noeuds des mailles).
+	 * @param		Décalages des mailles dans la connectivité
+	 * 				(<I>cellsNum + 1</I> valeurs).
+	 * @param		Types des mailles (<I>CELL_TYPE</I>).
+	 * @exception	Une exception est levée si un tableau est nul.
+	 */
+	virtual void setCells (size_t cellsNum, const int64_t* connectivity,
+	                       const int64_t* offsets, const unsigned char* types);
+	virtual void setCells (size_t cellsNum, const int32_t* connectivity,
+	                       const int32_t* offsets, const unsigned char* types);
+
+	/**
+	 * Affecte les mailles, toutes de même type.
+	 * @param		Nombre de mailles.
+	 * @param		Connectivité (indices des noeuds des mailles, le nombre de
+	 * 				noeuds par maille étant défini par le type).
+	 * @param		Type des mailles (<I>CELL_TYPE</I>).
+	 * @exception	Une exception est levée si la connectivité est nulle ou le
+	 * 				type non supporté.
+	 */
+	virtual void setCells (size_t cellsNum, const int64_t* connectivity,
+	                       unsigned char type);
+	virtual void setCells (size_t cellsNum, const int32_t* connectivity,
+	                       unsigned char type);
+
+	/**
+	 * Affecte les mailles de la série transmise en argument, dont les
+	 * tableaux sont partagés (ex : pas de temps successifs d'un même
+	 * maillage). Les types des mailles déjà recensés par cette série sont
+	 * repris.
+	 * @param		Série dont les mailles sont reprises.
+	 * @warning		Les coordonnées et l'ordre d'évaluation ne sont pas repris.
+	 */
+	virtual void setCells (const ArrayQualifSerie& serie);
+
+	/**
+	 * A invoquer en cas de modification du contenu des tableaux. Libère les
+	 * données en cache et incrémente le numéro de révision
+	 * (<I>getRevision</I>).
+	 */
+	virtual void dataModified ( );
+
+	/**
+	 * A invoquer en cas de modification des seules coordonnées des noeuds.
+	 * Libère les valeurs des critères en cache et la validité des
+	 * coordonnées, mais conserve les types des mailles et l'ordre
+	 * d'évaluation, qui ne dépendent que de la connectivité. Incrémente le
+	 * numéro de révision (<I>getRevision</I>).
+	 */
+	virtual void coordinatesModified ( );
+
+	/**
+	 * Affecte le champ de déplacements aux noeuds, ajouté aux coordonnées
+	 * après multiplication par le facteur d'échelle courant
+	 * (<I>setDisplacementScale</I>). Les types des mailles et l'ordre
+	 * d'évaluation sont conservés (cf. <I>coordinatesModified</I>).
+	 * @param		Déplacements des noeuds (0 : pas de déplacements).
+	 * @param		Nombre de valeurs séparant 2 noeuds consécutifs dans le
+	 * 				tableau (0 : dimension de l'espace).
+	 * @exception	Une exception est levée si <I>stride</I> est inférieur à la
+	 * 				dimension.
+	 */
+	virtual void setDisplacements (const double* displacements, size_t stride = 0);
+	virtual void setDisplacements (const float* displacements, size_t stride = 0);
+
+	/**
+	 * @return		<I>true</I> si la série a un champ de déplacements.
+	 */
+	virtual bool hasDisplacements ( ) const;
+
+	/**
+	 * Facteur d'échelle appliqué aux déplacements (0 par défaut : coordonnées
+	 * non déplacées). Sa modification libère les valeurs des critères en
+	 * cache (cf. <I>coordinatesModified</I>).
+	 */
+	virtual void setDisplacementScale (double scale);
+	virtual double getDisplacementScale ( ) const;
+
+	/**
+	 * @return		Le nombre de noeuds de la série.
+	 */
+	virtual size_t getNodeCount ( ) const;
+
+	/**
+	 * @return		Le nombre de mailles de la série.
+	 */
+	virtual size_t getCellCount ( ) const;
+
+	/**
+	 * @return		La i-ème maille.
+	 * @warning		<B>A utiliser tout de suite, le contenu de la maille
+	 * 				étant susceptible d'évoluer lors d'autres appels à cette
+	 * 				<I>API</I></B>.
+	 * @exception	Une exception est levée si la maille est de type non
+	 * 				supporté ou référence un noeud inexistant.
+	 */
+	virtual Qualif::Maille& getCell (size_t i) const;
+
+	/**
+	 * @return		Le type, au sens <I>QualifHelper</I>, de la i-ème maille.
+	 */
+	virtual size_t getCellType (size_t i) const;
+
+	/**
+	 * Evalue le critère pour les mailles de rangs [first, last[ dans l'ordre
+	 * d'évaluation, par séquences de mailles de même type, chaque séquence étant confiée à la chaîne
+	 * d'évaluation spécialisée pour ce type (<I>StaticQualifPipeline</I>).
+	 * @see			AbstractQualifSerie::evaluateCriterion
+	 */
+	virtual size_t evaluateCriterion (
+				Qualif::Critere criterion, size_t cellTypes,
+				size_t first, size_t last,
+				double* values, unsigned char* status) const;
+
+	/**
+	 * Recherche par dichotomie, pour les mailles de rangs [first, last[ dans
+	 * l'ordre d'évaluation, le plus grand facteur d'échelle des déplacements
+	 * de [0, maxScale] jusqu'auquel la maille reste acceptable, à savoir de
+	 * valeur du critère supérieure ou égale à <I>threshold</I> (ex :
+	 * <I>VALIDITY</I> et 1, <I>SCALEDJACOBIAN</I> et 0). Les coordonnées et
+	 * déplacements des sommets d'une maille ne sont lus qu'une fois pour
+	 * toutes les itérations. Le critère est supposé ne franchir le seuil
+	 * qu'une fois sur l'intervalle.
+	 * @param		Critère à appliquer.
+	 * @param		Types des mailles traitées, au sens <I>QualifHelper</I>
+	 * 				(<I>ALL_TYPES</I> : toutes).
+	 * @param		Valeur minimale acceptable du critère.
+	 * @param		Facteur d'échelle maximal.
+	 * @param		Nombre d'itérations de la dichotomie (précision :
+	 * 				<I>maxScale / 2^iterations</I>).
+	 * @param		Rang de la première maille du paquet.
+	 * @param		Rang suivant celui de la dernière maille du paquet.
+	 * @param		En retour, <I>scales [p - first]</I> est le facteur limite
+	 * 				de la maille de rang p : <I>maxScale</I> si elle reste
+	 * 				acceptable sur tout l'intervalle, -1 si elle ne l'est pas
+	 * 				sans déplacement.
+	 * @param		En retour, <I>status [p - first]</I> est le statut
+	 * 				(<I>CELL_EVALUATION</I>) de la maille de rang p.
+	 * @return		Le nombre de mailles traitées.
+	 * @exception	Une exception est levée si la série n'a pas de champ de
+	 * 				déplacements.
+	 * @warning		Ne modifie pas la série (le facteur d'échelle courant
+	 * 				n'est pas utilisé) : peut être invoquée simultanément par
+	 * 				plusieurs threads.
+	 * @see			QualifDisplacementSweepTask
+	 */
+	virtual size_t findDisplacementLimits (
+				Qualif::Critere criterion, size_t cellTypes, double threshold,
+				double maxScale, size_t iterations, size_t first, size_t last,
+				double* scales, unsigned char* status) const;
+
+	/**
+	 * @return		Les types de mailles au sens <I>QualifHelper</I>. Dans le
+	 * 				cas d'un maillage homogène les mailles ne sont pas
+	 * 				parcourues.
+	 */
+	virtual size_t getDataTypes ( ) const;
+
+	/**
+	 * @return		<I>true</I> si la série comporte des polyèdres.
+	 */
+	virtual bool isVolumic ( ) const;
+
+	/**
+	 * @return		<I>true</I>
+	 */
+	virtual bool isThreadable ( ) const;
+
+	/**
+	 * @return		En retour, le centre de la i-ème maille, lu dans les
+	 * 				tableaux.
+	 * @exception	Une exception est levée si la maille est invalide.
+	 */
+	virtual void getCellCentroid (
+						size_t i, double& x, double& y, double& z) const;
+
+	/**
+	 * @return		<I>true</I>
+	 */
+	virtual bool isCentroidReentrant ( ) const;
+
+	/**
+	 * @return		Le nombre de noeuds d'une maille du type <I>VTK</I>
+	 * 				transmis en argument, 0 si ce type n'est pas supporté.
+	 */
+	static size_t nodesNum (unsigned char type);
+
+	/**
+	 * @return		Le type au sens <I>QualifHelper</I> correspondant au type
+	 * 				<I>VTK</I> transmis en argument, 0 si ce type n'est pas
+	 * 				supporté.
+	 */
+	static size_t qualifType (unsigned char type);
+
+
+	private :
+
+	template <class Adapter, class Cell, size_t NODES>
+											friend class StaticQualifPipeline;
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	ArrayQualifSerie (const ArrayQualifSerie&);
+	ArrayQualifSerie& operator = (const ArrayQualifSerie&);
+
+	/**
+	 * Affecte à <I>cell</I> les <I>NODES</I> sommets de la i-ème maille
+	 * (<I>i</I> étant supposé valide).
+	 * @exception	Une exception est levée si le nombre de noeuds de la
+	 * 				maille n'est pas <I>NODES</I> ou si elle référence un
+	 * 				noeud inexistant.
+	 */
+	template <size_t NODES>
+	void fillCell (size_t i, Qualif::Maille& cell) const;
+
+	/**
+	 * @return		Le facteur limite de la i-ème maille, de <I>NODES</I>
+	 * 				sommets, évaluée par <I>cell</I> (cf.
+	 * 				<I>findDisplacementLimits</I>).
+	 * @exception	Une exception est levée si la maille est invalide.
+	 */
+	template <class Cell, size_t NODES>
+	double displacementLimit (size_t i, Cell& cell, Qualif::Critere criterion,
+	                          double threshold, double maxScale,
+	                          size_t iterations) const;
+
+	/**
+	 * @return		Le type <I>VTK</I> de la i-ème maille.
+	 */
+	unsigned char cellType (size_t i) const
+	{ return 0 == _types ? _type : _types [i]; }
+
+	/**
+	 * @return		L'indice dans la connectivité du premier noeud de la
+	 * 				i-ème maille.
+	 */
+	size_t cellOffset (size_t i) const
+	{
+		if (0 != _offsets64)
+			return (size_t)_offsets64 [i];
+		if (0 != _offsets32)
+			return (size_t)_offsets32 [i];
+		return i * _nodesPerCell;
+	}
+
+	/**
+	 * @return		L'indice du noeud situé à l'indice <I>k</I> de la
+	 * 				connectivité.
+	 */
+	size_t nodeId (size_t k) const
+	{
+		return 0 != _connectivity64 ?
+			(size_t)_connectivity64 [k] : (size_t)_connectivity32 [k];
+	}
+
+	/**
+	 * @return		Les coordonnées du noeud situé à l'indice <I>k</I> de la
+	 * 				connectivité.
+	 * @exception	Une exception est levée si ce noeud n'existe pas.
+	 */
+	void nodeCoordinates (size_t k, double& x, double& y, double& z) const;
+
+	/**
+	 * @return		Les coordonnées, hors déplacements, et le déplacement du
+	 * 				noeud situé à l'indice <I>k</I> de la connectivité.
+	 * @exception	Une exception est levée si ce noeud n'existe pas.
+	 */
+	void nodeGeometry (size_t k, double* coordinates, double* displacement) const;
+
+	/**
+	 * Les mailles sont réinitialisées.
+	 */
+	void resetCells ( );
+
+	size_t					_nodesNum, _stride;
+	const double*			_coordinates64;
+	const float*			_coordinates32;
+	size_t					_cellsNum;
+	const int64_t			*_connectivity64, *_offsets64;
+	const int32_t			*_connectivity32, *_offsets32;
+	const unsigned char*	_types;
+	/** Type et nombre de noeuds des mailles d'un maillage homogène. */
+	unsigned char			_type;
+	size_t					_nodesPerCell;
+	/** Les types de mailles au sens <I>QualifHelper</I> (cache). */
+	mutable size_t			_dataTypes;
+	/** Le champ de déplacements et son facteur d'échelle. */
+	const double*			_displacements64;
+	const float*			_displacements32;
+	size_t					_displacementsStride;
+	double					_displacementScale;
+};	// class ArrayQualifSerie
+
+}	// namespace GQualif
+
+#endif	// ARRAY_QUALIF_SERIE_H
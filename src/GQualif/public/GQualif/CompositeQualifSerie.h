@@ -0,0 +1,190 @@
+#ifndef COMPOSITE_QUALIF_SERIE_H
+#define COMPOSITE_QUALIF_SERIE_H
+
+#include "GQualif/AbstractQualifSerie.h"
+
+#include <mutex>
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Vue concaténant les mailles de plusieurs séries (ex : groupes B, C et D
+ * analysés comme un seul). Les mailles ne sont <B>pas copiées</B> : la i-ème
+ * maille de la vue est obtenue auprès de la série qui la contient, les séries
+ * étant mises bout à bout dans l'ordre transmis au constructeur. Une maille
+ * appartenant à plusieurs de ces séries est présente autant de fois dans la
+ * vue.
+ * </P>
+ *
+ * <P>Les valeurs des critères en cache et les types des mailles sont ceux des
+ * séries concaténées : <I>getDataRange</I> et <I>rebin</I> sont délégués à
+ * chacune d'elles, leurs résultats étant ensuite fusionnés.
+ * </P>
+ *
+ * <P>La vue est utilisable en contexte multithread si les séries concaténées
+ * le sont. Elle ne doit cependant pas être consultée simultanément à l'une
+ * de ces séries ou à une autre vue sur celles-ci
+ * (<I>getUnderlyingSeries</I>), ce dont se chargent les tâches
+ * <I>Qualif</I>.
+ * </P>
+ *
+ * @see		SubsetQualifSerie
+ */
+class CompositeQualifSerie : public AbstractQualifSerie
+{
+	public :
+
+	/**
+	 * Constructeur.
+	 * @param		Séries concaténées.
+	 * @param		Nom de la série.
+	 * @exception	Une exception est levée si aucune série n'est transmise,
+	 * 				si une série est nulle, ou si les mailles des séries ne
+	 * 				sont pas de même nature (<I>isVolumic</I>).
+	 * @warning		Les séries concaténées doivent être utilisables pendant
+	 * 				toute la durée de vie de cette instance. Leurs nombres de
+	 * 				mailles peuvent évoluer (cf. <I>getCellCount</I>).
+	 */
+	CompositeQualifSerie (const std::vector<AbstractQualifSerie*>& series,
+	                      const IN_STD string& name);
+
+	/**
+	 * Destructeur. RAS (les séries concaténées ne sont pas détruites).
+	 */
+	virtual ~CompositeQualifSerie ( );
+
+	/**
+	 * @return		Les séries concaténées.
+	 */
+	virtual const std::vector<AbstractQualifSerie*>& getSeries ( ) const;
+
+	/**
+	 * @return		Le nombre de mailles de la série.
+	 * @warning		Les indices des premières mailles des séries concaténées
+	 * 				sont recalculés ici si l'une d'elles a été modifiée
+	 * 				(<I>getRevision</I>) : les accès aux mailles
+	 * 				(<I>getCell</I>, ...) sont à précéder d'un appel à cette
+	 * 				méthode après toute modification, ce que font les
+	 * 				parcours des séries.
+	 */
+	virtual size_t getCellCount ( ) const;
+
+	/**
+	 * @return		La i-ème maille, obtenue auprès de la série qui la
+	 * 				contient.
+	 * @warning		<B>A utiliser tout de suite</B> (cf.
+	 * 				<I>AbstractQualifSerie::getCell</I>).
+	 */
+	virtual Qualif::Maille& getCell (size_t i) const;
+
+	/**
+	 * @return		Le type, au sens <I>QualifHelper</I>, de la i-ème maille.
+	 */
+	virtual size_t getCellType (size_t i) const;
+
+	/**
+	 * @return		<I>true</I> si les mailles des séries concaténées sont
+	 * 				volumiques.
+	 */
+	virtual bool isVolumic ( ) const;
+
+	/**
+	 * Identifiants des mailles et maillage : ceux des séries concaténées,
+	 * connus si celles-ci sont toutes issues d'une même instance de
+	 * maillage.
+	 */
+	virtual bool hasMeshCellIds ( ) const;
+	virtual size_t getMeshCellId (size_t i) const;
+	virtual const void* getMeshInstance ( ) const;
+
+	/**
+	 * Met en cache, si nécessaire, les valeurs du critère pour toutes les
+	 * mailles des séries concaténées.
+	 * @return		Les extrema du critère sur les mailles de ces séries.
+	 */
+	virtual void getDataRange (
+					Qualif::Critere criterion, double& min, double& max) const;
+
+	/**
+	 * Valeurs en cache des critères : celles des séries concaténées. Un
+	 * critère est en cache s'il l'est pour chacune de ces séries, l'erreur
+	 * commise sur ses valeurs étant la plus grande de celles des séries.
+	 */
+	virtual bool isCriteriaStored (Qualif::Critere criterion) const;
+	virtual double getStoredCriteria (Qualif::Critere criterion, size_t i) const;
+	virtual double getStoredCriteriaError (Qualif::Critere criterion) const;
+	virtual double getCriteriaValue (Qualif::Critere criterion, size_t i) const;
+
+	/**
+	 * Répartit en classes les mailles de la vue, série concaténée par série
+	 * concaténée, à partir des valeurs en cache de ces séries.
+	 * @see		AbstractQualifSerie::rebin
+	 */
+	virtual bool rebin (
+				Qualif::Critere criterion, size_t cellTypes, size_t classesNum,
+				double min, double max, bool strict,
+				std::vector<size_t>& counts, size_t threadsNum = 0) const;
+	virtual bool rebin (
+				Qualif::Critere criterion, size_t cellTypes, size_t classesNum,
+				double min, double max, bool strict,
+				const std::vector<size_t>& cells, std::vector<size_t>& counts,
+				size_t threadsNum = 0) const;
+
+	/**
+	 * @return		<I>true</I> si toutes les séries concaténées sont
+	 * 				utilisables en contexte multithread.
+	 */
+	virtual bool isThreadable ( ) const;
+
+	/**
+	 * @return		Les séries sous-jacentes aux séries concaténées.
+	 */
+	virtual std::vector<AbstractQualifSerie*> getUnderlyingSeries ( );
+	virtual std::vector<const AbstractQualifSerie*> getUnderlyingSeries ( ) const;
+
+	/**
+	 * Centres des mailles : ceux des séries concaténées.
+	 */
+	virtual void getCellCentroid (
+						size_t i, double& x, double& y, double& z) const;
+	virtual bool isCentroidReentrant ( ) const;
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	CompositeQualifSerie (const CompositeQualifSerie&);
+	CompositeQualifSerie& operator = (const CompositeQualifSerie&);
+
+	/**
+	 * @return		L'indice de la série concaténée contenant la i-ème maille,
+	 * 				l'indice de cette maille dans cette série étant
+	 * 				<I>i - _offsets [s]</I>.
+	 */
+	size_t getSerieIndex (size_t i) const;
+
+	/** Les séries concaténées. */
+	std::vector<AbstractQualifSerie*>			_series;
+
+	/**
+	 * Recalcule <I>_offsets</I> à partir des nombres de mailles des séries
+	 * concaténées.
+	 */
+	void updateOffsets ( ) const;
+
+	/** Indice, dans la vue, de la première maille de chaque série (et
+	 * nombre de mailles de la vue), et révision des séries concaténées
+	 * (<I>getRevision</I>) lors de son calcul. */
+	mutable std::vector<size_t>					_offsets;
+	mutable size_t								_offsetsRevision;
+	mutable std::mutex							_offsetsMutex;
+};	// class CompositeQualifSerie
+
+}	// namespace GQualif
+
+#endif	// COMPOSITE_QUALIF_SERIE_H
@@ -2,6 +2,7 @@
 #define Q_CAL_QUAL_THREAD_H
 
 #include "GQualif/AbstractQualifSerie.h"
+#include "GQualif/QualifProfile.h"
 
 #include <TkUtil/Threads.h>
 
@@ -31,6 +32,13 @@ class QCalQualThread : public TkUtil::ReportedJoinableThread < QualifSerieData >
 	 */
 	virtual ~QCalQualThread ( );
 
+	/**
+	 * Effectue l'analyse de qualité des données transmises en argument dans
+	 * le thread courant, et en renseigne le statut d'achèvement.
+	 * @see		QSeriesBatchThread
+	 */
+	static void analyse (QualifSerieData& data);
+
 
 	protected :
 
@@ -78,9 +86,18 @@ class QualifSerieData : public TkUtil::ThreadData
 	virtual ~QualifSerieData ( );
 
 	/**
-	 * Modification du résultat de l'analyse.
+	 * Modification du résultat de l'analyse : la maille c est de classe cl.
+	 * @see		sortClassment
 	 */
-	virtual void increment (unsigned char cl, size_t c);
+	virtual void increment (size_t cl, size_t c);
+
+	/**
+	 * Range de manière contiguë, par classe, les ids des mailles transmises
+	 * à <I>increment</I> (tri par dénombrement). Invoqué au terme de
+	 * l'analyse, préalablement à <I>classCells</I>. Sans effet si les ids
+	 * sont déjà rangés.
+	 */
+	virtual void sortClassment ( );
 
 	/**
 	 * Modification du domaine.
@@ -104,11 +121,17 @@ class QualifSerieData : public TkUtil::ThreadData
 	{ return _max; }
 	inline bool strictMode ( ) const
 	{ return _strictMode; }
-	/** Les ids des mailles par classe. Cette méthode retourne un vecteur
-	 * de classNum ( ) vecteurs d'ids. */
-	inline const std::vector< std::vector<size_t> >& classment ( ) const
-	{ return _classment; }
-	size_t cellNum (unsigned char cl) const;
+	/** Les ids des mailles de la classe cl : <I>cellNum (cl)</I> ids
+	 * débutant en <I>classCells (cl)</I>. <I>sortClassment</I> doit
+	 * préalablement avoir été invoqué. */
+	const size_t* classCells (size_t cl) const;
+	size_t cellNum (size_t cl) const;
+	/** L'instrumentation du traitement de la série, renseignée par le
+	 * thread. */
+	inline const QualifProfile& profile ( ) const
+	{ return _profile; }
+	inline QualifProfile& profile ( )
+	{ return _profile; }
 
 
 	private :
@@ -123,7 +146,17 @@ class QualifSerieData : public TkUtil::ThreadData
 	const size_t						_classNum, _cellTypes;
 	double								_min, _max;
 	const bool							_strictMode;
-	std::vector< std::vector<size_t> >	_classment;
+	/** Les ids des mailles et leurs classes, dans l'ordre des appels à
+	 * <I>increment</I> puis, après <I>sortClassment</I>, les ids rangés
+	 * par classe (les classes étant alors libérées). <I>_offsets [cl + 1]</I>
+	 * est le nombre de mailles de la classe cl, puis, après
+	 * <I>sortClassment</I>, <I>_offsets [cl]</I> est l'indice de la
+	 * première maille de la classe cl dans <I>_cells</I>. */
+	std::vector<size_t>					_cells;
+	std::vector<uint32_t>				_classes;
+	std::vector<size_t>					_offsets;
+	bool								_sorted;
+	QualifProfile						_profile;
 };	// class QualifSerieData
 
 
@@ -146,6 +179,14 @@ class QSerieRangeThread : public TkUtil::ReportedJoinableThread < QualifSerieDat
 	 */
 	virtual ~QSerieRangeThread ( );
 
+	/**
+	 * Recherche le domaine du critère pour les données transmises en
+	 * argument dans le thread courant, et en renseigne le statut
+	 * d'achèvement.
+	 * @see		QSeriesBatchThread
+	 */
+	static void computeRange (QualifSerieData& data);
+
 
 	protected :
 
@@ -164,6 +205,124 @@ class QSerieRangeThread : public TkUtil::ReportedJoinableThread < QualifSerieDat
 	QSerieRangeThread& operator = (const QSerieRangeThread&);
 };	// class QSerieRangeThread
 
+
+/**
+ * <P>Lot de séries traitées successivement par une même instance de
+ * <I>QSeriesBatchThread</I>.
+ * </P>
+ *
+ * <P>Lancer un thread par série est coûteux lorsque les séries sont
+ * nombreuses (un maillage comptant des milliers de groupes) : les séries sont
+ * alors réparties par <I>pack</I> en un nombre de lots de l'ordre du nombre
+ * de processeurs, équilibrés selon leurs nombres de mailles. Les petites
+ * séries partagent ainsi un même lot, une série volumineuse pouvant occuper
+ * seule le sien.
+ * </P>
+ */
+class QualifSeriesBatch : public TkUtil::ThreadData
+{
+	public :
+
+	/**
+	 * Constructeur. RAS.
+	 * @param	<I>true</I> s'il s'agit de rechercher le domaine du critère
+	 * 			(<I>QSerieRangeThread::computeRange</I>), <I>false</I> s'il
+	 *			s'agit d'une analyse de qualité
+	 *			(<I>QCalQualThread::analyse</I>).
+	 */
+	QualifSeriesBatch (bool range);
+
+	/**
+	 * Destructeur. Ne détruit pas les données des séries du lot.
+	 */
+	virtual ~QualifSeriesBatch ( );
+
+	/**
+	 * Ajoute au lot les données transmises en argument, qui restent à la
+	 * charge de l'appelant.
+	 */
+	virtual void add (QualifSerieData& data);
+
+	/**
+	 * Accesseurs.
+	 */
+	inline bool range ( ) const
+	{ return _range; }
+	inline const std::vector<QualifSerieData*>& series ( ) const
+	{ return _series; }
+	/** Le nombre total de mailles des séries du lot. */
+	inline size_t cellCount ( ) const
+	{ return _cellCount; }
+
+	/**
+	 * Répartit les données transmises en argument en lots équilibrés selon
+	 * les nombres de mailles des séries : chaque série, par ordre décroissant
+	 * de taille, est affectée au lot le moins chargé. Les séries partageant
+	 * une série sous-jacente (<I>AbstractQualifSerie::groupSharingSeries</I>)
+	 * sont affectées ensemble à un même lot.
+	 * @param	Données des séries à traiter.
+	 * @param	<I>true</I> s'il s'agit de rechercher le domaine du critère,
+	 *			<I>false</I> s'il s'agit d'une analyse de qualité.
+	 * @param	Nombre maximum de lots (0 : nombre de processeurs). Chaque
+	 *			série a son propre lot si elles ne sont pas plus nombreuses.
+	 * @return	Les lots non vides, à détruire par l'appelant.
+	 */
+	static std::vector<QualifSeriesBatch*> pack (
+		const std::vector<QualifSerieData*>& data, bool range,
+		size_t batchesNum = 0);
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QualifSeriesBatch (const QualifSeriesBatch&);
+	QualifSeriesBatch& operator = (const QualifSeriesBatch&);
+
+	const bool							_range;
+	std::vector<QualifSerieData*>		_series;
+	size_t								_cellCount;
+};	// class QualifSeriesBatch
+
+
+/**
+ * Classe de thread traitant successivement les séries d'un lot.
+ * @see		QualifSeriesBatch::pack
+ */
+class QSeriesBatchThread : public TkUtil::ReportedJoinableThread < QualifSeriesBatch >
+{
+	public :
+
+	/**
+	 * Constructeur. RAS. Ne modifie pas les données prises en charge.
+	 * @param	Lot de séries à traiter.
+	 */
+	QSeriesBatchThread (QualifSeriesBatch& batch);
+
+	/**
+	 * Destructeur. RAS.
+	 */
+	virtual ~QSeriesBatchThread ( );
+
+
+	protected :
+
+	/**
+	 * Traite chacune des séries du lot.
+	 */
+	virtual void execute ( );
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QSeriesBatchThread (const QSeriesBatchThread&);
+	QSeriesBatchThread& operator = (const QSeriesBatchThread&);
+};	// class QSeriesBatchThread
+
 }	// namespace GQualif
 
 
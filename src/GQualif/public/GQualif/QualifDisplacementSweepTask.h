@@ -0,0 +1,161 @@
+#ifndef QUALIF_DISPLACEMENT_SWEEP_TASK_H
+#define QUALIF_DISPLACEMENT_SWEEP_TASK_H
+
+#include "GQualif/AbstractQualifTask.h"
+#include "GQualif/ArrayQualifSerie.h"
+
+#include <utility>
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Tâche <I>Qualif</I> de balayage du facteur d'échelle d'un champ de
+ * déplacements (études ALE, déformations, ...). Pour chaque maille d'une
+ * série munie d'un champ de déplacements
+ * (<I>ArrayQualifSerie::setDisplacements</I>), le plus grand facteur
+ * d'échelle de [0, maxScale] jusqu'auquel la maille reste acceptable (valeur
+ * du critère supérieure ou égale à un seuil, ex : <I>VALIDITY</I> et 1,
+ * <I>SCALEDJACOBIAN</I> et 0) est recherché par dichotomie
+ * (<I>ArrayQualifSerie::findDisplacementLimits</I>), en parallèle. Aucun
+ * maillage déformé n'est créé, et une seule exécution remplace les analyses
+ * complètes à facteurs d'échelle fixés.
+ * </P>
+ *
+ * <P>Résultats :
+ * <UL>
+ * <LI>L'histogramme des facteurs limites des mailles devenant inacceptables
+ * sur ]0, maxScale[ : <I>getSeriesValues ( ) [cl][0]</I>, les classes
+ * découpant régulièrement [0, maxScale],
+ * <LI>Les nombres de mailles inacceptables sans déplacement
+ * (<I>getInvalidCellsNum</I>) et acceptables sur tout l'intervalle
+ * (<I>getAcceptableCellsNum</I>), non comptabilisées dans l'histogramme,
+ * <LI>Les mailles de plus petits facteurs limites (<I>getWorstCells</I>) et
+ * le facteur limite de chaque maille (<I>getCellsLimits</I>).
+ * </UL>
+ * </P>
+ */
+class QualifDisplacementSweepTask: public AbstractQualifTask
+{
+	public :
+
+	/**
+	 * Constructeur.
+	 * @param		Les types de mailles au sens <I>QualifHelper</I>, définis
+	 * 				par un ou exclusif sur les types élémentaires
+	 * 				(TRIANGLE, ...).
+	 * @param		Le critère <I>Qualif</I> appliqué à la tâche.
+	 * @param		Valeur minimale acceptable du critère.
+	 * @param		Facteur d'échelle maximal des déplacements (strictement
+	 * 				positif).
+	 * @param		Nombre de classes de l'histogramme des facteurs limites.
+	 * @param		Série balayée, munie d'un champ de déplacements.
+	 * @param		Nombre de mailles de plus petits facteurs limites
+	 * 				retenues.
+	 * @param		Nombre d'itérations de la dichotomie (précision :
+	 * 				<I>maxScale / 2^iterations</I>).
+	 * @param		Nombre de threads (0 : nombre de processeurs).
+	 * @warning		La série transmise en argument doit être utilisable
+	 * 				pendant toute la durée de vie de cette instance.
+	 */
+	QualifDisplacementSweepTask (
+			size_t types, Qualif::Critere criterion, double threshold,
+			double maxScale, size_t classesNum, ArrayQualifSerie& serie,
+			size_t worstCellsNum = 20, size_t iterations = 20,
+			size_t threadsNum = 0);
+
+	/**
+	 * Destructeur. RAS.
+	 */
+	virtual ~QualifDisplacementSweepTask ( );
+
+	/**
+	 * @return		La valeur minimale acceptable du critère.
+	 */
+	virtual double getThreshold ( ) const;
+
+	/**
+	 * @return		Le facteur d'échelle maximal des déplacements.
+	 */
+	virtual double getMaxScale ( ) const;
+
+	/**
+	 * @return		Le nombre de classes de l'histogramme.
+	 */
+	virtual size_t getClassesNum ( ) const;
+
+	/**
+	 * @return		Le nombre d'itérations de la dichotomie.
+	 */
+	virtual size_t getIterations ( ) const;
+
+	/**
+	 * @return		Le nombre de mailles inacceptables sans déplacement lors
+	 * 				de la dernière exécution.
+	 */
+	virtual size_t getInvalidCellsNum ( ) const;
+
+	/**
+	 * @return		Le nombre de mailles acceptables jusqu'au facteur
+	 * 				d'échelle maximal lors de la dernière exécution.
+	 */
+	virtual size_t getAcceptableCellsNum ( ) const;
+
+	/**
+	 * @return		Les mailles de plus petits facteurs limites, par ordre
+	 * 				croissant de facteur limite : (indice de la maille,
+	 * 				facteur limite, -1 si inacceptable sans déplacement). Les
+	 * 				mailles acceptables sur tout l'intervalle n'y figurent pas.
+	 */
+	virtual const std::vector< std::pair<size_t, double> >&
+														getWorstCells ( ) const;
+
+	/**
+	 * @return		Les facteurs limites des mailles (indices de la série) :
+	 * 				<I>maxScale</I> si la maille est acceptable sur tout
+	 * 				l'intervalle, -1 si elle ne l'est pas sans déplacement,
+	 * 				<I>NaN</I> si elle n'a pas été traitée (type non retenu ou
+	 * 				non supporté).
+	 */
+	virtual const std::vector<double>& getCellsLimits ( ) const;
+
+	/**
+	 * Exécute la tâche.
+	 * @exception	Une exception est levée si la série n'a pas de champ de
+	 * 				déplacements ou si les paramètres sont invalides.
+	 */
+	virtual void execute ( );
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QualifDisplacementSweepTask (const QualifDisplacementSweepTask&);
+	QualifDisplacementSweepTask& operator = (
+										const QualifDisplacementSweepTask&);
+
+	/** La série balayée. */
+	ArrayQualifSerie*						_serie;
+
+	/** Le seuil du critère et le facteur d'échelle maximal. */
+	double									_threshold, _maxScale;
+
+	/** Nombres de classes, de mailles retenues, d'itérations et de
+	 * threads. */
+	size_t									_classesNum, _worstCellsNum,
+											_iterations, _threadsNum;
+
+	/** Les résultats de la dernière exécution. */
+	size_t									_invalidCellsNum,
+											_acceptableCellsNum;
+	std::vector< std::pair<size_t, double> >	_worstCells;
+	std::vector<double>						_limits;
+};	// class QualifDisplacementSweepTask
+
+}	// namespace GQualif
+
+#endif	// QUALIF_DISPLACEMENT_SWEEP_TASK_H
@@ -0,0 +1,80 @@
+#ifndef QUALIF_GROUP_METADATA_H
+#define QUALIF_GROUP_METADATA_H
+
+#include <TkUtil/util_config.h>
+#include <TkUtil/UTF8String.h>
+
+#include <string>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Description sommaire d'un groupe de mailles d'un fichier : nom,
+ * dimension, nombre de mailles et répartition par type. Ces informations sont
+ * destinées à être obtenues sans charger le maillage (lecture des seuls
+ * en-têtes du fichier), afin de permettre à l'utilisateur de choisir les
+ * groupes à analyser avant leur chargement.
+ * </P>
+ *
+ * @see		QtSeriesChoiceDialog
+ */
+struct QualifGroupMetadata
+{
+	/** Nombre de mailles non déterminé par la lecture des en-têtes. */
+	static const size_t		UNKNOWN;
+
+	/**
+	 * Constructeur. Nombre de mailles <I>UNKNOWN</I>.
+	 * @param		Nom du groupe (vide : ensemble du maillage).
+	 * @param		Dimension des mailles du groupe.
+	 */
+	QualifGroupMetadata (
+			const IN_STD string& name = IN_STD string ( ),
+			unsigned char dimension = 0);
+
+	/**
+	 * Recense <I>count</I> mailles de type <I>type</I>
+	 * (<I>QualifHelper::TRIANGLE</I>, ..., 0 pour un type non supporté par
+	 * <I>Qualif</I>). Un nombre de mailles <I>UNKNOWN</I> devient alors
+	 * connu.
+	 */
+	void addCells (size_t type, size_t count = 1);
+
+	/**
+	 * @return		Le nombre recensé de mailles du type transmis en argument
+	 *				(0 pour les types non supportés par <I>Qualif</I>).
+	 */
+	size_t getCellsNum (size_t type) const;
+
+	/**
+	 * @return		Les types de mailles recensés, obtenus par ou exclusif
+	 *				(<I>QualifHelper::TRIANGLE</I>, ...).
+	 */
+	size_t getDataTypes ( ) const;
+
+	/**
+	 * @return		Une description du groupe : nom, dimension, nombre de
+	 *				mailles et répartition par type.
+	 */
+	IN_UTIL UTF8String getDescription ( ) const;
+
+	/** Le nom du groupe. */
+	IN_STD string		name;
+
+	/** La dimension des mailles du groupe. */
+	unsigned char		dimension;
+
+	/** Le nombre total de mailles, ou <I>UNKNOWN</I>. */
+	size_t				cellsNum;
+
+	/** Le nombre de mailles par type, dans l'ordre des types de
+	 * <I>QualifHelper</I> (triangles, quadrangles, ...), le dernier élément
+	 * recensant les mailles de types non supportés. */
+	size_t				typesCellsNum [7];
+};	// struct QualifGroupMetadata
+
+}	// namespace GQualif
+
+#endif	// QUALIF_GROUP_METADATA_H
@@ -5,6 +5,7 @@
 
 #include <unistd.h>
 #include <cmath>
+#include <functional>
 #include <string>
 
 #include <ConstQualif.h>
@@ -62,6 +63,48 @@ class QualifHelper
 	 */
 	static bool isTypeSupported (size_t type, Qualif::Critere criteria);
 
+	/**
+	 * @return		true si le critère transmis en argument est binaire (valeurs
+	 *				0 ou 1, ex : VALIDITY), false dans le cas contraire.
+	 */
+	static bool isBinaryCriterion (Qualif::Critere criteria);
+
+	/**
+	 * @param		Valeur approchée d'un critère.
+	 * @param		Erreur maximale (absolue) commise sur cette valeur.
+	 * @param		Domaine [min, max] de la partition en classes.
+	 * @param		Largeur des classes.
+	 * @return		true si la valeur exacte est susceptible d'appartenir à une
+	 *				autre classe que la valeur approchée, ou d'être de l'autre
+	 *				côté d'une borne du domaine, false dans le cas contraire.
+	 */
+	static bool isClassAmbiguous (double value, double error,
+	                              double min, double max, double classWidth);
+
+	/**
+	 * @param		Valeur d'un critère.
+	 * @param		Borne inférieure du domaine de la partition en classes.
+	 * @param		Largeur des classes (<I>max / classesNum -
+	 *				min / classesNum</I>).
+	 * @param		Nombre de classes.
+	 * @return		L'indice de la classe de la valeur, <I>(value - min) /
+	 *				classWidth</I>, borné à [0, classesNum - 1] (0 si la valeur
+	 *				est invalide).
+	 * @warning		Calcul de référence de toutes les répartitions en classes
+	 *				(analyses, répartitions des valeurs stockées, ...), qui
+	 *				doivent coïncider aux bornes des classes.
+	 */
+	static inline size_t getClassIndex (
+			double value, double min, double classWidth, size_t classesNum)
+	{
+		const double	position	= (value - min) / classWidth;
+		if (false == (position > 0.))
+			return 0;
+
+		return position < (double)classesNum ?
+		       (size_t)position : classesNum - 1;
+	}	// getClassIndex
+
 	/**
 	 * @return		La valeur minimale pour un triangle et pour le critère
 	 *				transmis en argument.
@@ -187,6 +230,36 @@ class QualifHelper
 	 */
 	static bool hasValideCoordinates (const Qualif::Maille& cell, bool exc);
 
+	/**
+	 * \param		Nombre de threads demandé (0 : nombre de processeurs).
+	 * \return		Le nombre de threads correspondant, toujours non nul :
+	 * 				<I>threadsNum</I>, ou s'il est nul le nombre de
+	 * 				processeurs (1 s'il n'est pas connu). Convention de tous
+	 * 				les traitements parallèles de <I>GQualif</I>.
+	 */
+	static size_t getThreadsNum (size_t threadsNum);
+
+	/**
+	 * Exécute <I>task (begin, end)</I> sur l'intervalle [0, count[ découpé en
+	 * <I>threadsNum</I> sous-intervalles contigus traités chacun par un thread
+	 * (le thread courant si <I>threadsNum</I> vaut 1).
+	 * \param		Nombre d'itérations.
+	 * \param		Nombre de threads (0 : nombre de processeurs).
+	 * \param		Traitement d'un sous-intervalle.
+	 * \exception	Une exception est levée, une fois tous les threads
+	 * 				terminés, si l'un des traitements a échoué.
+	 */
+	static void parallelFor (
+			size_t count, size_t threadsNum,
+			const IN_STD function<void (size_t, size_t)>& task);
+
+	/**
+	 * \param		Chaîne à écrire dans un document <I>JSON</I>.
+	 * \return		La chaîne transmise en argument, entre guillemets et
+	 * 				échappée selon la syntaxe <I>JSON</I>.
+	 */
+	static IN_STD string jsonString (const IN_STD string& str);
+
 	//@}	// Autres services que <I>Qualif</I>.
 
 
@@ -0,0 +1,247 @@
+#ifndef QUALIF_PROFILE_H
+#define QUALIF_PROFILE_H
+
+#include <TkUtil/util_config.h>
+#include <TkUtil/UTF8String.h>
+
+#include <chrono>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Instrumentation légère des analyses de qualité : temps passés dans les
+ * différentes phases d'une analyse et compteurs associés.
+ * </P>
+ *
+ * <P>Les tâches (<I>AbstractQualifTask</I>) renseignent une instance de cette
+ * classe par thread, fusionnées au terme de l'exécution. Les temps des phases
+ * exécutées dans les threads sont donc cumulés sur l'ensemble des threads
+ * (temps CPU), à comparer au temps de fusion (<I>MERGE</I>) qui est
+ * séquentiel.
+ * </P>
+ *
+ * <P>Par défaut les temps sont mesurés par série : la totalité du temps de
+ * parcours d'une série est attribuée à <I>CRITERION_EVALUATION</I>. Le mode
+ * détaillé (<I>enableDetailedTimings</I>), plus coûteux car mesurant chaque
+ * appel, répartit ce temps entre le parcours des types, le recueil des
+ * coordonnées, l'évaluation du critère et le classement.
+ * </P>
+ *
+ * @see		QualifPhaseTimer
+ * @see		QualifHardwareCounters
+ */
+class QualifProfile
+{
+	public :
+
+	/** Les phases instrumentées. */
+	enum PHASE
+	{
+		LOADING, TYPE_SCANNING, COORDINATES_GATHERING, CRITERION_EVALUATION,
+		BINNING, MERGE, RENDERING, PHASES_NUM
+	};
+
+	/** Les compteurs. Les 4 derniers ne sont renseignés qu'en cas
+	 * d'utilisation des compteurs matériels. <I>CELLS_SHARED</I> : mailles
+	 * non évaluées car partagées avec une autre série
+	 * (<I>QualifSharedCellsTask</I>). */
+	enum COUNTER
+	{
+		CELLS_EVALUATED, CELLS_SKIPPED, EXCEPTIONS_CAUGHT, BYTES_CACHED,
+		CELLS_SHARED, CPU_CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, COUNTERS_NUM
+	};
+
+	/**
+	 * Constructeur. Temps et compteurs nuls.
+	 */
+	QualifProfile ( );
+
+	/**
+	 * Constructeur de copie et opérateur = : RAS.
+	 */
+	QualifProfile (const QualifProfile&);
+	QualifProfile& operator = (const QualifProfile&);
+
+	/**
+	 * Destructeur. RAS.
+	 */
+	~QualifProfile ( );
+
+	/**
+	 * Remet à zéro temps et compteurs.
+	 */
+	void reset ( );
+
+	/**
+	 * Ajoute les temps et compteurs de <I>profile</I> à ceux de cette
+	 * instance.
+	 */
+	void merge (const QualifProfile& profile);
+
+	/**
+	 * @return		Le temps (en secondes) passé dans la phase transmise en
+	 * 				argument.
+	 */
+	double getTime (PHASE phase) const
+	{ return _times [phase]; }
+
+	/**
+	 * Ajoute <I>seconds</I> au temps passé dans la phase transmise en argument.
+	 */
+	void addTime (PHASE phase, double seconds)
+	{ _times [phase]	+= seconds; }
+
+	/**
+	 * @return		La valeur du compteur transmis en argument.
+	 */
+	unsigned long long getCounter (COUNTER counter) const
+	{ return _counters [counter]; }
+
+	/**
+	 * Incrémente de <I>count</I> le compteur transmis en argument.
+	 */
+	void increment (COUNTER counter, unsigned long long count = 1)
+	{ _counters [counter]	+= count; }
+
+	/**
+	 * @return		Un texte récapitulant temps et compteurs non nuls.
+	 */
+	IN_UTIL UTF8String toString ( ) const;
+
+	/**
+	 * @return		Le nom de la phase/du compteur transmis en argument.
+	 */
+	static IN_STD string phaseName (PHASE phase);
+	static IN_STD string counterName (COUNTER counter);
+
+	/**
+	 * (Dés)active le mode détaillé (temps mesurés à chaque appel).
+	 * Inactif par défaut.
+	 */
+	static void enableDetailedTimings (bool enable);
+	static bool detailedTimings ( );
+
+	/**
+	 * (Dés)active l'utilisation des compteurs matériels <I>perf_event</I>
+	 * (Linux, nécessite que <I>GQualif</I> soit compilé avec
+	 * <I>USE_PERF_EVENT</I>). Inactif par défaut.
+	 */
+	static void enableHardwareCounters (bool enable);
+	static bool hardwareCounters ( );
+
+
+	private :
+
+	double				_times [PHASES_NUM];
+	unsigned long long	_counters [COUNTERS_NUM];
+
+	static bool			_detailedTimings;
+	static bool			_hardwareCounters;
+};	// class QualifProfile
+
+
+/**
+ * Chronomètre ajoutant à une phase d'une instance de <I>QualifProfile</I> le
+ * temps écoulé entre sa construction et sa destruction.
+ */
+class QualifPhaseTimer
+{
+	public :
+
+	/**
+	 * Constructeur.
+	 * @param		Instrumentation renseignée.
+	 * @param		Phase mesurée.
+	 * @param		<I>false</I> si aucune mesure ne doit être effectuée (mode
+	 * 				détaillé inactif, ...).
+	 */
+	QualifPhaseTimer (QualifProfile& profile, QualifProfile::PHASE phase,
+	                  bool enabled = true)
+		: _profile (profile), _phase (phase), _enabled (enabled), _start ( )
+	{
+		if (true == _enabled)
+			_start	= IN_STD chrono::steady_clock::now ( );
+	}
+
+	/**
+	 * Destructeur. Ajoute le temps écoulé à la phase.
+	 */
+	~QualifPhaseTimer ( )
+	{ stop ( ); }
+
+	/**
+	 * Ajoute le temps écoulé à la phase et arrête le chronomètre.
+	 */
+	void stop ( )
+	{
+		if (true == _enabled)
+			_profile.addTime (_phase, IN_STD chrono::duration<double> (
+						IN_STD chrono::steady_clock::now ( ) - _start).count ( ));
+		_enabled	= false;
+	}
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QualifPhaseTimer (const QualifPhaseTimer&);
+	QualifPhaseTimer& operator = (const QualifPhaseTimer&);
+
+	QualifProfile&								_profile;
+	const QualifProfile::PHASE					_phase;
+	bool										_enabled;
+	IN_STD chrono::steady_clock::time_point		_start;
+};	// class QualifPhaseTimer
+
+
+/**
+ * <P>Compteurs matériels (cycles, instructions, défauts de cache, erreurs de
+ * prédiction de branchement) du thread courant, reposant sur l'appel système
+ * Linux <I>perf_event_open</I>.
+ * </P>
+ *
+ * <P>Ces compteurs ne sont effectifs que si <I>GQualif</I> est compilé avec
+ * <I>USE_PERF_EVENT</I> et si <I>QualifProfile::hardwareCounters</I> retourne
+ * <I>true</I>. Dans le cas contraire, ou si le système en refuse l'accès
+ * (<I>/proc/sys/kernel/perf_event_paranoid</I>), ils sont sans effet.
+ * </P>
+ */
+class QualifHardwareCounters
+{
+	public :
+
+	/**
+	 * Constructeur. Ouvre et démarre les compteurs.
+	 */
+	QualifHardwareCounters ( );
+
+	/**
+	 * Destructeur. Ferme les compteurs.
+	 */
+	~QualifHardwareCounters ( );
+
+	/**
+	 * Arrête les compteurs et ajoute leurs valeurs à <I>profile</I>.
+	 */
+	void stop (QualifProfile& profile);
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QualifHardwareCounters (const QualifHardwareCounters&);
+	QualifHardwareCounters& operator = (const QualifHardwareCounters&);
+
+	/** Les descripteurs des compteurs (-1 si inutilisés). */
+	int				_descriptors [4];
+};	// class QualifHardwareCounters
+
+}	// namespace GQualif
+
+#endif	// QUALIF_PROFILE_H
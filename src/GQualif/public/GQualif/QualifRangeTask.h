@@ -3,6 +3,7 @@
 
 #include "GQualif/AbstractQualifTask.h"
 
+#include <utility>
 #include <vector>
 
 
@@ -54,6 +55,26 @@ class QualifRangeTask: public AbstractQualifTask
 	virtual double getMin ( ) const;
 	virtual double getMax ( ) const;
 
+	/**
+	 * @param		Indice de la série dans la tâche.
+	 * @return		Les extrema de la série calculés par <I>execute</I>,
+	 * 				éventuellement invalides (<I>doubleMachMax</I>) si aucune
+	 * 				maille n'a été évaluée.
+	 * @exception	Une exception est levée si l'indice est invalide.
+	 * @see			mergeRanges
+	 */
+	virtual void getSerieRange (size_t i, double& min, double& max) const;
+
+	/**
+	 * Calcule les extrema de l'ensemble des séries à partir de leurs extrema
+	 * (<I>getSerieRange</I>), en retenant un domaine fini si certains
+	 * d'entre-eux sont invalides. Permet de recomposer le domaine de séries
+	 * dont les extrema ont été conservés.
+	 */
+	static void mergeRanges (
+						const std::vector< std::pair<double, double> >& ranges,
+						double& min, double& max);
+
 
 	protected :
 
@@ -66,8 +87,9 @@ class QualifRangeTask: public AbstractQualifTask
 	QualifRangeTask (const QualifRangeTask&);
 	QualifRangeTask& operator = (const QualifRangeTask&);
 
-	/* Les valeurs extrêmales rencontrées. */
-	double			_min, _max;
+	/* Les valeurs extrêmales rencontrées, globales et par série. */
+	double									_min, _max;
+	std::vector< std::pair<double, double> >	_seriesRanges;
 };	// class QualifRangeTask
 
 }	// namespace GQualif
@@ -0,0 +1,86 @@
+#ifndef QUALIF_REBINNING_TASK_H
+#define QUALIF_REBINNING_TASK_H
+
+#include "GQualif/QualifAnalysisTask.h"
+
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Tâche <I>Qualif</I> de répartition en classes des mailles de séries à
+ * partir des seules valeurs en cache du critère
+ * (<I>AbstractQualifSerie::rebin</I>), sans filtrage par type ni appel
+ * virtuel par maille. Elle est destinée à la mise à jour instantanée d'un
+ * histogramme lorsque seuls le nombre de classes ou le domaine
+ * d'échantillonnage changent.
+ * </P>
+ *
+ * <P>Si l'une des séries n'a pas les valeurs du critère en cache l'analyse
+ * complète de <I>QualifAnalysisTask</I> est effectuée.
+ * </P>
+ */
+class QualifRebinningTask: public QualifAnalysisTask
+{
+	public :
+
+	/**
+	 * Constructeur.
+	 * @param		Les types de mailles au sens <I>QualifHelper</I>, définis
+	 * 				par un ou exclusif sur les types élémentaires
+	 * 				(TRIANGLE, ...).
+	 * @param		Le critère <I>Qualif</I> appliqué à la tâche.
+	 * @param		Le nombre de classes pour la répartition des mailles selon
+	 *				le domaine d'échantillonnage (!= 0).
+	 * @param		La valeur minimale du domaine d'échantillonnage.
+	 * @param		La valeur maximale du domaine d'échantillonnage.
+	 * @param		<I>true</I> s'il ne faut pas prendre en compte les mailles
+	 * 				dont le critère est hors-domaine, <I>false</I> dans le cas
+	 * 				contraire.
+	 * @param		Séries soumises à la tâche.
+	 * @warning		Les séries transmises en argument doivent être utilisables
+	 * 				pendant toute la durée de vie de cette instance.
+	 */
+	QualifRebinningTask (
+			size_t types, Qualif::Critere criterion, size_t classNum,
+			double min, double max, bool strict,
+			const std::vector<AbstractQualifSerie*>& series);
+
+	/**
+	 * Destructeur. RAS.
+	 */
+	virtual ~QualifRebinningTask ( );
+
+	/**
+	 * @return		<I>true</I> si toutes les séries transmises en argument
+	 * 				ont les valeurs du critère en cache, <I>false</I> dans
+	 * 				le cas contraire.
+	 */
+	static bool isApplicable (
+					Qualif::Critere criterion,
+					const std::vector<AbstractQualifSerie*>& series);
+
+	/**
+	 * Exécute la tâche. En cas de répartition à partir des valeurs en cache
+	 * les index des mailles par classe des séries, devenus obsolètes, sont
+	 * libérés et seront recalculés selon la nouvelle répartition lors de
+	 * leur prochaine consultation
+	 * (<I>AbstractQualifSerie::deferClassesCellsIndexes</I>).
+	 */
+	virtual void execute ( );
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QualifRebinningTask (const QualifRebinningTask&);
+	QualifRebinningTask& operator = (const QualifRebinningTask&);
+};	// class QualifRebinningTask
+
+}	// namespace GQualif
+
+#endif	// QUALIF_REBINNING_TASK_H
@@ -0,0 +1,201 @@
+#ifndef QUALIF_SERIE_WARM_UP_H
+#define QUALIF_SERIE_WARM_UP_H
+
+#include "GQualif/AbstractQualifSerie.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Préparation en tâche de fond de séries venant d'être ajoutées à une
+ * IHM, afin que le premier calcul trouve l'essentiel des données en cache.
+ * Les séries sont préparées l'une après l'autre par un thread de basse
+ * priorité (<I>SCHED_IDLE</I> sous <I>Linux</I>), créé au premier ajout.
+ * Pour chaque série :
+ * <UL>
+ * <LI>Recensement des types de mailles (<I>getDataTypes</I>), toujours
+ * effectué, les types étant transmis via <I>takeCompleted</I>,
+ * <LI>Recopie des mailles dans des tableaux contigus
+ * (<I>flattenCoordinates</I>),
+ * <LI>Evaluation des coordonnées des noeuds (<I>validateCoordinates</I>, le
+ * résultat étant conservé par la série),
+ * <LI>Evaluation et stockage du critère courant (<I>getDataRange</I>).
+ * </UL>
+ * </P>
+ *
+ * <P>Une série en cours de préparation ne doit pas être utilisée par un
+ * autre thread : <I>cancel</I> ou <I>remove</I> sont à appeler avant tout
+ * accès à une série ajoutée. La préparation en cours est alors abandonnée au
+ * terme de l'étape en cours, les étapes effectuées servant au calcul qui
+ * suit, et les séries en attente ne sont pas préparées. Le thread de
+ * préparation n'est pas repassé en priorité normale pendant cette attente,
+ * ce qui n'est pas possible sans privilège. Les données en cache d'une série
+ * en cours de préparation sont verrouillées
+ * (<I>AbstractQualifSerie::lockStoredData</I>). Les séries non threadables
+ * (<I>AbstractQualifSerie::isThreadable</I>) ne sont pas prises en charge.
+ * </P>
+ */
+class QualifSerieWarmUp
+{
+	public :
+
+	/**
+	 * Les étapes optionnelles de la préparation, à combiner par un ou
+	 * exclusif.
+	 */
+	enum STEP
+	{
+		COORDINATES_FLATTENING = 1, COORDINATES_VALIDATION = 2,
+		CRITERION_EVALUATION = 4, ALL_STEPS = 7
+	};
+
+	/**
+	 * Constructeur. RAS, le thread de préparation est créé au premier
+	 * ajout.
+	 * @param		Etapes optionnelles de la préparation (cf. <I>STEP</I>).
+	 * @param		Critère évalué (<I>(Qualif::Critere)-1</I> : aucun).
+	 */
+	QualifSerieWarmUp (size_t steps = ALL_STEPS,
+	                   Qualif::Critere criterion = (Qualif::Critere)-1);
+
+	/**
+	 * Destructeur. Interrompt la préparation (<I>cancel</I>) et attend la fin
+	 * du thread de préparation.
+	 */
+	virtual ~QualifSerieWarmUp ( );
+
+	/**
+	 * @return		Les étapes optionnelles de la préparation.
+	 */
+	virtual size_t getSteps ( ) const;
+
+	/**
+	 * @param		Critère évalué lors de la préparation des prochaines
+	 * 				séries (<I>(Qualif::Critere)-1</I> : aucun).
+	 */
+	virtual void setCriterion (Qualif::Critere criterion);
+	virtual Qualif::Critere getCriterion ( ) const;
+
+	/**
+	 * @param		Fonction appelée <U>par le thread de préparation</U> au
+	 * 				terme de la préparation de chaque série, avant que la
+	 * 				série ne soit considérée comme préparée (les appels à
+	 * 				<I>cancel</I> attendent donc son retour). Typiquement
+	 * 				l'émission d'un signal <I>Qt</I> reçu par le thread
+	 * 				graphique qui appelle alors <I>takeCompleted</I>.
+	 */
+	virtual void setCompletionCallback (const std::function<void ( )>& callback);
+
+	/**
+	 * Ajoute la série transmise en argument à la file des séries à préparer.
+	 * Sans effet si la série n'est pas threadable.
+	 * @return		<I>true</I> si la série a été ajoutée, <I>false</I> dans
+	 * 				le cas contraire.
+	 * @warning		La série doit rester utilisable jusqu'à sa préparation ou
+	 * 				son retrait (<I>remove</I>, <I>cancel</I>).
+	 */
+	virtual bool add (AbstractQualifSerie& serie);
+
+	/**
+	 * Retire la série transmise en argument de la file des séries à préparer
+	 * et des séries préparées, en abandonnant le cas échéant sa préparation
+	 * au terme de l'étape en cours (ou du paquet de mailles en cours
+	 * d'évaluation pour l'étape <I>CRITERION_EVALUATION</I>). La série peut
+	 * ensuite être détruite.
+	 */
+	virtual void remove (AbstractQualifSerie& serie);
+
+	/**
+	 * Vide la file des séries à préparer et abandonne la préparation en
+	 * cours au terme de l'étape en cours (ou du paquet de mailles en cours
+	 * d'évaluation pour l'étape <I>CRITERION_EVALUATION</I>, le critère
+	 * n'étant alors pas mis en cache). Aucune série n'est plus alors
+	 * utilisée par le thread de préparation.
+	 */
+	virtual void cancel ( );
+
+	/**
+	 * Attend que toutes les séries de la file soient préparées.
+	 */
+	virtual void wait ( );
+
+	/**
+	 * @return		<I>true</I> si aucune série n'est en attente ou en cours
+	 * 				de préparation.
+	 */
+	virtual bool isIdle ( ) const;
+
+	/**
+	 * @return		Les séries préparées depuis le dernier appel, avec leurs
+	 * 				types de mailles (nuls pour les séries de dimension
+	 * 				inférieure à 2).
+	 */
+	virtual std::vector< std::pair<AbstractQualifSerie*, size_t> >
+															takeCompleted ( );
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QualifSerieWarmUp (const QualifSerieWarmUp&);
+	QualifSerieWarmUp& operator = (const QualifSerieWarmUp&);
+
+	/**
+	 * La boucle du thread de préparation.
+	 */
+	void run ( );
+
+	/**
+	 * Prépare la série transmise en argument.
+	 * @return		Les types de mailles de la série.
+	 */
+	size_t prepare (AbstractQualifSerie& serie, Qualif::Critere criterion);
+
+	/**
+	 * @return		<I>true</I> si la préparation en cours est à abandonner.
+	 */
+	bool isAbandoned ( ) const;
+
+	/**
+	 * Abandonne la préparation en cours au terme de l'étape (ou du paquet de
+	 * mailles) en cours et attend sa fin. Le verrou doit être détenu.
+	 */
+	void waitCurrent (std::unique_lock<std::mutex>& lock);
+
+	/** Les étapes optionnelles de la préparation et le critère évalué. */
+	size_t										_steps;
+	Qualif::Critere								_criterion;
+
+	/** La fonction appelée au terme de chaque préparation. */
+	std::function<void ( )>						_callback;
+
+	/** Les séries en attente, en cours de préparation (et l'abandon de
+	 * celle-ci), et préparées. */
+	std::deque<AbstractQualifSerie*>			_queue;
+	AbstractQualifSerie*						_current;
+	bool										_abandoned;
+	std::vector< std::pair<AbstractQualifSerie*, size_t> >	_completed;
+
+	/** Protège les données ci-dessus, et signale leurs modifications. */
+	mutable std::mutex							_mutex;
+	std::condition_variable						_condition;
+
+	/** Le thread de préparation, et sa demande d'arrêt. */
+	std::thread									_thread;
+	bool										_stopped;
+};	// class QualifSerieWarmUp
+
+}	// namespace GQualif
+
+#endif	// QUALIF_SERIE_WARM_UP_H
@@ -0,0 +1,80 @@
+#ifndef QUALIF_SHARED_CELLS_TASK_H
+#define QUALIF_SHARED_CELLS_TASK_H
+
+#include "GQualif/QualifAnalysisTask.h"
+
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Tâche <I>Qualif</I> d'analyse qualitative de séries se recouvrant
+ * (groupes de mailles d'un même maillage : matériaux, couches limites,
+ * maillage entier, ...). Chaque maille du maillage n'est évaluée qu'une fois
+ * quel que soit le nombre de séries la contenant, les histogrammes des séries
+ * étant déduits de leurs appartenances. L'analyse conjointe de tous les
+ * groupes et du maillage entier coûte ainsi de l'ordre d'un parcours du
+ * maillage.
+ * </P>
+ *
+ * <P>Les mailles sont identifiées par <I>AbstractQualifSerie::getMeshCellId</I>
+ * au sein des séries issues d'une même instance de maillage
+ * (<I>getMeshInstance</I>) et de même nature (<I>isVolumic</I>), via un
+ * tableau indexé par ces identifiants lorsqu'ils sont denses. Une maille
+ * partagée est évaluée par la plus grande des séries qui la contiennent,
+ * chaque série évaluant ses mailles dans un seul thread (<I>getCell</I>
+ * n'étant pas réentrant).
+ * </P>
+ *
+ * <P>Si aucune maille ne peut être partagée l'analyse de
+ * <I>QualifAnalysisTask</I> est effectuée.
+ * </P>
+ */
+class QualifSharedCellsTask: public QualifAnalysisTask
+{
+	public :
+
+	/**
+	 * Constructeur. Arguments : cf. <I>QualifAnalysisTask</I>.
+	 * @warning		Les séries transmises en argument doivent être utilisables
+	 * 				pendant toute la durée de vie de cette instance.
+	 */
+	QualifSharedCellsTask (
+			size_t types, Qualif::Critere criterion, size_t classNum,
+			double min, double max, bool strict,
+			const std::vector<AbstractQualifSerie*>& series);
+
+	/**
+	 * Destructeur. RAS.
+	 */
+	virtual ~QualifSharedCellsTask ( );
+
+	/**
+	 * @return		<I>true</I> si au moins deux des séries transmises en
+	 * 				argument sont susceptibles de partager des mailles (même
+	 * 				instance de maillage, même nature, identifiants des
+	 * 				mailles connus),
+	 * 				<I>false</I> dans le cas contraire.
+	 */
+	static bool isApplicable (const std::vector<AbstractQualifSerie*>& series);
+
+	/**
+	 * Exécute la tâche.
+	 */
+	virtual void execute ( );
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QualifSharedCellsTask (const QualifSharedCellsTask&);
+	QualifSharedCellsTask& operator = (const QualifSharedCellsTask&);
+};	// class QualifSharedCellsTask
+
+}	// namespace GQualif
+
+#endif	// QUALIF_SHARED_CELLS_TASK_H
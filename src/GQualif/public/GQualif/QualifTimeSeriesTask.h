@@ -0,0 +1,110 @@
+#ifndef QUALIF_TIME_SERIES_TASK_H
+#define QUALIF_TIME_SERIES_TASK_H
+
+#include "GQualif/QualifAnalysisTask.h"
+#include "GQualif/TimeSeriesQualifSerie.h"
+
+#include <utility>
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Tâche <I>Qualif</I> d'analyse qualitative de tous les pas de temps
+ * d'une série <I>TimeSeriesQualifSerie</I> en une seule exécution. La
+ * <I>s-ième</I> "série" de la tâche est le <I>s-ième</I> pas de temps :
+ * <I>getSeriesValues ( ) [cl][s]</I> est le nombre de mailles de la classe
+ * <I>cl</I> au pas de temps <I>s</I>.
+ * </P>
+ *
+ * <P>Un thread lit les pas de temps dans l'ordre auprès de la source de la
+ * série, avec <I>prefetch</I> pas de temps d'avance au plus, pendant que les
+ * threads d'évaluation analysent chacun un pas de temps différent. Ces
+ * derniers partagent la connectivité, les types des mailles et l'ordre
+ * d'évaluation de la série, seules les coordonnées des noeuds leur étant
+ * propres. La mémoire requise est de l'ordre de
+ * <I>(threadsNum + prefetch)</I> tableaux de coordonnées.
+ * </P>
+ *
+ * <P>Les valeurs du critère ne sont pas conservées en cache, et
+ * l'appartenance des mailles aux classes n'est pas enregistrée
+ * (<I>AbstractQualifSerie::getCellsIndexes</I>). Les pas de temps
+ * intéressants peuvent ensuite être analysés individuellement
+ * (<I>TimeSeriesQualifSerie::setStep</I>).
+ * </P>
+ */
+class QualifTimeSeriesTask: public QualifAnalysisTask
+{
+	public :
+
+	/**
+	 * Constructeur. Arguments : cf. <I>QualifAnalysisTask</I>, et :
+	 * @param		Série dont les pas de temps sont analysés. Ses mailles
+	 * 				doivent être affectées.
+	 * @param		Nombre de pas de temps lus par anticipation (1 au moins).
+	 * @param		Nombre de threads d'évaluation (0 : nombre de
+	 * 				processeurs).
+	 * @warning		La série transmise en argument doit être utilisable
+	 * 				pendant toute la durée de vie de cette instance.
+	 */
+	QualifTimeSeriesTask (
+			size_t types, Qualif::Critere criterion, size_t classNum,
+			double min, double max, bool strict, TimeSeriesQualifSerie& serie,
+			size_t prefetch = 2, size_t threadsNum = 0);
+
+	/**
+	 * Destructeur. RAS.
+	 */
+	virtual ~QualifTimeSeriesTask ( );
+
+	/**
+	 * @return		Le nombre de pas de temps analysés.
+	 */
+	virtual size_t getSeriesNum ( ) const;
+
+	/**
+	 * @return		La série dont les pas de temps sont analysés.
+	 */
+	virtual TimeSeriesQualifSerie& getTimeSerie ( ) const;
+
+	/**
+	 * @return		En retour, les extrema du critère au pas de temps transmis
+	 * 				en argument lors de la dernière exécution (toutes mailles
+	 * 				évaluées confondues, <I>min > max</I> si aucune maille n'a
+	 * 				été évaluée).
+	 * @exception	Une exception est levée si le pas de temps est invalide.
+	 */
+	virtual void getStepRange (size_t step, double& min, double& max) const;
+
+	/**
+	 * Exécute la tâche.
+	 * @exception	Une exception est levée, une fois tous les threads
+	 * 				terminés, si la lecture d'un pas de temps a échoué.
+	 */
+	virtual void execute ( );
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QualifTimeSeriesTask (const QualifTimeSeriesTask&);
+	QualifTimeSeriesTask& operator = (const QualifTimeSeriesTask&);
+
+	/** La série analysée. */
+	TimeSeriesQualifSerie*						_serie;
+
+	/** Le nombre de pas de temps lus par anticipation et de threads
+	 * d'évaluation. */
+	size_t										_prefetch, _threadsNum;
+
+	/** Les extrema du critère par pas de temps. */
+	std::vector< std::pair<double, double> >	_ranges;
+};	// class QualifTimeSeriesTask
+
+}	// namespace GQualif
+
+#endif	// QUALIF_TIME_SERIES_TASK_H
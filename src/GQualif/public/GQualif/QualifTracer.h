@@ -0,0 +1,181 @@
+#ifndef QUALIF_TRACER_H
+#define QUALIF_TRACER_H
+
+#include <TkUtil/util_config.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Enregistreur optionnel de la chronologie des calculs (tâches, threads,
+ * paquets de mailles, phases, chargement des maillages). Les évènements sont
+ * écrits au format <I>Chrome trace-event</I> (JSON), exploitable par
+ * <I>Perfetto</I> (<I>https://ui.perfetto.dev</I>) ou
+ * <I>chrome://tracing</I>. Il permet par exemple de visualiser le
+ * déséquilibre de charge entre les threads associés aux séries.
+ * </P>
+ *
+ * <P>Inactif par défaut. Lorsqu'il est inactif le coût de l'instrumentation
+ * se limite à la lecture d'un booléen. Les évènements enregistrés sont de
+ * granularité grossière (pas d'évènement par maille), leur enregistrement est
+ * protégé par un mutex.
+ * </P>
+ *
+ * @see		QualifTraceScope
+ */
+class QualifTracer
+{
+	public :
+
+	typedef IN_STD chrono::steady_clock	Clock;
+
+	/**
+	 * Active l'enregistrement. Les éventuels évènements précédemment
+	 * enregistrés sont oubliés, l'origine des temps est réinitialisée.
+	 */
+	static void start ( );
+
+	/**
+	 * Désactive l'enregistrement. Les évènements enregistrés sont conservés.
+	 */
+	static void stop ( );
+
+	/**
+	 * @return		<I>true</I> si l'enregistrement est actif.
+	 */
+	static bool enabled ( )
+	{ return _enabled.load (IN_STD memory_order_relaxed); }
+
+	/**
+	 * Ecrit les évènements enregistrés au format <I>Chrome trace-event</I>
+	 * dans le fichier transmis en argument.
+	 * @exception	Une exception est levée en cas d'erreur d'écriture.
+	 */
+	static void write (const IN_STD string& fileName);
+
+	/**
+	 * @return		Le nombre d'évènements enregistrés.
+	 */
+	static size_t eventsNum ( );
+
+	/**
+	 * Enregistre un évènement ayant débuté à <I>begin</I> et achevé à
+	 * <I>end</I> dans le thread courant. Sans effet si l'enregistrement est
+	 * inactif.
+	 * @param		Nom de l'évènement
+	 * @param		Catégorie de l'évènement (<I>task</I>, <I>thread</I>,
+	 * 				<I>chunk</I>, <I>phase</I>, <I>loading</I>, ...).
+	 * @param		Début et fin de l'évènement
+	 * @param		Eventuel complément d'information (série, nombre de
+	 * 				mailles, ...).
+	 */
+	static void addEvent (
+			const IN_STD string& name, const IN_STD string& category,
+			const Clock::time_point& begin, const Clock::time_point& end,
+			const IN_STD string& detail = IN_STD string ( ));
+
+	/**
+	 * Nomme le thread courant dans la chronologie. Sans effet si
+	 * l'enregistrement est inactif.
+	 */
+	static void setThreadName (const IN_STD string& name);
+
+
+	private :
+
+	/**
+	 * Constructeurs, opérateur = et destructeur : interdits.
+	 */
+	QualifTracer ( );
+	QualifTracer (const QualifTracer&);
+	QualifTracer& operator = (const QualifTracer&);
+	~QualifTracer ( );
+
+	/**
+	 * @return		Un identifiant, propre à ce tracé, du thread courant.
+	 */
+	static size_t threadId ( );
+
+	struct Event
+	{
+		IN_STD string	name, category, detail;
+		double			begin, duration;	// En microsecondes
+		size_t			thread;
+		bool			metadata;
+	};	// struct Event
+
+	static IN_STD atomic<bool>		_enabled;
+	static IN_STD mutex				_mutex;
+	static Clock::time_point		_origin;
+	static IN_STD vector<Event>		_events;
+};	// class QualifTracer
+
+
+/**
+ * Enregistre, via <I>QualifTracer</I>, un évènement couvrant la durée de vie de
+ * l'instance (ou jusqu'à l'appel de <I>stop</I>). Sans effet si
+ * l'enregistrement est inactif lors de la construction.
+ */
+class QualifTraceScope
+{
+	public :
+
+	/**
+	 * Constructeur. Arguments : cf. <I>QualifTracer::addEvent</I>.
+	 */
+	QualifTraceScope (const IN_STD string& name, const char* category,
+	                  const IN_STD string& detail = IN_STD string ( ))
+		: _enabled (QualifTracer::enabled ( )), _name ( ), _category (category),
+		  _detail ( ), _begin ( )
+	{
+		if (true == _enabled)
+		{
+			_name	= name;
+			_detail	= detail;
+			_begin	= QualifTracer::Clock::now ( );
+		}	// if (true == _enabled)
+	}
+
+	/**
+	 * Destructeur. Enregistre l'évènement.
+	 */
+	~QualifTraceScope ( )
+	{ stop ( ); }
+
+	/**
+	 * Enregistre l'évènement.
+	 */
+	void stop ( )
+	{
+		if (true == _enabled)
+			QualifTracer::addEvent (_name, _category, _begin,
+			                        QualifTracer::Clock::now ( ), _detail);
+		_enabled	= false;
+	}
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QualifTraceScope (const QualifTraceScope&);
+	QualifTraceScope& operator = (const QualifTraceScope&);
+
+	bool							_enabled;
+	IN_STD string					_name;
+	const char*						_category;
+	IN_STD string					_detail;
+	QualifTracer::Clock::time_point	_begin;
+};	// class QualifTraceScope
+
+}	// namespace GQualif
+
+#endif	// QUALIF_TRACER_H
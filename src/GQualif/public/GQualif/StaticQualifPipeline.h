@@ -0,0 +1,95 @@
+#ifndef STATIC_QUALIF_PIPELINE_H
+#define STATIC_QUALIF_PIPELINE_H
+
+#include "GQualif/AbstractQualifSerie.h"
+
+#include <Maille.h>	// Qualif
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Chaîne d'évaluation d'un critère de qualité spécialisée à la
+ * compilation pour un type de série (<I>Adapter</I>) et un type de maille
+ * <I>Qualif</I> (<I>Cell</I>, de <I>NODES</I> noeuds). Elle évalue un paquet
+ * de mailles de même type sans appel virtuel : le remplissage des sommets
+ * est fait par la méthode non virtuelle (et donc susceptible d'être
+ * intégrée) <I>Adapter::fillCell&lt;NODES&gt;</I>, et le critère est appliqué
+ * via la méthode de la classe <I>Cell</I>, explicitement qualifiée.
+ * </P>
+ *
+ * <P>Le type de maille est ainsi testé une seule fois par paquet, et non plus
+ * à chaque maille. Le critère reste quant à lui transmis à <I>Qualif</I> à
+ * l'exécution, <I>Qualif</I> n'offrant pas d'accès individuel aux
+ * critères.
+ * </P>
+ *
+ * <P><I>Adapter</I> doit offrir, éventuellement à titre privé (déclarer alors
+ * cette classe amie), la méthode
+ * <I>template &lt;size_t NODES&gt; void fillCell (size_t i, Qualif::Maille& cell) const</I>
+ * qui affecte à <I>cell</I> les sommets de la i-ème maille de la série, et
+ * lève une exception si la maille est invalide.
+ * </P>
+ *
+ * @see		AbstractQualifSerie::evaluateCriterion
+ * @see		ArrayQualifSerie
+ */
+template <class Adapter, class Cell, size_t NODES> class StaticQualifPipeline
+{
+	public :
+
+	/**
+	 * Evalue le critère pour les mailles de rangs [first, last[ dans l'ordre
+	 * d'évaluation de la série (cf.
+	 * <I>AbstractQualifSerie::getEvaluatedCell</I>), toutes de type
+	 * <I>Cell</I>.
+	 * @param		Série évaluée.
+	 * @param		Maille <I>Qualif</I> de la série utilisée pour l'évaluation.
+	 * @param		Critère à appliquer.
+	 * @param		Rang de la première maille du paquet.
+	 * @param		Rang suivant celui de la dernière maille du paquet.
+	 * @param		En retour, les valeurs du critère (<I>values [0]</I> pour
+	 * 				la maille de rang <I>first</I>).
+	 * @param		En retour, les statuts des mailles
+	 * 				(<I>AbstractQualifSerie::CELL_EVALUATION</I>).
+	 * @return		Le nombre de mailles évaluées.
+	 */
+	static size_t evaluate (const Adapter& serie, Cell& cell,
+			Qualif::Critere criterion, size_t first, size_t last,
+			double* values, unsigned char* status)
+	{
+		size_t	evaluated	= 0;
+		for (size_t p = first; p < last; p++, values++, status++)
+		{
+			try
+			{
+				serie.template fillCell<NODES> (serie.getEvaluatedCell (p), cell);
+				*values	= cell.Cell::AppliqueCritere (criterion);
+				*status	= AbstractQualifSerie::CELL_EVALUATED;
+				evaluated++;
+			}
+			catch (...)
+			{
+				*status	= AbstractQualifSerie::CELL_FAILED;
+			}
+		}	// for (size_t p = first; p < last; p++, values++, status++)
+
+		return evaluated;
+	}	// evaluate
+
+
+	private :
+
+	/**
+	 * Constructeurs, opérateur = et destructeur : interdits.
+	 */
+	StaticQualifPipeline ( );
+	StaticQualifPipeline (const StaticQualifPipeline&);
+	StaticQualifPipeline& operator = (const StaticQualifPipeline&);
+	~StaticQualifPipeline ( );
+};	// class StaticQualifPipeline
+
+}	// namespace GQualif
+
+#endif	// STATIC_QUALIF_PIPELINE_H
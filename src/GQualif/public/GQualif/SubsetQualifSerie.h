@@ -0,0 +1,209 @@
+#ifndef SUBSET_QUALIF_SERIE_H
+#define SUBSET_QUALIF_SERIE_H
+
+#include "GQualif/AbstractQualifSerie.h"
+
+#include <map>
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * <P>Vue sur un sous-ensemble des mailles d'une autre série (série parente),
+ * défini par une liste d'indices ou un masque (ex : mailles d'un groupe
+ * situées à moins de 2 mm de la paroi). Les mailles ne sont <B>pas
+ * copiées</B> : seuls leurs indices dans la série parente sont conservés.
+ * Une sélection ad-hoc ne coûte ainsi que la mémoire de ses indices.
+ * </P>
+ *
+ * <P>Les valeurs des critères en cache et les types des mailles sont ceux de
+ * la série parente : <I>getDataRange</I> met en cache le critère pour toutes
+ * les mailles de la série parente, et <I>rebin</I> répartit en classes les
+ * seules mailles du sous-ensemble à partir des valeurs en cache de la série
+ * parente. Seuls les extrema des critères sur le sous-ensemble sont propres à
+ * la vue.
+ * </P>
+ *
+ * <P>La vue est utilisable en contexte multithread si la série parente l'est.
+ * Elle ne doit cependant pas être consultée simultanément à la série parente
+ * ou à une autre vue sur cette série (<I>getUnderlyingSeries</I>), ce dont se
+ * chargent les tâches <I>Qualif</I>.
+ * </P>
+ *
+ * @see		CompositeQualifSerie
+ */
+class SubsetQualifSerie : public AbstractQualifSerie
+{
+	public :
+
+	/**
+	 * Constructeur.
+	 * @param		Série parente.
+	 * @param		Indices, dans la série parente, des mailles de la vue.
+	 * @param		Nom de la série.
+	 * @exception	Une exception est levée si un indice est invalide.
+	 * @warning		La série parente doit être utilisable pendant toute la
+	 * 				durée de vie de cette instance.
+	 */
+	SubsetQualifSerie (AbstractQualifSerie& parent,
+	                   const std::vector<size_t>& cells,
+	                   const IN_STD string& name);
+
+	/**
+	 * Constructeur.
+	 * @param		Série parente.
+	 * @param		Masque des mailles de la vue : la i-ème maille de la série
+	 * 				parente appartient à la vue si <I>selection [i]</I> vaut
+	 * 				<I>true</I>.
+	 * @param		Nom de la série.
+	 * @exception	Une exception est levée si la taille du masque diffère du
+	 * 				nombre de mailles de la série parente.
+	 * @warning		La série parente doit être utilisable pendant toute la
+	 * 				durée de vie de cette instance.
+	 */
+	SubsetQualifSerie (AbstractQualifSerie& parent,
+	                   const std::vector<bool>& selection,
+	                   const IN_STD string& name);
+
+	/**
+	 * Destructeur. RAS (la série parente n'est pas détruite).
+	 */
+	virtual ~SubsetQualifSerie ( );
+
+	/**
+	 * @return		La série parente.
+	 */
+	virtual AbstractQualifSerie& getParent ( ) const;
+
+	/**
+	 * @return		Les indices, dans la série parente, des mailles de la vue.
+	 */
+	virtual const std::vector<size_t>& getParentCells ( ) const;
+
+	/**
+	 * @return		L'indice, dans la série parente, de la i-ème maille.
+	 * @exception	Une exception est levée si l'indice est invalide.
+	 */
+	virtual size_t getParentCell (size_t i) const;
+
+	/**
+	 * @return		Le nombre de mailles de la série.
+	 */
+	virtual size_t getCellCount ( ) const;
+
+	/**
+	 * @return		La i-ème maille, obtenue auprès de la série parente.
+	 * @warning		<B>A utiliser tout de suite</B> (cf.
+	 * 				<I>AbstractQualifSerie::getCell</I>).
+	 */
+	virtual Qualif::Maille& getCell (size_t i) const;
+
+	/**
+	 * @return		Le type, au sens <I>QualifHelper</I>, de la i-ème maille.
+	 */
+	virtual size_t getCellType (size_t i) const;
+
+	/**
+	 * @return		<I>true</I> si les mailles de la série parente sont
+	 * 				volumiques.
+	 */
+	virtual bool isVolumic ( ) const;
+
+	/**
+	 * Identifiants des mailles et maillage : ceux de la série parente.
+	 */
+	virtual bool hasMeshCellIds ( ) const;
+	virtual size_t getMeshCellId (size_t i) const;
+	virtual const void* getMeshInstance ( ) const;
+
+	/**
+	 * Met en cache, si nécessaire, les valeurs du critère pour toutes les
+	 * mailles de la série parente.
+	 * @return		Les extrema du critère sur les mailles du sous-ensemble,
+	 * 				en pleine précision.
+	 */
+	virtual void getDataRange (
+					Qualif::Critere criterion, double& min, double& max) const;
+
+	/**
+	 * Valeurs en cache des critères : celles de la série parente.
+	 */
+	virtual bool isCriteriaStored (Qualif::Critere criterion) const;
+	virtual double getStoredCriteria (Qualif::Critere criterion, size_t i) const;
+	virtual double getStoredCriteriaError (Qualif::Critere criterion) const;
+	virtual double getCriteriaValue (Qualif::Critere criterion, size_t i) const;
+
+	/**
+	 * Répartit en classes les mailles de la vue à partir des valeurs en cache
+	 * de la série parente.
+	 * @see		AbstractQualifSerie::rebin
+	 */
+	virtual bool rebin (
+				Qualif::Critere criterion, size_t cellTypes, size_t classesNum,
+				double min, double max, bool strict,
+				std::vector<size_t>& counts, size_t threadsNum = 0) const;
+	virtual bool rebin (
+				Qualif::Critere criterion, size_t cellTypes, size_t classesNum,
+				double min, double max, bool strict,
+				const std::vector<size_t>& cells, std::vector<size_t>& counts,
+				size_t threadsNum = 0) const;
+
+	/**
+	 * Libère les extrema en cache des critères sur le sous-ensemble ainsi
+	 * que les données propres à la vue (index des mailles par classe, ...).
+	 * Les données en cache de la série parente ne sont pas libérées.
+	 */
+	virtual void releaseStoredData ( );
+	virtual void releaseStoredCriterion (Qualif::Critere criterion);
+
+	/**
+	 * @return		<I>true</I> si la série parente est utilisable en contexte
+	 * 				multithread.
+	 */
+	virtual bool isThreadable ( ) const;
+
+	/**
+	 * @return		Les séries sous-jacentes à la série parente.
+	 */
+	virtual std::vector<AbstractQualifSerie*> getUnderlyingSeries ( );
+	virtual std::vector<const AbstractQualifSerie*> getUnderlyingSeries ( ) const;
+
+	/**
+	 * Centres des mailles : ceux de la série parente.
+	 */
+	virtual void getCellCentroid (
+						size_t i, double& x, double& y, double& z) const;
+	virtual bool isCentroidReentrant ( ) const;
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	SubsetQualifSerie (const SubsetQualifSerie&);
+	SubsetQualifSerie& operator = (const SubsetQualifSerie&);
+
+	/** La série parente. */
+	AbstractQualifSerie&								_parent;
+
+	/** Les indices des mailles dans la série parente. */
+	std::vector<size_t>									_cells;
+
+	/** Les extrema d'un critère sur le sous-ensemble, et la révision de la
+	 * série parente (<I>getRevision</I>) lors de leur calcul. */
+	struct Range
+	{
+		double			min, max;
+		size_t			revision;
+	};	// struct Range
+
+	/** Les extrema des critères sur le sous-ensemble. */
+	mutable std::map<Qualif::Critere, Range>			_ranges;
+};	// class SubsetQualifSerie
+
+}	// namespace GQualif
+
+#endif	// SUBSET_QUALIF_SERIE_H
@@ -0,0 +1,190 @@
+#ifndef TIME_SERIES_QUALIF_SERIE_H
+#define TIME_SERIES_QUALIF_SERIE_H
+
+#include "GQualif/ArrayQualifSerie.h"
+
+#include <string>
+#include <vector>
+
+
+namespace GQualif
+{
+
+/**
+ * Les coordonnées des noeuds d'un pas de temps, telles que fournies par
+ * <I>QualifTimeStepsSource</I> (simple ou double précision selon la
+ * source).
+ * @see		ArrayQualifSerie::setCoordinates
+ */
+struct QualifStepCoordinates
+{
+	QualifStepCoordinates ( );
+
+	/**
+	 * Libère la mémoire.
+	 */
+	void clear ( );
+
+	/** Le nombre de noeuds, et le nombre de valeurs séparant 2 noeuds
+	 * consécutifs dans les tableaux (0 : dimension de l'espace). */
+	size_t						nodesNum, stride;
+	/** Seul l'un des deux tableaux de coordonnées est renseigné. */
+	IN_STD vector<float>		floatCoordinates;
+	IN_STD vector<double>		doubleCoordinates;
+};	// struct QualifStepCoordinates
+
+
+/**
+ * <P>Classe abstraite fournissant les coordonnées des noeuds des pas de
+ * temps successifs d'un maillage de connectivité constante (fichiers de
+ * sortie d'une simulation, ...).
+ * </P>
+ *
+ * <P>Les pas de temps sont lus par un seul thread à la fois, mais pas
+ * nécessairement par le thread ayant créé l'instance (lecture anticipée,
+ * cf. <I>QualifTimeSeriesTask</I>).
+ * </P>
+ */
+class QualifTimeStepsSource
+{
+	public :
+
+	/**
+	 * Destructeur. RAS.
+	 */
+	virtual ~QualifTimeStepsSource ( );
+
+	/**
+	 * @return		Le nombre de pas de temps.
+	 */
+	virtual size_t getStepsNum ( ) const = 0;
+
+	/**
+	 * @return		Le nom du pas de temps transmis en argument (par défaut
+	 * 				son indice).
+	 */
+	virtual IN_STD string getStepName (size_t step) const;
+
+	/**
+	 * Lit les coordonnées des noeuds du pas de temps transmis en argument.
+	 * @param		Indice du pas de temps.
+	 * @param		En retour, les coordonnées des noeuds. Les tableaux sont
+	 * 				réutilisés d'un pas de temps à l'autre.
+	 * @exception	Une exception est levée si le pas de temps ne peut être lu.
+	 */
+	virtual void readStep (size_t step, QualifStepCoordinates& coordinates) = 0;
+
+
+	protected :
+
+	/**
+	 * Constructeur. RAS.
+	 */
+	QualifTimeStepsSource ( );
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	QualifTimeStepsSource (const QualifTimeStepsSource&);
+	QualifTimeStepsSource& operator = (const QualifTimeStepsSource&);
+};	// class QualifTimeStepsSource
+
+
+/**
+ * <P>Série de mailles d'un maillage mobile : la connectivité, les types des
+ * mailles et l'ordre d'évaluation sont affectés une fois pour toutes
+ * (<I>setCells</I>, <I>computeEvaluationOrder</I>), les coordonnées des
+ * noeuds étant celles du pas de temps courant, lues auprès d'une instance de
+ * <I>QualifTimeStepsSource</I> (<I>setStep</I>). Le recensement des types de
+ * mailles et le parcours de la connectivité ne sont ainsi pas refaits à
+ * chaque pas de temps.
+ * </P>
+ *
+ * <P>L'analyse de tous les pas de temps en une seule tâche, avec lecture
+ * anticipée des pas de temps et évaluation simultanée de plusieurs pas de
+ * temps, est effectuée par <I>QualifTimeSeriesTask</I>.
+ * </P>
+ *
+ * @see		QualifTimeSeriesTask
+ */
+class TimeSeriesQualifSerie : public ArrayQualifSerie
+{
+	public :
+
+	/**
+	 * Constructeur. La série est vide tant que <I>setCells</I> et
+	 * <I>setStep</I> n'ont pas été invoqués.
+	 * @param		Nom de la série.
+	 * @param		Dimension de l'espace (2 ou 3).
+	 * @param		Source des coordonnées des pas de temps.
+	 * @param		Nom de l'éventuel fichier d'où sont issues les données.
+	 * @exception	Une exception est levée si la dimension est invalide.
+	 * @warning		La source doit être utilisable pendant toute la durée de
+	 * 				vie de cette instance.
+	 */
+	TimeSeriesQualifSerie (const IN_STD string& name, unsigned char dimension,
+	                       QualifTimeStepsSource& source,
+	                       const IN_STD string& fileName = IN_STD string ( ));
+
+	/**
+	 * Destructeur. RAS (la source n'est pas détruite).
+	 */
+	virtual ~TimeSeriesQualifSerie ( );
+
+	/**
+	 * @return		La source des coordonnées des pas de temps.
+	 */
+	virtual QualifTimeStepsSource& getSource ( ) const;
+
+	/**
+	 * @return		Le nombre de pas de temps.
+	 */
+	virtual size_t getStepsNum ( ) const;
+
+	/**
+	 * Lit les coordonnées du pas de temps transmis en argument et en fait
+	 * les coordonnées de la série. Les valeurs des critères en cache sont
+	 * libérées, les types des mailles et l'ordre d'évaluation sont conservés.
+	 * @param		Indice du pas de temps.
+	 * @exception	Une exception est levée si le pas de temps est invalide ou
+	 * 				ne peut être lu.
+	 */
+	virtual void setStep (size_t step);
+
+	/**
+	 * @return		L'indice du pas de temps courant, <I>(size_t)-1</I> si
+	 * 				aucun pas de temps n'a été lu.
+	 */
+	virtual size_t getStep ( ) const;
+
+	/**
+	 * Affecte à la série transmise en argument les coordonnées transmises en
+	 * argument, qui ne sont pas copiées.
+	 * @see		ArrayQualifSerie::setCoordinates
+	 */
+	static void assignCoordinates (
+			ArrayQualifSerie& serie, const QualifStepCoordinates& coordinates);
+
+
+	private :
+
+	/**
+	 * Constructeur de copie et opérateur = : interdits.
+	 */
+	TimeSeriesQualifSerie (const TimeSeriesQualifSerie&);
+	TimeSeriesQualifSerie& operator = (const TimeSeriesQualifSerie&);
+
+	/** La source des coordonnées des pas de temps. */
+	QualifTimeStepsSource&			_source;
+
+	/** Le pas de temps courant et ses coordonnées. */
+	size_t							_step;
+	QualifStepCoordinates			_coordinates;
+};	// class TimeSeriesQualifSerie
+
+}	// namespace GQualif
+
+#endif	// TIME_SERIES_QUALIF_SERIE_H
@@ -1,9 +1,12 @@
 #include "QtCalQualMainWindow.h"
 #include "QtQualif/QtSeriesChoiceDialog.h"
+#include "GQLima/LimaMeshCache.h"
 #include "GQLima/LimaQualifSerie.h"
 #include "GQVtk/VtkQualifSerie.h"
+#include "GQualif/QualifTracer.h"
 #ifdef USE_GMDS
 #include "GQGMDS/GMDSQualifSerie.h"
+#include "GQGMDS/MeditFileScanner.h"
 #endif	// USE_GMDS
 #include <QwtCharts/QwtChartsManager.h>
 #include <QtUtil/QtMessageBox.h>
@@ -16,6 +19,7 @@
 #include <QApplication>
 #include <QContextMenuEvent>
 #include <QFileDialog>
+#include <QInputDialog>
 #include <QMenuBar>
 #include <QLayout>
 
@@ -28,7 +32,11 @@
 #include <gmds/io/VTKReader.h>
 #endif	// USE_GMDS
 
+#include <future>
 #include <memory>
+#include <thread>
+
+#include <limits.h>
 
 using namespace std;
 using namespace TkUtil;
@@ -49,6 +57,24 @@ namespace GQualif
 //                            FONCTIONS STATIQUES
 // ============================================================================
 
+/**
+ * Charge, dans un autre thread, le maillage <I>Lima</I> du fichier transmis
+ * en argument (via <I>LimaMeshCache</I>). Contrairement à celui retourné par
+ * <I>std::async</I>, le futur retourné n'attend pas la fin du chargement lors
+ * de sa destruction : l'abandon de l'opération par l'utilisateur n'est pas
+ * bloquant, le maillage étant alors détruit au terme de son chargement.
+ */
+static future<shared_ptr<_MaillageInterne> > loadLimaMeshInBackground (
+														const string& fileName)
+{
+	packaged_task<shared_ptr<_MaillageInterne> ( )>	task (
+					[fileName] ( ) { return LimaMeshCache::getMesh (fileName); });
+	future<shared_ptr<_MaillageInterne> >			mesh	= task.get_future ( );
+	thread (move (task)).detach ( );
+
+	return mesh;
+}	// loadLimaMeshInBackground
+
 
 
 // ============================================================================
@@ -117,26 +143,35 @@ QtLimaMeshAnalysisView::QtLimaMeshAnalysisView (
 {
 	try
 	{
-		_mesh.reset (new _MaillageInterne ( ));
-		_mesh->lire (fileName);
+		// Les groupes sont proposés à l'utilisateur d'après la structure du
+		// fichier, le maillage étant chargé en tâche de fond durant son
+		// choix :
+		QualifTraceScope	scanScope ("Lecture des en-têtes", "loading", fileName);
+		const vector<QualifGroupMetadata>	metadata	=
+									LimaQualifSerie::getMetadata (fileName);
+		scanScope.stop ( );
+		future<shared_ptr<_MaillageInterne> >	loading	=
+										loadLimaMeshInBackground (fileName);
 		vector < pair <string, unsigned char> >	groups;
-		size_t	g	= 0;
-		for (g = 0; g < _mesh->nb_volumes ( ); g++)
-			 groups.push_back (
-					pair<string, unsigned char>(_mesh->volume (g)->nom( ), 3));
-		for (g = 0; g < _mesh->nb_surfaces ( ); g++)
-			 groups.push_back (
-					pair<string, unsigned char>(_mesh->surface (g)->nom( ), 2));
-		if (0 != groups.size ( ))
+		if (0 != metadata.size ( ))
 		{
-			QtSeriesChoiceDialog	dialog (this, appTitle, groups);
+			QtSeriesChoiceDialog	dialog (this, appTitle, metadata);
 			dialog.exec ( );
 			if (QDialog::Accepted != dialog.result ( ))
 				throw Exception (UTF8String ("Opération annulée par l'utilisateur.", charset));
 
 			groups	= dialog.getGroups ( );
-		}
-		else if ((0 != _mesh->nb_polygones( )) && (0 == _mesh->nb_polyedres( )))
+		}	// if (0 != metadata.size ( ))
+
+		// Temps de chargement restant après le choix des groupes :
+		QualifPhaseTimer	loadingTimer (
+				getAnalysisPanel ( ).getProfile ( ), QualifProfile::LOADING);
+		QualifTraceScope	loadingScope ("Chargement", "loading", fileName);
+		_mesh	= loading.get ( );
+		loadingScope.stop ( );
+		loadingTimer.stop ( );
+		if ((0 == metadata.size ( )) &&
+		    (0 != _mesh->nb_polygones( )) && (0 == _mesh->nb_polyedres( )))
 			throw Exception (UTF8String ("Absence de mailles de dimension 2 et 3.", charset));
 
 		LimaQualifSerie*	serie	= 0;
@@ -151,14 +186,15 @@ QtLimaMeshAnalysisView::QtLimaMeshAnalysisView (
 					case	2	:
 					{
 						_SurfaceInterne*	s	= _mesh->surface ((*it).first);
-						serie	= new LimaQualifSerie (
-											*s, _mesh->dimension ( ), fileName);
+						serie	= new LimaQualifSerie (*s, _mesh->dimension ( ),
+						                        fileName, _mesh.get ( ));
 					}	// case    2
 					break;
 					case	3	:
 					{
 						_VolumeInterne*	v	= _mesh->volume ((*it).first);
-						serie	= new LimaQualifSerie (*v, fileName);
+						serie	= new LimaQualifSerie (
+											*v, fileName, _mesh.get ( ));
 					}	// case    3
 					break;
 					default		:
@@ -304,23 +340,42 @@ QtGMDSMeshAnalysisView::QtGMDSMeshAnalysisView (
 	{
 		AbstractQualifSerie*	serie	= 0;
 
+		// Fichier Medit : contrôle préalable, sans chargement, de la présence
+		// de mailles 2D ou 3D :
+		vector<QualifGroupMetadata>	metadata;
+		if ((true == MeditFileScanner::scan (fileName, metadata)) &&
+		    (0 == metadata.size ( )))
+			throw Exception (UTF8String ("Absence de mailles de dimension 2 et 3.", charset));
+
 		_mesh.reset (new gmds::Mesh(QtCalQualMainWindow::gmdsMask));
+		QualifPhaseTimer	loadingTimer (
+				getAnalysisPanel ( ).getProfile ( ), QualifProfile::LOADING);
+		QualifTraceScope	loadingScope ("Chargement", "loading", fileName);
 		loadMesh (*_mesh.get ( ), fileName);
+		loadingScope.stop ( );
+		loadingTimer.stop ( );
 		vector < pair <string, unsigned char> >	groups;
 
+		metadata.clear ( );
 		for (auto its = _mesh->groups_begin<gmds::Face>(); its != _mesh->groups_end<gmds::Face>(); its++)
-			groups.push_back (pair<string, unsigned char>((*its)->name ( ), 2));
+		{
+			metadata.push_back (QualifGroupMetadata ((*its)->name ( ), 2));
+			metadata.back ( ).cellsNum	= (*its)->size ( );
+		}
 		for (auto itv = _mesh->groups_begin<gmds::Region>(); itv != _mesh->groups_end<gmds::Region>(); itv++)
-			 groups.push_back (pair<string, unsigned char>((*itv)->name ( ), 3));
-		if (0 != groups.size ( ))
 		{
-			QtSeriesChoiceDialog	dialog (this, appTitle, groups);
+			metadata.push_back (QualifGroupMetadata ((*itv)->name ( ), 3));
+			metadata.back ( ).cellsNum	= (*itv)->size ( );
+		}
+		if (0 != metadata.size ( ))
+		{
+			QtSeriesChoiceDialog	dialog (this, appTitle, metadata);
 			dialog.exec ( );
 			if (QDialog::Accepted != dialog.result ( ))
 				throw Exception (UTF8String ("Opération annulée par l'utilisateur.", charset));
 
 			groups	= dialog.getGroups ( );
-		}	// if (0 != groups.size ( ))
+		}	// if (0 != metadata.size ( ))
 		else if ((0 == _mesh->getNbRegions ( )) && (0 == _mesh->getNbFaces ( )))
 			throw Exception (UTF8String ("Absence de mailles de dimension 2 et 3.", charset));
 
@@ -443,7 +498,8 @@ QtGMDSMeshAnalysisView::~QtGMDSMeshAnalysisView ( )
 
 QtCalQualMainWindow::QtCalQualMainWindow (
 									QWidget* parent, const string& appTitle)
-	: QMainWindow (parent), _mdiArea (0), _windowMenu (0)
+	: QMainWindow (parent), _mdiArea (0), _windowMenu (0),
+	  _profileDock (0), _profileTextArea (0)
 {
 	setWindowTitle (appTitle.c_str ( ));
 	_mdiArea	= new QMdiArea (this);
@@ -477,6 +533,40 @@ QtCalQualMainWindow::QtCalQualMainWindow (
 
 	// Utilisation de la barre d'outils par défaut de QwtChartsManager :
 	addToolBar (Qt::LeftToolBarArea, &QwtChartsManager::getToolBar ( ));
+
+	// Le panneau d'instrumentation (temps par phase, compteurs) :
+	_profileDock		= new QDockWidget (QLatin1String ("Performances"), this);
+	_profileTextArea	= new QPlainTextEdit (_profileDock);
+	_profileTextArea->setReadOnly (true);
+	_profileDock->setWidget (_profileTextArea);
+	addDockWidget (Qt::BottomDockWidgetArea, _profileDock);
+	_profileDock->hide ( );
+	_windowMenu->addAction (_profileDock->toggleViewAction ( ));
+	action	= _windowMenu->addAction (QSTR ("Instrumentation détaillée"));
+	action->setCheckable (true);
+	action->setChecked (QualifProfile::detailedTimings ( ));
+	connect (action, SIGNAL (toggled (bool)), this,
+	         SLOT (detailedTimingsCallback (bool)));
+	action	= _windowMenu->addAction (QSTR ("Compteurs matériels"));
+	action->setCheckable (true);
+	action->setChecked (QualifProfile::hardwareCounters ( ));
+	connect (action, SIGNAL (toggled (bool)), this,
+	         SLOT (hardwareCountersCallback (bool)));
+	action	= _windowMenu->addAction (QSTR ("Enregistrer la chronologie"));
+	action->setCheckable (true);
+	action->setChecked (QualifTracer::enabled ( ));
+	connect (action, SIGNAL (toggled (bool)), this,
+	         SLOT (traceCallback (bool)));
+	_windowMenu->addAction (QSTR ("Budget mémoire ..."), this,
+	                        SLOT (memoryBudgetCallback ( )));
+	action	= _windowMenu->addAction (QSTR ("Stockage compact des critères"));
+	action->setCheckable (true);
+	action->setChecked (AbstractQualifSerie::QUANTIZED_STORAGE ==
+	                    AbstractQualifSerie::getStorageMode ( ));
+	action->setToolTip (QSTR ("Coché, les valeurs des critères calculés ultérieurement sont mises en cache sur 16 bits (1 bit pour les critères binaires)."));
+	connect (action, SIGNAL (toggled (bool)), this,
+	         SLOT (compactStorageCallback (bool)));
+	_windowMenu->addSeparator ( );
 }	// QtCalQualMainWindow::QtCalQualMainWindow
 
 
@@ -523,7 +613,7 @@ void QtCalQualMainWindow::analyseMeshCallback ( )
 			count++;
 		}	// while (NULL != *ext)
 		extensions << ")";
-		extensions << ";;VTK(*.vtk);;GMDS(*.mesh *.med *.vtu *.vtp *.fac)";
+		extensions << ";;VTK(*.vtk *.vtu);;GMDS(*.mesh *.med *.vtu *.vtp *.fac)";
 
 		static QString	lastFile, lastFilter;
 		QFileInfo		path (lastFile);
@@ -603,10 +693,22 @@ QtMeshAnalysisView* QtCalQualMainWindow::createAnalysisView (
 						_mdiArea, windowTitle ( ).toStdString ( ), fileName);
 	else if (0 == filter.compare (0, 3, "VTK", 0, 3))
 	{
+		// Contrôle préalable, sans chargement, des types des mailles :
+		const QualifGroupMetadata	metadata	=
+										VtkQualifSerie::getMetadata (fileName);
+		if ((QualifGroupMetadata::UNKNOWN != metadata.cellsNum) &&
+		    (0 == metadata.getDataTypes ( )))
+			throw Exception (UTF8String ("Absence de mailles de types supportés par Qualif dans le maillage.", charset));
+
 		view	= new QtMeshAnalysisView (
 								_mdiArea, windowTitle ( ).toStdString ( ));
+		QualifPhaseTimer	loadingTimer (view->getAnalysisPanel ( ).getProfile ( ),
+		                                  QualifProfile::LOADING);
+		QualifTraceScope	loadingScope ("Chargement", "loading", fileName);
 		VtkQualifSerie*	serie	=
 					new VtkQualifSerie (fileName, file.getFileName ( ));
+		loadingScope.stop ( );
+		loadingTimer.stop ( );
 		view->getAnalysisPanel ( ).addSerie (serie);
 	}	// else if (file.getExtension ( ) == string ("vtk"))
 #ifdef USE_GMDS
@@ -633,6 +735,8 @@ QtMeshAnalysisView* QtCalQualMainWindow::createAnalysisView (
 	QMenu*	graphicMenu	= QwtChartsManager::createMenu (0, "Graphique ...");
 	menu->addMenu (graphicMenu);	
 	view->setContextMenu (menu);
+	connect (&view->getAnalysisPanel ( ), SIGNAL (histogramUpdated ( )), this,
+	         SLOT (updateProfileCallback ( )));
 
 //	view->getAnalysisPanel ( ).updateHistogram ( );
 
@@ -646,7 +750,118 @@ void QtCalQualMainWindow::subWindowActivated (QMdiSubWindow* window)
 	if (0 != view)
 		QwtChartsManager::getManager ( ).focusChanged (
 							&view->getAnalysisPanel ( ).getHistogramPanel ( ));
+	updateProfileCallback ( );
 }	// QtCalQualMainWindow::subWindowActivated
 
 
+void QtCalQualMainWindow::detailedTimingsCallback (bool enable)
+{
+	QualifProfile::enableDetailedTimings (enable);
+}	// QtCalQualMainWindow::detailedTimingsCallback
+
+
+void QtCalQualMainWindow::hardwareCountersCallback (bool enable)
+{
+	QualifProfile::enableHardwareCounters (enable);
+}	// QtCalQualMainWindow::hardwareCountersCallback
+
+
+void QtCalQualMainWindow::traceCallback (bool enable)
+{
+	if (true == enable)
+	{
+		QualifTracer::start ( );
+		return;
+	}	// if (true == enable)
+
+	QualifTracer::stop ( );
+	if (0 == QualifTracer::eventsNum ( ))
+		return;
+
+	const QString	fileName	= QFileDialog::getSaveFileName (
+			this, QSTR ("Fichier de la chronologie"), QString ( ),
+			QSTR ("Chrome trace-event (*.json)"));
+	if (true == fileName.isEmpty ( ))
+		return;
+
+	try
+	{
+		QualifTracer::write (fileName.toStdString ( ));
+	}
+	catch (const Exception& exc)
+	{
+		QtMessageBox::displayErrorMessage (
+			this, windowTitle ( ).toStdString ( ), exc.getFullMessage ( ));
+	}
+}	// QtCalQualMainWindow::traceCallback
+
+
+void QtCalQualMainWindow::memoryBudgetCallback ( )
+{
+	bool		ok		= false;
+	const int	budget	= QInputDialog::getInt (this, windowTitle ( ),
+			QSTR ("Budget mémoire des données en cache (Mo, 0 : sans limite) :"),
+			(int)(AbstractQualifSerie::getMemoryBudget ( ) / 1048576), 0,
+			INT_MAX, 1, &ok);
+	if (false == ok)
+		return;
+
+	AbstractQualifSerie::setMemoryBudget ((size_t)budget * 1048576);
+	updateProfileCallback ( );
+}	// QtCalQualMainWindow::memoryBudgetCallback
+
+
+void QtCalQualMainWindow::compactStorageCallback (bool enable)
+{
+	AbstractQualifSerie::setStorageMode (true == enable ?
+			AbstractQualifSerie::QUANTIZED_STORAGE :
+			AbstractQualifSerie::FULL_STORAGE,
+			AbstractQualifSerie::getStorageMaxError ( ));
+}	// QtCalQualMainWindow::compactStorageCallback
+
+
+void QtCalQualMainWindow::updateProfileCallback ( )
+{
+	assert ((0 != _mdiArea) && "QtCalQualMainWindow::updateProfileCallback : null MDI area.");
+	assert ((0 != _profileTextArea) && "QtCalQualMainWindow::updateProfileCallback : null text area.");
+	QtMeshAnalysisView*	view	=
+			dynamic_cast<QtMeshAnalysisView*>(_mdiArea->activeSubWindow ( ));
+	if (0 == view)
+	{
+		_profileTextArea->clear ( );
+		return;
+	}	// if (0 == view)
+
+	UTF8String	text (charset);
+	text << view->windowTitle ( ).toStdString ( ) << " :\n"
+	     << view->getAnalysisPanel ( ).getProfile ( ).toString ( );
+
+	// La mémoire occupée par les données en cache, par série et critère :
+	const size_t	budget	= AbstractQualifSerie::getMemoryBudget ( );
+	text << "Données en cache (budget : ";
+	if (0 == budget)
+		text << "sans limite) :\n";
+	else
+		text << (unsigned long)(budget / 1048576) << " Mo) :\n";
+	// Les séries ne doivent plus être utilisées en tâche de fond :
+	QtQualifWidget&	panel	= view->getAnalysisPanel ( );
+	panel.stopWarmUp ( );
+	for (size_t s = 0; s < panel.getSeriesNum ( ); s++)
+	{
+		const AbstractQualifSerie&	serie		= panel.getSerie (s);
+		const vector<Qualif::Critere>	criteria	=
+										serie.getStoredCriteriaList ( );
+		text << serie.getName ( ) << " : "
+		     << serie.getMemoryUsage ( ) / 1048576. << " Mo (";
+		for (vector<Qualif::Critere>::const_iterator itc = criteria.begin ( );
+		     criteria.end ( ) != itc; itc++)
+			text << Qualif::CRITERESTR [*itc] << " "
+			     << serie.getMemoryUsage (*itc) / 1048576. << " Mo, ";
+		text << "classes " << serie.getClassesMemoryUsage ( ) / 1048576.
+		     << " Mo)\n";
+	}	// for (size_t s = 0; s < panel.getSeriesNum ( ); s++)
+	_profileTextArea->setPlainText (UTF8TOQSTRING (text));
+}	// QtCalQualMainWindow::updateProfileCallback
+
+
 }	// namespace GQualif
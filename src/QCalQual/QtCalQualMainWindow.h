@@ -6,6 +6,8 @@
 #include <QAction>
 #include <QMdiArea>
 #include <QMdiSubWindow>
+#include <QDockWidget>
+#include <QPlainTextEdit>
 
 #include <QtQualif/QtQualifWidget.h>
 
@@ -85,6 +87,9 @@ class QtLimaMeshAnalysisView : public QtMeshAnalysisView
 	/**
 	 * Charge le maillage contenu dans le fichier <I>fileName</I> et propose
 	 * à l'utilisateur de sélectionner les groupes de données à analyser.
+	 * Le maillage est obtenu via <I>LimaMeshCache</I> : les vues portant sur
+	 * un même fichier le partagent, et il est libéré à la fermeture de la
+	 * dernière d'entre-elles.
 	 */
 	QtLimaMeshAnalysisView (QMdiArea* parent, const IN_STD string& appTitle,
 	                        const IN_STD string&fileName);
@@ -97,7 +102,7 @@ class QtLimaMeshAnalysisView : public QtMeshAnalysisView
 	QtLimaMeshAnalysisView (const QtLimaMeshAnalysisView&);
 	QtLimaMeshAnalysisView& operator = (const QtLimaMeshAnalysisView&);
 
-	IN_STD unique_ptr <Lima::_MaillageInterne>	_mesh;
+	IN_STD shared_ptr <Lima::_MaillageInterne>	_mesh;
 };	// class QtLimaMeshAnalysisView
 
 
@@ -167,6 +172,34 @@ class QtCalQualMainWindow : public QMainWindow
 	virtual void cascadeCallback ( );
 	virtual void tileCallback ( );
 	virtual void subWindowActivated (QMdiSubWindow*);
+	virtual void detailedTimingsCallback (bool);
+	virtual void hardwareCountersCallback (bool);
+
+	/**
+	 * (Dés)active l'enregistrement de la chronologie des calculs
+	 * (<I>QualifTracer</I>). A la désactivation la chronologie est écrite dans
+	 * un fichier choisi par l'utilisateur.
+	 */
+	virtual void traceCallback (bool);
+
+	/**
+	 * Saisie du budget mémoire des données en cache des séries
+	 * (<I>AbstractQualifSerie::setMemoryBudget</I>).
+	 */
+	virtual void memoryBudgetCallback ( );
+
+	/**
+	 * (Dés)active le stockage compact (quantifié) des valeurs des critères
+	 * mises en cache (<I>AbstractQualifSerie::setStorageMode</I>).
+	 */
+	virtual void compactStorageCallback (bool);
+
+	/**
+	 * Affiche dans le panneau "Performances" l'instrumentation du dernier
+	 * calcul de la vue active, et la mémoire occupée par les données en cache
+	 * de ses séries.
+	 */
+	virtual void updateProfileCallback ( );
 
 
 	protected :
@@ -182,6 +215,8 @@ class QtCalQualMainWindow : public QMainWindow
 
 	QMdiArea			*_mdiArea;
 	QMenu				*_windowMenu;
+	QDockWidget			*_profileDock;
+	QPlainTextEdit		*_profileTextArea;
 };	// class QtCalQualMainWindow
 
 
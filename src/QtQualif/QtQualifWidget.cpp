@@ -1,7 +1,10 @@
 #include "QtQualif/QtQualifWidget.h"
 #include "GQualif/QualifHelper.h"
 #include "GQualif/QualifAnalysisTask.h"
+#include "GQualif/QualifRebinningTask.h"
+#include "GQualif/QualifSharedCellsTask.h"
 #include "GQualif/QCalQualThread.h"
+#include "GQualif/QualifTracer.h"
 
 #include <QtUtil/QtAutoWaitingCursor.h>
 #include <QtUtil/QtMessageBox.h>
@@ -17,6 +20,7 @@
 #include <QLayout>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QResizeEvent>
 
 #include <qwt_text.h>
 
@@ -97,10 +101,13 @@ class QtQualifDataTypeItem : public QListWidgetItem
 //                         Classe QtQualifWidget
 // ===========================================================================
 
+const size_t	QtQualifWidget::maxClassesNum	= 100000;
+
 
 QtQualifWidget::QtQualifWidget (QWidget* parent, const string& appTitle)
 	: QWidget (parent),
 	  _histogramPanel (0), _appTitle (appTitle), _series ( ),
+	  _seriesResults ( ), _seriesTypes (0), _requestedTypes (0),
 	  _theoreticalRadioButton (0), _computedRadioButton (0),
 	  _userDefinedRadioButton (0), _minTextField (0), _maxTextField (0),
 	  _strictDomainUsageCheckBox (0),
@@ -108,7 +115,12 @@ QtQualifWidget::QtQualifWidget (QWidget* parent, const string& appTitle)
 	  _criterionComboBox (0), _dataTypesList (0),
 	  _coordinatesCheckBox (0), _releaseDataCheckBox (0),
 	  _buttonsLayout (0), _applyButton (0),
-	  _criterion ((Qualif::Critere)-1)
+	  _criterion ((Qualif::Critere)-1),
+	  _histogramCriterion ((Qualif::Critere)-1), _histogramTypes (0),
+	  _dataMin (1.), _dataMax (0.), _classesValues ( ),
+	  _histogramMin (0.), _histogramMax (1.), _classesWidth (1.),
+	  _histogramAutoScale (true), _displayedGroupSize (1), _profile ( ),
+	  _warmUp ( )
 {
 	QVBoxLayout*	mainLayout	= new QVBoxLayout (this);
 	mainLayout->setSizeConstraint (QLayout::SetMinimumSize);
@@ -173,6 +185,10 @@ QtQualifWidget::QtQualifWidget (QWidget* parent, const string& appTitle)
 			QSTR ("Champ de saisie de la valeur maximale à représenter."));
 	_maxTextField->setToolTip (
 			QSTR ("Champ de saisie de la valeur maximale à représenter."));
+	connect (_minTextField, SIGNAL (textEdited (const QString&)), this,
+	         SLOT (rebinCallback ( )));
+	connect (_maxTextField, SIGNAL (textEdited (const QString&)), this,
+	         SLOT (rebinCallback ( )));
 	_strictDomainUsageCheckBox = new QCheckBox (QSTR ("Restreindre au domaine"), this);
 	_strictDomainUsageCheckBox->setChecked (true);
 	hboxLayout->addWidget (_strictDomainUsageCheckBox);	
@@ -182,6 +198,8 @@ QtQualifWidget::QtQualifWidget (QWidget* parent, const string& appTitle)
 		QSTR ("Coché les mailles dont le critère sort du domaine ne sont pas prises en compte dans les classes."));
 	_strictDomainUsageCheckBox->setToolTip (
 		QSTR ("Coché les mailles dont le critère sort du domaine ne sont pas prises en compte dans les classes."));
+	connect (_strictDomainUsageCheckBox, SIGNAL (clicked ( )), this,
+	         SLOT (rebinCallback ( )));
 	hboxLayout->addStretch (10.);
 	
 	// 3-ème ligne : nombre de classes :
@@ -191,15 +209,17 @@ QtQualifWidget::QtQualifWidget (QWidget* parent, const string& appTitle)
 	hboxLayout->addWidget (label);
 	_barNumTextField	= new QtTextField ("10", this);
 	hboxLayout->addWidget (_barNumTextField);
-	_barNumTextField->setVisibleColumns (3);
+	_barNumTextField->setVisibleColumns (6);
 	QIntValidator*	barValidator	=
-							new QIntValidator (0, 100, _barNumTextField);
+				new QIntValidator (1, (int)maxClassesNum, _barNumTextField);
 	_barNumTextField->setValidator (barValidator);
 	_barNumTextField->setFixedSize (_barNumTextField->sizeHint ( ));
 	_barNumTextField->setToolTip (
 			QSTR ("Champ de saisie du nombre de classes de l'histogramme."));
 	_barNumTextField->setWhatsThis (
 			QSTR ("Champ de saisie du nombre de classes de l'histogramme."));
+	connect (_barNumTextField, SIGNAL (textEdited (const QString&)), this,
+	         SLOT (rebinCallback ( )));
 	hboxLayout->addStretch (10.);
 
 	// 4-ème ligne : hauteur maximale
@@ -251,6 +271,7 @@ QtQualifWidget::QtQualifWidget (QWidget* parent, const string& appTitle)
 	         SLOT (updateDomainCallback ( )));
 	connect (_criterionComboBox, SIGNAL(activated (int)), this,
 	         SLOT (updateSelectableTypesCallback ( )));
+	_warmUp.setCriterion (getCriterion ( ));
 	hboxLayout->addStretch (10.);
 
 	// 6-ième ligne : sélection :
@@ -284,9 +305,9 @@ QtQualifWidget::QtQualifWidget (QWidget* parent, const string& appTitle)
 	_releaseDataCheckBox->setFixedSize (_releaseDataCheckBox->sizeHint ( ));
 	_releaseDataCheckBox->setChecked (true);
 	_releaseDataCheckBox->setToolTip (
-		QSTR ("Activé, libère la mémoire utilisée en cache à chaque changement de critère."));
+		QSTR ("Activé, libère la mémoire utilisée en cache à chaque changement de critère. Désactivé, les données en cache utilisées le moins récemment sont libérées selon le budget mémoire."));
 	_releaseDataCheckBox->setWhatsThis (
-		QSTR ("Activé, libère la mémoire utilisée en cache à chaque changement de critère."));
+		QSTR ("Activé, libère la mémoire utilisée en cache à chaque changement de critère. Désactivé, les données en cache utilisées le moins récemment sont libérées selon le budget mémoire."));
 	hboxLayout->addStretch (10.);
 	vlayout->addStretch (10.);
 
@@ -303,6 +324,12 @@ QtQualifWidget::QtQualifWidget (QWidget* parent, const string& appTitle)
 	_buttonsLayout->addStretch (10.);
 	setFocusPolicy (Qt::StrongFocus);
 
+	// Préparation des séries en tâche de fond : le signal est émis par le
+	// thread de préparation.
+	connect (this, SIGNAL (serieWarmedUp ( )), this, SLOT (warmUpCallback ( )),
+	         Qt::QueuedConnection);
+	_warmUp.setCompletionCallback ([this] ( ) { emit serieWarmedUp ( ); });
+
 	layout ( );
 }	// QtQualifWidget::QtQualifWidget
 
@@ -310,6 +337,7 @@ QtQualifWidget::QtQualifWidget (QWidget* parent, const string& appTitle)
 QtQualifWidget::QtQualifWidget (const QtQualifWidget&)
 	: QWidget (0),
 	  _histogramPanel (0), _appTitle ("Invalid application"), _series ( ),
+	  _seriesResults ( ), _seriesTypes (0), _requestedTypes (0),
 	  _theoreticalRadioButton (0), _computedRadioButton (0),
 	  _userDefinedRadioButton (0), _minTextField (0), _maxTextField (0),
 	  _strictDomainUsageCheckBox (0),
@@ -317,7 +345,12 @@ QtQualifWidget::QtQualifWidget (const QtQualifWidget&)
 	  _criterionComboBox (0), _dataTypesList (0),
 	  _coordinatesCheckBox (0), _releaseDataCheckBox (0),
 	  _buttonsLayout (0), _applyButton (0),
-	  _criterion ((Qualif::Critere)-1)
+	  _criterion ((Qualif::Critere)-1),
+	  _histogramCriterion ((Qualif::Critere)-1), _histogramTypes (0),
+	  _dataMin (1.), _dataMax (0.), _classesValues ( ),
+	  _histogramMin (0.), _histogramMax (1.), _classesWidth (1.),
+	  _histogramAutoScale (true), _displayedGroupSize (1), _profile ( ),
+	  _warmUp ( )
 {
 	assert (0 && "QtQualifWidget copy constructor is not allowed.");
 }	// QtQualifWidget::QtQualifWidget
@@ -360,7 +393,60 @@ void QtQualifWidget::addSerie (AbstractQualifSerie* serie)
 	}	// if (0 == serie)
 
 	_series.push_back (serie);
+	_seriesResults.push_back (SerieResults ( ));
+	_seriesResults.back ( ).revision	= serie->getRevision ( );
+	_histogramCriterion	= (Qualif::Critere)-1;
+
+	// Préparation en tâche de fond, les types de mailles de la série étant
+	// recensés à son terme (warmUpCallback). A défaut (série non threadable)
+	// ils le sont ici.
+	if (true == _warmUp.add (*serie))
+		return;
+	_seriesResults.back ( ).dataTypes		=
+					2 > serie->getDimension ( ) ? 0 : serie->getDataTypes ( );
+	_seriesResults.back ( ).dataTypesKnown	= true;
+	updateSeriesTypes ( );
+}	// QtQualifWidget::addSerie
+
 
+void QtQualifWidget::removeSerie (size_t i)
+{
+	assert (0 != _dataTypesList && "QtQualifWidget::removeSerie : null data list widget.");
+	if (i >= _series.size ( ))
+	{
+		UTF8String	error (charset);
+		error << "Impossibilité de retirer la " << (unsigned long)i
+		      << "-ème série : ce panneau n'en gère que "
+		      << (unsigned long)_series.size ( ) << ".";
+		throw Exception (error);
+	}	// if (i >= _series.size ( ))
+	if (1 == _series.size ( ))
+	{
+		removeSeries (true);
+		return;
+	}	// if (1 == _series.size ( ))
+
+	_warmUp.remove (*_series [i]);
+	delete _series [i];
+	_series.erase (_series.begin ( ) + i);
+	_seriesResults.erase (_seriesResults.begin ( ) + i);
+	// Les effectifs des autres séries restent valables pour le domaine
+	// affiché :
+	for (vector< vector<size_t> >::iterator itc = _classesValues.begin ( );
+	     _classesValues.end ( ) != itc; itc++)
+		if (i < (*itc).size ( ))
+			(*itc).erase ((*itc).begin ( ) + i);
+
+	// La série retirée était peut être la seule à apporter certains types :
+	updateSeriesTypes ( );
+
+	displayHistogram ( );
+}	// QtQualifWidget::removeSerie
+
+
+void QtQualifWidget::updateDataTypesList ( )
+{
+	assert (0 != _dataTypesList && "QtQualifWidget::updateDataTypesList : null data list widget.");
 	_dataTypesList->clear ( );
 	map<size_t, size_t>	types	= getDataTypes ( );
 	for (map<size_t, size_t>::iterator itt = types.begin ( );
@@ -375,7 +461,71 @@ void QtQualifWidget::addSerie (AbstractQualifSerie* serie)
 			item->setSelected (true);
 	}	// for (map<size_t, size_t>::iterator itt ...
 	_dataTypesList->setFixedSize (_dataTypesList->sizeHint ( ));
-}	// QtQualifWidget::addSerie
+}	// QtQualifWidget::updateDataTypesList
+
+
+void QtQualifWidget::updateSeriesTypes ( )
+{
+	// Reconstruire la liste des types à chaque ajout rendrait quadratique
+	// l'ajout de nombreuses séries : seule une modification des types la
+	// modifie.
+	size_t	seriesTypes	= 0;
+	for (vector<SerieResults>::const_iterator itr = _seriesResults.begin ( );
+	     _seriesResults.end ( ) != itr; itr++)
+		seriesTypes	|= true == (*itr).dataTypesKnown ? (*itr).dataTypes : 0;
+	if (seriesTypes == _seriesTypes)
+		return;
+
+	const size_t	selectedTypes	= getQualifiedTypes ( ) | _requestedTypes;
+	const size_t	requestedTypes	= _requestedTypes;
+	_seriesTypes	= seriesTypes;
+	updateDataTypesList ( );
+	if (0 != (selectedTypes & seriesTypes))
+		selectQualifiedTypes (selectedTypes & seriesTypes);
+	_requestedTypes	= requestedTypes & ~seriesTypes;
+}	// QtQualifWidget::updateSeriesTypes
+
+
+void QtQualifWidget::storeWarmUpResults ( )
+{
+	const vector< pair<AbstractQualifSerie*, size_t> >	completed	=
+												_warmUp.takeCompleted ( );
+	const size_t	seriesNum	= _series.size ( );
+	for (vector< pair<AbstractQualifSerie*, size_t> >::const_iterator itc =
+	     completed.begin ( ); completed.end ( ) != itc; itc++)
+	{
+		for (size_t i = 0; i < seriesNum; i++)
+		{
+			if ((*itc).first == _series [i])
+			{
+				_seriesResults [i].dataTypes		= (*itc).second;
+				_seriesResults [i].dataTypesKnown	= true;
+				break;
+			}	// if ((*itc).first == _series [i])
+		}	// for (size_t i = 0; i < seriesNum; i++)
+	}	// for (vector< pair<AbstractQualifSerie*, size_t> >::const_iterator ...
+}	// QtQualifWidget::storeWarmUpResults
+
+
+void QtQualifWidget::stopWarmUp ( )
+{
+	_warmUp.cancel ( );
+	storeWarmUpResults ( );
+
+	// Les séries non préparées :
+	const size_t	seriesNum	= _series.size ( );
+	for (size_t i = 0; i < seriesNum; i++)
+	{
+		if (true == _seriesResults [i].dataTypesKnown)
+			continue;
+		AbstractQualifSerie*	serie	= _series [i];
+		CHECK_NULL_PTR_ERROR (serie)
+		_seriesResults [i].dataTypes		=
+					2 > serie->getDimension ( ) ? 0 : serie->getDataTypes ( );
+		_seriesResults [i].dataTypesKnown	= true;
+	}	// for (size_t i = 0; i < seriesNum; i++)
+	updateSeriesTypes ( );
+}	// QtQualifWidget::stopWarmUp
 
 
 void QtQualifWidget::removeSeries (bool clearHistogram)
@@ -385,16 +535,25 @@ void QtQualifWidget::removeSeries (bool clearHistogram)
 	if (0 == seriesNum)
 		return;	// Surtout ne rien faire, Qwt a horreur du vide.
 
+	_warmUp.cancel ( );
+	_warmUp.takeCompleted ( );
 	for (size_t i = 0; i < seriesNum; i++)
 		delete _series [i];
 	_series.clear ( );
+	_seriesResults.clear ( );
+	_seriesTypes	= _requestedTypes	= 0;
 	_dataTypesList->clear ( );
+	_histogramCriterion	= (Qualif::Critere)-1;
+	_classesValues.clear ( );
 
-	if (false == clearHistogram)
-		return;
+	if (true == clearHistogram)
+		displayEmptyHistogram ( );
+}	// QtQualifWidget::removeSeries
 
+
+void QtQualifWidget::displayEmptyHistogram ( )
+{
 	// ========================================================================
-	// Ici on a donc true == clearHistogram.
 	// Le widget ne doit pas être en cours de destruction sinon plantage
 	// prochain dans Qwt.
 	// ========================================================================
@@ -412,12 +571,12 @@ void QtQualifWidget::removeSeries (bool clearHistogram)
 	serie0.push_back (0.);
 	seriesValues.push_back (serie0);
 	getHistogramPanel ( ).setSeries (seriesNames, classValues, seriesValues);
-}	// QtQualifWidget::removeSeries
+}	// QtQualifWidget::displayEmptyHistogram
 
 
 static void computeXDomain (
 			double& min, double& max, double& interval, double& cnRatio,
-			bool& autoScale, unsigned char classNum)
+			bool& autoScale, size_t classNum)
 {	// Si min et ou max invalide => problèmes, et Qwt aura du mal.
 	// Si min = -inf et max = +inf alors max - min est hors domaine ...
 	if (false == NumericServices::isValidAndNotMax (min))
@@ -442,26 +601,80 @@ static void computeXDomain (
 
 void QtQualifWidget::updateHistogram ( )
 {
-	assert (0 != _applyButton && "QtQualifWidget::updateHistogram : null apply button.");
-	assert (0 != _userDefinedRadioButton && "QtQualifWidget::updateHistogram : null user defined button.");
+	computeHistogram (false);
+}	// QtQualifWidget::updateHistogram
+
+
+void QtQualifWidget::invalidateResults (size_t i)
+{
+	const size_t	seriesNum	= _seriesResults.size ( );
+	for (size_t j = 0; j < seriesNum; j++)
+	{
+		if (((size_t)-1 != i) && (i != j))
+			continue;
+		// Les types de mailles sont conservés, la série est de nouveau
+		// préparée :
+		SerieResults	results;
+		results.dataTypes		= _seriesResults [j].dataTypes;
+		results.dataTypesKnown	= _seriesResults [j].dataTypesKnown;
+		CHECK_NULL_PTR_ERROR (_series [j])
+		results.revision		= _series [j]->getRevision ( );
+		_seriesResults [j]		= results;
+		_warmUp.add (*_series [j]);
+	}	// for (size_t j = 0; j < seriesNum; j++)
+	_histogramCriterion	= (Qualif::Critere)-1;
+}	// QtQualifWidget::invalidateResults
+
+
+void QtQualifWidget::invalidateModifiedResults ( )
+{
+	const size_t	seriesNum	= _seriesResults.size ( );
+	for (size_t j = 0; j < seriesNum; j++)
+	{
+		CHECK_NULL_PTR_ERROR (_series [j])
+		if (_series [j]->getRevision ( ) != _seriesResults [j].revision)
+			invalidateResults (j);
+	}	// for (size_t j = 0; j < seriesNum; j++)
+}	// QtQualifWidget::invalidateModifiedResults
+
+
+void QtQualifWidget::computeHistogram (bool rebinning)
+{
+	assert (0 != _applyButton && "QtQualifWidget::computeHistogram : null apply button.");
+	assert (0 != _userDefinedRadioButton && "QtQualifWidget::computeHistogram : null user defined button.");
 	_applyButton->setEnabled (false);
 
 	BEGIN_TRY_CATCH_BLOCK
 
 	QtAutoWaitingCursor				cursor (true);
 
-	// Faut il préalablement évaluer les coordonnées des noeuds ?
+	// Les résultats des séries modifiées depuis leur analyse sont obsolètes,
+	// et les séries ne doivent plus être utilisées en tâche de fond :
+	invalidateModifiedResults ( );
+	stopWarmUp ( );
+
+	// Instrumentation : on ne conserve que le temps de chargement.
+	const double	loadingTime	= _profile.getTime (QualifProfile::LOADING);
+	_profile.reset ( );
+	_profile.addTime (QualifProfile::LOADING, loadingTime);
+
+	// Faut il préalablement évaluer les coordonnées des noeuds ? (déjà
+	// fait lors du calcul complet en cas de répartition à partir du cache, et
+	// pour les séries déjà analysées)
 	size_t			i	= 0;
 	const size_t	seriesNum	= _series.size ( );
-	if (true == coordinatesEvaluation ( ))
+	if ((false == rebinning) && (true == coordinatesEvaluation ( )))
 	{
 		for (i = 0; i < seriesNum; i++)
 		{
 			AbstractQualifSerie*	serie	= _series [i];
 			CHECK_NULL_PTR_ERROR (serie)
+			if (true == _seriesResults [i].coordinatesValidated)
+				continue;
 			try
 			{
 				serie->validateCoordinates ( );
+				_seriesResults [i].coordinatesValidated	= true;
 			}
 			catch (const Exception& exc)
 			{
@@ -471,17 +684,13 @@ void QtQualifWidget::updateHistogram ( )
 				throw (Exception (message));
 			}
 		}	// for (i = 0; i < seriesNum; i++)
-	}	// if (true == coordinatesEvaluation ( ))
+	}	// if ((false == rebinning) && (true == coordinatesEvaluation ( )))
 
 	// Récupération des paramètres de présentation, application à l'histogramme,
 	// et on refait les classes.
-	QwtHistogramChartPanel&	histogramPanel		= getHistogramPanel ( );
 	const Critere					criterion	= getCriterion ( );
-	const unsigned char				classNum	= getClassesNum ( );
+	const size_t					classNum	= getClassesNum ( );
 	const size_t					cellTypes	= getQualifiedTypes ( );
-	const size_t					maxHeight	= false==isAutomaticHeight ( ) ?
-												  getMaxHeight ( ) : 1;
-	QList<QwtText>					seriesNames;
 	double							min	= 0., max	= 1., interval	= max - min;
 
 	if (0 == cellTypes)
@@ -491,7 +700,13 @@ void QtQualifWidget::updateHistogram ( )
 	// Si domaine calculé, on prend le domaine théorique, puis on récupère
 	// min et max calculés et on refait le classement.
 	if (true == _computedRadioButton->isChecked ( ))
-		getDataRange (min, max);
+	{	// Répartition à partir du cache : domaine du dernier calcul complet
+		// s'il a été calculé.
+		if ((false == rebinning) || (_dataMin > _dataMax))
+			getDataRange (_dataMin, _dataMax);
+		min	= _dataMin;
+		max	= _dataMax;
+	}	// if (true == _computedRadioButton->isChecked ( ))
 	else if (true == _theoreticalRadioButton->isChecked ( ))
 		QualifHelper::getDomain (criterion, cellTypes, min, max);
 	else
@@ -506,71 +721,174 @@ void QtQualifWidget::updateHistogram ( )
 	computeXDomain (min, max, interval, cnRatio, autoScale, classNum);
 	// Rem CP : attention, on peut avoir des problèmes d'arrondis ci-dessous
 	// type setText (min + epsilon) => le passage en mode manuel peut réserver
-	// des surprises.
-	_minTextField->setText (QString::number (min));
-	_maxTextField->setText (QString::number (max));
+	// des surprises. Saisie manuelle en cours de répartition à partir du
+	// cache : on ne la réécrit pas.
+	if ((false == rebinning) || (false == _userDefinedRadioButton->isChecked ( )))
+	{
+		_minTextField->setText (QString::number (min));
+		_maxTextField->setText (QString::number (max));
+	}	// if ((false == rebinning) || ...
 	if ((false == autoScale) && (true == _theoreticalRadioButton->isChecked( )))
 	{
 		_theoreticalRadioButton->setChecked (false);
 		_userDefinedRadioButton->setChecked (true);
 		_minTextField->setEnabled (true);
 		_maxTextField->setEnabled (true);
-		updateHistogram ( );
+		computeHistogram (rebinning);
 		return;
 	}
-	for (i = 0; i < seriesNum; i++)
-	{
-		AbstractQualifSerie*	serie	= _series [i];
-		CHECK_NULL_PTR_ERROR (serie)
-		seriesNames.append (QwtText (serie->getName ( ).c_str ( )));
-	}	// for (i = 0; i < seriesNum; i++)
 
 	// Version 0.20.0 : mode strict possible, on ne considère que les mailles
 	// donc le critère est dans le domaine.
 	const bool	strictMode	=
 		(true == _userDefinedRadioButton->isChecked ( )) &&
 		(true == _strictDomainUsageCheckBox->isChecked ( )) ? true : false;
-	// Version 0.20.0 : exécution dans une tâche Qualif :
-	unique_ptr<QualifAnalysisTask>	task (createAnalysisTask (
-				cellTypes, criterion, classNum, min, max, strictMode, _series));
-	task->execute ( );
+	// Version 0.20.0 : exécution dans une tâche Qualif. Seules les séries
+	// dont les effectifs ne sont pas en cache pour ces paramètres sont
+	// analysées (ex : ajout d'une série).
+	vector<AbstractQualifSerie*>	series;
+	vector<size_t>					indexes;
+	for (i = 0; i < seriesNum; i++)
+	{
+		if (false == _seriesResults [i].matches (
+							criterion, cellTypes, classNum, min, max, strictMode))
+		{
+			series.push_back (_series [i]);
+			indexes.push_back (i);
+		}
+	}	// for (i = 0; i < seriesNum; i++)
+	if (false == series.empty ( ))
+	{
+		unique_ptr<QualifAnalysisTask>	task (true == rebinning ?
+			createRebinningTask (
+					cellTypes, criterion, classNum, min, max, strictMode, series) :
+			createAnalysisTask (
+					cellTypes, criterion, classNum, min, max, strictMode, series));
+		task->execute ( );
+		_profile.merge (task->getProfile ( ));
+		const vector< vector<size_t> >&	values	= task->getSeriesValues ( );
+		for (size_t s = 0; s < indexes.size ( ); s++)
+		{
+			SerieResults&	results	= _seriesResults [indexes [s]];
+			results.criterion	= criterion;
+			results.types		= cellTypes;
+			results.min			= min;
+			results.max			= max;
+			results.strict		= strictMode;
+			results.classes.resize (classNum);
+			for (size_t cl = 0; cl < classNum; cl++)
+				results.classes [cl]	= values [cl][s];
+		}	// for (size_t s = 0; s < indexes.size ( ); s++)
+	}	// if (false == series.empty ( ))
+	if (false == rebinning)
+	{	// Pour les répartitions ultérieures à partir du cache :
+		_histogramCriterion	= criterion;
+		_histogramTypes		= cellTypes;
+		if (false == _computedRadioButton->isChecked ( ))
+		{
+			_dataMin	= 1.;
+			_dataMax	= 0.;
+		}	// if (false == _computedRadioButton->isChecked ( ))
+	}	// if (false == rebinning)
+
+	// Les séries de l'histogramme : les effectifs par classe sont conservés,
+	// et regroupés pour l'affichage selon sa résolution.
+	QualifPhaseTimer				renderingTimer (
+										_profile, QualifProfile::RENDERING);
+	QualifTraceScope				renderingScope (
+			QualifProfile::phaseName (QualifProfile::RENDERING), "phase");
+	_classesValues.assign (classNum, vector<size_t> (seriesNum, 0));
+	for (i = 0; i < seriesNum; i++)
+		for (size_t cl = 0; cl < classNum; cl++)
+			_classesValues [cl][i]	= _seriesResults [i].classes [cl];
+	_histogramMin		= min;
+	_histogramMax		= max;
+	_classesWidth		= interval;
+	_histogramAutoScale	= autoScale;
+	displayHistogram ( );
+	renderingScope.stop ( );
+	renderingTimer.stop ( );
+
+	COMPLETE_TRY_CATCH_BLOCK
+
+	_applyButton->setEnabled (true);
+	emit histogramUpdated ( );
+}	// QtQualifWidget::computeHistogram
+
 
-	// Les séries de l'histogramme :
+void QtQualifWidget::displayHistogram ( )
+{
+	const size_t	classNum	= _classesValues.size ( );
+	const size_t	seriesNum	= _series.size ( );
+	if ((0 == classNum) || (0 == seriesNum))
+		return;	// Qwt a horreur du vide.
+	if (seriesNum != _classesValues [0].size ( ))
+		return;	// Séries ajoutées depuis le dernier calcul.
+
+	QwtHistogramChartPanel&	histogramPanel	= getHistogramPanel ( );
+	const size_t			maxHeight		= false==isAutomaticHeight ( ) ?
+											  getMaxHeight ( ) : 1;
+	const size_t			groupSize		= getDisplayedGroupSize ( );
+	const size_t			displayedNum	=
+								(classNum + groupSize - 1) / groupSize;
+	QList<QwtText>					seriesNames;
 	QVector<double>					classValues;
 	QVector< QVector <double> >		seriesValues;
-	seriesValues.resize (classNum);
-    const vector< vector <size_t> >&	values	= task->getSeriesValues ( );
-	for (i = 0; i < classNum; i++)
-	{
-		const double	classValue	= min + interval / 2. + i * interval;
-//		classValues.push_back (min + i * interval);
-		classValues.push_back (classValue);	// v 1.3.0
-		seriesValues [i].resize (seriesNum);
-		for (size_t j = 0; j < seriesNum; j++)
-			seriesValues [i][j]	= (double)values [i][j];
-	}
-	// Cas particulier : VALIDITY, le critère vaut 0 ou 1.
-	if ((VALIDITY == criterion) && (2 == classNum))
+	for (size_t j = 0; j < seriesNum; j++)
+	{
+		AbstractQualifSerie*	serie	= _series [j];
+		CHECK_NULL_PTR_ERROR (serie)
+		seriesNames.append (QwtText (serie->getName ( ).c_str ( )));
+	}	// for (size_t j = 0; j < seriesNum; j++)
+	seriesValues.resize (displayedNum);
+	for (size_t i = 0; i < displayedNum; i++)
+	{	// Classes [first, last[ regroupées :
+		const size_t	first	= i * groupSize;
+		const size_t	last	= first + groupSize < classNum ?
+								  first + groupSize : classNum;
+		classValues.push_back (_histogramMin + (first + last) * _classesWidth / 2.);
+		seriesValues [i].fill (0., (int)seriesNum);
+		for (size_t cl = first; cl < last; cl++)
+			for (size_t j = 0; j < seriesNum; j++)
+				seriesValues [i][j]	+= (double)_classesValues [cl][j];
+	}	// for (size_t i = 0; i < displayedNum; i++)
+	// Cas particulier : VALIDITY, le critère vaut 0 ou 1. Les 2 classes
+	// peuvent être regroupées en une barre (panneau non encore dimensionné,
+	// au moins autant de séries que de pixels, ...) :
+	if ((VALIDITY == _histogramCriterion) && (2 == classNum) &&
+	    (2 == displayedNum))
 	{
 		classValues [0]	= 0.;
 		classValues [1]	= 1.;
-	}	// if ((VALIDITY == criterion) && (2 == classNum))
-	getHistogramPanel ( ).setSeries (seriesNames, classValues, seriesValues);
+	}	// if ((VALIDITY == _histogramCriterion) && (2 == classNum) && ...
+	histogramPanel.setSeries (seriesNames, classValues, seriesValues);
 
 	// Redéfinition des axes : après setSeries of course :
-	double	xTickStep	= histogramPanel.getAbscissaStep ( );
 	double	yTickStep	= histogramPanel.getOrdinateStep ( );
-
-	xTickStep	= interval;
-	histogramPanel.setAbscissaScale (min, max, autoScale, xTickStep);
+	histogramPanel.setAbscissaScale (_histogramMin, _histogramMax,
+	                          _histogramAutoScale, _classesWidth * groupSize);
 	histogramPanel.setOrdinateScale (
 						 0, maxHeight, isAutomaticHeight ( ), yTickStep);
 	histogramPanel.dataModified ( );
+	_displayedGroupSize	= groupSize;
+}	// QtQualifWidget::displayHistogram
 
-	COMPLETE_TRY_CATCH_BLOCK
 
-	_applyButton->setEnabled (true);
-}	// QtQualifWidget::updateHistogram
+void QtQualifWidget::resizeEvent (QResizeEvent* event)
+{
+	QWidget::resizeEvent (event);
+
+	try
+	{
+		if ((false == _classesValues.empty ( )) &&
+		    (getDisplayedGroupSize ( ) != _displayedGroupSize))
+			displayHistogram ( );
+	}
+	catch (...)
+	{	// Ex : hauteur maximale en cours de saisie, l'affichage sera
+		// actualisé au prochain calcul.
+	}
+}	// QtQualifWidget::resizeEvent
 
 
 Qualif::Critere QtQualifWidget::getCriterion ( ) const
@@ -604,11 +922,42 @@ double QtQualifWidget::getDomainMaxValue ( ) const
 
 void QtQualifWidget::getDataRange (double& min, double& max)
 {
+	invalidateModifiedResults ( );
+	stopWarmUp ( );
 	const size_t			cellTypes	= getQualifiedTypes ( );
 	const Qualif::Critere		criterion	= getCriterion ( );
-	unique_ptr<QualifRangeTask>	task (createRangeTask (cellTypes, criterion, _series));
-	task->execute ( );
-	task->getRange (min, max);
+	const size_t			seriesNum	= _series.size ( );
+	// Seuls les extrema non en cache sont calculés :
+	vector<AbstractQualifSerie*>	series;
+	vector<size_t>					indexes;
+	for (size_t i = 0; i < seriesNum; i++)
+	{
+		if ((criterion != _seriesResults [i].rangeCriterion) ||
+		    (cellTypes != _seriesResults [i].rangeTypes))
+		{
+			series.push_back (_series [i]);
+			indexes.push_back (i);
+		}
+	}	// for (size_t i = 0; i < seriesNum; i++)
+	if (false == series.empty ( ))
+	{
+		unique_ptr<QualifRangeTask>	task (createRangeTask (cellTypes, criterion, series));
+		task->execute ( );
+		_profile.merge (task->getProfile ( ));
+		for (size_t s = 0; s < indexes.size ( ); s++)
+		{
+			SerieResults&	results	= _seriesResults [indexes [s]];
+			task->getSerieRange (s, results.rangeMin, results.rangeMax);
+			results.rangeCriterion	= criterion;
+			results.rangeTypes		= cellTypes;
+		}	// for (size_t s = 0; s < indexes.size ( ); s++)
+	}	// if (false == series.empty ( ))
+
+	vector< pair<double, double> >	ranges;
+	for (size_t i = 0; i < seriesNum; i++)
+		ranges.push_back (pair<double, double> (
+						_seriesResults [i].rangeMin, _seriesResults [i].rangeMax));
+	QualifRangeTask::mergeRanges (ranges, min, max);
 }	// QtQualifWidget::getDataRange
 
 
@@ -619,24 +968,44 @@ bool QtQualifWidget::useStrictDomain ( ) const
 }	// QtQualifWidget::useStrictDomain
 
 
-unsigned char QtQualifWidget::getClassesNum ( ) const
+size_t QtQualifWidget::getClassesNum ( ) const
 {
 	assert ((0 != _barNumTextField) && "QtQualifWidget::getClassesNum : null textfield.");
 	if (true == _barNumTextField->text ( ).isEmpty ( ))
 		throw Exception (UTF8String ("Absence de nombre de classes saisi.", charset));
 
 	bool	ok	= true;
-	return (unsigned char)(_barNumTextField->text ( ).toULong (&ok));
+	return (size_t)(_barNumTextField->text ( ).toULong (&ok));
 }	// QtQualifWidget::getClassesNum
 
 
-unsigned char QtQualifWidget::getSeriesNum ( ) const
+const vector< vector<size_t> >& QtQualifWidget::getClassesValues ( ) const
+{
+	return _classesValues;
+}	// QtQualifWidget::getClassesValues
+
+
+size_t QtQualifWidget::getDisplayedGroupSize ( ) const
+{
+	// Au moins un pixel par barre, chaque classe affichée ayant une barre
+	// par série :
+	const size_t	classNum	= _classesValues.size ( );
+	const size_t	seriesNum	= 0 == _series.size ( ) ? 1 : _series.size ( );
+	const int		width		= getHistogramPanel ( ).width ( );
+	const size_t	bars		= 0 < width ? (size_t)width / seriesNum : 0;
+	const size_t	displayed	= 0 == bars ? 1 : bars;
+
+	return classNum <= displayed ? 1 : (classNum + displayed - 1) / displayed;
+}	// QtQualifWidget::getDisplayedGroupSize
+
+
+size_t QtQualifWidget::getSeriesNum ( ) const
 {
 	return _series.size ( );
 }	// QtQualifWidget::getSeriesNum
 
 
-const AbstractQualifSerie& QtQualifWidget::getSerie (unsigned char i) const
+const AbstractQualifSerie& QtQualifWidget::getSerie (size_t i) const
 {
 	if (i >= _series.size ( ))
 	{
@@ -652,7 +1021,7 @@ const AbstractQualifSerie& QtQualifWidget::getSerie (unsigned char i) const
 }	// QtQualifWidget::getSerie
 
 
-AbstractQualifSerie& QtQualifWidget::getSerie (unsigned char i)
+AbstractQualifSerie& QtQualifWidget::getSerie (size_t i)
 {
 	if (i >= _series.size ( ))
 	{
@@ -727,6 +1096,8 @@ void QtQualifWidget::selectQualifiedTypes (size_t types)
 									  false : true;
 		item->setSelected (select);
 	}	// for (int i = 0; i < itemCount; i++)
+	// Types non encore recensés (séries en cours de préparation) :
+	_requestedTypes	= types & ~_seriesTypes;
 }	// QtQualifWidget::selectQualifiedTypes
 
 
@@ -778,12 +1149,7 @@ void QtQualifWidget::setDomainType (QtQualifWidget::DOMAIN_TYPE type)
 
 
 static void addToMap (map<size_t, size_t>& dataTypes, size_t type, size_t dim)
-{
-	for (map<size_t, size_t>::const_iterator it = dataTypes.begin ( );
-	     dataTypes.end ( ) != it; it++)
-		if (type == (*it).first)
-			return;
-
+{	// Sans effet si le type est déjà répertorié :
 	dataTypes.insert (pair<size_t, size_t>(type, dim));
 }	// addToMap
 
@@ -792,28 +1158,21 @@ map<size_t, size_t> QtQualifWidget::getDataTypes ( )
 {
 	map<size_t, size_t>	dataTypes;
 
-	const size_t	seriesNum	= _series.size ( );
-	for (size_t j = 0; j < seriesNum; j++)
-	{
-		AbstractQualifSerie*	serie	= _series [j];
-		CHECK_NULL_PTR_ERROR (serie)
-
-		if (2 > serie->getDimension ( ))
-			continue;
-		size_t	serieTypes	= serie->getDataTypes ( );
-		if (0 != (serieTypes & QualifHelper::TRIANGLE))
-			addToMap (dataTypes, QualifHelper::TRIANGLE, 2);
-		if (0 != (serieTypes & QualifHelper::QUADRANGLE))
-			addToMap (dataTypes, QualifHelper::QUADRANGLE, 2);
-		if (0 != (serieTypes & QualifHelper::TETRAEDRON))
-			addToMap (dataTypes, QualifHelper::TETRAEDRON, 3);
-		if (0 != (serieTypes & QualifHelper::PYRAMID))
-			addToMap (dataTypes, QualifHelper::PYRAMID, 3);
-		if (0 != (serieTypes & QualifHelper::HEXAEDRON))
-			addToMap (dataTypes, QualifHelper::HEXAEDRON, 3);
-		if (0 != (serieTypes & QualifHelper::TRIANGULAR_PRISM))
-			addToMap (dataTypes, QualifHelper::TRIANGULAR_PRISM, 3);
-	}	// for (size_t j = 0; j < seriesNum; j++)
+	// Types recensés (séries de dimension au moins 2), la préparation de
+	// certaines séries pouvant être en cours :
+	const size_t	serieTypes	= _seriesTypes;
+	if (0 != (serieTypes & QualifHelper::TRIANGLE))
+		addToMap (dataTypes, QualifHelper::TRIANGLE, 2);
+	if (0 != (serieTypes & QualifHelper::QUADRANGLE))
+		addToMap (dataTypes, QualifHelper::QUADRANGLE, 2);
+	if (0 != (serieTypes & QualifHelper::TETRAEDRON))
+		addToMap (dataTypes, QualifHelper::TETRAEDRON, 3);
+	if (0 != (serieTypes & QualifHelper::PYRAMID))
+		addToMap (dataTypes, QualifHelper::PYRAMID, 3);
+	if (0 != (serieTypes & QualifHelper::HEXAEDRON))
+		addToMap (dataTypes, QualifHelper::HEXAEDRON, 3);
+	if (0 != (serieTypes & QualifHelper::TRIANGULAR_PRISM))
+		addToMap (dataTypes, QualifHelper::TRIANGULAR_PRISM, 3);
 
 	return dataTypes;
 }	// QtQualifWidget::getDataTypes
@@ -826,6 +1185,18 @@ QHBoxLayout& QtQualifWidget::getButtonsLayout ( )
 }	// QtQualifWidget::getButtonsLayout
 
 
+const QualifProfile& QtQualifWidget::getProfile ( ) const
+{
+	return _profile;
+}	// QtQualifWidget::getProfile
+
+
+QualifProfile& QtQualifWidget::getProfile ( )
+{
+	return _profile;
+}	// QtQualifWidget::getProfile
+
+
 string QtQualifWidget::getAppTitle ( ) const
 {
 	return _appTitle;
@@ -848,12 +1219,25 @@ QualifRangeTask* QtQualifWidget::createRangeTask (
 QualifAnalysisTask* QtQualifWidget::createAnalysisTask (
 	size_t types, Critere criterion, size_t classNum, double min, double max,
 	bool strict, const vector<AbstractQualifSerie*>& series)
-{
+{	// Groupes d'un même maillage : mailles partagées évaluées une fois.
+	if (true == QualifSharedCellsTask::isApplicable (series))
+		return new QualifSharedCellsTask (
+						types, criterion, classNum, min, max, strict, series);
+
 	return new QualifAnalysisTask (
 						types, criterion, classNum, min, max, strict, series);
 }	// QtQualifWidget::createAnalysisTask
 
 
+QualifAnalysisTask* QtQualifWidget::createRebinningTask (
+	size_t types, Critere criterion, size_t classNum, double min, double max,
+	bool strict, const vector<AbstractQualifSerie*>& series)
+{
+	return new QualifRebinningTask (
+						types, criterion, classNum, min, max, strict, series);
+}	// QtQualifWidget::createRebinningTask
+
+
 void QtQualifWidget::updateDomainCallback ( )
 {
 	assert (0 != _theoreticalRadioButton);
@@ -936,6 +1320,7 @@ void QtQualifWidget::updateSelectableTypesCallback ( )
 	BEGIN_TRY_CATCH_BLOCK
 
 	Critere		criterion	= getCriterion ( );
+	_warmUp.setCriterion (criterion);
 	const int	itemCount	= _dataTypesList->count ( );
 	for (int i = 0; i < itemCount; i++)
 	{
@@ -970,6 +1355,7 @@ void QtQualifWidget::computeCallback ( )
 {
 	BEGIN_TRY_CATCH_BLOCK
 
+	stopWarmUp ( );
 	if ((getCriterion ( ) != _criterion) && (true == shouldReleaseData ( )))
 	{
 		const size_t	seriesNum	= _series.size ( );
@@ -980,6 +1366,11 @@ void QtQualifWidget::computeCallback ( )
 			serie->releaseStoredData ( );
 		}	// for (size_t j = 0; j < seriesNum; j++)
 	}	// if ((getCriterion ( ) != _criterion) && ...
+	else
+	{	// Libération des données utilisées le moins récemment selon le
+		// budget mémoire :
+		AbstractQualifSerie::applyMemoryBudget (_series, getCriterion ( ));
+	}	// else if ((getCriterion ( ) != _criterion) && ...
 	_criterion	= getCriterion ( );
 
 	updateHistogram ( );
@@ -988,5 +1379,52 @@ void QtQualifWidget::computeCallback ( )
 }	// QtQualifWidget::computeCallback
 
 
+void QtQualifWidget::warmUpCallback ( )
+{
+	BEGIN_TRY_CATCH_BLOCK
+
+	storeWarmUpResults ( );
+	updateSeriesTypes ( );
+
+	COMPLETE_TRY_CATCH_BLOCK
+}	// QtQualifWidget::warmUpCallback
+
+
+void QtQualifWidget::rebinCallback ( )
+{
+	assert (0 != _barNumTextField);
+	assert (0 != _minTextField);
+	assert (0 != _maxTextField);
+	assert (0 != _userDefinedRadioButton);
+
+	// Saisie incomplète, série modifiée depuis son analyse, ou histogramme
+	// non calculé pour le critère et les types courants, ou valeurs non en
+	// cache : on attend "Calculer".
+	try
+	{
+		invalidateModifiedResults ( );
+		if ((true == _series.empty ( )) || (false == _warmUp.isIdle ( )) ||
+		    (false == _barNumTextField->hasAcceptableInput ( )) ||
+		    (0 == getClassesNum ( )) ||
+		    (getCriterion ( ) != _histogramCriterion) ||
+		    (getQualifiedTypes ( ) != _histogramTypes) ||
+		    (false == QualifRebinningTask::isApplicable (
+											_histogramCriterion, _series)))
+			return;
+		if ((true == _userDefinedRadioButton->isChecked ( )) &&
+		    ((false == _minTextField->hasAcceptableInput ( )) ||
+		     (false == _maxTextField->hasAcceptableInput ( )) ||
+		     (getDomainMinValue ( ) >= getDomainMaxValue ( ))))
+			return;
+	}
+	catch (...)
+	{
+		return;
+	}
+
+	computeHistogram (true);
+}	// QtQualifWidget::rebinCallback
+
+
 }	// namespace GQualif
 
@@ -1,6 +1,7 @@
 #include "QtQualif/QtQualityDividerWidget.h"
 #include "GQualif/QualifHelper.h"
 #include "GQualif/QualifAnalysisTask.h"
+#include "GQualif/QualifSharedCellsTask.h"
 #include "GQualif/QCalQualThread.h"
 
 #include <QtUtil/QtAutoWaitingCursor.h>
@@ -100,12 +101,12 @@ class QtQualifDataTypeItem : public QListWidgetItem
 
 QtQualityDividerWidget::QtQualityDividerWidget (QWidget* parent, const string& appTitle)
 	: QWidget (parent),
-	  _appTitle (appTitle), _series ( ),
+	  _appTitle (appTitle), _series ( ), _seriesDataTypes ( ), _seriesTypes (0), _requestedTypes (0),
 	  _minTextField (0), _maxTextField (0), _domainLabel (0),
 	  _criterionComboBox (0), _dataTypesList (0), _seriesExtractionsTableWidget (),
 	  _coordinatesCheckBox (0), _releaseDataCheckBox (0),
 	  _buttonsLayout (0), _optionsLayout (0), _applyButton (0),
-	  _criterion ((Qualif::Critere)-1)
+	  _criterion ((Qualif::Critere)-1), _warmUp ( )
 {
 	QVBoxLayout*	mainLayout	= new QVBoxLayout (this);
 	mainLayout->setSizeConstraint (QLayout::SetMinimumSize);
@@ -153,6 +154,7 @@ QtQualityDividerWidget::QtQualityDividerWidget (QWidget* parent, const string& a
 	_criterionComboBox->setToolTip (QSTR ("Critère de qualité à appliquer."));
 	connect (_criterionComboBox, SIGNAL(activated (int)), this, SLOT (updateSelectableTypesCallback ( )));
 	connect (_criterionComboBox, SIGNAL(activated (int)), this, SLOT (updateDomainCallback ( )));
+	_warmUp.setCriterion (getCriterion ( ));
 	hboxLayout->addStretch (10.);
 
 	// 3-ème ligne : les extractions de séries
@@ -195,7 +197,7 @@ QtQualityDividerWidget::QtQualityDividerWidget (QWidget* parent, const string& a
 	_optionsLayout->addWidget (_releaseDataCheckBox);	
 	_releaseDataCheckBox->setFixedSize (_releaseDataCheckBox->sizeHint ( ));
 	_releaseDataCheckBox->setChecked (true);
-	_releaseDataCheckBox->setToolTip (QSTR ("Activé, libère la mémoire utilisée en cache à chaque changement de critère."));
+	_releaseDataCheckBox->setToolTip (QSTR ("Activé, libère la mémoire utilisée en cache à chaque changement de critère. Désactivé, les données en cache utilisées le moins récemment sont libérées selon le budget mémoire."));
 	hboxLayout->addStretch (10.);
 	_optionsLayout->addStretch (10.);
 
@@ -210,6 +212,10 @@ QtQualityDividerWidget::QtQualityDividerWidget (QWidget* parent, const string& a
 	_buttonsLayout->addStretch (10.);
 	setFocusPolicy (Qt::StrongFocus);
 
+	// Préparation des séries en tâche de fond : le signal est émis par le thread de préparation.
+	connect (this, SIGNAL (serieWarmedUp ( )), this, SLOT (warmUpCallback ( )), Qt::QueuedConnection);
+	_warmUp.setCompletionCallback ([this] ( ) { emit serieWarmedUp ( ); });
+
 	layout ( );
 	
 	// Affichage d'un domaine possible :
@@ -219,12 +225,12 @@ QtQualityDividerWidget::QtQualityDividerWidget (QWidget* parent, const string& a
 
 QtQualityDividerWidget::QtQualityDividerWidget (const QtQualityDividerWidget&)
 	: QWidget (0),
-	  _appTitle ("Invalid application"), _series ( ),
+	  _appTitle ("Invalid application"), _series ( ), _seriesDataTypes ( ), _seriesTypes (0), _requestedTypes (0),
 	  _minTextField (0), _maxTextField (0), _domainLabel (0),
 	  _criterionComboBox (0), _dataTypesList (0), _seriesExtractionsTableWidget (0),
 	  _coordinatesCheckBox (0), _releaseDataCheckBox (0),
 	  _buttonsLayout (0), _optionsLayout (0), _applyButton (0),
-	  _criterion ((Qualif::Critere)-1)
+	  _criterion ((Qualif::Critere)-1), _warmUp ( )
 {
 	assert (0 && "QtQualityDividerWidget copy constructor is not allowed.");
 }	// QtQualityDividerWidget::QtQualityDividerWidget
@@ -253,18 +259,14 @@ void QtQualityDividerWidget::addSerie (AbstractQualifSerie* serie)
 	}	// if (0 == serie)
 
 	_series.push_back (serie);
+	_seriesDataTypes.push_back ((size_t)-1);
 
-	_dataTypesList->clear ( );
-	map<size_t, size_t>	types	= getDataTypes ( );
-	for (map<size_t, size_t>::iterator itt = types.begin ( ); types.end ( ) != itt; itt++)
-	{
-		QtQualifDataTypeItem*	item	= new QtQualifDataTypeItem (_dataTypesList, (*itt).first, (*itt).second);
-		bool	selectable	= QualifHelper::isTypeSupported ((*itt).first);
-		item->setFlags (true == selectable ? Qt::ItemIsSelectable | Qt::ItemIsEnabled : Qt::NoItemFlags);
-		if ((true == selectable) && (1 == types.size ( )))
-			item->setSelected (true);
-	}	// for (map<size_t, size_t>::iterator itt ...
-	_dataTypesList->setFixedSize (_dataTypesList->sizeHint ( ));
+	// Préparation en tâche de fond, les types de mailles de la série étant recensés à son terme (warmUpCallback). A défaut (série non
+	// threadable) ils le sont ici.
+	if (true == _warmUp.add (*serie))
+		return;
+	_seriesDataTypes.back ( )	= 2 > serie->getDimension ( ) ? 0 : serie->getDataTypes ( );
+	updateSeriesTypes ( );
 }	// QtQualityDividerWidget::addSerie
 
 
@@ -275,13 +277,36 @@ void QtQualityDividerWidget::removeSeries (bool clear)
 	if (0 == seriesNum)
 		return;	// Surtout ne rien faire, Qwt a horreur du vide.
 
+	_warmUp.cancel ( );
+	_warmUp.takeCompleted ( );
 	for (size_t i = 0; i < seriesNum; i++)
 		delete _series [i];
 	_series.clear ( );
+	_seriesDataTypes.clear ( );
+	_seriesTypes	= _requestedTypes	= 0;
 	_dataTypesList->clear ( );
 }	// QtQualityDividerWidget::removeSeries
 
 
+void QtQualityDividerWidget::stopWarmUp ( )
+{
+	_warmUp.cancel ( );
+	storeWarmUpResults ( );
+
+	// Les séries non préparées :
+	const size_t	seriesNum	= _series.size ( );
+	for (size_t i = 0; i < seriesNum; i++)
+	{
+		if ((size_t)-1 != _seriesDataTypes [i])
+			continue;
+		AbstractQualifSerie*	serie	= _series [i];
+		CHECK_NULL_PTR_ERROR (serie)
+		_seriesDataTypes [i]	= 2 > serie->getDimension ( ) ? 0 : serie->getDataTypes ( );
+	}	// for (size_t i = 0; i < seriesNum; i++)
+	updateSeriesTypes ( );
+}	// QtQualityDividerWidget::stopWarmUp
+
+
 void QtQualityDividerWidget::compute ( )
 {
 	assert (0 != _seriesExtractionsTableWidget);
@@ -292,6 +317,9 @@ void QtQualityDividerWidget::compute ( )
 
 	QtAutoWaitingCursor				cursor (true);
 
+	// Les séries ne doivent plus être utilisées en tâche de fond :
+	stopWarmUp ( );
+
 	// Faut il préalablement évaluer les coordonnées des noeuds ?
 	size_t			i	= 0;
 	const size_t	seriesNum	= _series.size ( );
@@ -380,13 +408,13 @@ double QtQualityDividerWidget::getDomainMaxValue ( ) const
 }   // QtQualityDividerWidget::getDomainMaxValue
 
 
-unsigned char QtQualityDividerWidget::getSeriesNum ( ) const
+size_t QtQualityDividerWidget::getSeriesNum ( ) const
 {
 	return _series.size ( );
 }	// QtQualityDividerWidget::getSeriesNum
 
 
-const AbstractQualifSerie& QtQualityDividerWidget::getSerie (unsigned char i) const
+const AbstractQualifSerie& QtQualityDividerWidget::getSerie (size_t i) const
 {
 	if (i >= _series.size ( ))
 	{
@@ -399,7 +427,7 @@ const AbstractQualifSerie& QtQualityDividerWidget::getSerie (unsigned char i) co
 }	// QtQualityDividerWidget::getSerie
 
 
-AbstractQualifSerie& QtQualityDividerWidget::getSerie (unsigned char i)
+AbstractQualifSerie& QtQualityDividerWidget::getSerie (size_t i)
 {
 	if (i >= _series.size ( ))
 	{
@@ -412,17 +440,17 @@ AbstractQualifSerie& QtQualityDividerWidget::getSerie (unsigned char i)
 }	// QtQualityDividerWidget::getSerie
 
 
-vector<unsigned char> QtQualityDividerWidget::getSelectedSeries ( ) const
+vector<size_t> QtQualityDividerWidget::getSelectedSeries ( ) const
 {
 	assert (0 != _seriesExtractionsTableWidget);
-	vector<unsigned char>	series;
+	vector<size_t>	series;
 	
-	for (unsigned char i = 0; i < _seriesExtractionsTableWidget->rowCount ( ); i++)
+	for (int i = 0; i < _seriesExtractionsTableWidget->rowCount ( ); i++)
 	{
 		QTableWidgetItem*	item	= _seriesExtractionsTableWidget->item (i, 0);
 		if ((0 != item) && (true == item->isSelected ( )))
 			series.push_back (i);
-	}	// for (unsigned char i = 0; i < _seriesExtractionsTableWidget->rowCount ( ); i++)
+	}	// for (int i = 0; i < _seriesExtractionsTableWidget->rowCount ( ); i++)
 	
 	return series;
 }	// QtQualityDividerWidget::getSelectedSeries
@@ -466,6 +494,8 @@ void QtQualityDividerWidget::selectQualifiedTypes (size_t types)
 		bool					select	= 0 == (types & item->getDataType ( )) ? false : true;
 		item->setSelected (select);
 	}	// for (int i = 0; i < itemCount; i++)
+	// Types non encore recensés (séries en cours de préparation) :
+	_requestedTypes	= types & ~_seriesTypes;
 }	// QtQualityDividerWidget::selectQualifiedTypes
 
 
@@ -484,12 +514,7 @@ bool QtQualityDividerWidget::shouldReleaseData ( ) const
 
 
 static void addToMap (map<size_t, size_t>& dataTypes, size_t type, size_t dim)
-{
-	for (map<size_t, size_t>::const_iterator it = dataTypes.begin ( );
-	     dataTypes.end ( ) != it; it++)
-		if (type == (*it).first)
-			return;
-
+{	// Sans effet si le type est déjà répertorié :
 	dataTypes.insert (pair<size_t, size_t>(type, dim));
 }	// addToMap
 
@@ -498,28 +523,20 @@ map<size_t, size_t> QtQualityDividerWidget::getDataTypes ( )
 {
 	map<size_t, size_t>	dataTypes;
 
-	const size_t	seriesNum	= _series.size ( );
-	for (size_t j = 0; j < seriesNum; j++)
-	{
-		AbstractQualifSerie*	serie	= _series [j];
-		CHECK_NULL_PTR_ERROR (serie)
-
-		if (2 > serie->getDimension ( ))
-			continue;
-		size_t	serieTypes	= serie->getDataTypes ( );
-		if (0 != (serieTypes & QualifHelper::TRIANGLE))
-			addToMap (dataTypes, QualifHelper::TRIANGLE, 2);
-		if (0 != (serieTypes & QualifHelper::QUADRANGLE))
-			addToMap (dataTypes, QualifHelper::QUADRANGLE, 2);
-		if (0 != (serieTypes & QualifHelper::TETRAEDRON))
-			addToMap (dataTypes, QualifHelper::TETRAEDRON, 3);
-		if (0 != (serieTypes & QualifHelper::PYRAMID))
-			addToMap (dataTypes, QualifHelper::PYRAMID, 3);
-		if (0 != (serieTypes & QualifHelper::HEXAEDRON))
-			addToMap (dataTypes, QualifHelper::HEXAEDRON, 3);
-		if (0 != (serieTypes & QualifHelper::TRIANGULAR_PRISM))
-			addToMap (dataTypes, QualifHelper::TRIANGULAR_PRISM, 3);
-	}	// for (size_t j = 0; j < seriesNum; j++)
+	// Types recensés (séries de dimension au moins 2), la préparation de certaines séries pouvant être en cours :
+	const size_t	serieTypes	= _seriesTypes;
+	if (0 != (serieTypes & QualifHelper::TRIANGLE))
+		addToMap (dataTypes, QualifHelper::TRIANGLE, 2);
+	if (0 != (serieTypes & QualifHelper::QUADRANGLE))
+		addToMap (dataTypes, QualifHelper::QUADRANGLE, 2);
+	if (0 != (serieTypes & QualifHelper::TETRAEDRON))
+		addToMap (dataTypes, QualifHelper::TETRAEDRON, 3);
+	if (0 != (serieTypes & QualifHelper::PYRAMID))
+		addToMap (dataTypes, QualifHelper::PYRAMID, 3);
+	if (0 != (serieTypes & QualifHelper::HEXAEDRON))
+		addToMap (dataTypes, QualifHelper::HEXAEDRON, 3);
+	if (0 != (serieTypes & QualifHelper::TRIANGULAR_PRISM))
+		addToMap (dataTypes, QualifHelper::TRIANGULAR_PRISM, 3);
 
 	return dataTypes;
 }	// QtQualityDividerWidget::getDataTypes
@@ -554,9 +571,9 @@ static bool isChecked (QTableWidgetItem& item)
 void QtQualityDividerWidget::displaySelectedExtractions (bool display)
 {
 	assert (0 != _seriesExtractionsTableWidget);
-	const vector<unsigned char>	selection	= getSelectedSeries ( );
+	const vector<size_t>	selection	= getSelectedSeries ( );
 	
-	for (vector<unsigned char>::const_iterator it = selection.begin ( ); selection.end ( ) != it; it++)
+	for (vector<size_t>::const_iterator it = selection.begin ( ); selection.end ( ) != it; it++)
 	{
 		QTableWidgetItem*	item	= _seriesExtractionsTableWidget->item (*it, 0);
 		if ((0 != item) && (true == item->isSelected ( )) && (display != isChecked (*item)))
@@ -564,7 +581,7 @@ void QtQualityDividerWidget::displaySelectedExtractions (bool display)
 			item->setCheckState (true == display ? Qt::Checked : Qt::Unchecked);
 			displayExtraction (*it, display);
 		}	// if ((0 != item) && (display != item->isSelected ( )))
-	}	// for (vector<unsigned char>::const_iterator it = selection.begin ( ); selection.end ( ) != it; it++)
+	}	// for (vector<size_t>::const_iterator it = selection.begin ( ); selection.end ( ) != it; it++)
 }	// QtQualityDividerWidget::displaySelectedExtractions
 
 	
@@ -580,6 +597,54 @@ void QtQualityDividerWidget::displayErrorMessage (const UTF8String& msg)
 }	// QtQualityDividerWidget::displayErrorMessage
 
 
+void QtQualityDividerWidget::updateSeriesTypes ( )
+{
+	assert (0 != _dataTypesList && "QtQualityDividerWidget::updateSeriesTypes : null data list widget.");
+	// La liste des types n'est reconstruite que si les types sont modifiés :
+	size_t	seriesTypes	= 0;
+	for (vector<size_t>::const_iterator itt = _seriesDataTypes.begin ( ); _seriesDataTypes.end ( ) != itt; itt++)
+		seriesTypes	|= (size_t)-1 == *itt ? 0 : *itt;
+	if (seriesTypes == _seriesTypes)
+		return;
+
+	const size_t	selectedTypes	= getQualifiedTypes ( ) | _requestedTypes;
+	const size_t	requestedTypes	= _requestedTypes;
+	_seriesTypes	= seriesTypes;
+	_dataTypesList->clear ( );
+	map<size_t, size_t>	types	= getDataTypes ( );
+	for (map<size_t, size_t>::iterator itt = types.begin ( ); types.end ( ) != itt; itt++)
+	{
+		QtQualifDataTypeItem*	item	= new QtQualifDataTypeItem (_dataTypesList, (*itt).first, (*itt).second);
+		bool	selectable	= QualifHelper::isTypeSupported ((*itt).first);
+		item->setFlags (true == selectable ? Qt::ItemIsSelectable | Qt::ItemIsEnabled : Qt::NoItemFlags);
+		if ((true == selectable) && (1 == types.size ( )))
+			item->setSelected (true);
+	}	// for (map<size_t, size_t>::iterator itt ...
+	_dataTypesList->setFixedSize (_dataTypesList->sizeHint ( ));
+	if (0 != (selectedTypes & seriesTypes))
+		selectQualifiedTypes (selectedTypes & seriesTypes);
+	_requestedTypes	= requestedTypes & ~seriesTypes;
+}	// QtQualityDividerWidget::updateSeriesTypes
+
+
+void QtQualityDividerWidget::storeWarmUpResults ( )
+{
+	const vector< pair<AbstractQualifSerie*, size_t> >	completed	= _warmUp.takeCompleted ( );
+	const size_t										seriesNum	= _series.size ( );
+	for (vector< pair<AbstractQualifSerie*, size_t> >::const_iterator itc = completed.begin ( ); completed.end ( ) != itc; itc++)
+	{
+		for (size_t i = 0; i < seriesNum; i++)
+		{
+			if ((*itc).first == _series [i])
+			{
+				_seriesDataTypes [i]	= (*itc).second;
+				break;
+			}	// if ((*itc).first == _series [i])
+		}	// for (size_t i = 0; i < seriesNum; i++)
+	}	// for (vector< pair<AbstractQualifSerie*, size_t> >::const_iterator itc = ...
+}	// QtQualityDividerWidget::storeWarmUpResults
+
+
 QualifRangeTask* QtQualityDividerWidget::createRangeTask (size_t types, Critere criterion, const vector<AbstractQualifSerie*>& series)
 {
 	return new QualifRangeTask (types, criterion, series);
@@ -588,6 +653,9 @@ QualifRangeTask* QtQualityDividerWidget::createRangeTask (size_t types, Critere
 
 QualifAnalysisTask* QtQualityDividerWidget::createAnalysisTask (size_t types, Critere criterion, double min, double max, const vector<AbstractQualifSerie*>& series)
 {
+	if (true == QualifSharedCellsTask::isApplicable (series))
+		return new QualifSharedCellsTask (types, criterion, 1, min, max, true, series);
+
 	return new QualifAnalysisTask (types, criterion, 1, min, max, true, series);
 }	// QtQualityDividerWidget::createAnalysisTask
 
@@ -628,6 +696,7 @@ void QtQualityDividerWidget::updateSelectableTypesCallback ( )
 
 	_domainLabel->setText ("Domaine : [, ]");
 	Critere		criterion	= getCriterion ( );
+	_warmUp.setCriterion (criterion);
 	const int	itemCount	= _dataTypesList->count ( );
 	for (int i = 0; i < itemCount; i++)
 	{
@@ -677,6 +746,7 @@ void QtQualityDividerWidget::computeCallback ( )
 {
 	BEGIN_TRY_CATCH_BLOCK
 
+	stopWarmUp ( );
 	if ((getCriterion ( ) != _criterion) && (true == shouldReleaseData ( )))
 	{
 		const size_t	seriesNum	= _series.size ( );
@@ -687,6 +757,11 @@ void QtQualityDividerWidget::computeCallback ( )
 			serie->releaseStoredData ( );
 		}	// for (size_t j = 0; j < seriesNum; j++)
 	}	// if ((getCriterion ( ) != _criterion) && ...
+	else
+	{	// Libération des données utilisées le moins récemment selon le
+		// budget mémoire :
+		AbstractQualifSerie::applyMemoryBudget (_series, getCriterion ( ));
+	}	// else if ((getCriterion ( ) != _criterion) && ...
 	_criterion	= getCriterion ( );
 
 	compute ( );
@@ -695,5 +770,16 @@ void QtQualityDividerWidget::computeCallback ( )
 }	// QtQualityDividerWidget::computeCallback
 
 
+void QtQualityDividerWidget::warmUpCallback ( )
+{
+	BEGIN_TRY_CATCH_BLOCK
+
+	storeWarmUpResults ( );
+	updateSeriesTypes ( );
+
+	COMPLETE_TRY_CATCH_BLOCK
+}	// QtQualityDividerWidget::warmUpCallback
+
+
 }	// namespace GQualif
 
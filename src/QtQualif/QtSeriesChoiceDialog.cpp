@@ -43,6 +43,13 @@ class QtGroupItem : public QListWidgetItem
 		setText (UTF8TOQSTRING (str));
 	}
 
+	QtGroupItem (const QualifGroupMetadata& metadata, QListWidget* parent)
+		: QListWidgetItem (QString ( ), parent),
+		  _name (metadata.name), _dimension (metadata.dimension)
+	{
+		setText (UTF8TOQSTRING (metadata.getDescription ( )));
+	}
+
 	virtual ~QtGroupItem ( )
 	{ }
 
@@ -81,6 +88,48 @@ QtSeriesChoiceDialog::QtSeriesChoiceDialog (
 					QWidget* parent, const string& appTitle,
 					const vector <pair <string, unsigned char> >& groups)
 	: QDialog (parent), _groupsList (0)
+{
+	createGui ( );
+	for (vector <pair <string, unsigned char> >::const_iterator it =
+			groups.begin ( ); groups.end ( ) != it; it++)
+		_groupsList->addItem (
+			new QtGroupItem ((*it).first.c_str ( ), _groupsList, (*it).second));
+}	// QtSeriesChoiceDialog::QtSeriesChoiceDialog
+
+
+QtSeriesChoiceDialog::QtSeriesChoiceDialog (
+					QWidget* parent, const string& appTitle,
+					const vector <QualifGroupMetadata>& groups)
+	: QDialog (parent), _groupsList (0)
+{
+	createGui ( );
+	for (vector <QualifGroupMetadata>::const_iterator it = groups.begin ( );
+	     groups.end ( ) != it; it++)
+		_groupsList->addItem (new QtGroupItem (*it, _groupsList));
+}	// QtSeriesChoiceDialog::QtSeriesChoiceDialog
+
+
+QtSeriesChoiceDialog::QtSeriesChoiceDialog (const QtSeriesChoiceDialog&)
+	: QDialog (0), _groupsList ( )
+{
+	assert (0 && "QtSeriesChoiceDialog copy constructor is not allowed.");
+}	// QtSeriesChoiceDialog::QtSeriesChoiceDialog
+
+
+QtSeriesChoiceDialog& QtSeriesChoiceDialog::operator = (
+												const QtSeriesChoiceDialog&)
+{
+	assert (0 && "QtSeriesChoiceDialog assignment operator is not allowed.");
+	return *this;
+}	// QtSeriesChoiceDialog::operator =
+
+
+QtSeriesChoiceDialog::~QtSeriesChoiceDialog ( )
+{
+}	// QtSeriesChoiceDialog::~QtSeriesChoiceDialog
+
+
+void QtSeriesChoiceDialog::createGui ( )
 {
 	QVBoxLayout*	mainLayout	= new QVBoxLayout (this);
 	mainLayout->setSizeConstraint (QLayout::SetMinimumSize);
@@ -95,10 +144,6 @@ QtSeriesChoiceDialog::QtSeriesChoiceDialog (
 	QAbstractItemModel*	dataTypeModel	= _groupsList->model ( );
 	dataTypeModel->setHeaderData (
 						0, Qt::Horizontal, QVariant(QSTR ("Groupes de mailles")));
-	for (vector <pair <string, unsigned char> >::const_iterator it =
-			groups.begin ( ); groups.end ( ) != it; it++)
-		_groupsList->addItem (
-			new QtGroupItem ((*it).first.c_str ( ), _groupsList, (*it).second));
 	QFrame*	separator	= new QFrame (this);
 	separator->setFrameStyle (QFrame::HLine);
 	mainLayout->addWidget (separator);
@@ -112,27 +157,7 @@ QtSeriesChoiceDialog::QtSeriesChoiceDialog (
 	hlayout->addWidget (cancelButton);
 	connect (cancelButton, SIGNAL(clicked ( )), this, SLOT(reject ( )));
 	hlayout->addStretch (10.);
-}	// QtSeriesChoiceDialog::QtSeriesChoiceDialog
-
-
-QtSeriesChoiceDialog::QtSeriesChoiceDialog (const QtSeriesChoiceDialog&)
-	: QDialog (0), _groupsList ( )
-{
-	assert (0 && "QtSeriesChoiceDialog copy constructor is not allowed.");
-}	// QtSeriesChoiceDialog::QtSeriesChoiceDialog
-
-
-QtSeriesChoiceDialog& QtSeriesChoiceDialog::operator = (
-												const QtSeriesChoiceDialog&)
-{
-	assert (0 && "QtSeriesChoiceDialog assignment operator is not allowed.");
-	return *this;
-}	// QtSeriesChoiceDialog::operator =
-
-
-QtSeriesChoiceDialog::~QtSeriesChoiceDialog ( )
-{
-}	// QtSeriesChoiceDialog::~QtSeriesChoiceDialog
+}	// QtSeriesChoiceDialog::createGui
 
 
 vector <pair <string, unsigned char> > QtSeriesChoiceDialog::getGroups ( ) const
@@ -3,6 +3,7 @@
 
 #include "GQualif/QualifAnalysisTask.h"
 #include "GQualif/QualifRangeTask.h"
+#include "GQualif/QualifSerieWarmUp.h"
 
 #include <QwtCharts/QwtHistogramChartPanel.h>
 #include <QtUtil/QtGroupBox.h>
@@ -39,6 +40,13 @@ namespace GQualif
  * <I>ThreadManager::initialize</I> ait été préalablement appelé.
  * </P>
  *
+ * <P>Les séries ajoutées sont préparées en tâche de fond
+ * (<I>QualifSerieWarmUp</I> : types de mailles, coordonnées, critère
+ * courant), la liste des types de mailles étant complétée au fil de leur
+ * préparation. Celle-ci est interrompue avant tout calcul
+ * (<I>stopWarmUp</I>).
+ * </P>
+ *
  * @see		AbstractQualifSerie
  */
 class QtQualifWidget : public QWidget
@@ -52,6 +60,11 @@ class QtQualifWidget : public QWidget
 	 */
 	enum DOMAIN_TYPE { THEORETICAL_DOMAIN,COMPUTED_DOMAIN,USER_DEFINED_DOMAIN };
 
+	/**
+	 * Le nombre maximal de classes saisissable.
+	 */
+	static const size_t		maxClassesNum;
+
 	/**
 	 * Constructeur.
 	 * @param		Widget parent.
@@ -73,10 +86,26 @@ class QtQualifWidget : public QWidget
 	/**
 	 * Ajoute la série transmise en argument à l'histogramme.
 	 * Cette série est adoptée et donc détruite à la destruction du widget.
+	 * Sa préparation (recensement des types de mailles, évaluation des
+	 * coordonnées et du critère courant) est effectuée en tâche de fond.
+	 * Au prochain calcul de l'histogramme, seules les séries dont les
+	 * résultats ne sont pas en cache pour les paramètres courants sont
+	 * analysées.
+	 * @see			removeSerie
 	 * @see			removeSeries
+	 * @see			invalidateResults
 	 */
 	virtual void addSerie (AbstractQualifSerie* serie);
 
+	/**
+	 * Retire de l'histogramme et détruit (operateur <I>delete</I>) la
+	 * <I>i-ème</I> série. Sa colonne est retirée de l'histogramme affiché,
+	 * sans nouvelle analyse des autres séries.
+	 * @exception	Une exception est levée si l'indice est invalide.
+	 * @see			addSerie
+	 */
+	virtual void removeSerie (size_t i);
+
 	/**
  	 * Détruit (operateur <I>delete</I>) toutes les séries de l'histogramme.
  	 * @param		Si clearHistogram vaut <I>true</I> l'histogramme sera
@@ -92,9 +121,37 @@ class QtQualifWidget : public QWidget
 	/**
 	 * Actualise l'histogramme conformément aux paramètres renseignés dans
 	 * l'IHM.
+	 * @see			computeHistogram
 	 */
 	virtual void updateHistogram ( );
 
+	/**
+	 * Oublie les résultats d'analyse (effectifs par classe, extrema) en
+	 * cache de la <I>i-ème</I> série, ou de toutes les séries si <I>i</I>
+	 * vaut <I>(size_t)-1</I>. Effectué avant chaque calcul pour les séries
+	 * modifiées depuis leur analyse (cf.
+	 * <I>AbstractQualifSerie::getRevision</I> : coordonnées, pas de temps,
+	 * ...).
+	 * @see			invalidateModifiedResults
+	 */
+	virtual void invalidateResults (size_t i = (size_t)-1);
+
+	/**
+	 * Oublie les résultats d'analyse en cache des séries modifiées depuis
+	 * leur analyse (<I>AbstractQualifSerie::getRevision</I>).
+	 * @see			invalidateResults
+	 */
+	virtual void invalidateModifiedResults ( );
+
+	/**
+	 * Interrompt la préparation en tâche de fond des séries ajoutées, après
+	 * celle de la série en cours de préparation, et recense les types de
+	 * mailles des séries non préparées. Les séries ne sont alors plus
+	 * utilisées par un autre thread.
+	 * @see			addSerie
+	 */
+	virtual void stopWarmUp ( );
+
 	/**
 	 * @return		Le critère <I>Qualif</I> appliqué pour l'analyse.
 	 */
@@ -118,7 +175,9 @@ class QtQualifWidget : public QWidget
 
 	/**
 	 * @return		Les valeurs extremales (calculées à partir des séries)
-	 * 				du domaine d'échantillonnage.
+	 * 				du domaine d'échantillonnage. Les extrema de chaque série
+	 * 				sont conservés pour les critère et types de mailles
+	 * 				courants, seuls ceux des nouvelles séries sont calculés.
 	 * @see			getDomainMinValue
 	 * @see			getDomainMaxValue
 	 * @see			useStrictDomain
@@ -137,21 +196,42 @@ class QtQualifWidget : public QWidget
 
 	/**
 	 * @return		Le nombre d'échantillons à créer.
+	 * @see			maxClassesNum
 	 */
-	virtual unsigned char getClassesNum ( ) const;
+	virtual size_t getClassesNum ( ) const;
+
+	/**
+	 * @return		Les effectifs exacts par classe du dernier calcul de
+	 * 				l'histogramme, avant regroupement pour l'affichage.
+	 * Utilisation : getClassesValues ( ) [cl][s], cl : classe, s : série.
+	 * @see			getDisplayedGroupSize
+	 */
+	virtual const std::vector< std::vector<size_t> >& getClassesValues ( ) const;
+
+	/**
+	 * @return		Le nombre de classes consécutives regroupées en une barre
+	 * 				de l'histogramme affiché (niveau de détail), de sorte que
+	 * 				chaque barre dispose d'au moins un pixel.
+	 * @see			getClassesValues
+	 */
+	virtual size_t getDisplayedGroupSize ( ) const;
 
 	/**
 	 * @return		Le nombre de séries analysées.
 	 * @see			getSerie
 	 */
-	virtual unsigned char getSeriesNum ( ) const;
+	virtual size_t getSeriesNum ( ) const;
 
 	/**
 	 * @return		La <I>i-ème</I> série prise en charge.
+	 * @warning		La série est susceptible d'être en cours de préparation
+	 * 				en tâche de fond : appeler au préalable <I>stopWarmUp</I>
+	 * 				pour l'utiliser.
 	 * @see			getSeriesNum
+	 * @see			stopWarmUp
 	 */
-	virtual const AbstractQualifSerie& getSerie (unsigned char i) const;
-	virtual AbstractQualifSerie& getSerie (unsigned char i);
+	virtual const AbstractQualifSerie& getSerie (size_t i) const;
+	virtual AbstractQualifSerie& getSerie (size_t i);
 
 	/**
 	 * @return		true si la hauteur maximale est automatique, ou false
@@ -174,7 +254,9 @@ class QtQualifWidget : public QWidget
     virtual size_t getQualifiedTypes ( ) const;
 
 	/**
-	 * @param		Types de données à sélectionner.
+	 * @param		Types de données à sélectionner. Les types des séries en
+	 * 				cours de préparation seront sélectionnés au terme de
+	 * 				celle-ci.
 	 * @see			getQualifiedTypes
 	 */
 	virtual void selectQualifiedTypes (size_t types);
@@ -223,6 +305,31 @@ class QtQualifWidget : public QWidget
 	 */
 	virtual QHBoxLayout& getButtonsLayout ( );
 
+	/**
+	 * @return		L'instrumentation du dernier calcul de l'histogramme
+	 * 				(tâches <I>Qualif</I> et affichage). Le temps de
+	 * 				chargement (<I>QualifProfile::LOADING</I>), renseigné par
+	 * 				l'application, est conservé d'un calcul à l'autre.
+	 * @see			histogramUpdated
+	 */
+	virtual const QualifProfile& getProfile ( ) const;
+	virtual QualifProfile& getProfile ( );
+
+
+	signals :
+
+	/**
+	 * Emis au terme de chaque calcul de l'histogramme.
+	 */
+	void histogramUpdated ( );
+
+	/**
+	 * Emis <U>par le thread de préparation</U> au terme de la préparation
+	 * d'une série ajoutée.
+	 * @see			warmUpCallback
+	 */
+	void serieWarmedUp ( );
+
 
 	protected :
 
@@ -265,12 +372,69 @@ class QtQualifWidget : public QWidget
 	 * 				dont le critère est hors-domaine, <I>false</I> dans le cas
 	 * 				contraire.
 	 * @param		Les séries soumises à l'analyse <I>Qualif</I>.
+	 * @see			QualifSharedCellsTask
 	 */
 	virtual GQualif::QualifAnalysisTask* createAnalysisTask (
 				size_t types, Qualif::Critere criterion, size_t classNum,
 				double min, double max, bool strict,
 				const std::vector<AbstractQualifSerie*>& series);
 
+	/**
+	 * Créé une tâche <I>Qualif</I> de répartition des mailles en classes à
+	 * partir des valeurs en cache du critère. Cette tâche est à détruire par
+	 * la fonction appelante. Arguments : cf. <I>createAnalysisTask</I>.
+	 * @see			QualifRebinningTask
+	 */
+	virtual GQualif::QualifAnalysisTask* createRebinningTask (
+				size_t types, Qualif::Critere criterion, size_t classNum,
+				double min, double max, bool strict,
+				const std::vector<AbstractQualifSerie*>& series);
+
+	/**
+	 * Actualise l'histogramme conformément aux paramètres renseignés dans
+	 * l'IHM.
+	 * @param		<I>true</I> si seuls le nombre de classes et/ou le domaine
+	 * 				ont changé depuis le dernier calcul, les mailles étant
+	 * 				alors réparties à partir des valeurs en cache
+	 * 				(<I>createRebinningTask</I>), le domaine calculé étant
+	 * 				celui du dernier calcul. <I>false</I> pour une analyse
+	 * 				complète (<I>createAnalysisTask</I>).
+	 */
+	virtual void computeHistogram (bool rebinning);
+
+	/**
+	 * Affiche les effectifs par classe du dernier calcul, regroupés selon
+	 * <I>getDisplayedGroupSize</I>.
+	 */
+	virtual void displayHistogram ( );
+
+	/**
+	 * Affiche un histogramme vide (absence de série).
+	 */
+	virtual void displayEmptyHistogram ( );
+
+	/**
+	 * Reconstruit la liste des types de mailles des séries.
+	 */
+	virtual void updateDataTypesList ( );
+
+	/**
+	 * Actualise les types de mailles des séries, et la liste des types si
+	 * elle est modifiée, la sélection étant conservée.
+	 */
+	virtual void updateSeriesTypes ( );
+
+	/**
+	 * Recueille les types de mailles des séries préparées en tâche de fond.
+	 */
+	virtual void storeWarmUpResults ( );
+
+	/**
+	 * Actualise l'affichage de l'histogramme si le regroupement des classes
+	 * change.
+	 */
+	virtual void resizeEvent (QResizeEvent* event);
+
 
 	protected slots :
 
@@ -302,6 +466,21 @@ class QtQualifWidget : public QWidget
 	 */
 	virtual void computeCallback ( );
 
+	/**
+	 * Appelé lorsque le nombre de classes, le domaine ou son caractère strict
+	 * sont modifiés. Si l'histogramme a été calculé pour le critère et les
+	 * types de mailles courants et que les valeurs du critère sont en cache
+	 * pour toutes les séries, l'actualise instantanément à partir de ces
+	 * valeurs. Ne fait rien dans le cas contraire.
+	 */
+	virtual void rebinCallback ( );
+
+	/**
+	 * Appelé au terme de la préparation d'une série. Complète la liste des
+	 * types de mailles.
+	 */
+	virtual void warmUpCallback ( );
+
 
 	private :
 
@@ -311,6 +490,59 @@ class QtQualifWidget : public QWidget
 	QtQualifWidget (const QtQualifWidget&);
 	QtQualifWidget& operator = (const QtQualifWidget&);
 
+	/**
+	 * Les résultats d'analyse d'une série, conservés tant que les paramètres
+	 * de l'analyse sont inchangés.
+	 */
+	struct SerieResults
+	{
+		SerieResults ( )
+			: dataTypes (0), dataTypesKnown (false), revision (0),
+			  coordinatesValidated (false),
+			  criterion ((Qualif::Critere)-1), types (0), min (0.), max (0.),
+			  strict (false), classes ( ),
+			  rangeCriterion ((Qualif::Critere)-1), rangeTypes (0),
+			  rangeMin (0.), rangeMax (0.)
+		{ }
+
+		/**
+		 * @return		<I>true</I> si les effectifs par classe sont ceux de
+		 * 				l'analyse dont les paramètres sont transmis en
+		 * 				argument.
+		 */
+		bool matches (Qualif::Critere crit, size_t cellTypes, size_t classNum,
+		              double mn, double mx, bool strictMode) const
+		{
+			return (crit == criterion) && (cellTypes == types) &&
+			       (classNum == classes.size ( )) && (mn == min) &&
+			       (mx == max) && (strictMode == strict);
+		}
+
+		/** Les types de mailles de la série, s'ils sont connus (préparation
+		 * en tâche de fond). */
+		size_t								dataTypes;
+		bool								dataTypesKnown;
+
+		/** Le numéro de révision de la série lorsque ces résultats ont été
+		 * initialisés (<I>AbstractQualifSerie::getRevision</I>). */
+		size_t								revision;
+
+		/** Les coordonnées des noeuds ont elles été évaluées ? */
+		bool								coordinatesValidated;
+
+		/** Les paramètres de l'analyse et les effectifs par classe. */
+		Qualif::Critere						criterion;
+		size_t								types;
+		double								min, max;
+		bool								strict;
+		std::vector<size_t>					classes;
+
+		/** Les extrema du critère (cf. <I>QualifRangeTask</I>). */
+		Qualif::Critere						rangeCriterion;
+		size_t								rangeTypes;
+		double								rangeMin, rangeMax;
+	};	// struct SerieResults
+
 	/** Le widget affichant l'histogramme. */
 	QwtHistogramChartPanel*					_histogramPanel;
 
@@ -320,6 +552,16 @@ class QtQualifWidget : public QWidget
 	/** Les séries prises en charge par le widget. */
 	IN_STD vector<AbstractQualifSerie*>		_series;
 
+	/** Les résultats d'analyse en cache des séries (même indexation que
+	 * <I>_series</I>). */
+	IN_STD vector<SerieResults>				_seriesResults;
+
+	/** Les types de mailles des séries prises en charge (la liste des types
+	 * n'est reconstruite que lorsqu'une série en apporte un nouveau), et
+	 * les types dont la sélection a été demandée (<I>selectQualifiedTypes</I>)
+	 * mais qui ne sont pas encore connus. */
+	size_t									_seriesTypes, _requestedTypes;
+
 	QRadioButton*							_theoreticalRadioButton;
 	QRadioButton*							_computedRadioButton;
 	QRadioButton*							_userDefinedRadioButton;
@@ -339,6 +581,26 @@ class QtQualifWidget : public QWidget
 
 	// Gestion des données en cache :
 	Qualif::Critere							_criterion;
+
+	/** Le critère, les types de mailles et le domaine calculé du dernier
+	 * calcul complet de l'histogramme (cf. <I>rebinCallback</I>). */
+	Qualif::Critere							_histogramCriterion;
+	size_t									_histogramTypes;
+	double									_dataMin, _dataMax;
+
+	/** Les effectifs par classe du dernier calcul, son domaine, la largeur
+	 * des classes, et le regroupement des classes affiché. */
+	std::vector< std::vector<size_t> >		_classesValues;
+	double									_histogramMin, _histogramMax,
+											_classesWidth;
+	bool									_histogramAutoScale;
+	size_t									_displayedGroupSize;
+
+	/** L'instrumentation du dernier calcul. */
+	QualifProfile							_profile;
+
+	/** La préparation en tâche de fond des séries ajoutées. */
+	QualifSerieWarmUp						_warmUp;
 };	// class QtQualifWidget
 
 }	// namespace GQualif
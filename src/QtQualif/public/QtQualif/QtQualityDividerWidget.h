@@ -3,6 +3,7 @@
 
 #include "GQualif/QualifAnalysisTask.h"
 #include "GQualif/QualifRangeTask.h"
+#include "GQualif/QualifSerieWarmUp.h"
 
 #include <QtUtil/QtGroupBox.h>
 #include <QtUtil/QtTextField.h>
@@ -32,6 +33,10 @@ namespace GQualif
  * <I>ThreadManager::initialize</I> ait été préalablement appelé.
  * </P>
  *
+ * <P>Les séries recensées sont préparées en tâche de fond (<I>QualifSerieWarmUp</I> : types de mailles, coordonnées, critère courant), la liste
+ * des types de mailles étant complétée au fil de leur préparation. Celle-ci est interrompue avant tout calcul (<I>stopWarmUp</I>).
+ * </P>
+ *
  * @since	4.4.0
  * @see		AbstractQualifSerie
  */
@@ -56,7 +61,9 @@ class QtQualityDividerWidget : public QWidget
 	/**
 	 * Recense la série transmise en argument.
 	 * Cette série est adoptée et donc détruite à la destruction du widget.
+	 * Sa préparation (recensement des types de mailles, évaluation des coordonnées et du critère courant) est effectuée en tâche de fond.
 	 * @see			removeSeries
+	 * @see			stopWarmUp
 	 */
 	virtual void addSerie (AbstractQualifSerie* serie);
 
@@ -66,6 +73,13 @@ class QtQualityDividerWidget : public QWidget
  	 */
 	virtual void removeSeries (bool clear = false);
 
+	/**
+	 * Interrompt la préparation en tâche de fond des séries recensées, après celle de la série en cours de préparation, et recense les types
+	 * de mailles des séries non préparées. Les séries ne sont alors plus utilisées par un autre thread.
+	 * @see			addSerie
+	 */
+	virtual void stopWarmUp ( );
+
 	/**
 	 * Actualise les extractions conformément aux paramètres renseignés dans l'IHM.
 	 */
@@ -92,19 +106,21 @@ class QtQualityDividerWidget : public QWidget
 	 * @return		Le nombre de séries analysées.
 	 * @see			getSerie
 	 */
-	virtual unsigned char getSeriesNum ( ) const;
+	virtual size_t getSeriesNum ( ) const;
 
 	/**
 	 * @return		La <I>i-ème</I> série prise en charge.
+	 * @warning		La série est susceptible d'être en cours de préparation en tâche de fond : appeler au préalable <I>stopWarmUp</I> pour l'utiliser.
 	 * @see			getSeriesNum
+	 * @see			stopWarmUp
 	 */
-	virtual const AbstractQualifSerie& getSerie (unsigned char i) const;
-	virtual AbstractQualifSerie& getSerie (unsigned char i);
+	virtual const AbstractQualifSerie& getSerie (size_t i) const;
+	virtual AbstractQualifSerie& getSerie (size_t i);
 	
 	/**
 	 * @return		Les indices des séries sélectionnées.
 	 */
-	virtual IN_STD vector<unsigned char> getSelectedSeries ( ) const;
+	virtual IN_STD vector<size_t> getSelectedSeries ( ) const;
 
 	/**
 	 * @return		Les types de données à soumettre au traitement.
@@ -114,7 +130,7 @@ class QtQualityDividerWidget : public QWidget
     virtual size_t getQualifiedTypes ( ) const;
 
 	/**
-	 * @param		Types de données à sélectionner.
+	 * @param		Types de données à sélectionner. Les types des séries en cours de préparation seront sélectionnés au terme de celle-ci.
 	 * @see			getQualifiedTypes
 	 */
 	virtual void selectQualifiedTypes (size_t types);
@@ -162,6 +178,14 @@ class QtQualityDividerWidget : public QWidget
 	virtual QVBoxLayout& getOptionsLayout ( );
 
 
+	signals :
+
+	/**
+	 * Emis <U>par le thread de préparation</U> au terme de la préparation d'une série recensée.
+	 * @see			warmUpCallback
+	 */
+	void serieWarmedUp ( );
+
 
 	protected :
 
@@ -189,6 +213,16 @@ class QtQualityDividerWidget : public QWidget
 	 */
 	virtual void displayErrorMessage (const IN_UTIL UTF8String& msg);
 
+	/**
+	 * Actualise les types de mailles des séries, et la liste des types si elle est modifiée, la sélection étant conservée.
+	 */
+	virtual void updateSeriesTypes ( );
+
+	/**
+	 * Recueille les types de mailles des séries préparées en tâche de fond.
+	 */
+	virtual void storeWarmUpResults ( );
+
 	/**
 	 * Créé une tâche <I>Qualif</I> qui recueille les extrema pris par les mailles d'analyse de mailles de séries soumises à un critère de qualité.
 	 * Cette tâche est à détruire par la fonction appelante.
@@ -233,6 +267,11 @@ class QtQualityDividerWidget : public QWidget
 	 */
 	virtual void computeCallback ( );
 
+	/**
+	 * Appelé au terme de la préparation d'une série. Complète la liste des types de mailles.
+	 */
+	virtual void warmUpCallback ( );
+
 
 	private :
 
@@ -248,6 +287,13 @@ class QtQualityDividerWidget : public QWidget
 	/** Les séries prises en charge par le widget. */
 	IN_STD vector<AbstractQualifSerie*>		_series;
 
+	/** Les types de mailles de chaque série (<I>(size_t)-1</I> tant qu'ils ne sont pas recensés, cf. préparation en tâche de fond). */
+	IN_STD vector<size_t>					_seriesDataTypes;
+
+	/** Les types de mailles des séries prises en charge, et les types dont la sélection a été demandée (<I>selectQualifiedTypes</I>) mais
+	 * qui ne sont pas encore connus. */
+	size_t									_seriesTypes, _requestedTypes;
+
 	QtTextField*							_minTextField;
 	QtTextField*							_maxTextField;
 	QLabel*									_domainLabel;
@@ -265,6 +311,9 @@ class QtQualityDividerWidget : public QWidget
 	
 	// Les sous-ensembles extraits
 	QTableWidget*							_seriesExtractionsTableWidget;
+
+	// La préparation en tâche de fond des séries :
+	QualifSerieWarmUp						_warmUp;
 };	// class QtQualityDividerWidget
 
 }	// namespace GQualif
@@ -2,6 +2,7 @@
 #define QT_SERIES_CHOICE_DIALOG_H
 
 #include <TkUtil/util_config.h>
+#include "GQualif/QualifGroupMetadata.h"
 
 #include <QDialog>
 #include <QListWidget>
@@ -18,6 +19,11 @@ namespace GQualif
  * <P>Classe de boite de dialogue <I>Qt</I> permettant de sélectionner des
  * groupes de mailles à analyser.
  * </P>
+ *
+ * <P>Les groupes peuvent être décrits sommairement (nombre de mailles et
+ * répartition par type, cf. <I>QualifGroupMetadata</I>), ce qui permet de
+ * proposer le choix avant le chargement du maillage.
+ * </P>
  */
 class QtSeriesChoiceDialog : public QDialog
 {
@@ -33,6 +39,16 @@ class QtSeriesChoiceDialog : public QDialog
 			QWidget* parent, const IN_STD string& appTitle,
 			const IN_STD vector <IN_STD pair <IN_STD string, unsigned char> >& groups);
 
+	/**
+	 * Constructeur.
+	 * @param		Widget parent.
+	 * @param		Titre de l'application (pour les messages).
+	 * @param		Description sommaire des groupes de mailles proposés.
+	 */
+	QtSeriesChoiceDialog (
+			QWidget* parent, const IN_STD string& appTitle,
+			const IN_STD vector <QualifGroupMetadata>& groups);
+
 	/**
 	 * Destructeur. RAS.
 	 */
@@ -54,6 +70,11 @@ class QtSeriesChoiceDialog : public QDialog
 	QtSeriesChoiceDialog (const QtSeriesChoiceDialog&);
 	QtSeriesChoiceDialog& operator = (const QtSeriesChoiceDialog&);
 
+	/**
+	 * Création de l'IHM.
+	 */
+	void createGui ( );
+
 	/** La liste des couples nom de groupe de mailles/dimension. */
 	QListWidget*					_groupsList;
 };	// class QtSeriesChoiceDialog
@@ -1,17 +1,37 @@
 //
 // Petit programme de génération d'hexaèdres +- beaux
 //
+// Avec l'option -type il génère un maillage paramétrique de taille
+// quelconque (jusqu'à 10^9 mailles), de l'un des 6 types de mailles
+// supportés, avec perturbation aléatoire des noeuds et proportion de mailles
+// retournées contrôlées. Le tirage aléatoire est fonction de la graine et de
+// l'indice du noeud/de la maille : un même jeu d'options produit toujours le
+// même maillage, et les noeuds/mailles sont écrits au fil de l'eau, sans
+// stockage intermédiaire (formats VTK et brut).
+//
 
 #include <Lima/maillage.h>
 #include <Lima/maillage.h>
 #include <Lima/noeud.h>
+#include <Lima/surface.h>
+#include <Lima/polygone.h>
 #include <Lima/volume.h>
 #include <Lima/polyedre.h>
 #include <Lima/erreur.h>
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <vector>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 
 
 using namespace Lima;
@@ -24,6 +44,566 @@ static int parseArgs (int argc, char* argv []);
 static int syntax (const string& pgm);
 
 
+// ============================================================================
+//                     GENERATION DE MAILLAGES PARAMETRES
+// ============================================================================
+
+enum CELL_TYPE { CELL_TRIANGLE, CELL_QUADRANGLE, CELL_TETRAEDRON,
+                 CELL_PYRAMID, CELL_PRISM, CELL_HEXAEDRON };
+enum DISTRIBUTION { DIST_UNIFORM, DIST_NORMAL };
+enum FORMAT { FORMAT_DEFAULT, FORMAT_LIMA, FORMAT_VTK, FORMAT_RAW };
+
+static bool			parametric		= false;
+static CELL_TYPE	cellType		= CELL_HEXAEDRON;
+static uint64_t		ni = 10, nj = 10, nk = 10;
+static uint64_t		requestedCells	= 0;
+static bool			unstructured	= false;
+static DISTRIBUTION	distribution	= DIST_UNIFORM;
+static double		distortion		= 0.;
+static double		invertedRatio	= 0.;
+static uint64_t		seed			= 1;
+static FORMAT		outputFormat	= FORMAT_DEFAULT;
+
+
+/**
+ * Générateur pseudo-aléatoire sans état (<I>splitmix64</I>) : retourne un
+ * entier fonction de la graine, d'un flux et d'une clé (indice de noeud ou de
+ * maille). Permet un tirage reproductible et indépendant de l'ordre de
+ * parcours.
+ */
+static uint64_t randomBits (uint64_t stream, uint64_t key)
+{
+	uint64_t	z	= seed * 0x9E3779B97F4A7C15ULL + stream * 0xD1B54A32D192ED03ULL
+				  + key * 0xBF58476D1CE4E5B9ULL + 0x94D049BB133111EBULL;
+	z	= (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z	= (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}	// randomBits
+
+
+/** Tirage uniforme dans [0, 1[. */
+static double uniform (uint64_t stream, uint64_t key)
+{
+	return (randomBits (stream, key) >> 11) * (1. / 9007199254740992.);
+}	// uniform
+
+
+/**
+ * Permutation affine pseudo-aléatoire de [0, n[ : f -> (a.f + b) mod n,
+ * avec a premier avec n. Evite de stocker les permutations pour les très gros
+ * maillages.
+ */
+class Permutation
+{
+	public :
+
+	Permutation ( )
+		: _n (1), _a (1), _b (0), _inverse (1)
+	{ }
+
+	void initialize (uint64_t n, uint64_t stream)
+	{
+		_n	= 0 == n ? 1 : n;
+		_a	= 1;	_b	= 0;	_inverse	= 1;
+		if ((false == unstructured) || (_n < 3))
+			return;
+
+		_b	= randomBits (stream, 0) % _n;
+		for (uint64_t i = 1; ; i++)
+		{
+			_a	= randomBits (stream, i) % _n;
+			if ((1 < _a) && (1 == gcd (_a, _n)))
+				break;
+		}	// for (uint64_t i = 1; ; i++)
+		// Inverse de a modulo n (algorithme d'Euclide étendu) :
+		int64_t	r0 = (int64_t)_n, r1 = (int64_t)_a, t0 = 0, t1 = 1;
+		while (0 != r1)
+		{
+			const int64_t	q	= r0 / r1;
+			int64_t			tmp	= r0 - q * r1;
+			r0	= r1;	r1	= tmp;
+			tmp	= t0 - q * t1;
+			t0	= t1;	t1	= tmp;
+		}	// while (0 != r1)
+		_inverse	= (uint64_t)(t0 < 0 ? t0 + (int64_t)_n : t0);
+	}	// initialize
+
+	/** @return	L'indice d'origine de l'élément écrit en position f. */
+	uint64_t original (uint64_t f) const
+	{ return (uint64_t)(((unsigned __int128)_a * f + _b) % _n); }
+
+	/** @return	La position d'écriture de l'élément d'indice d'origine o. */
+	uint64_t position (uint64_t o) const
+	{ return (uint64_t)(((unsigned __int128)((o + _n - _b) % _n) * _inverse) % _n); }
+
+
+	private :
+
+	static uint64_t gcd (uint64_t a, uint64_t b)
+	{
+		while (0 != b)
+		{
+			const uint64_t	r	= a % b;
+			a	= b;	b	= r;
+		}	// while (0 != b)
+
+		return a;
+	}	// gcd
+
+	uint64_t	_n, _a, _b, _inverse;
+};	// class Permutation
+
+
+/**
+ * Maillage paramétré : grille de ni x nj x nk hexaèdres (ni x nj quadrangles
+ * en 2D), éventuellement découpés en mailles d'autres types, aux noeuds
+ * perturbés. En mode non structuré noeuds et mailles sont renumérotés
+ * aléatoirement (perte de localité des données, comme pour un maillage
+ * non structuré).
+ * Les connectivités suivent les conventions VTK, reprises par <I>Qualif</I>.
+ */
+class ParametricMesh
+{
+	public :
+
+	ParametricMesh ( )
+		: _subCells (1), _nodesPerCell (8), _gridNodes (0), _gridCells (0),
+		  _nodes (0), _cells (0), _nodesPermutation ( ), _cellsPermutation ( )
+	{
+		const bool	planar	= is2D ( );
+		if (true == planar)
+			nk	= 0;
+		switch (cellType)
+		{
+			case CELL_TRIANGLE		: _subCells = 2;	_nodesPerCell = 3;	break;
+			case CELL_QUADRANGLE	: _subCells = 1;	_nodesPerCell = 4;	break;
+			case CELL_TETRAEDRON	: _subCells = 6;	_nodesPerCell = 4;	break;
+			case CELL_PYRAMID		: _subCells = 6;	_nodesPerCell = 5;	break;
+			case CELL_PRISM			: _subCells = 2;	_nodesPerCell = 6;	break;
+			case CELL_HEXAEDRON		: _subCells = 1;	_nodesPerCell = 8;	break;
+		}	// switch (cellType)
+		if (0 != requestedCells)
+		{	// Grille cubique (carrée) de requestedCells mailles environ :
+			const double	n	= ceil (pow ((double)requestedCells / _subCells,
+											 true == planar ? 0.5 : 1. / 3.));
+			ni	= nj	= (uint64_t)n;
+			nk	= true == planar ? 0 : (uint64_t)n;
+		}	// if (0 != requestedCells)
+		if ((0 == ni) || (0 == nj) || ((false == planar) && (0 == nk)))
+			throw runtime_error ("Taille de grille nulle.");
+		_gridNodes	= (ni + 1) * (nj + 1) * (true == planar ? 1 : nk + 1);
+		_gridCells	= ni * nj * (true == planar ? 1 : nk);
+		_cells		= _gridCells * _subCells;
+		// Les pyramides ont pour sommet le centre de l'hexaèdre découpé :
+		_nodes		= _gridNodes + (CELL_PYRAMID == cellType ? _gridCells : 0);
+		_nodesPermutation.initialize (_nodes, 1);
+		_cellsPermutation.initialize (_cells, 2);
+	}	// ParametricMesh
+
+	static bool is2D ( )
+	{ return (CELL_TRIANGLE == cellType) || (CELL_QUADRANGLE == cellType); }
+
+	uint64_t nodesNum ( ) const
+	{ return _nodes; }
+	uint64_t cellsNum ( ) const
+	{ return _cells; }
+	size_t nodesPerCell ( ) const
+	{ return _nodesPerCell; }
+
+	/** Les coordonnées du f-ème noeud écrit. */
+	void node (uint64_t f, double coords [3]) const
+	{ originalNode (_nodesPermutation.original (f), coords); }
+
+	/**
+	 * La connectivité (positions d'écriture des noeuds) de la f-ème maille
+	 * écrite.
+	 * @return	<I>true</I> si la maille est retournée.
+	 */
+	bool cell (uint64_t f, uint64_t ids [8]) const
+	{
+		// Connectivités locales des mailles issues du découpage de
+		// l'hexaèdre (0, 1, 2, 3 : face z-, 4, 5, 6, 7 : face z+), 8 étant
+		// son centre :
+		static const int	tetras [6][4]	=
+			{ {0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6},
+			  {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6} };
+		static const int	pyramids [6][5]	=
+			{ {0, 1, 2, 3, 8}, {4, 7, 6, 5, 8}, {0, 4, 5, 1, 8},
+			  {1, 5, 6, 2, 8}, {2, 6, 7, 3, 8}, {3, 7, 4, 0, 8} };
+		static const int	prisms [2][6]	=
+			{ {0, 2, 1, 4, 6, 5}, {0, 3, 2, 4, 7, 6} };
+		static const int	triangles [2][3]	= { {0, 1, 2}, {0, 2, 3} };
+		static const int	identity [8]	= { 0, 1, 2, 3, 4, 5, 6, 7 };
+		// Permutations retournant les mailles :
+		static const int	invTriangle [3]		= { 0, 2, 1 };
+		static const int	invQuadrangle [4]	= { 0, 3, 2, 1 };
+		static const int	invTetraedron [4]	= { 0, 2, 1, 3 };
+		static const int	invPyramid [5]		= { 0, 3, 2, 1, 4 };
+		static const int	invPrism [6]		= { 0, 2, 1, 3, 5, 4 };
+		static const int	invHexaedron [8]	= { 4, 5, 6, 7, 0, 1, 2, 3 };
+
+		const uint64_t	o	= _cellsPermutation.original (f);
+		const uint64_t	g	= o / _subCells;
+		const size_t	s	= (size_t)(o % _subCells);
+		const uint64_t	i	= g % ni;
+		const uint64_t	j	= (g / ni) % nj;
+		const uint64_t	k	= g / (ni * nj);
+		uint64_t		corners [9];
+		corners [0]	= gridNode (i, j, k);
+		corners [1]	= gridNode (i + 1, j, k);
+		corners [2]	= gridNode (i + 1, j + 1, k);
+		corners [3]	= gridNode (i, j + 1, k);
+		if (false == is2D ( ))
+		{
+			corners [4]	= gridNode (i, j, k + 1);
+			corners [5]	= gridNode (i + 1, j, k + 1);
+			corners [6]	= gridNode (i + 1, j + 1, k + 1);
+			corners [7]	= gridNode (i, j + 1, k + 1);
+		}	// if (false == is2D ( ))
+		corners [8]	= _gridNodes + g;
+
+		const int*	local		= identity;
+		const int*	inversion	= identity;
+		switch (cellType)
+		{
+			case CELL_TRIANGLE		:
+				local	= triangles [s];	inversion	= invTriangle;		break;
+			case CELL_QUADRANGLE	:
+				inversion	= invQuadrangle;								break;
+			case CELL_TETRAEDRON	:
+				local	= tetras [s];		inversion	= invTetraedron;	break;
+			case CELL_PYRAMID		:
+				local	= pyramids [s];		inversion	= invPyramid;		break;
+			case CELL_PRISM			:
+				local	= prisms [s];		inversion	= invPrism;			break;
+			case CELL_HEXAEDRON		:
+				inversion	= invHexaedron;									break;
+		}	// switch (cellType)
+		const bool	inverted	= uniform (3, o) < invertedRatio;
+		if (false == inverted)
+			inversion	= identity;
+		for (size_t n = 0; n < _nodesPerCell; n++)
+			ids [n]	= _nodesPermutation.position (corners [local [inversion [n]]]);
+
+		return inverted;
+	}	// cell
+
+
+	private :
+
+	uint64_t gridNode (uint64_t i, uint64_t j, uint64_t k) const
+	{ return i + (ni + 1) * (j + (nj + 1) * k); }
+
+	/** Les coordonnées du noeud d'indice (d'origine) o. */
+	void originalNode (uint64_t o, double coords [3]) const
+	{
+		if (o >= _gridNodes)
+		{	// Centre d'hexaèdre (pyramides) :
+			const uint64_t	g	= o - _gridNodes;
+			const uint64_t	i	= g % ni;
+			const uint64_t	j	= (g / ni) % nj;
+			const uint64_t	k	= g / (ni * nj);
+			double			corner [3];
+			coords [0]	= coords [1]	= coords [2]	= 0.;
+			for (uint64_t c = 0; c < 8; c++)
+			{
+				originalNode (gridNode (i + (c & 1), j + ((c >> 1) & 1),
+				                        k + ((c >> 2) & 1)), corner);
+				for (size_t d = 0; d < 3; d++)
+					coords [d]	+= corner [d] / 8.;
+			}	// for (uint64_t c = 0; c < 8; c++)
+			return;
+		}	// if (o >= _gridNodes)
+
+		coords [0]	= (double)(o % (ni + 1));
+		coords [1]	= (double)((o / (ni + 1)) % (nj + 1));
+		coords [2]	= (double)(o / ((ni + 1) * (nj + 1)));
+		if (0. == distortion)
+			return;
+		const size_t	dim	= true == is2D ( ) ? 2 : 3;
+		for (size_t d = 0; d < dim; d++)
+		{
+			double	delta	= 0.;
+			if (DIST_UNIFORM == distribution)
+				delta	= 2. * uniform (10 + d, o) - 1.;
+			else
+			{	// Box-Muller :
+				const double	u1	= 1. - uniform (10 + d, o);
+				const double	u2	= uniform (20 + d, o);
+				delta	= sqrt (-2. * log (u1)) * cos (2. * M_PI * u2);
+			}	// else if (DIST_UNIFORM == distribution)
+			coords [d]	+= distortion * delta;
+		}	// for (size_t d = 0; d < dim; d++)
+	}	// originalNode
+
+	size_t			_subCells, _nodesPerCell;
+	uint64_t		_gridNodes, _gridCells, _nodes, _cells;
+	Permutation		_nodesPermutation, _cellsPermutation;
+};	// class ParametricMesh
+
+
+static Polyedre createPolyedron (
+			const vector<Noeud>& nodes, const uint64_t ids [8], size_t count)
+{
+	switch (count)
+	{
+		case	4	:
+			return Polyedre (nodes [ids [0]], nodes [ids [1]], nodes [ids [2]],
+			                 nodes [ids [3]]);
+		case	5	:
+			return Polyedre (nodes [ids [0]], nodes [ids [1]], nodes [ids [2]],
+			                 nodes [ids [3]], nodes [ids [4]]);
+		case	6	:
+			return Polyedre (nodes [ids [0]], nodes [ids [1]], nodes [ids [2]],
+			                 nodes [ids [3]], nodes [ids [4]], nodes [ids [5]]);
+	}	// switch (count)
+
+	return Polyedre (nodes [ids [0]], nodes [ids [1]], nodes [ids [2]],
+	                 nodes [ids [3]], nodes [ids [4]], nodes [ids [5]],
+	                 nodes [ids [6]], nodes [ids [7]]);
+}	// createPolyedron
+
+
+/**
+ * Ecriture au format Lima (maillage construit en mémoire => tailles
+ * modérées). Les mailles retournées sont également placées dans le groupe
+ * <I>INVERTED</I>.
+ */
+static void writeLima (const ParametricMesh& generated)
+{
+	const bool		planar	= ParametricMesh::is2D ( );
+	Maillage		mesh ("CELLS");
+	Volume			allVolumes ("CELLS"), invertedVolumes ("INVERTED");
+	Surface			allSurfaces ("CELLS"), invertedSurfaces ("INVERTED");
+	vector<Noeud>	nodes;
+	mesh.dimension (true == planar ? D2 : D3);
+	nodes.reserve (generated.nodesNum ( ));
+	for (uint64_t n = 0; n < generated.nodesNum ( ); n++)
+	{
+		double	coords [3];
+		generated.node (n, coords);
+		nodes.push_back (Noeud (coords [0], coords [1], coords [2]));
+		mesh.ajouter (nodes.back ( ));
+	}	// for (uint64_t n = 0; n < generated.nodesNum ( ); n++)
+
+	for (uint64_t c = 0; c < generated.cellsNum ( ); c++)
+	{
+		uint64_t	ids [8];
+		const bool	inverted	= generated.cell (c, ids);
+		if (true == planar)
+		{
+			Polygone	polygon	= 3 == generated.nodesPerCell ( ) ?
+				Polygone (nodes [ids [0]], nodes [ids [1]], nodes [ids [2]]) :
+				Polygone (nodes [ids [0]], nodes [ids [1]], nodes [ids [2]],
+				          nodes [ids [3]]);
+			mesh.ajouter (polygon);
+			allSurfaces.ajouter (polygon);
+			if (true == inverted)
+				invertedSurfaces.ajouter (polygon);
+			continue;
+		}	// if (true == planar)
+
+		Polyedre	polyedron	=
+					createPolyedron (nodes, ids, generated.nodesPerCell ( ));
+		mesh.ajouter (polyedron);
+		allVolumes.ajouter (polyedron);
+		if (true == inverted)
+			invertedVolumes.ajouter (polyedron);
+	}	// for (uint64_t c = 0; c < generated.cellsNum ( ); c++)
+
+	if (true == planar)
+	{
+		mesh.ajouter (allSurfaces);
+		if (0 != invertedSurfaces.nb_polygones ( ))
+			mesh.ajouter (invertedSurfaces);
+	}	// if (true == planar)
+	else
+	{
+		mesh.ajouter (allVolumes);
+		if (0 != invertedVolumes.nb_polyedres ( ))
+			mesh.ajouter (invertedVolumes);
+	}	// else if (true == planar)
+	mesh.ecrire (meshPath);
+}	// writeLima
+
+
+/**
+ * Tampon d'écriture binaire, avec éventuelle inversion des octets (VTK
+ * legacy binaire est big endian).
+ */
+class BinaryWriter
+{
+	public :
+
+	BinaryWriter (const string& path, bool bigEndian)
+		: _stream (path.c_str ( ), ios::out | ios::binary | ios::trunc),
+		  _swap (false), _buffer ( )
+	{
+		if (!_stream)
+			throw runtime_error ("Impossible d'ouvrir le fichier " + path + ".");
+		const uint16_t	one	= 1;
+		_swap	= bigEndian == (1 == *(const unsigned char*)&one);
+		_buffer.reserve (1 << 20);
+	}	// BinaryWriter
+
+	~BinaryWriter ( )
+	{
+		try
+		{
+			flush ( );
+		}
+		catch (...)
+		{
+		}
+	}	// ~BinaryWriter
+
+	template <typename T> void write (T value)
+	{
+		unsigned char*	bytes	= (unsigned char*)&value;
+		if (true == _swap)
+			for (size_t b = 0; b < sizeof (T) / 2; b++)
+				std::swap (bytes [b], bytes [sizeof (T) - 1 - b]);
+		_buffer.insert (_buffer.end ( ), bytes, bytes + sizeof (T));
+		if (_buffer.size ( ) >= (1 << 20))
+			flush ( );
+	}	// write
+
+	void write (const string& text)
+	{
+		flush ( );
+		_stream << text;
+	}	// write
+
+	void flush ( )
+	{
+		if (0 != _buffer.size ( ))
+			_stream.write ((const char*)&_buffer [0], _buffer.size ( ));
+		_buffer.clear ( );
+		if (!_stream)
+			throw runtime_error ("Erreur d'écriture du maillage.");
+	}	// flush
+
+
+	private :
+
+	ofstream				_stream;
+	bool					_swap;
+	vector<unsigned char>	_buffer;
+};	// class BinaryWriter
+
+
+/** Ecriture au format VTK legacy binaire, au fil de l'eau. */
+static void writeVtk (const ParametricMesh& generated)
+{
+	static const int32_t	vtkTypes [6]	= { 5, 9, 10, 14, 13, 12 };
+	const size_t			nodesPerCell	= generated.nodesPerCell ( );
+	BinaryWriter			writer (meshPath, true);
+	char					line [256];
+	writer.write (string ("# vtk DataFile Version 3.0\nhexagen\nBINARY\n")
+	              + "DATASET UNSTRUCTURED_GRID\n");
+	snprintf (line, sizeof (line), "POINTS %llu double\n",
+	          (unsigned long long)generated.nodesNum ( ));
+	writer.write (string (line));
+	for (uint64_t n = 0; n < generated.nodesNum ( ); n++)
+	{
+		double	coords [3];
+		generated.node (n, coords);
+		writer.write (coords [0]);
+		writer.write (coords [1]);
+		writer.write (coords [2]);
+	}	// for (uint64_t n = 0; n < generated.nodesNum ( ); n++)
+	snprintf (line, sizeof (line), "\nCELLS %llu %llu\n",
+	          (unsigned long long)generated.cellsNum ( ),
+	          (unsigned long long)(generated.cellsNum ( ) * (nodesPerCell + 1)));
+	writer.write (string (line));
+	for (uint64_t c = 0; c < generated.cellsNum ( ); c++)
+	{
+		uint64_t	ids [8];
+		generated.cell (c, ids);
+		writer.write ((int32_t)nodesPerCell);
+		for (size_t n = 0; n < nodesPerCell; n++)
+			writer.write ((int32_t)ids [n]);
+	}	// for (uint64_t c = 0; c < generated.cellsNum ( ); c++)
+	snprintf (line, sizeof (line), "\nCELL_TYPES %llu\n",
+	          (unsigned long long)generated.cellsNum ( ));
+	writer.write (string (line));
+	for (uint64_t c = 0; c < generated.cellsNum ( ); c++)
+		writer.write (vtkTypes [cellType]);
+	writer.write (string ("\n"));
+	writer.flush ( );
+}	// writeVtk
+
+
+/**
+ * Ecriture au format brut, au fil de l'eau, dans le boutisme de la machine :
+ * - 8 octets : "QQRAW001",
+ * - uint32 : type de maille VTK, uint32 : nombre de noeuds par maille,
+ * - uint64 : nombre de noeuds, uint64 : nombre de mailles,
+ * - nombre de noeuds x 3 double : coordonnées,
+ * - nombre de mailles x noeuds par maille uint64 : connectivités.
+ */
+static void writeRaw (const ParametricMesh& generated)
+{
+	static const uint32_t	vtkTypes [6]	= { 5, 9, 10, 14, 13, 12 };
+	const size_t			nodesPerCell	= generated.nodesPerCell ( );
+	BinaryWriter			writer (meshPath, false);
+	writer.write (string ("QQRAW001"));
+	writer.write (vtkTypes [cellType]);
+	writer.write ((uint32_t)nodesPerCell);
+	writer.write (generated.nodesNum ( ));
+	writer.write (generated.cellsNum ( ));
+	for (uint64_t n = 0; n < generated.nodesNum ( ); n++)
+	{
+		double	coords [3];
+		generated.node (n, coords);
+		writer.write (coords [0]);
+		writer.write (coords [1]);
+		writer.write (coords [2]);
+	}	// for (uint64_t n = 0; n < generated.nodesNum ( ); n++)
+	for (uint64_t c = 0; c < generated.cellsNum ( ); c++)
+	{
+		uint64_t	ids [8];
+		generated.cell (c, ids);
+		for (size_t n = 0; n < nodesPerCell; n++)
+			writer.write (ids [n]);
+	}	// for (uint64_t c = 0; c < generated.cellsNum ( ); c++)
+	writer.flush ( );
+}	// writeRaw
+
+
+static void generate ( )
+{
+	if (FORMAT_DEFAULT == outputFormat)
+	{
+		const string::size_type	dot	= meshPath.rfind ('.');
+		const string	extension	=
+					string::npos == dot ? string ( ) : meshPath.substr (dot + 1);
+		outputFormat	= 0 == strcasecmp (extension.c_str ( ), "vtk") ? FORMAT_VTK :
+				  0 == strcasecmp (extension.c_str ( ), "raw") ? FORMAT_RAW :
+				  FORMAT_LIMA;
+	}	// if (FORMAT_DEFAULT == outputFormat)
+
+	const ParametricMesh	generated;
+	// Indices des noeuds, nombre de mailles et taille de la liste CELLS sur
+	// 32 bits :
+	if ((FORMAT_VTK == outputFormat) &&
+	    ((generated.nodesNum ( ) > 2147483647ULL) ||
+	     (generated.cellsNum ( ) > 2147483647ULL) ||
+	     (generated.cellsNum ( ) * (generated.nodesPerCell ( ) + 1) >
+	      2147483647ULL)))
+		throw runtime_error ("Trop de noeuds pour le format VTK legacy (indices sur 32 bits).");
+	switch (outputFormat)
+	{
+		case FORMAT_VTK	: writeVtk (generated);		break;
+		case FORMAT_RAW	: writeRaw (generated);		break;
+		default			: writeLima (generated);
+	}	// switch (outputFormat)
+	cout << "Maillage de " << generated.cellsNum ( ) << " mailles et "
+	     << generated.nodesNum ( ) << " noeuds enregistré dans le fichier "
+	     << meshPath << "." << endl;
+}	// generate
+
+
 int main (int argc, char* argv[])
 {
 	if (0 != parseArgs (argc, argv))
@@ -32,6 +612,12 @@ int main (int argc, char* argv[])
 	try
 	{
 
+	if (true == parametric)
+	{
+		generate ( );
+		return 0;
+	}	// if (true == parametric)
+
 	// Création du maillage :
 	Maillage	mesh ("CELLS");
 	Volume		line1 ("L1");
@@ -376,7 +962,7 @@ int main (int argc, char* argv[])
 
 static int parseArgs (int argc, char* argv [])
 {
-	for (int i = 0; i < argc; i++)
+	for (int i = 1; i < argc; i++)
 	{
 		if (i < argc - 1)
 		{
@@ -385,8 +971,77 @@ static int parseArgs (int argc, char* argv [])
 				meshPath	= argv [++i];
 				continue;
 			}	// if (0 == strcmp (argv [i], "-mesh"))
+			if (0 == strcmp (argv [i], "-type"))
+			{
+				static const char*	types [6]	=
+					{ "tri", "quad", "tetra", "pyramid", "prism", "hexa" };
+				const char*	type	= argv [++i];
+				int			t		= 0;
+				for (t = 0; t < 6; t++)
+					if (0 == strcasecmp (type, types [t]))
+						break;
+				if (6 == t)
+					return -1;
+				cellType	= (CELL_TYPE)t;
+				parametric	= true;
+				continue;
+			}	// if (0 == strcmp (argv [i], "-type"))
+			if ((0 == strcmp (argv [i], "-size")) && (i < argc - 3))
+			{
+				ni	= strtoull (argv [++i], 0, 10);
+				nj	= strtoull (argv [++i], 0, 10);
+				nk	= strtoull (argv [++i], 0, 10);
+				continue;
+			}	// if ((0 == strcmp (argv [i], "-size")) && (i < argc - 3))
+			if (0 == strcmp (argv [i], "-cells"))
+			{
+				requestedCells	= strtoull (argv [++i], 0, 10);
+				continue;
+			}	// if (0 == strcmp (argv [i], "-cells"))
+			if ((0 == strcmp (argv [i], "-distortion")) && (i < argc - 2))
+			{
+				const char*	law	= argv [++i];
+				if (0 == strcasecmp (law, "uniform"))
+					distribution	= DIST_UNIFORM;
+				else if (0 == strcasecmp (law, "normal"))
+					distribution	= DIST_NORMAL;
+				else
+					return -1;
+				distortion	= atof (argv [++i]);
+				continue;
+			}	// if ((0 == strcmp (argv [i], "-distortion")) && ...
+			if (0 == strcmp (argv [i], "-inverted"))
+			{
+				invertedRatio	= atof (argv [++i]);
+				continue;
+			}	// if (0 == strcmp (argv [i], "-inverted"))
+			if (0 == strcmp (argv [i], "-seed"))
+			{
+				seed	= strtoull (argv [++i], 0, 10);
+				continue;
+			}	// if (0 == strcmp (argv [i], "-seed"))
+			if (0 == strcmp (argv [i], "-format"))
+			{
+				const char*	name	= argv [++i];
+				if (0 == strcasecmp (name, "lima"))
+					outputFormat	= FORMAT_LIMA;
+				else if (0 == strcasecmp (name, "vtk"))
+					outputFormat	= FORMAT_VTK;
+				else if (0 == strcasecmp (name, "raw"))
+					outputFormat	= FORMAT_RAW;
+				else
+					return -1;
+				continue;
+			}	// if (0 == strcmp (argv [i], "-format"))
 		}	// if (i < argc - 1)
-	}	// for (int i = 0; i < argc; i++)
+		if (0 == strcmp (argv [i], "-unstructured"))
+		{
+			unstructured	= true;
+			continue;
+		}	// if (0 == strcmp (argv [i], "-unstructured"))
+
+		return -1;
+	}	// for (int i = 1; i < argc; i++)
 
 	return 0;
 }	// parseArgs
@@ -394,8 +1049,17 @@ static int parseArgs (int argc, char* argv [])
 
 static int syntax (const string& pgm)
 {
-	cout << "Syntaxe : " << pgm << " -mesh filename" << endl;
+	cout << "Syntaxe : " << pgm << " -mesh filename" << endl
+	     << "ou " << pgm << " -mesh filename -type tri|quad|tetra|pyramid|prism|hexa "
+	     << "[-size ni nj nk | -cells num] [-unstructured] "
+	     << "[-distortion uniform|normal amplitude] [-inverted ratio] "
+	     << "[-seed num] [-format lima|vtk|raw]" << endl
+	     << "Les mailles sont issues d'une grille de ni x nj x nk hexaèdres "
+	     << "(ni x nj quadrangles en 2D), les noeuds de pas 1 étant perturbés "
+	     << "selon la loi et l'amplitude données. -inverted donne la "
+	     << "proportion de mailles retournées. Le format est par défaut déduit "
+	     << "de l'extension du fichier (vtk : VTK legacy binaire, raw : "
+	     << "format brut, autres : Lima)." << endl;
 
 	return -1;
 }	// syntax
-
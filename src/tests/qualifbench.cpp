@@ -0,0 +1,710 @@
+//
+// Programme de mesure des performances de GQualif :
+// - débit (mailles/s) de Maille::AppliqueCritere par critère et type de maille,
+// - coût de getCell des adaptateurs Lima/VTK/GMDS,
+// - débit de bout en bout de QualifRangeTask et QualifAnalysisTask,
+// - coût du calcul de l'ordre d'évaluation des mailles (courbe de Morton) et
+//   mêmes mesures dans cet ordre (adaptateurs suffixés par -morton),
+// chaque mesure étant effectuée pour 1, 2, 4, ..., N threads.
+// Les résultats sont écrits au format CSV afin d'être comparés d'une version
+// à l'autre.
+//
+// Rem : les séries n'autorisent les accès concurrents qu'entre séries
+// différentes. Les mesures multithreads sont donc effectuées avec une série
+// par thread, chaque série parcourant l'ensemble des mailles (débit global
+// = nombre de threads x nombre de mailles / durée).
+//
+
+#include "GQualif/AbstractQualifSerieAdapter.h"
+#include "GQualif/QualifAnalysisTask.h"
+#include "GQualif/QualifHelper.h"
+#include "GQualif/QualifRangeTask.h"
+#include "GQLima/LimaQualifSerie.h"
+#ifdef USE_VTK
+#include "GQVtk/VtkQualifSerie.h"
+#endif	// USE_VTK
+#ifdef USE_GMDS
+#include "GQGMDS/GMDSQualifSerie.h"
+#endif	// USE_GMDS
+
+#include <TkUtil/Exception.h>
+#include <TkUtil/File.h>
+#include <TkUtil/ThreadManager.h>
+#include <TkUtil/UTF8String.h>
+
+#include <Lima/erreur.h>
+#ifdef USE_VTK
+#include <vtkUnstructuredGridReader.h>
+#endif	// USE_VTK
+#ifdef USE_GMDS
+#include <gmds/io/IGMeshIOService.h>
+#include <gmds/io/MeditReader.h>
+#include <gmds/io/VTKReader.h>
+#endif	// USE_GMDS
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+
+using namespace GQualif;
+using namespace Qualif;
+using namespace TkUtil;
+using namespace std;
+
+static const Charset	charset ("àéèùô");
+
+
+static size_t			cellsNum	= 1000000;
+static size_t			maxThreads	= 0;
+static double			distortion	= 0.1;
+static unsigned int		seed		= 1;
+static vector<Critere>	criteria;
+static string			limaPath, vtkPath, gmdsPath;
+static string			outputPath;
+
+static int parseArgs (int argc, char* argv []);
+static int syntax (const string& pgm);
+
+
+typedef chrono::steady_clock	Clock;
+
+static double elapsed (const Clock::time_point& start)
+{
+	return chrono::duration<double> (Clock::now ( ) - start).count ( );
+}	// elapsed
+
+
+/** Puits des valeurs calculées, afin que le compilateur ne supprime pas les
+ * appels mesurés. */
+static volatile double	sink	= 0.;
+
+
+// ============================================================================
+//                      LA CLASSE SyntheticQualifSerie
+// ============================================================================
+
+/**
+ * Série de mailles d'un type donné, générées en mémoire par perturbation
+ * aléatoire d'une maille idéale. Permet de mesurer les performances de
+ * <I>Qualif</I> et des tâches sans coût d'accès à une structure de maillage.
+ */
+class SyntheticQualifSerie : public AbstractQualifSerieAdapter
+{
+	public :
+
+	SyntheticQualifSerie (size_t type, size_t count, double distortion, unsigned int seed);
+	virtual ~SyntheticQualifSerie ( )
+	{ }
+
+	virtual size_t getCellCount ( ) const
+	{ return _count; }
+	virtual Qualif::Maille& getCell (size_t i) const;
+	virtual size_t getCellType (size_t) const
+	{ return _type; }
+	virtual bool isVolumic ( ) const
+	{ return _nodesNum > 4 || QualifHelper::TETRAEDRON == _type; }
+	virtual bool isThreadable ( ) const
+	{ return true; }
+
+	static size_t nodesNum (size_t type);
+
+
+	private :
+
+	SyntheticQualifSerie (const SyntheticQualifSerie&);
+	SyntheticQualifSerie& operator = (const SyntheticQualifSerie&);
+
+	size_t						_type, _count, _nodesNum;
+	vector<double>				_coordinates;
+};	// class SyntheticQualifSerie
+
+
+size_t SyntheticQualifSerie::nodesNum (size_t type)
+{
+	if (QualifHelper::TRIANGLE == type)
+		return 3;
+	if ((QualifHelper::QUADRANGLE == type) || (QualifHelper::TETRAEDRON == type))
+		return 4;
+	if (QualifHelper::PYRAMID == type)
+		return 5;
+	if (QualifHelper::TRIANGULAR_PRISM == type)
+		return 6;
+	return 8;
+}	// SyntheticQualifSerie::nodesNum
+
+
+SyntheticQualifSerie::SyntheticQualifSerie (
+			size_t type, size_t count, double distortion, unsigned int seed)
+	: AbstractQualifSerieAdapter ("", QualifHelper::dataTypeToName (type).utf8 ( ),
+	                              QualifHelper::TRIANGLE == type ||
+	                              QualifHelper::QUADRANGLE == type ? 2 : 3),
+	  _type (type), _count (count), _nodesNum (nodesNum (type)), _coordinates ( )
+{
+	// Les mailles idéales (arête unité) :
+	static const double	triangle [3][3]	=
+		{ {0., 0., 0.}, {1., 0., 0.}, {0.5, 0.8660254, 0.} };
+	static const double	quadrangle [4][3]	=
+		{ {0., 0., 0.}, {1., 0., 0.}, {1., 1., 0.}, {0., 1., 0.} };
+	static const double	tetraedron [4][3]	=
+		{ {0., 0., 0.}, {1., 0., 0.}, {0.5, 0.8660254, 0.},
+		  {0.5, 0.2886751, 0.8164966} };
+	static const double	pyramid [5][3]	=
+		{ {0., 0., 0.}, {1., 0., 0.}, {1., 1., 0.}, {0., 1., 0.},
+		  {0.5, 0.5, 0.7071068} };
+	static const double	prism [6][3]	=
+		{ {0., 0., 0.}, {1., 0., 0.}, {0.5, 0.8660254, 0.},
+		  {0., 0., 1.}, {1., 0., 1.}, {0.5, 0.8660254, 1.} };
+	static const double	hexaedron [8][3]	=
+		{ {0., 0., 0.}, {1., 0., 0.}, {1., 1., 0.}, {0., 1., 0.},
+		  {0., 0., 1.}, {1., 0., 1.}, {1., 1., 1.}, {0., 1., 1.} };
+	const double	(*ideal)[3]	= hexaedron;
+	if (QualifHelper::TRIANGLE == type)
+		ideal	= triangle;
+	else if (QualifHelper::QUADRANGLE == type)
+		ideal	= quadrangle;
+	else if (QualifHelper::TETRAEDRON == type)
+		ideal	= tetraedron;
+	else if (QualifHelper::PYRAMID == type)
+		ideal	= pyramid;
+	else if (QualifHelper::TRIANGULAR_PRISM == type)
+		ideal	= prism;
+
+	const bool							planar	= 2 == getDimension ( );
+	mt19937								generator (seed);
+	uniform_real_distribution<double>	noise (-distortion, distortion);
+	_coordinates.resize (count * _nodesNum * 3);
+	double*	coords	= &_coordinates [0];
+	for (size_t c = 0; c < count; c++)
+		for (size_t n = 0; n < _nodesNum; n++)
+			for (size_t d = 0; d < 3; d++, coords++)
+				*coords	= ideal [n][d] +
+				          (true == planar && 2 == d ? 0. : noise (generator));
+}	// SyntheticQualifSerie::SyntheticQualifSerie
+
+
+Qualif::Maille& SyntheticQualifSerie::getCell (size_t i) const
+{
+	const double*	coords	= &_coordinates [i * _nodesNum * 3];
+	Qualif::Maille*	cell	= &_hexaedron;
+	if (QualifHelper::TRIANGLE == _type)
+		cell	= &_triangle;
+	else if (QualifHelper::QUADRANGLE == _type)
+		cell	= &_quadrangle;
+	else if (QualifHelper::TETRAEDRON == _type)
+		cell	= &_tetraedron;
+	else if (QualifHelper::PYRAMID == _type)
+		cell	= &_pyramid;
+	else if (QualifHelper::TRIANGULAR_PRISM == _type)
+		cell	= &_prism;
+	for (size_t n = 0; n < _nodesNum; n++, coords += 3)
+		cell->Modifier_Sommet (n, coords [0], coords [1], coords [2]);
+
+	return *cell;
+}	// SyntheticQualifSerie::getCell
+
+
+// ============================================================================
+//                            LES MESURES
+// ============================================================================
+
+/** Les nombres de threads testés : 1, 2, 4, ..., N. */
+static vector<size_t> threadsCounts ( )
+{
+	vector<size_t>	counts;
+	for (size_t t = 1; t < maxThreads; t *= 2)
+		counts.push_back (t);
+	counts.push_back (maxThreads);
+
+	return counts;
+}	// threadsCounts
+
+
+static void writeResult (ostream& stream, const string& benchmark,
+		const string& adapter, const string& criterion, const string& type,
+		size_t threads, size_t cells, double seconds)
+{
+	stream << benchmark << "," << adapter << "," << criterion << "," << type
+	       << "," << threads << "," << cells << "," << seconds << ","
+	       << (0. < seconds ? cells / seconds : 0.) << endl;
+}	// writeResult
+
+
+/**
+ * Exécute <I>function (s)</I> dans <I>threads</I> threads, <I>s</I> étant
+ * l'indice du thread, et retourne la durée d'exécution.
+ */
+template <typename F> static double runThreads (size_t threads, F function)
+{
+	vector<thread>			workers;
+	const Clock::time_point	start	= Clock::now ( );
+	for (size_t t = 0; t < threads; t++)
+		workers.push_back (thread (function, t));
+	for (vector<thread>::iterator itw = workers.begin ( );
+	     workers.end ( ) != itw; itw++)
+		(*itw).join ( );
+
+	return elapsed (start);
+}	// runThreads
+
+
+/**
+ * Mesure du débit de <I>Maille::AppliqueCritere</I> par critère et par
+ * type de maille, sur séries synthétiques.
+ */
+static void criteriaBenchmark (ostream& stream)
+{
+	for (size_t type = QualifHelper::TRIANGLE;
+	     type <= QualifHelper::TRIANGULAR_PRISM; type <<= 1)
+	{
+		vector< unique_ptr<SyntheticQualifSerie> >	series;
+		for (size_t t = 0; t < maxThreads; t++)
+			series.push_back (unique_ptr<SyntheticQualifSerie> (
+				new SyntheticQualifSerie (type, cellsNum, distortion, seed + t)));
+		const string	typeName	= QualifHelper::dataTypeToName (type).utf8 ( );
+
+		// Coût de la mise à jour des noeuds seule :
+		vector<size_t>	counts	= threadsCounts ( );
+		for (vector<size_t>::const_iterator itt = counts.begin ( );
+		     counts.end ( ) != itt; itt++)
+		{
+			const double	seconds	= runThreads (*itt, [&series] (size_t s)
+			{
+				const SyntheticQualifSerie&	serie	= *series [s];
+				double						sum		= 0.;
+				for (size_t c = 0; c < cellsNum; c++)
+					sum	+= serie.getCell (
+							serie.getEvaluatedCell (c)).Sommet (0).GetCoor (0);
+				sink	= sink + sum;
+			});
+			writeResult (stream, "getCell", "synthetic", "", typeName, *itt,
+			             *itt * cellsNum, seconds);
+		}	// for (vector<size_t>::const_iterator itt = counts.begin ( ); ...
+
+		for (vector<Critere>::const_iterator itc = criteria.begin ( );
+		     criteria.end ( ) != itc; itc++)
+		{
+			if (false == QualifHelper::isTypeSupported (type, *itc))
+				continue;
+
+			const Critere	criterion	= *itc;
+			for (vector<size_t>::const_iterator itt = counts.begin ( );
+			     counts.end ( ) != itt; itt++)
+			{
+				const double	seconds	= runThreads (*itt,
+											[&series, criterion] (size_t s)
+				{
+					const SyntheticQualifSerie&	serie	= *series [s];
+					double						sum		= 0.;
+					for (size_t c = 0; c < cellsNum; c++)
+					{
+						try
+						{
+							sum	+= serie.getCell (c).AppliqueCritere (criterion);
+						}
+						catch (...)
+						{
+						}
+					}	// for (size_t c = 0; c < cellsNum; c++)
+					sink	= sink + sum;
+				});
+				writeResult (stream, "AppliqueCritere", "synthetic",
+				             CRITERESTR [criterion], typeName, *itt,
+				             *itt * cellsNum, seconds);
+			}	// for (vector<size_t>::const_iterator itt = counts.begin ( ); ...
+		}	// for (vector<Critere>::const_iterator itc = criteria.begin ( ); ...
+	}	// for (size_t type = QualifHelper::TRIANGLE; ...
+}	// criteriaBenchmark
+
+
+/**
+ * Mesure du coût de <I>getCell</I> (sans application de critère) pour
+ * <I>threads</I> séries d'un même maillage.
+ */
+static void getCellBenchmark (ostream& stream, const string& adapter,
+                              const vector<AbstractQualifSerie*>& series)
+{
+	vector<size_t>	counts	= threadsCounts ( );
+	const size_t	count	= series [0]->getCellCount ( );
+	for (vector<size_t>::const_iterator itt = counts.begin ( );
+	     counts.end ( ) != itt; itt++)
+	{
+		const double	seconds	= runThreads (*itt, [&series, count] (size_t s)
+		{
+			const AbstractQualifSerie&	serie	= *series [s];
+			double						sum		= 0.;
+			for (size_t c = 0; c < count; c++)
+			{
+				try
+				{
+					sum	+= serie.getCell (c).Sommet (0).GetCoor (0);
+				}
+				catch (...)
+				{
+				}
+			}	// for (size_t c = 0; c < count; c++)
+			sink	= sink + sum;
+		});
+		writeResult (stream, "getCell", adapter, "", "all", *itt,
+		             *itt * count, seconds);
+	}	// for (vector<size_t>::const_iterator itt = counts.begin ( ); ...
+}	// getCellBenchmark
+
+
+/**
+ * Mesure de bout en bout de <I>QualifRangeTask</I> (séries sans cache) puis
+ * de <I>QualifAnalysisTask</I> (valeurs en cache, comme dans
+ * <I>QtQualifWidget</I>) pour 1 à N séries traitées en parallèle.
+ */
+static void tasksBenchmark (ostream& stream, const string& adapter,
+                            const vector<AbstractQualifSerie*>& allSeries)
+{
+	vector<size_t>	counts	= threadsCounts ( );
+	size_t			types	= 0;
+	for (vector<AbstractQualifSerie*>::const_iterator its = allSeries.begin ( );
+	     allSeries.end ( ) != its; its++)
+		types	|= (*its)->getDataTypes ( );
+
+	for (vector<Critere>::const_iterator itc = criteria.begin ( );
+	     criteria.end ( ) != itc; itc++)
+	{
+		size_t	criterionTypes	= 0;
+		for (size_t type = QualifHelper::TRIANGLE;
+		     type <= QualifHelper::TRIANGULAR_PRISM; type <<= 1)
+			if ((0 != (type & types)) &&
+			    (true == QualifHelper::isTypeSupported (type, *itc)))
+				criterionTypes	|= type;
+		if (0 == criterionTypes)
+			continue;
+
+		for (vector<size_t>::const_iterator itt = counts.begin ( );
+		     counts.end ( ) != itt; itt++)
+		{
+			vector<AbstractQualifSerie*>	series (
+								allSeries.begin ( ), allSeries.begin ( ) + *itt);
+			size_t							cells	= 0;
+			for (vector<AbstractQualifSerie*>::iterator its = series.begin ( );
+			     series.end ( ) != its; its++)
+			{
+				(*its)->releaseStoredData ( );
+				cells	+= (*its)->getCellCount ( );
+			}	// for (vector<AbstractQualifSerie*>::iterator its = ...
+
+			Clock::time_point	start	= Clock::now ( );
+			QualifRangeTask		rangeTask (criterionTypes, *itc, series);
+			rangeTask.execute ( );
+			writeResult (stream, "QualifRangeTask", adapter, CRITERESTR [*itc],
+			             "all", *itt, cells, elapsed (start));
+
+			start	= Clock::now ( );
+			QualifAnalysisTask	analysisTask (criterionTypes, *itc, 100,
+						rangeTask.getMin ( ), rangeTask.getMax ( ), false, series);
+			analysisTask.execute ( );
+			writeResult (stream, "QualifAnalysisTask", adapter,
+			             CRITERESTR [*itc], "all", *itt, cells, elapsed (start));
+
+			for (vector<AbstractQualifSerie*>::iterator its = series.begin ( );
+			     series.end ( ) != its; its++)
+				(*its)->releaseStoredData ( );
+		}	// for (vector<size_t>::const_iterator itt = counts.begin ( ); ...
+	}	// for (vector<Critere>::const_iterator itc = criteria.begin ( ); ...
+}	// tasksBenchmark
+
+
+/**
+ * Calcule l'ordre d'évaluation des mailles des séries (courbe de Morton, avec
+ * renumérotation éventuelle des noeuds) puis reprend les mesures de
+ * <I>getCellBenchmark</I> et <I>tasksBenchmark</I> dans cet ordre, pour
+ * l'adaptateur <I>adapter</I>-morton.
+ */
+static void reorderingBenchmark (ostream& stream, const string& adapter,
+                                 const vector<AbstractQualifSerie*>& series,
+                                 bool renumber)
+{
+	const string	reordered	= adapter + "-morton";
+	size_t			cells		= 0;
+	double			seconds		= 0.;
+	for (vector<AbstractQualifSerie*>::const_iterator its = series.begin ( );
+	     series.end ( ) != its; its++)
+	{
+		seconds	+= (*its)->computeEvaluationOrder (maxThreads, renumber);
+		cells	+= (*its)->getCellCount ( );
+	}	// for (vector<AbstractQualifSerie*>::const_iterator its = ...
+	writeResult (stream, "computeEvaluationOrder", reordered, "", "all",
+	             maxThreads, cells, seconds);
+	getCellBenchmark (stream, reordered, series);
+	tasksBenchmark (stream, reordered, series);
+}	// reorderingBenchmark
+
+
+static void deleteSeries (vector<AbstractQualifSerie*>& series)
+{
+	for (vector<AbstractQualifSerie*>::iterator its = series.begin ( );
+	     series.end ( ) != its; its++)
+		delete *its;
+	series.clear ( );
+}	// deleteSeries
+
+
+static void syntheticBenchmark (ostream& stream)
+{
+	// Des hexaèdres, type le plus coûteux et le plus fréquent :
+	vector<AbstractQualifSerie*>	series;
+	for (size_t t = 0; t < maxThreads; t++)
+		series.push_back (new SyntheticQualifSerie (
+					QualifHelper::HEXAEDRON, cellsNum, distortion, seed + t));
+	tasksBenchmark (stream, "synthetic", series);
+	deleteSeries (series);
+}	// syntheticBenchmark
+
+
+static void limaBenchmark (ostream& stream)
+{
+	unique_ptr<Lima::_MaillageInterne>	mesh (new Lima::_MaillageInterne ( ));
+	mesh->lire (limaPath);
+	const unsigned char	dimension	= 0 != mesh->nb_polyedres ( ) ? 3 : 2;
+	vector<AbstractQualifSerie*>	series;
+	for (size_t t = 0; t < maxThreads; t++)
+		series.push_back (new LimaQualifSerie (
+							*mesh.get ( ), false, dimension, "", limaPath));
+	getCellBenchmark (stream, "Lima", series);
+	tasksBenchmark (stream, "Lima", series);
+	reorderingBenchmark (stream, "Lima", series, false);
+	deleteSeries (series);
+
+	// Mailles lues dans un instantané (tableaux contigus) :
+	for (size_t t = 0; t < maxThreads; t++)
+	{
+		LimaQualifSerie*	serie	= new LimaQualifSerie (
+							*mesh.get ( ), false, dimension, "", limaPath);
+		series.push_back (serie);
+		serie->createSnapshot ( );
+	}	// for (size_t t = 0; t < maxThreads; t++)
+	getCellBenchmark (stream, "Lima-snapshot", series);
+	tasksBenchmark (stream, "Lima-snapshot", series);
+	reorderingBenchmark (stream, "Lima-snapshot", series, true);
+	deleteSeries (series);
+}	// limaBenchmark
+
+
+#ifdef USE_VTK
+static void vtkBenchmark (ostream& stream)
+{
+	vtkUnstructuredGridReader*	reader	= vtkUnstructuredGridReader::New ( );
+	reader->SetFileName (vtkPath.c_str ( ));
+	reader->Update ( );
+	vtkUnstructuredGrid*	grid	= reader->GetOutput ( );
+	if ((0 == grid) || (0 == grid->GetNumberOfCells ( )))
+	{
+		reader->Delete ( );
+		UTF8String	error (charset);
+		error << "Absence de maillage non structuré VTK dans le fichier "
+		      << vtkPath << ".";
+		throw Exception (error);
+	}	// if ((0 == grid) || (0 == grid->GetNumberOfCells ( )))
+	vector<AbstractQualifSerie*>	series;
+	for (size_t t = 0; t < maxThreads; t++)
+		series.push_back (new VtkQualifSerie (*grid, "VTK", vtkPath));
+	getCellBenchmark (stream, "VTK", series);
+	tasksBenchmark (stream, "VTK", series);
+	reorderingBenchmark (stream, "VTK", series, false);
+	deleteSeries (series);
+	reader->Delete ( );
+}	// vtkBenchmark
+#endif	// USE_VTK
+
+
+#ifdef USE_GMDS
+static void gmdsBenchmark (ostream& stream)
+{
+	static const int	gmdsMask	=
+				gmds::DIM3|gmds::N|gmds::E|gmds::F|gmds::R|gmds::E2N|
+				gmds::F2N|gmds::R2N|gmds::F2E|gmds::R2F|gmds::F2R|
+				gmds::N2F|gmds::N2E|gmds::E2F|gmds::N2R|gmds::E2R|gmds::R2E;
+	gmds::Mesh				mesh (gmdsMask);
+	gmds::IGMeshIOService	ioService (&mesh);
+	TkUtil::File			file (gmdsPath);
+	if ((0 == strcasecmp (file.getExtension ( ).c_str ( ), "mesh")) ||
+	    (0 == strcasecmp (file.getExtension ( ).c_str ( ), "med")))
+	{
+		gmds::MeditReader	reader (&ioService);
+		reader.setCellOptions (gmds::R|gmds::F|gmds::N);
+		reader.read (gmdsPath);
+	}	// mesh med
+	else
+	{
+		gmds::VTKReader	reader (&ioService);
+		reader.read (gmdsPath);
+	}	// vtu vtp
+	vector<AbstractQualifSerie*>	series;
+	for (size_t t = 0; t < maxThreads; t++)
+	{
+		if (0 != mesh.getNbRegions ( ))
+			series.push_back (new GMDSRegionQualifSerie (mesh, "", gmdsPath));
+		else
+			series.push_back (new GMDSFaceQualifSerie (mesh, "", gmdsPath));
+	}	// for (size_t t = 0; t < maxThreads; t++)
+	getCellBenchmark (stream, "GMDS", series);
+	tasksBenchmark (stream, "GMDS", series);
+	reorderingBenchmark (stream, "GMDS", series, false);
+	deleteSeries (series);
+}	// gmdsBenchmark
+#endif	// USE_GMDS
+
+
+int main (int argc, char* argv[])
+{
+	if (0 != parseArgs (argc, argv))
+		return syntax (argv [0]);
+
+	try
+	{
+		if (0 == maxThreads)
+			maxThreads	= thread::hardware_concurrency ( );
+		if (0 == maxThreads)
+			maxThreads	= 1;
+		ThreadManager::initialize (maxThreads);
+
+		unique_ptr<ofstream>	file;
+		if (false == outputPath.empty ( ))
+			file.reset (new ofstream (outputPath.c_str ( )));
+		ostream&	stream	= 0 == file.get ( ) ? cout : *file;
+		stream << setprecision (6);
+		stream << "benchmark,adapter,criterion,type,threads,cells,seconds,"
+		       << "cells_per_second" << endl;
+
+		criteriaBenchmark (stream);
+		syntheticBenchmark (stream);
+		if (false == limaPath.empty ( ))
+			limaBenchmark (stream);
+#ifdef USE_VTK
+		if (false == vtkPath.empty ( ))
+			vtkBenchmark (stream);
+#endif	// USE_VTK
+#ifdef USE_GMDS
+		if (false == gmdsPath.empty ( ))
+			gmdsBenchmark (stream);
+#endif	// USE_GMDS
+	}
+	catch (const Lima::erreur& err)
+	{
+		cerr << "Erreur lima : " << err.what ( ) << endl;
+		return -2;
+	}
+	catch (const Exception& exc)
+	{
+		cerr << "Erreur : " << exc.getFullMessage ( ) << endl;
+		return -3;
+	}
+	catch (const exception& exc)
+	{
+		cerr << "Erreur : " << exc.what ( ) << endl;
+		return -4;
+	}
+	catch (...)
+	{
+		cerr << "Erreur non documentée." << endl;
+		return -5;
+	}
+
+	return 0;
+}	// int main (int, char*[])
+
+
+static int parseArgs (int argc, char* argv [])
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (i < argc - 1)
+		{
+			if (0 == strcmp (argv [i], "-cells"))
+			{
+				cellsNum	= strtoul (argv [++i], 0, 10);
+				continue;
+			}	// if (0 == strcmp (argv [i], "-cells"))
+			if (0 == strcmp (argv [i], "-threads"))
+			{
+				maxThreads	= strtoul (argv [++i], 0, 10);
+				continue;
+			}	// if (0 == strcmp (argv [i], "-threads"))
+			if (0 == strcmp (argv [i], "-distortion"))
+			{
+				distortion	= atof (argv [++i]);
+				continue;
+			}	// if (0 == strcmp (argv [i], "-distortion"))
+			if (0 == strcmp (argv [i], "-seed"))
+			{
+				seed	= (unsigned int)strtoul (argv [++i], 0, 10);
+				continue;
+			}	// if (0 == strcmp (argv [i], "-seed"))
+			if (0 == strcmp (argv [i], "-criterion"))
+			{
+				const char*	name	= argv [++i];
+				int			c		= 0;
+				for (c = 0; c < (int)FIN; c++)
+					if (0 == strcasecmp (name, CRITERESTR [c].c_str ( )))
+						break;
+				if ((int)FIN == c)
+				{
+					cerr << "Critère " << name << " inconnu." << endl;
+					return -1;
+				}	// if ((int)FIN == c)
+				criteria.push_back ((Critere)c);
+				continue;
+			}	// if (0 == strcmp (argv [i], "-criterion"))
+			if (0 == strcmp (argv [i], "-lima"))
+			{
+				limaPath	= argv [++i];
+				continue;
+			}	// if (0 == strcmp (argv [i], "-lima"))
+			if (0 == strcmp (argv [i], "-vtk"))
+			{
+				vtkPath	= argv [++i];
+				continue;
+			}	// if (0 == strcmp (argv [i], "-vtk"))
+			if (0 == strcmp (argv [i], "-gmds"))
+			{
+				gmdsPath	= argv [++i];
+				continue;
+			}	// if (0 == strcmp (argv [i], "-gmds"))
+			if (0 == strcmp (argv [i], "-output"))
+			{
+				outputPath	= argv [++i];
+				continue;
+			}	// if (0 == strcmp (argv [i], "-output"))
+		}	// if (i < argc - 1)
+
+		return -1;
+	}	// for (int i = 1; i < argc; i++)
+
+	if (0 == cellsNum)
+		return -1;
+	if (0 == criteria.size ( ))
+		for (int c = 0; c < (int)FIN; c++)
+			criteria.push_back ((Critere)c);
+
+	return 0;
+}	// parseArgs
+
+
+static int syntax (const string& pgm)
+{
+	cout << "Syntaxe : " << pgm << " [-cells num] [-threads max] "
+	     << "[-distortion ratio] [-seed num] [-criterion name ...] "
+	     << "[-lima filename] [-vtk filename] [-gmds filename] "
+	     << "[-output filename]" << endl
+	     << "Résultats au format CSV : benchmark,adapter,criterion,type,"
+	     << "threads,cells,seconds,cells_per_second" << endl;
+
+	return -1;
+}	// syntax